@@ -453,6 +453,9 @@ UAnimSequence* UFbxLoader::LoadFbxAnimation(const FString& FilePath, const FSkel
 			return nullptr;
 		}
 
+		// 키 줄이기 + 양자화. 캐시에는 압축된 트랙이 저장된다
+		AnimSeq->CompressAnimation();
+
 #ifdef USE_OBJ_CACHE
 		// 7. 캐시 저장
 		try
@@ -475,7 +478,8 @@ UAnimSequence* UFbxLoader::LoadFbxAnimation(const FString& FilePath, const FSkel
 #endif
 	}
 
-	// 8. 리소스 매니저에 등록
+	// 8. 본 -> 트랙 표 생성 (스켈레톤이 지정된 뒤) 후 리소스 매니저에 등록
+	AnimSeq->BuildBoneTrackMap();
 	UResourceManager::GetInstance().Add<UAnimSequence>(NormalizedPath, AnimSeq);
 
 	return AnimSeq;
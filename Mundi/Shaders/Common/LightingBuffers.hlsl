@@ -23,8 +23,10 @@ cbuffer LightBuffer : register(b8)
 
 // --- 타일 기반 라이트 컬링 리소스 ---
 // t2: 타일별 라이트 인덱스 Structured Buffer
-// 구조:  [TileIndex * MaxLightsPerTile] = LightCount
-//        [TileIndex * MaxLightsPerTile + 1 ~ ...] = LightIndices (상위 16비트: 타입, 하위 16비트: 인덱스)
+// 구조:  [0 ~ TileCount) = 타일 그리드 워드 (하위 8비트: 라이트 개수, 상위 24비트: 인덱스 목록 시작 위치)
+//        [TileCount ~ ...) = 모든 타일의 라이트 인덱스를 이어 붙인 목록
+// 라이트 인덱스 워드 (TileLightCuller.h와 일치):
+//        [0..15] 인덱스, [16..19] 타입 (0=Point, 1=Spot), [20..24] 최소 깊이 슬라이스, [25..29] 최대 깊이 슬라이스
 StructuredBuffer<uint> g_TileLightIndices : register(t2);
 
 // PointLight, SpotLight Structured Buffer
@@ -40,7 +42,8 @@ cbuffer TileCullingBuffer : register(b11)
     uint bUseTileCulling;   // 타일 컬링 활성화 여부 (0=비활성화, 1=활성화)
     uint ViewportStartX;    // 뷰포트 시작 X 좌표
     uint ViewportStartY;    // 뷰포트 시작 Y 좌표
-    uint2 Padding;          // 16바이트 정렬을 위한 패딩
+    float DepthSliceScale;  // 깊이 슬라이스 = log2(뷰 깊이) * Scale + Bias
+    float DepthSliceBias;
 };
 
 TextureCubeArray g_PointShadowMapArray : register(t10);
@@ -55,12 +55,27 @@ uint CalculateTileIndex(float4 screenPos, float viewportStartX, float viewportSt
     return tileY * TileCountX + tileX;
 }
 
-// 타일별 라이트 인덱스 데이터의 시작 오프셋 계산
-uint GetTileDataOffset(uint tileIndex)
+// 타일의 라이트 인덱스 목록 위치와 개수 (그리드 워드 구성은 TileLightCuller.h와 일치)
+void GetTileLightRange(uint tileIndex, out uint lightOffset, out uint lightCount)
 {
-    // MaxLightsPerTile = 256 (TileLightCuller.h와 일치)
-    const uint MaxLightsPerTile = 256;
-    return tileIndex * MaxLightsPerTile;
+    uint gridWord = g_TileLightIndices[tileIndex];
+    lightOffset = gridWord >> 8;
+    lightCount = gridWord & 0xFF;
+}
+
+// 픽셀의 깊이 슬라이스 (viewDepth = SV_Position.w). 깊이 제한을 끄면 Scale/Bias = 0 이라 항상 0
+uint CalculateDepthSlice(float viewDepth)
+{
+    // DepthSliceCount = 32 (TileLightCuller.h와 일치)
+    return uint(clamp(log2(max(viewDepth, 1e-4f)) * DepthSliceScale + DepthSliceBias, 0.0f, 31.0f));
+}
+
+// 라이트 인덱스 워드에 기록된 깊이 슬라이스 범위에 픽셀 슬라이스가 들어가는지
+bool IsLightInDepthSlice(uint packedIndex, uint depthSlice)
+{
+    uint minSlice = (packedIndex >> 20) & 0x1F;
+    uint maxSlice = (packedIndex >> 25) & 0x1F;
+    return depthSlice >= minSlice && depthSlice <= maxSlice;
 }
 
 //================================================================================================
@@ -857,13 +872,16 @@ float3 CalculateAllLights(
     if (bUseTileCulling)
     {
         uint tileIndex = CalculateTileIndex(screenPos, ViewportStartX, ViewportStartY);
-        uint tileDataOffset = GetTileDataOffset(tileIndex);
-        uint lightCount = g_TileLightIndices[tileDataOffset];
+        uint lightOffset, lightCount;
+        GetTileLightRange(tileIndex, lightOffset, lightCount);
+        uint depthSlice = CalculateDepthSlice(screenPos.w);
 
         for (uint i = 0; i < lightCount; i++)
         {
-            uint packedIndex = g_TileLightIndices[tileDataOffset + 1 + i];
-            uint lightType = (packedIndex >> 16) & 0xFFFF;
+            uint packedIndex = g_TileLightIndices[lightOffset + i];
+            if (!IsLightInDepthSlice(packedIndex, depthSlice))
+                continue;
+            uint lightType = (packedIndex >> 16) & 0xF;
             uint lightIdx = packedIndex & 0xFFFF;
 
             if (lightType == 0)  // Point Light
@@ -62,9 +62,10 @@ cbuffer PixelConstBuffer : register(b4)
     uint bHasNormalTexture;
 };
 
+// affine 3x4: 각 행 = 4x4 스키닝 행렬의 한 열 (FMatrix3x4 와 일치)
 cbuffer SkinningMatrixBuffer : register(b5)
 {
-    row_major float4x4 SkinningMatrices[1000];
+    row_major float3x4 SkinningMatrices[1000];
 };
 
 // --- Material.SpecularColor 지원 매크로 ---
@@ -146,14 +147,14 @@ PS_INPUT mainVS(VS_INPUT Input)
      
     float3 SkinnedNormal = float3(0,0,0);
     float3 SkinnedTangent = float3(0,0,0);
-    float4 SkinnedPosition = float4(0,0,0,0);
+    float3 SkinnedPosition = float3(0,0,0);
     for(int Index = 0; Index < 4; Index++)
     {
-        row_major float4x4 SkinningMatrix = SkinningMatrices[Input.BoneIndices[Index]];
+        row_major float3x4 SkinningMatrix = SkinningMatrices[Input.BoneIndices[Index]];
         float BoneWeight = Input.BoneWeights[Index];
-        SkinnedPosition += mul(float4(Input.Position.xyz, 1), SkinningMatrix) * BoneWeight;
-        SkinnedNormal += mul(Input.Normal, (float3x3)SkinningMatrix) * BoneWeight;
-        SkinnedTangent += mul(Input.Tangent.xyz, (float3x3)SkinningMatrix) * BoneWeight;
+        SkinnedPosition += mul(SkinningMatrix, float4(Input.Position.xyz, 1)) * BoneWeight;
+        SkinnedNormal += mul((float3x3)SkinningMatrix, Input.Normal) * BoneWeight;
+        SkinnedTangent += mul((float3x3)SkinningMatrix, Input.Tangent.xyz) * BoneWeight;
     }
     Input.Position = SkinnedPosition;
     Input.Normal = normalize(SkinnedNormal);
@@ -424,17 +425,20 @@ PS_OUTPUT mainPS(PS_INPUT Input)
     {
         // 현재 픽셀이 속한 타일 계산
         uint tileIndex = CalculateTileIndex(Input.Position, ViewportStartX, ViewportStartY);
-        uint tileDataOffset = GetTileDataOffset(tileIndex);
 
-        // 타일에 영향을 주는 라이트 개수
-        uint lightCount = g_TileLightIndices[tileDataOffset];
+        // 타일에 영향을 주는 라이트 목록 위치와 개수
+        uint lightOffset, lightCount;
+        GetTileLightRange(tileIndex, lightOffset, lightCount);
+        uint depthSlice = CalculateDepthSlice(Input.Position.w);
 
         // 타일 내 라이트만 순회
         [loop]
         for (uint i = 0; i < lightCount; i++)
         {
-            uint packedIndex = g_TileLightIndices[tileDataOffset + 1 + i];
-            uint lightType = (packedIndex >> 16) & 0xFFFF;  // 상위 16비트: 타입
+            uint packedIndex = g_TileLightIndices[lightOffset + i];
+            if (!IsLightInDepthSlice(packedIndex, depthSlice))  // 픽셀 깊이 슬라이스 밖의 라이트
+                continue;
+            uint lightType = (packedIndex >> 16) & 0xF;     // [16..19]: 타입
             uint lightIdx = packedIndex & 0xFFFF;           // 하위 16비트: 인덱스
 
             if (lightType == 0)  // Point Light
@@ -536,17 +540,20 @@ PS_OUTPUT mainPS(PS_INPUT Input)
     {
         // 현재 픽셀이 속한 타일 계산
         uint tileIndex = CalculateTileIndex(Input.Position, ViewportStartX, ViewportStartY);
-        uint tileDataOffset = GetTileDataOffset(tileIndex);
 
-        // 타일에 영향을 주는 라이트 개수
-        uint lightCount = g_TileLightIndices[tileDataOffset];
+        // 타일에 영향을 주는 라이트 목록 위치와 개수
+        uint lightOffset, lightCount;
+        GetTileLightRange(tileIndex, lightOffset, lightCount);
+        uint depthSlice = CalculateDepthSlice(Input.Position.w);
 
         // 타일 내 라이트만 순회
         [loop]
         for (uint i = 0; i < lightCount; i++)
         {
-            uint packedIndex = g_TileLightIndices[tileDataOffset + 1 + i];
-            uint lightType = (packedIndex >> 16) & 0xFFFF;  // 상위 16비트: 타입
+            uint packedIndex = g_TileLightIndices[lightOffset + i];
+            if (!IsLightInDepthSlice(packedIndex, depthSlice))  // 픽셀 깊이 슬라이스 밖의 라이트
+                continue;
+            uint lightType = (packedIndex >> 16) & 0xF;     // [16..19]: 타입
             uint lightIdx = packedIndex & 0xFFFF;           // 하위 16비트: 인덱스
 
             if (lightType == 0)  // Point Light
@@ -13,7 +13,8 @@ cbuffer TileCullingBuffer : register(b11)
     uint bUseTileCulling;   // 타일 컬링 활성화 여부 (0=비활성화, 1=활성화)
     uint ViewportStartX;    // 뷰포트 시작 X 좌표
     uint ViewportStartY;    // 뷰포트 시작 Y 좌표
-    uint2 Padding;          // 16바이트 정렬을 위한 패딩
+    float DepthSliceScale;  // 깊이 슬라이스 (여기서는 사용 안 함)
+    float DepthSliceBias;
 };
 
 // t0: 원본 씬 텍스처
@@ -21,8 +22,8 @@ Texture2D g_SceneTexture : register(t0);
 SamplerState g_SamplerLinear : register(s0);
 
 // t2: 타일별 라이트 인덱스 Structured Buffer
-// 구조: [TileIndex * MaxLightsPerTile] = LightCount
-//       [TileIndex * MaxLightsPerTile + 1 ~ ...] = LightIndices
+// 구조: [0 ~ TileCount) = 타일 그리드 워드 (하위 8비트: 라이트 개수, 상위 24비트: 인덱스 목록 시작 위치)
+//       [TileCount ~ ...) = 모든 타일의 라이트 인덱스 목록
 StructuredBuffer<uint> g_TileLightIndices : register(t2);
 
 // 타일 인덱스 계산
@@ -38,11 +39,10 @@ uint CalculateTileIndex(float2 screenPos)
     return tileY * TileCountX + tileX;
 }
 
-// 타일별 라이트 인덱스 데이터의 시작 오프셋 계산
-uint GetTileDataOffset(uint tileIndex)
+// 타일의 라이트 개수 (그리드 워드 하위 8비트)
+uint GetTileLightCount(uint tileIndex)
 {
-    const uint MaxLightsPerTile = 256;
-    return tileIndex * MaxLightsPerTile;
+    return g_TileLightIndices[tileIndex] & 0xFF;
 }
 
 // 라이트 개수를 색상으로 변환 (히트맵)
@@ -98,10 +98,9 @@ float4 mainPS(float4 Pos : SV_Position, float2 TexCoord : TEXCOORD0) : SV_Target
 
     // 현재 픽셀이 속한 타일 계산
     uint tileIndex = CalculateTileIndex(Pos.xy);
-    uint tileDataOffset = GetTileDataOffset(tileIndex);
 
     // 타일의 라이트 개수
-    uint lightCount = g_TileLightIndices[tileDataOffset];
+    uint lightCount = GetTileLightCount(tileIndex);
 
     // 히트맵 색상 계산
     float3 heatmapColor = LightCountToHeatmap(lightCount);
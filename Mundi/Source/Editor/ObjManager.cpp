@@ -423,6 +423,9 @@ FStaticMesh* FObjManager::LoadObjStaticMeshAsset(const FString& PathFileName)
 		Serialization::WriteArray<FMaterialInfo>(MatWriter, MaterialInfos);
 		MatWriter.Close();
 
+		// 재생성한 캐시도 경로를 남겨 둔다 (메시 BVH 캐시가 이 옆에 저장됨)
+		NewFStaticMesh->CacheFilePath = BinPathFileName;
+
 		UE_LOG("Cache regeneration complete for '%s'.", NormalizedPathStr.c_str());
 #endif // USE_OBJ_CACHE
 	}
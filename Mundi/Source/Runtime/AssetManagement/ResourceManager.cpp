@@ -6,6 +6,9 @@
 #include "ObjManager.h"
 #include "Quad.h"
 #include "MeshBVH.h"
+#include "WindowsBinReader.h"
+#include "WindowsBinWriter.h"
+#include "PlatformTime.h"
 #include "Enums.h"
 
 #include <filesystem>
@@ -130,6 +133,55 @@ FMeshBVH* UResourceManager::GetMeshBVH(const FString& ObjPath)
     return nullptr;
 }
 
+namespace
+{
+    // 메시 캐시 경로(.bin)에서 BVH 캐시 경로(.bvh.bin)를 만든다. 메시 캐시가 없으면 빈 문자열
+    FString GetMeshBVHCachePath(const FString& MeshCachePath)
+    {
+        static const FString BinExtension = ".bin";
+        if (MeshCachePath.size() <= BinExtension.size() ||
+            MeshCachePath.compare(MeshCachePath.size() - BinExtension.size(), BinExtension.size(), BinExtension) != 0)
+        {
+            return FString();
+        }
+        return MeshCachePath.substr(0, MeshCachePath.size() - BinExtension.size()) + ".bvh.bin";
+    }
+
+    // 메시 캐시보다 새롭고, 버전/버퍼 크기/인덱스 범위가 맞을 때만 성공
+    bool LoadMeshBVHCache(const FString& BVHCachePath, const FStaticMesh* StaticMeshAsset, FMeshBVH& OutBVH)
+    {
+        namespace fs = std::filesystem;
+        try
+        {
+            if (!fs::exists(BVHCachePath) ||
+                fs::last_write_time(BVHCachePath) < fs::last_write_time(StaticMeshAsset->CacheFilePath))
+            {
+                return false;
+            }
+
+            FWindowsBinReader Reader(BVHCachePath);
+            if (!Reader.IsOpen())
+            {
+                return false;
+            }
+            Reader << OutBVH;
+            Reader.Close();
+        }
+        catch (const std::exception& e)
+        {
+            UE_LOG("MeshBVH: cache '%s' is corrupt or incompatible (%s). Rebuilding.", BVHCachePath.c_str(), e.what());
+            return false;
+        }
+
+        if (!OutBVH.IsValidFor(StaticMeshAsset->Vertices, StaticMeshAsset->Indices))
+        {
+            UE_LOG("MeshBVH: cache '%s' does not match the mesh. Rebuilding.", BVHCachePath.c_str());
+            return false;
+        }
+        return true;
+    }
+}
+
 FMeshBVH* UResourceManager::GetOrBuildMeshBVH(const FString& ObjPath, const FStaticMesh* StaticMeshAsset)
 {
     if (auto* Found = MeshBVHCache.Find(ObjPath))
@@ -139,7 +191,35 @@ FMeshBVH* UResourceManager::GetOrBuildMeshBVH(const FString& ObjPath, const FSta
         return nullptr;
 
     FMeshBVH* NewBVH = new FMeshBVH();
+
+    // 메시 캐시(예: cube.obj.bin) 옆의 cube.obj.bvh.bin 을 먼저 시도
+    const FString BVHCachePath = GetMeshBVHCachePath(StaticMeshAsset->CacheFilePath);
+    if (!BVHCachePath.empty() && LoadMeshBVHCache(BVHCachePath, StaticMeshAsset, *NewBVH))
+    {
+        MeshBVHCache.Add(ObjPath, NewBVH);
+        return NewBVH;
+    }
+
+    const uint64 StartCycles = FPlatformTime::Cycles64();
     NewBVH->Build(StaticMeshAsset->Vertices, StaticMeshAsset->Indices);
+    const double BuildMs = FPlatformTime::ToMilliseconds(FPlatformTime::Cycles64() - StartCycles);
+    UE_LOG("MeshBVH: built '%s' in %.2fms (%d nodes, %d triangles, SAH %.2f)",
+        ObjPath.c_str(), BuildMs, NewBVH->GetNumNodes(), NewBVH->GetNumTriangles(), NewBVH->ComputeSAHCost());
+
+    if (!BVHCachePath.empty())
+    {
+        try
+        {
+            FWindowsBinWriter Writer(BVHCachePath);
+            Writer << *NewBVH;
+            Writer.Close();
+        }
+        catch (const std::exception& e)
+        {
+            UE_LOG("MeshBVH: failed to write cache '%s': %s", BVHCachePath.c_str(), e.what());
+        }
+    }
+
     MeshBVHCache.Add(ObjPath, NewBVH);
     return NewBVH;
 }
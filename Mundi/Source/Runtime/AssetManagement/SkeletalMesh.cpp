@@ -41,6 +41,8 @@ void USkeletalMesh::Load(const FString& InFilePath, ID3D11Device* InDevice)
     VertexCount = static_cast<uint32>(Data->Vertices.size());
     IndexCount = static_cast<uint32>(Data->Indices.size());
     VertexStride = sizeof(FSkinnedVertex);
+
+    SkinningStreams.Build(Data->Vertices, Data->Skeleton.Bones.Num());
 }
 
 void USkeletalMesh::ReleaseResources()
@@ -57,6 +59,8 @@ void USkeletalMesh::ReleaseResources()
         IndexBuffer = nullptr;
     }
 
+    SkinningStreams.Reset();
+
     if (Data)
     {
         delete Data;
@@ -1,5 +1,6 @@
 ﻿#pragma once
 #include "ResourceBase.h"
+#include "CPUSkinning.h"
 
 class USkeletalMesh : public UResourceBase
 {
@@ -29,6 +30,9 @@ public:
 
     uint64 GetMeshGroupCount() const { return Data ? Data->GroupInfos.size() : 0; }
 
+    // CPU 스키닝 입력 (본이 256개를 넘으면 비어 있다)
+    const FSkinningStreams& GetSkinningStreams() const { return SkinningStreams; }
+
     void CreateVertexBuffer(ID3D11Buffer** InVertexBuffer);
     void UpdateVertexBuffer(const TArray<FSkinnedVertex>& SkinnedVertices, ID3D11Buffer* InVertexBuffer);
     
@@ -46,4 +50,5 @@ private:
     
     // CPU 리소스
     FSkeletalMeshData* Data = nullptr;
+    FSkinningStreams SkinningStreams;
 };
\ No newline at end of file
@@ -96,6 +96,10 @@ void UStaticMesh::Load(const FString& InFilePath, ID3D11Device* InDevice, EVerte
         // Update Lua-accessible properties
         TestVertexCount = VertexCount;
         TestIndexCount = IndexCount;
+
+        // 피킹용 BVH 를 메시와 함께 준비 (디스크 캐시가 있으면 로드, 없으면 빌드 후 저장)
+        // 첫 피킹 때 빌드하느라 멈추지 않도록 로드 시점으로 옮김
+        UResourceManager::GetInstance().GetOrBuildMeshBVH(GetAssetPathFileName(), StaticMeshAsset);
     }
 }
 
@@ -0,0 +1,641 @@
+﻿#pragma once
+#include <new>
+#include <utility>
+#include <functional>
+#include <stdexcept>
+#include <tuple>
+#include <vector>
+#include "UEContainer.h"
+
+/**
+ * Open addressing(Robin Hood) 해시 테이블.
+ * - 원소는 빈틈 없는 배열(Entries)에 연속으로 저장한다. 순회는 배열 순회와 같고 노드 할당이 없다.
+ * - 버킷 배열은 8바이트(거리 + 해시 fingerprint, 원소 인덱스)만 담는다. 탐색은 버킷만 훑고
+ *   fingerprint 가 일치할 때만 원소의 키를 비교한다. 재해시도 버킷만 다시 만든다.
+ * - 삭제는 버킷 backward-shift + 마지막 원소를 빈자리로 옮기는 방식이라 tombstone 이 없다.
+ *
+ * 주의: std::unordered_map 과 달리 삽입/삭제 시 원소 주소와 이터레이터가 무효화된다.
+ *       다른 원소를 삽입/삭제하는 동안 원소 참조를 들고 있어야 하는 곳에는 TMap/TSet 을 사용할 것.
+ */
+template<typename ElementType, typename KeyType, typename KeyOfFunc>
+class TRobinHoodTable
+{
+	using FEntryArray = std::vector<ElementType>;
+
+public:
+	using iterator = typename FEntryArray::iterator;
+	using const_iterator = typename FEntryArray::const_iterator;
+	using size_type = SIZE_T;
+
+	TRobinHoodTable() = default;
+
+	TRobinHoodTable(const TRobinHoodTable& Other)
+		: Entries(Other.Entries)
+	{
+		CopyBuckets(Other);
+	}
+
+	TRobinHoodTable(TRobinHoodTable&& Other) noexcept
+		: Entries(std::move(Other.Entries))
+	{
+		StealBuckets(Other);
+	}
+
+	~TRobinHoodTable()
+	{
+		delete[] Buckets;
+	}
+
+	TRobinHoodTable& operator=(const TRobinHoodTable& Other)
+	{
+		if (this != &Other)
+		{
+			Entries = Other.Entries;
+			delete[] Buckets;
+			CopyBuckets(Other);
+		}
+		return *this;
+	}
+
+	TRobinHoodTable& operator=(TRobinHoodTable&& Other) noexcept
+	{
+		if (this != &Other)
+		{
+			Entries = std::move(Other.Entries);
+			delete[] Buckets;
+			StealBuckets(Other);
+		}
+		return *this;
+	}
+
+	/** STL 호환 */
+	iterator begin() { return Entries.begin(); }
+	iterator end() { return Entries.end(); }
+	const_iterator begin() const { return Entries.begin(); }
+	const_iterator end() const { return Entries.end(); }
+	const_iterator cbegin() const { return Entries.cbegin(); }
+	const_iterator cend() const { return Entries.cend(); }
+
+	SIZE_T size() const { return Entries.size(); }
+	bool empty() const { return Entries.empty(); }
+	SIZE_T bucket_count() const { return NumBuckets; }
+
+	void clear()
+	{
+		Entries.clear();
+		for (uint32 i = 0; i < NumBuckets; ++i)
+		{
+			Buckets[i] = FBucket{};
+		}
+	}
+
+	void reserve(SIZE_T InCount)
+	{
+		Entries.reserve(InCount);
+		const uint32 Required = GetBucketCountFor(InCount);
+		if (Required > NumBuckets)
+		{
+			Rehash(Required);
+		}
+	}
+
+	iterator find(const KeyType& Key)
+	{
+		const uint32 EntryIndex = FindEntryIndex(Key);
+		return EntryIndex != InvalidIndex ? Entries.begin() + EntryIndex : Entries.end();
+	}
+
+	const_iterator find(const KeyType& Key) const
+	{
+		const uint32 EntryIndex = FindEntryIndex(Key);
+		return EntryIndex != InvalidIndex ? Entries.begin() + EntryIndex : Entries.end();
+	}
+
+	SIZE_T count(const KeyType& Key) const
+	{
+		return FindEntryIndex(Key) != InvalidIndex ? 1 : 0;
+	}
+
+	bool contains(const KeyType& Key) const
+	{
+		return FindEntryIndex(Key) != InvalidIndex;
+	}
+
+	SIZE_T erase(const KeyType& Key)
+	{
+		const uint32 BucketIndex = FindBucketIndex(Key, HashKey(Key));
+		if (BucketIndex == InvalidIndex)
+		{
+			return 0;
+		}
+		EraseBucket(BucketIndex);
+		return 1;
+	}
+
+	// 다음에 방문할 원소를 가리키는 이터레이터 반환 (순회 중 삭제 지원)
+	// 마지막 원소가 삭제 위치로 옮겨오므로 같은 위치가 곧 "다음" 원소다.
+	iterator erase(const_iterator It)
+	{
+		const uint32 EntryIndex = static_cast<uint32>(It - Entries.cbegin());
+		EraseBucket(FindBucketIndexOfEntry(EntryIndex));
+		return Entries.begin() + EntryIndex;
+	}
+
+	iterator erase(iterator It)
+	{
+		return erase(const_iterator(It));
+	}
+
+protected:
+	// Key 가 없을 때만 삽입. (이터레이터, 삽입 여부)
+	template<typename... Args>
+	std::pair<iterator, bool> EmplaceUnique(const KeyType& Key, Args&&... InArgs)
+	{
+		const uint64 Hash = HashKey(Key);
+		const uint32 Existing = FindBucketIndex(Key, Hash);
+		if (Existing != InvalidIndex)
+		{
+			return { Entries.begin() + Buckets[Existing].EntryIndex, false };
+		}
+
+		if (static_cast<SIZE_T>(Entries.size() + 1) * 5 > static_cast<SIZE_T>(NumBuckets) * 4)
+		{
+			Rehash(NumBuckets ? NumBuckets * 2 : MinBuckets);
+		}
+
+		const uint32 EntryIndex = static_cast<uint32>(Entries.size());
+		Entries.emplace_back(std::forward<Args>(InArgs)...);
+		PlaceBucket(Hash, EntryIndex);
+		return { Entries.begin() + EntryIndex, true };
+	}
+
+	uint32 FindEntryIndex(const KeyType& Key) const
+	{
+		const uint32 BucketIndex = FindBucketIndex(Key, HashKey(Key));
+		return BucketIndex != InvalidIndex ? Buckets[BucketIndex].EntryIndex : InvalidIndex;
+	}
+
+	ElementType* GetEntryData() { return Entries.data(); }
+	const ElementType* GetEntryData() const { return Entries.data(); }
+
+	static constexpr uint32 InvalidIndex = 0xFFFFFFFFu;
+
+private:
+	struct FBucket
+	{
+		uint32 DistAndFingerprint = 0;  // 상위 24비트 = 홈 버킷부터의 거리 + 1 (0 = 빈 버킷), 하위 8비트 = 해시 fingerprint
+		uint32 EntryIndex = 0;
+	};
+
+	static constexpr uint32 DistOne = 1u << 8;
+	static constexpr uint32 MinBuckets = 8;
+
+	// 최대 load factor 0.8
+	static uint32 GetBucketCountFor(SIZE_T InCount)
+	{
+		if (InCount == 0)
+		{
+			return 0;
+		}
+		uint32 NewCount = MinBuckets;
+		while (static_cast<SIZE_T>(NewCount) * 4 < InCount * 5)
+		{
+			NewCount <<= 1;
+		}
+		return NewCount;
+	}
+
+	static uint64 HashKey(const KeyType& Key)
+	{
+		// std::hash 가 항등 함수인 포인터/정수/FName 키도 고르게 퍼지도록 비트를 섞는다 (splitmix64 finalizer).
+		// 곱셈 한 번(Fibonacci hashing)으로는 등간격 키(풀 할당 주소 등)에서 특정 크기에 클러스터가 생긴다.
+		uint64 Hash = static_cast<uint64>(std::hash<KeyType>()(Key));
+		Hash ^= Hash >> 30;
+		Hash *= 0xbf58476d1ce4e5b9ull;
+		Hash ^= Hash >> 27;
+		Hash *= 0x94d049bb133111ebull;
+		Hash ^= Hash >> 31;
+		return Hash;
+	}
+
+	// 버킷 인덱스는 해시 하위 비트, fingerprint 는 겹치지 않는 최상위 8비트에서 가져온다
+	uint32 GetHomeBucket(uint64 Hash) const
+	{
+		return static_cast<uint32>(Hash) & (NumBuckets - 1);
+	}
+
+	static uint32 MakeFingerprint(uint64 Hash)
+	{
+		return DistOne | static_cast<uint32>(Hash >> 56);
+	}
+
+	uint32 FindBucketIndex(const KeyType& Key, uint64 Hash) const
+	{
+		if (Entries.empty())
+		{
+			return InvalidIndex;
+		}
+
+		const uint32 Mask = NumBuckets - 1;
+		uint32 Index = GetHomeBucket(Hash);
+		uint32 Expected = MakeFingerprint(Hash);
+		while (true)
+		{
+			const FBucket& Bucket = Buckets[Index];
+			if (Bucket.DistAndFingerprint == Expected
+				&& std::equal_to<KeyType>()(KeyOfFunc::Get(Entries[Bucket.EntryIndex]), Key))
+			{
+				return Index;
+			}
+			// 거리가 더 짧은 버킷을 만나면 Robin Hood 불변식상 더 이상 있을 수 없다
+			if (Bucket.DistAndFingerprint < Expected)
+			{
+				return InvalidIndex;
+			}
+			Index = (Index + 1) & Mask;
+			Expected += DistOne;
+		}
+	}
+
+	// 원소 인덱스로 그 원소를 가리키는 버킷을 찾는다 (키 비교 없음)
+	uint32 FindBucketIndexOfEntry(uint32 EntryIndex) const
+	{
+		const uint32 Mask = NumBuckets - 1;
+		uint32 Index = GetHomeBucket(HashKey(KeyOfFunc::Get(Entries[EntryIndex])));
+		while (Buckets[Index].EntryIndex != EntryIndex || Buckets[Index].DistAndFingerprint == 0)
+		{
+			Index = (Index + 1) & Mask;
+		}
+		return Index;
+	}
+
+	void PlaceBucket(uint64 Hash, uint32 EntryIndex)
+	{
+		const uint32 Mask = NumBuckets - 1;
+		uint32 Index = GetHomeBucket(Hash);
+		FBucket Carry{ MakeFingerprint(Hash), EntryIndex };
+
+		// 더 가난한(홈에서 먼) 쪽이 자리를 차지한다
+		while (Buckets[Index].DistAndFingerprint != 0)
+		{
+			if (Buckets[Index].DistAndFingerprint < Carry.DistAndFingerprint)
+			{
+				std::swap(Carry, Buckets[Index]);
+			}
+			Index = (Index + 1) & Mask;
+			Carry.DistAndFingerprint += DistOne;
+		}
+		Buckets[Index] = Carry;
+	}
+
+	void EraseBucket(uint32 BucketIndex)
+	{
+		const uint32 Mask = NumBuckets - 1;
+		const uint32 EntryIndex = Buckets[BucketIndex].EntryIndex;
+
+		// 1) 버킷 backward-shift
+		uint32 Prev = BucketIndex;
+		uint32 Next = (BucketIndex + 1) & Mask;
+		while (Buckets[Next].DistAndFingerprint >= 2 * DistOne)
+		{
+			Buckets[Prev] = { Buckets[Next].DistAndFingerprint - DistOne, Buckets[Next].EntryIndex };
+			Prev = Next;
+			Next = (Next + 1) & Mask;
+		}
+		Buckets[Prev] = FBucket{};
+
+		// 2) 마지막 원소를 빈자리로 옮기고 그 원소의 버킷을 갱신
+		const uint32 LastIndex = static_cast<uint32>(Entries.size() - 1);
+		if (EntryIndex != LastIndex)
+		{
+			Buckets[FindBucketIndexOfEntry(LastIndex)].EntryIndex = EntryIndex;
+			Entries[EntryIndex] = std::move(Entries[LastIndex]);
+		}
+		Entries.pop_back();
+	}
+
+	void Rehash(uint32 NewNumBuckets)
+	{
+		delete[] Buckets;
+		Buckets = new FBucket[NewNumBuckets]();
+		NumBuckets = NewNumBuckets;
+
+		for (uint32 i = 0; i < static_cast<uint32>(Entries.size()); ++i)
+		{
+			PlaceBucket(HashKey(KeyOfFunc::Get(Entries[i])), i);
+		}
+	}
+
+	void CopyBuckets(const TRobinHoodTable& Other)
+	{
+		NumBuckets = Other.NumBuckets;
+		Buckets = nullptr;
+		if (NumBuckets > 0)
+		{
+			Buckets = new FBucket[NumBuckets];
+			std::copy(Other.Buckets, Other.Buckets + NumBuckets, Buckets);
+		}
+	}
+
+	void StealBuckets(TRobinHoodTable& Other)
+	{
+		Buckets = Other.Buckets;
+		NumBuckets = Other.NumBuckets;
+		Other.Buckets = nullptr;
+		Other.NumBuckets = 0;
+		Other.Entries.clear();
+	}
+
+	FEntryArray Entries;
+	FBucket* Buckets = nullptr;
+	uint32 NumBuckets = 0;        // 항상 0 또는 2의 거듭제곱
+};
+
+namespace FlatHashDetail
+{
+	struct FSetKeyOf
+	{
+		template<typename T>
+		static const T& Get(const T& Element) { return Element; }
+	};
+
+	struct FMapKeyOf
+	{
+		template<typename PairType>
+		static const auto& Get(const PairType& Element) { return Element.first; }
+	};
+}
+
+/** TFlatSet - TSet 과 같은 API 의 open addressing 집합 */
+template<typename T>
+class TFlatSet : public TRobinHoodTable<T, T, FlatHashDetail::FSetKeyOf>
+{
+	using Super = TRobinHoodTable<T, T, FlatHashDetail::FSetKeyOf>;
+
+public:
+	using key_type = T;
+	using value_type = T;
+
+	TFlatSet() = default;
+	TFlatSet(std::initializer_list<T> InitList)
+	{
+		this->reserve(InitList.size());
+		for (const T& Item : InitList)
+		{
+			Add(Item);
+		}
+	}
+
+	std::pair<typename Super::iterator, bool> insert(const T& Item) { return this->EmplaceUnique(Item, Item); }
+	std::pair<typename Super::iterator, bool> insert(T&& Item)
+	{
+		const T KeyCopy = Item;
+		return this->EmplaceUnique(KeyCopy, std::move(Item));
+	}
+
+	template<typename... Args>
+	std::pair<typename Super::iterator, bool> emplace(Args&&... InArgs)
+	{
+		T Item(std::forward<Args>(InArgs)...);
+		return insert(std::move(Item));
+	}
+
+	/** 요소 추가 */
+	void Add(const T& Item)
+	{
+		insert(Item);
+	}
+
+	/** 제거 */
+	bool Remove(const T& Item)
+	{
+		return this->erase(Item) > 0;
+	}
+
+	/** 크기 관련 */
+	int32 Num() const
+	{
+		return static_cast<int32>(this->size());
+	}
+
+	bool IsEmpty() const
+	{
+		return this->empty();
+	}
+
+	void Empty()
+	{
+		this->clear();
+	}
+
+	/** 검색 */
+	bool Contains(const T& Item) const
+	{
+		return this->contains(Item);
+	}
+
+	/** 집합 연산 */
+	TFlatSet<T> Union(const TFlatSet<T>& Other) const
+	{
+		TFlatSet<T> Result = *this;
+		for (const auto& Item : Other)
+		{
+			Result.Add(Item);
+		}
+		return Result;
+	}
+
+	TFlatSet<T> Intersect(const TFlatSet<T>& Other) const
+	{
+		TFlatSet<T> Result;
+		for (const auto& Item : *this)
+		{
+			if (Other.Contains(Item))
+			{
+				Result.Add(Item);
+			}
+		}
+		return Result;
+	}
+
+	TFlatSet<T> Difference(const TFlatSet<T>& Other) const
+	{
+		TFlatSet<T> Result;
+		for (const auto& Item : *this)
+		{
+			if (!Other.Contains(Item))
+			{
+				Result.Add(Item);
+			}
+		}
+		return Result;
+	}
+
+	/** 배열로 변환 */
+	TArray<T> Array() const
+	{
+		TArray<T> Result;
+		Result.Reserve(this->size());
+		for (const auto& Item : *this)
+		{
+			Result.Add(Item);
+		}
+		return Result;
+	}
+};
+
+/** TFlatMap - TMap 과 같은 API 의 open addressing 연관 컨테이너 */
+template<typename KeyType, typename ValueType>
+class TFlatMap : public TRobinHoodTable<TPair<KeyType, ValueType>, KeyType, FlatHashDetail::FMapKeyOf>
+{
+	using Super = TRobinHoodTable<TPair<KeyType, ValueType>, KeyType, FlatHashDetail::FMapKeyOf>;
+
+public:
+	using key_type = KeyType;
+	using mapped_type = ValueType;
+	using value_type = TPair<KeyType, ValueType>;
+
+	TFlatMap() = default;
+	TFlatMap(std::initializer_list<value_type> InitList)
+	{
+		this->reserve(InitList.size());
+		for (const value_type& Pair : InitList)
+		{
+			insert(Pair);
+		}
+	}
+
+	/** STL 호환 */
+	ValueType& operator[](const KeyType& Key)
+	{
+		return this->EmplaceUnique(Key, Key, ValueType{}).first->second;
+	}
+
+	ValueType& at(const KeyType& Key)
+	{
+		auto It = this->find(Key);
+		if (It == this->end())
+		{
+			throw std::out_of_range("TFlatMap::at");
+		}
+		return It->second;
+	}
+
+	const ValueType& at(const KeyType& Key) const
+	{
+		auto It = this->find(Key);
+		if (It == this->end())
+		{
+			throw std::out_of_range("TFlatMap::at");
+		}
+		return It->second;
+	}
+
+	std::pair<typename Super::iterator, bool> insert(const value_type& Pair)
+	{
+		return this->EmplaceUnique(Pair.first, Pair);
+	}
+
+	std::pair<typename Super::iterator, bool> insert(value_type&& Pair)
+	{
+		const KeyType KeyCopy = Pair.first;
+		return this->EmplaceUnique(KeyCopy, std::move(Pair));
+	}
+
+	template<typename InKeyType, typename... Args>
+	std::pair<typename Super::iterator, bool> emplace(InKeyType&& Key, Args&&... InArgs)
+	{
+		const KeyType KeyCopy(std::forward<InKeyType>(Key));
+		return this->EmplaceUnique(KeyCopy, std::piecewise_construct,
+			std::forward_as_tuple(KeyCopy), std::forward_as_tuple(std::forward<Args>(InArgs)...));
+	}
+
+	template<typename... Args>
+	std::pair<typename Super::iterator, bool> try_emplace(const KeyType& Key, Args&&... InArgs)
+	{
+		return this->EmplaceUnique(Key, std::piecewise_construct,
+			std::forward_as_tuple(Key), std::forward_as_tuple(std::forward<Args>(InArgs)...));
+	}
+
+	/** 요소 추가/수정 */
+	void Add(const KeyType& Key, const ValueType& Value)
+	{
+		(*this)[Key] = Value;
+	}
+
+	template<typename... Args>
+	void Emplace(const KeyType& Key, Args&&... args)
+	{
+		this->emplace(Key, ValueType(std::forward<Args>(args)...));
+	}
+
+	/** 제거 */
+	bool Remove(const KeyType& Key)
+	{
+		return this->erase(Key) > 0;
+	}
+
+	/** 크기 관련 */
+	int32 Num() const
+	{
+		return static_cast<int32>(this->size());
+	}
+
+	bool IsEmpty() const
+	{
+		return this->empty();
+	}
+
+	void Empty()
+	{
+		this->clear();
+	}
+
+	/** 검색 */
+	bool Contains(const KeyType& Key) const
+	{
+		return this->contains(Key);
+	}
+
+	ValueType* Find(const KeyType& Key)
+	{
+		const uint32 Index = this->FindEntryIndex(Key);
+		return Index != Super::InvalidIndex ? &this->GetEntryData()[Index].second : nullptr;
+	}
+
+	const ValueType* Find(const KeyType& Key) const
+	{
+		const uint32 Index = this->FindEntryIndex(Key);
+		return Index != Super::InvalidIndex ? &this->GetEntryData()[Index].second : nullptr;
+	}
+
+	/** 찾거나 기본값 반환 */
+	ValueType FindRef(const KeyType& Key) const
+	{
+		const ValueType* Found = Find(Key);
+		return Found ? *Found : ValueType{};
+	}
+
+	/** 키/값 배열 반환 */
+	TArray<KeyType> GetKeys() const
+	{
+		TArray<KeyType> Keys;
+		Keys.Reserve(this->size());
+		for (const auto& Pair : *this)
+		{
+			Keys.Add(Pair.first);
+		}
+		return Keys;
+	}
+
+	TArray<ValueType> GetValues() const
+	{
+		TArray<ValueType> Values;
+		Values.Reserve(this->size());
+		for (const auto& Pair : *this)
+		{
+			Values.Add(Pair.second);
+		}
+		return Values;
+	}
+};
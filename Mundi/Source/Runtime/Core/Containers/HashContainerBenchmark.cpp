@@ -0,0 +1,152 @@
+﻿#include "pch.h"
+#include "FlatHashMap.h"
+#include "Benchmark.h"
+#include "Name.h"
+#include <random>
+
+namespace
+{
+	struct FHashBenchResult
+	{
+		double InsertMs = 0.0;
+		double FindHitMs = 0.0;
+		double FindMissMs = 0.0;
+		double IterateMs = 0.0;
+		double EraseMs = 0.0;
+	};
+
+	template<typename MapType, typename KeyType>
+	FHashBenchResult RunMapBench(const TArray<KeyType>& Keys, const TArray<KeyType>& LookupKeys, const TArray<KeyType>& MissKeys, int32 Rounds)
+	{
+		FHashBenchResult Result;
+		for (int32 Round = 0; Round < Rounds; ++Round)
+		{
+			MapType Map;
+			uint64 Acc = 0;
+
+			{
+				FBenchTimer Timer;
+				for (int32 i = 0; i < Keys.Num(); ++i)
+				{
+					Map.Add(Keys[i], static_cast<uint32>(i));
+				}
+				Result.InsertMs += Timer.GetMs();
+			}
+
+			{
+				FBenchTimer Timer;
+				for (const KeyType& Key : LookupKeys)
+				{
+					if (const uint32* Found = Map.Find(Key))
+					{
+						Acc += *Found;
+					}
+				}
+				Result.FindHitMs += Timer.GetMs();
+			}
+
+			{
+				FBenchTimer Timer;
+				for (const KeyType& Key : MissKeys)
+				{
+					Acc += Map.Contains(Key) ? 1 : 0;
+				}
+				Result.FindMissMs += Timer.GetMs();
+			}
+
+			{
+				FBenchTimer Timer;
+				for (const auto& Pair : Map)
+				{
+					Acc += Pair.second;
+				}
+				Result.IterateMs += Timer.GetMs();
+			}
+
+			{
+				FBenchTimer Timer;
+				for (const KeyType& Key : LookupKeys)
+				{
+					Map.Remove(Key);
+				}
+				Result.EraseMs += Timer.GetMs();
+			}
+
+			BenchmarkKeep(Acc);
+		}
+
+		const double Inv = 1.0 / static_cast<double>(Rounds);
+		Result.InsertMs *= Inv;
+		Result.FindHitMs *= Inv;
+		Result.FindMissMs *= Inv;
+		Result.IterateMs *= Inv;
+		Result.EraseMs *= Inv;
+		return Result;
+	}
+
+	template<typename KeyType>
+	void CompareMaps(const char* Label, const TArray<KeyType>& Keys, const TArray<KeyType>& MissKeys)
+	{
+		constexpr int32 Rounds = 5;
+
+		// 삽입 순서대로 조회하면 노드가 할당 순서로 놓인 TMap 쪽이 캐시상 유리하므로 조회 순서를 섞는다
+		TArray<KeyType> LookupKeys = Keys;
+		std::shuffle(LookupKeys.begin(), LookupKeys.end(), std::mt19937(1234));
+
+		const FHashBenchResult Std = RunMapBench<TMap<KeyType, uint32>>(Keys, LookupKeys, MissKeys, Rounds);
+		const FHashBenchResult Flat = RunMapBench<TFlatMap<KeyType, uint32>>(Keys, LookupKeys, MissKeys, Rounds);
+
+		UE_LOG("[Bench] %s (N=%d)            TMap      TFlatMap   speedup", Label, Keys.Num());
+		UE_LOG("[Bench]   insert     %9.3fms %9.3fms   x%.2f", Std.InsertMs, Flat.InsertMs, Std.InsertMs / Flat.InsertMs);
+		UE_LOG("[Bench]   find hit   %9.3fms %9.3fms   x%.2f", Std.FindHitMs, Flat.FindHitMs, Std.FindHitMs / Flat.FindHitMs);
+		UE_LOG("[Bench]   find miss  %9.3fms %9.3fms   x%.2f", Std.FindMissMs, Flat.FindMissMs, Std.FindMissMs / Flat.FindMissMs);
+		UE_LOG("[Bench]   iterate    %9.3fms %9.3fms   x%.2f", Std.IterateMs, Flat.IterateMs, Std.IterateMs / Flat.IterateMs);
+		UE_LOG("[Bench]   erase      %9.3fms %9.3fms   x%.2f", Std.EraseMs, Flat.EraseMs, Std.EraseMs / Flat.EraseMs);
+	}
+}
+
+IMPLEMENT_BENCHMARK(HASH, "TMap(std::unordered_map) vs TFlatMap(open addressing)")
+{
+	constexpr int32 NumKeys = 100000;
+
+	// 포인터 키: UObject 할당 간격을 흉내낸 주소 (정렬된 포인터는 하위 비트가 0)
+	{
+		TArray<void*> Keys;
+		TArray<void*> MissKeys;
+		Keys.Reserve(NumKeys);
+		MissKeys.Reserve(NumKeys);
+		for (int32 i = 0; i < NumKeys; ++i)
+		{
+			Keys.Add(reinterpret_cast<void*>(static_cast<uintptr_t>(0x10000000ull + i * 96ull)));
+			MissKeys.Add(reinterpret_cast<void*>(static_cast<uintptr_t>(0x80000000ull + i * 96ull)));
+		}
+		CompareMaps("Pointer", Keys, MissKeys);
+	}
+
+	// 문자열 키: 리소스 경로 형태
+	TArray<FString> Paths;
+	TArray<FString> MissPaths;
+	Paths.Reserve(NumKeys);
+	MissPaths.Reserve(NumKeys);
+	for (int32 i = 0; i < NumKeys; ++i)
+	{
+		Paths.Add("Data/Model/Bench/Mesh_" + std::to_string(i) + ".obj");
+		MissPaths.Add("Data/Texture/Bench/Tex_" + std::to_string(i) + ".dds");
+	}
+	CompareMaps("FString", Paths, MissPaths);
+
+	// FName 키: 정수 비교이므로 포인터 키와 비슷한 성격
+	{
+		constexpr int32 NumNames = NumKeys / 10;
+		TArray<FName> Names;
+		TArray<FName> MissNames;
+		Names.Reserve(NumNames);
+		MissNames.Reserve(NumNames);
+		for (int32 i = 0; i < NumNames; ++i)
+		{
+			Names.Add(FName(Paths[i]));
+			MissNames.Add(FName(MissPaths[i]));
+		}
+		CompareMaps("FName", Names, MissNames);
+	}
+}
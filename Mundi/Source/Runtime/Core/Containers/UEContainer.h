@@ -19,44 +19,6 @@ typedef wchar_t WIDECHAR;
 typedef std::string FString;
 typedef std::wstring FWideString;
 
-// Lightweight weak object pointer compatible with engine UObject lifetime
-// - Stores a raw pointer (non-owning)
-// - Provides IsValid(), Get(), operators for containers
-// - Hash specialization provided below for unordered_map/set
-template<typename T>
-class TWeakObjectPtr
-{
-public:
-    using ElementType = T;
-
-    TWeakObjectPtr() : Ptr(nullptr) {}
-    TWeakObjectPtr(std::nullptr_t) : Ptr(nullptr) {}
-    explicit TWeakObjectPtr(T* InPtr) : Ptr(InPtr) {}
-
-    bool IsValid() const { return Ptr != nullptr; }
-    T* Get() const { return Ptr; }
-
-    T& operator*() const { return *Ptr; }
-    T* operator->() const { return Ptr; }
-
-    bool operator==(const TWeakObjectPtr& Other) const { return Ptr == Other.Ptr; }
-    bool operator!=(const TWeakObjectPtr& Other) const { return Ptr != Other.Ptr; }
-
-private:
-    T* Ptr;
-};
-
-namespace std {
-    template <typename T>
-    struct hash<TWeakObjectPtr<T>>
-    {
-        size_t operator()(const TWeakObjectPtr<T>& Key) const noexcept
-        {
-            return hash<const void*>()(static_cast<const void*>(Key.Get()));
-        }
-    };
-}
-
 template<typename T>
 using TUniqueObjectPtr = std::unique_ptr<T>;
 
@@ -68,12 +30,12 @@ using TPair = std::pair<T1, T2>;
 template<typename T, SIZE_T N>
 using TStaticArray = std::array<T, N>;
 
-/** TArray 구현 */
-template<typename T>
-class TArray : public std::vector<T>
+/** TArray 구현 (Allocator: 할당자 정책, 기본은 힙. 프레임 임시 배열은 TFrameAllocator 사용) */
+template<typename T, typename Allocator = std::allocator<T>>
+class TArray : public std::vector<T, Allocator>
 {
 public:
-    using std::vector<T>::vector; /** 생성자 상속 */
+    using std::vector<T, Allocator>::vector; /** 생성자 상속 */
 
     /** 요소 추가 */
     int32 Add(const T& Item)
@@ -101,7 +63,8 @@ public:
     }
 
     /** 배열 병합 */
-    void Append(const TArray<T>& Other)
+    template<typename OtherAllocator>
+    void Append(const TArray<T, OtherAllocator>& Other)
     {
         this->insert(this->end(), Other.begin(), Other.end());
     }
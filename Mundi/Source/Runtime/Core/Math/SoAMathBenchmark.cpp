@@ -0,0 +1,331 @@
+﻿#include "pch.h"
+#include "VectorSoA.h"
+#include "Benchmark.h"
+#include <random>
+
+namespace
+{
+	struct FSoABenchData
+	{
+		TArray<FTransform> Parents;
+		TArray<FTransform> Children;
+		TArray<FQuat> QuatsA;
+		TArray<FQuat> QuatsB;
+		TArray<FVector> Points;
+		TArray<FVector> BoxMin;
+		TArray<FVector> BoxMax;
+
+		FTransformSoA ParentsSoA;
+		FTransformSoA ChildrenSoA;
+		FQuatSoA QuatsASoA;
+		FQuatSoA QuatsBSoA;
+		FVectorSoA PointsSoA;
+		FVectorSoA BoxMinSoA;
+		FVectorSoA BoxMaxSoA;
+	};
+
+	FQuat RandomQuat(std::mt19937& Rng)
+	{
+		std::uniform_real_distribution<float> Dist(-1.0f, 1.0f);
+		FQuat Q(Dist(Rng), Dist(Rng), Dist(Rng), Dist(Rng));
+		Q.Normalize();
+		return Q;
+	}
+
+	void BuildData(FSoABenchData& Data, int32 Count)
+	{
+		std::mt19937 Rng(1234);
+		std::uniform_real_distribution<float> Pos(-100.0f, 100.0f);
+		std::uniform_real_distribution<float> Scale(0.5f, 2.0f);
+		std::uniform_real_distribution<float> Size(0.1f, 5.0f);
+
+		for (int32 i = 0; i < Count; ++i)
+		{
+			Data.Parents.Add(FTransform(FVector(Pos(Rng), Pos(Rng), Pos(Rng)), RandomQuat(Rng), FVector(Scale(Rng), Scale(Rng), Scale(Rng))));
+			Data.Children.Add(FTransform(FVector(Pos(Rng), Pos(Rng), Pos(Rng)), RandomQuat(Rng), FVector(Scale(Rng), Scale(Rng), Scale(Rng))));
+			Data.QuatsA.Add(RandomQuat(Rng));
+			Data.QuatsB.Add(RandomQuat(Rng));
+			Data.Points.Add(FVector(Pos(Rng), Pos(Rng), Pos(Rng)));
+
+			const FVector Center(Pos(Rng), Pos(Rng), Pos(Rng));
+			const FVector Extent(Size(Rng), Size(Rng), Size(Rng));
+			Data.BoxMin.Add(Center - Extent);
+			Data.BoxMax.Add(Center + Extent);
+		}
+
+		Data.ParentsSoA.FromAoS(Data.Parents);
+		Data.ChildrenSoA.FromAoS(Data.Children);
+		Data.QuatsASoA.FromAoS(Data.QuatsA);
+		Data.QuatsBSoA.FromAoS(Data.QuatsB);
+		Data.PointsSoA.FromAoS(Data.Points);
+		Data.BoxMinSoA.FromAoS(Data.BoxMin);
+		Data.BoxMaxSoA.FromAoS(Data.BoxMax);
+	}
+
+	float MaxQuatError(const FQuatSoA& A, const FQuatSoA& B)
+	{
+		float MaxError = 0.0f;
+		for (int32 i = 0; i < A.Num(); ++i)
+		{
+			// q 와 -q 는 같은 회전
+			const FQuat QA = A.Get(i);
+			const FQuat QB = B.Get(i);
+			const float Sign = (FQuat::Dot(QA, QB) < 0.0f) ? -1.0f : 1.0f;
+			MaxError = std::max(MaxError, std::fabs(QA.X - QB.X * Sign));
+			MaxError = std::max(MaxError, std::fabs(QA.Y - QB.Y * Sign));
+			MaxError = std::max(MaxError, std::fabs(QA.Z - QB.Z * Sign));
+			MaxError = std::max(MaxError, std::fabs(QA.W - QB.W * Sign));
+		}
+		return MaxError;
+	}
+
+	float MaxVectorError(const FVectorSoA& A, const FVectorSoA& B)
+	{
+		float MaxError = 0.0f;
+		for (int32 i = 0; i < A.Num(); ++i)
+		{
+			const FVector D = A.Get(i) - B.Get(i);
+			MaxError = std::max(MaxError, std::max(std::fabs(D.X), std::max(std::fabs(D.Y), std::fabs(D.Z))));
+		}
+		return MaxError;
+	}
+
+	// 3x3 부분 + 이동 성분의 최대 차이
+	float MaxMatrixError(const TArray<FMatrix3x4>& A, const TArray<FMatrix3x4>& B)
+	{
+		float MaxError = 0.0f;
+		for (int32 i = 0; i < A.Num(); ++i)
+		{
+			for (int32 Row = 0; Row < 3; ++Row)
+			{
+				for (int32 Col = 0; Col < 4; ++Col)
+				{
+					MaxError = std::max(MaxError, std::fabs(A[i].M[Row][Col] - B[i].M[Row][Col]));
+				}
+			}
+		}
+		return MaxError;
+	}
+
+	void LogRow(const char* Label, double AoSMs, double ScalarMs, double SIMDMs, float MaxError)
+	{
+		UE_LOG("[Bench] SoA %-16s AoS %8.3fms  SoA scalar %8.3fms  SoA AVX2 %8.3fms  x%.2f  (max err %.2e)",
+			Label, AoSMs, ScalarMs, SIMDMs, SIMDMs > 0.0 ? AoSMs / SIMDMs : 0.0, MaxError);
+	}
+}
+
+IMPLEMENT_BENCHMARK(SOA, "Batched transform/quat/AABB/skinning-matrix math: AoS scalar vs SoA scalar vs SoA AVX2")
+{
+	constexpr int32 Count = 100000;
+	constexpr int32 Rounds = 20;
+
+	if (!FSoAMath::HasAVX2())
+	{
+		UE_LOG("[Bench] SoA: AVX2/FMA not supported on this CPU, SIMD column uses the scalar path");
+	}
+
+	FSoABenchData Data;
+	BuildData(Data, Count);
+
+	// 벤치마크가 끝나면 원래 설정으로 되돌린다 (AVX2 미지원이면 설정값과 무관하게 스칼라)
+	const bool bPrevUseSIMD = FSoAMath::GetUseSIMD();
+
+	// SoA 경로를 스칼라/SIMD 로 각각 돌리고 결과를 비교한다
+	auto RunSoA = [&](auto&& Body, double& OutScalarMs, double& OutSIMDMs)
+	{
+		FSoAMath::SetUseSIMD(false);
+		{
+			FBenchTimer Timer;
+			for (int32 Round = 0; Round < Rounds; ++Round)
+			{
+				Body(false);
+			}
+			OutScalarMs = Timer.GetMs();
+		}
+		FSoAMath::SetUseSIMD(true);
+		{
+			FBenchTimer Timer;
+			for (int32 Round = 0; Round < Rounds; ++Round)
+			{
+				Body(true);
+			}
+			OutSIMDMs = Timer.GetMs();
+		}
+	};
+
+	// 트랜스폼 합성
+	{
+		TArray<FTransform> OutAoS(Count);
+		double AoSMs = 0.0;
+		{
+			FBenchTimer Timer;
+			for (int32 Round = 0; Round < Rounds; ++Round)
+			{
+				for (int32 i = 0; i < Count; ++i)
+				{
+					OutAoS[i] = Data.Parents[i].GetWorldTransform(Data.Children[i]);
+				}
+			}
+			AoSMs = Timer.GetMs();
+		}
+
+		FTransformSoA OutScalar, OutSIMD;
+		double ScalarMs = 0.0, SIMDMs = 0.0;
+		RunSoA([&](bool bSIMD) { FSoAMath::ComposeTransforms(Data.ParentsSoA, Data.ChildrenSoA, bSIMD ? OutSIMD : OutScalar); }, ScalarMs, SIMDMs);
+
+		const float Error = std::max(MaxVectorError(OutScalar.Translation, OutSIMD.Translation), MaxQuatError(OutScalar.Rotation, OutSIMD.Rotation));
+		LogRow("Compose", AoSMs, ScalarMs, SIMDMs, Error);
+	}
+
+	// Slerp / Nlerp
+	{
+		constexpr float Alpha = 0.37f;
+		TArray<FQuat> OutAoS(Count);
+		double AoSMs = 0.0;
+		{
+			FBenchTimer Timer;
+			for (int32 Round = 0; Round < Rounds; ++Round)
+			{
+				for (int32 i = 0; i < Count; ++i)
+				{
+					OutAoS[i] = FQuat::Slerp(Data.QuatsA[i], Data.QuatsB[i], Alpha);
+				}
+			}
+			AoSMs = Timer.GetMs();
+		}
+
+		FQuatSoA OutScalar, OutSIMD;
+		double ScalarMs = 0.0, SIMDMs = 0.0;
+		RunSoA([&](bool bSIMD) { FSoAMath::SlerpQuats(Data.QuatsASoA, Data.QuatsBSoA, Alpha, bSIMD ? OutSIMD : OutScalar); }, ScalarMs, SIMDMs);
+		LogRow("Slerp", AoSMs, ScalarMs, SIMDMs, MaxQuatError(OutScalar, OutSIMD));
+
+		{
+			FBenchTimer Timer;
+			for (int32 Round = 0; Round < Rounds; ++Round)
+			{
+				for (int32 i = 0; i < Count; ++i)
+				{
+					OutAoS[i] = FQuat::Nlerp(Data.QuatsA[i], Data.QuatsB[i], Alpha);
+				}
+			}
+			AoSMs = Timer.GetMs();
+		}
+		RunSoA([&](bool bSIMD) { FSoAMath::NlerpQuats(Data.QuatsASoA, Data.QuatsBSoA, Alpha, bSIMD ? OutSIMD : OutScalar); }, ScalarMs, SIMDMs);
+		LogRow("Nlerp", AoSMs, ScalarMs, SIMDMs, MaxQuatError(OutScalar, OutSIMD));
+	}
+
+	// 점 변환
+	{
+		TArray<FVector> OutAoS(Count);
+		double AoSMs = 0.0;
+		{
+			FBenchTimer Timer;
+			for (int32 Round = 0; Round < Rounds; ++Round)
+			{
+				for (int32 i = 0; i < Count; ++i)
+				{
+					OutAoS[i] = Data.Parents[i].TransformPosition(Data.Points[i]);
+				}
+			}
+			AoSMs = Timer.GetMs();
+		}
+
+		FVectorSoA OutScalar, OutSIMD;
+		double ScalarMs = 0.0, SIMDMs = 0.0;
+		RunSoA([&](bool bSIMD) { FSoAMath::TransformPoints(Data.ParentsSoA, Data.PointsSoA, bSIMD ? OutSIMD : OutScalar); }, ScalarMs, SIMDMs);
+		LogRow("TransformPoints", AoSMs, ScalarMs, SIMDMs, MaxVectorError(OutScalar, OutSIMD));
+	}
+
+	// AABB 변환 (AoS 기준은 8꼭짓점 변환 후 감싸기)
+	{
+		TArray<FVector> OutMinAoS(Count), OutMaxAoS(Count);
+		double AoSMs = 0.0;
+		{
+			FBenchTimer Timer;
+			for (int32 Round = 0; Round < Rounds; ++Round)
+			{
+				for (int32 i = 0; i < Count; ++i)
+				{
+					const FTransform& T = Data.Parents[i];
+					const FVector& Min = Data.BoxMin[i];
+					const FVector& Max = Data.BoxMax[i];
+					FVector WorldMin(FLT_MAX, FLT_MAX, FLT_MAX);
+					FVector WorldMax(-FLT_MAX, -FLT_MAX, -FLT_MAX);
+					for (int32 Corner = 0; Corner < 8; ++Corner)
+					{
+						const FVector P = T.TransformPosition(FVector(
+							(Corner & 1) ? Max.X : Min.X,
+							(Corner & 2) ? Max.Y : Min.Y,
+							(Corner & 4) ? Max.Z : Min.Z));
+						WorldMin = FVector(std::min(WorldMin.X, P.X), std::min(WorldMin.Y, P.Y), std::min(WorldMin.Z, P.Z));
+						WorldMax = FVector(std::max(WorldMax.X, P.X), std::max(WorldMax.Y, P.Y), std::max(WorldMax.Z, P.Z));
+					}
+					OutMinAoS[i] = WorldMin;
+					OutMaxAoS[i] = WorldMax;
+				}
+			}
+			AoSMs = Timer.GetMs();
+		}
+
+		FVectorSoA OutMinScalar, OutMaxScalar, OutMinSIMD, OutMaxSIMD;
+		double ScalarMs = 0.0, SIMDMs = 0.0;
+		RunSoA([&](bool bSIMD)
+		{
+			FSoAMath::TransformAABBs(Data.ParentsSoA, Data.BoxMinSoA, Data.BoxMaxSoA,
+				bSIMD ? OutMinSIMD : OutMinScalar, bSIMD ? OutMaxSIMD : OutMaxScalar);
+		}, ScalarMs, SIMDMs);
+
+		FVectorSoA RefMin, RefMax;
+		RefMin.FromAoS(OutMinAoS);
+		RefMax.FromAoS(OutMaxAoS);
+		const float Error = std::max(MaxVectorError(RefMin, OutMinSIMD), MaxVectorError(RefMax, OutMaxSIMD));
+		LogRow("TransformAABBs", AoSMs, ScalarMs, SIMDMs, Error);
+	}
+
+	// 스키닝 행렬 (AoS 기준은 4x4 곱 + 4x4 역행렬의 전치, 본 포즈 = Parents, 바인드 포즈 = Children)
+	{
+		FMatrix3x4SoA InverseBindPoses;
+		InverseBindPoses.SetNum(Count);
+		TArray<FMatrix> InverseBindMatrices(Count);
+		for (int32 i = 0; i < Count; ++i)
+		{
+			InverseBindMatrices[i] = Data.Children[i].ToMatrix();
+			InverseBindPoses.Set(i, FMatrix3x4(InverseBindMatrices[i]));
+		}
+
+		TArray<FMatrix> OutAoS(Count), OutNormalAoS(Count);
+		double AoSMs = 0.0;
+		{
+			FBenchTimer Timer;
+			for (int32 Round = 0; Round < Rounds; ++Round)
+			{
+				for (int32 i = 0; i < Count; ++i)
+				{
+					OutAoS[i] = InverseBindMatrices[i] * Data.Parents[i].ToMatrix();
+					OutNormalAoS[i] = OutAoS[i].Inverse().Transpose();
+				}
+			}
+			AoSMs = Timer.GetMs();
+		}
+
+		TArray<FMatrix3x4> OutScalar, OutNormalScalar, OutSIMD, OutNormalSIMD;
+		double ScalarMs = 0.0, SIMDMs = 0.0;
+		RunSoA([&](bool bSIMD)
+		{
+			FSoAMath::BuildSkinningMatrices(InverseBindPoses, Data.ParentsSoA,
+				bSIMD ? OutSIMD : OutScalar, bSIMD ? OutNormalSIMD : OutNormalScalar);
+		}, ScalarMs, SIMDMs);
+
+		// 4x4 역전치의 마지막 열(역행렬의 이동)은 노말 변환에 쓰이지 않으므로 3x4 로 옮기면서 버린다
+		TArray<FMatrix3x4> Ref(Count), RefNormal(Count);
+		for (int32 i = 0; i < Count; ++i)
+		{
+			Ref[i] = FMatrix3x4(OutAoS[i]);
+			RefNormal[i] = FMatrix3x4(OutNormalAoS[i]);
+		}
+		const float Error = std::max(MaxMatrixError(Ref, OutSIMD), MaxMatrixError(RefNormal, OutNormalSIMD));
+		LogRow("SkinningMatrices", AoSMs, ScalarMs, SIMDMs, Error);
+	}
+
+	FSoAMath::SetUseSIMD(bPrevUseSIMD);
+}
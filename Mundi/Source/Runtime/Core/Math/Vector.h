@@ -1220,6 +1220,59 @@ inline FMatrix operator*(const FMatrix& A, const FMatrix& B)
 	return Result;
 }
 
+// ─────────────────────────────
+// FMatrix3x4 (affine 변환, 마지막 열 (0,0,0,1) 생략)
+// FMatrix 의 앞 세 열을 행으로 저장: M[c] = (A.M[0][c], A.M[1][c], A.M[2][c], A.M[3][c])
+// p' = p * A 의 성분 c = Dot(M[c], (p, 1)). 셰이더의 row_major float3x4 와 같은 배치로, FMatrix 보다 16바이트 작다
+// ─────────────────────────────
+struct alignas(16) FMatrix3x4
+{
+	float M[3][4] = {};
+
+	FMatrix3x4() = default;
+
+	explicit FMatrix3x4(const FMatrix& A)
+	{
+		for (int32 Col = 0; Col < 3; ++Col)
+		{
+			for (int32 Row = 0; Row < 4; ++Row)
+			{
+				M[Col][Row] = A.M[Row][Col];
+			}
+		}
+	}
+
+	static FMatrix3x4 Identity()
+	{
+		return FMatrix3x4(FMatrix::Identity());
+	}
+
+	FMatrix ToMatrix() const
+	{
+		return FMatrix(
+			M[0][0], M[1][0], M[2][0], 0.0f,
+			M[0][1], M[1][1], M[2][1], 0.0f,
+			M[0][2], M[1][2], M[2][2], 0.0f,
+			M[0][3], M[1][3], M[2][3], 1.0f);
+	}
+
+	FVector TransformPosition(const FVector& P) const
+	{
+		return FVector(
+			P.X * M[0][0] + P.Y * M[0][1] + P.Z * M[0][2] + M[0][3],
+			P.X * M[1][0] + P.Y * M[1][1] + P.Z * M[1][2] + M[1][3],
+			P.X * M[2][0] + P.Y * M[2][1] + P.Z * M[2][2] + M[2][3]);
+	}
+
+	FVector TransformVector(const FVector& V) const
+	{
+		return FVector(
+			V.X * M[0][0] + V.Y * M[0][1] + V.Z * M[0][2],
+			V.X * M[1][0] + V.Y * M[1][1] + V.Z * M[1][2],
+			V.X * M[2][0] + V.Y * M[2][1] + V.Z * M[2][2]);
+	}
+};
+
 // ─────────────────────────────
 // FTransform (position/rotation/scale)
 // ─────────────────────────────
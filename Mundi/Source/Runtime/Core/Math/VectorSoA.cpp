@@ -0,0 +1,965 @@
+﻿#include "pch.h"
+#include "VectorSoA.h"
+#include <immintrin.h> // AVX2, FMA
+#include <intrin.h>    // __cpuid, _xgetbv
+
+// ─────────────────────────────
+// AoS <-> SoA 변환
+// ─────────────────────────────
+void FVectorSoA::FromAoS(const TArray<FVector>& Vectors)
+{
+	const int32 Count = static_cast<int32>(Vectors.size());
+	SetNum(Count);
+	for (int32 i = 0; i < Count; ++i)
+	{
+		Set(i, Vectors[i]);
+	}
+}
+
+void FVectorSoA::ToAoS(TArray<FVector>& OutVectors) const
+{
+	const int32 Count = Num();
+	OutVectors.resize(Count);
+	for (int32 i = 0; i < Count; ++i)
+	{
+		OutVectors[i] = Get(i);
+	}
+}
+
+void FQuatSoA::FromAoS(const TArray<FQuat>& Quats)
+{
+	const int32 Count = static_cast<int32>(Quats.size());
+	SetNum(Count);
+	for (int32 i = 0; i < Count; ++i)
+	{
+		Set(i, Quats[i]);
+	}
+}
+
+void FQuatSoA::ToAoS(TArray<FQuat>& OutQuats) const
+{
+	const int32 Count = Num();
+	OutQuats.resize(Count);
+	for (int32 i = 0; i < Count; ++i)
+	{
+		OutQuats[i] = Get(i);
+	}
+}
+
+void FTransformSoA::FromAoS(const TArray<FTransform>& Transforms)
+{
+	const int32 Count = static_cast<int32>(Transforms.size());
+	SetNum(Count);
+	for (int32 i = 0; i < Count; ++i)
+	{
+		Set(i, Transforms[i]);
+	}
+}
+
+void FTransformSoA::ToAoS(TArray<FTransform>& OutTransforms) const
+{
+	const int32 Count = Num();
+	OutTransforms.resize(Count);
+	for (int32 i = 0; i < Count; ++i)
+	{
+		OutTransforms[i] = Get(i);
+	}
+}
+
+void FMatrix3x4SoA::FromAoS(const TArray<FMatrix3x4>& Matrices)
+{
+	const int32 Count = static_cast<int32>(Matrices.size());
+	SetNum(Count);
+	for (int32 i = 0; i < Count; ++i)
+	{
+		Set(i, Matrices[i]);
+	}
+}
+
+void FMatrix3x4SoA::ToAoS(TArray<FMatrix3x4>& OutMatrices) const
+{
+	const int32 Count = Num();
+	OutMatrices.resize(Count);
+	for (int32 i = 0; i < Count; ++i)
+	{
+		OutMatrices[i] = Get(i);
+	}
+}
+
+namespace
+{
+	// ─────────────────────────────
+	// CPU 기능 검사
+	// ─────────────────────────────
+	bool DetectAVX2()
+	{
+		int Info[4] = {};
+		__cpuid(Info, 0);
+		if (Info[0] < 7)
+		{
+			return false;
+		}
+
+		__cpuid(Info, 1);
+		const bool bFMA = (Info[2] & (1 << 12)) != 0;
+		const bool bOSXSAVE = (Info[2] & (1 << 27)) != 0;
+		const bool bAVX = (Info[2] & (1 << 28)) != 0;
+		if (!bFMA || !bOSXSAVE || !bAVX)
+		{
+			return false;
+		}
+
+		// OS 가 컨텍스트 스위치 때 XMM/YMM 상태를 저장하는지 (XCR0 bit 1, 2)
+		if ((_xgetbv(0) & 0x6) != 0x6)
+		{
+			return false;
+		}
+
+		__cpuidex(Info, 7, 0);
+		return (Info[1] & (1 << 5)) != 0;
+	}
+
+	bool GUseSIMD = true;
+
+	bool ShouldUseAVX2()
+	{
+		return GUseSIMD && FSoAMath::HasAVX2();
+	}
+
+	// ─────────────────────────────
+	// 스칼라 커널 ([Begin, End) 구간). 지원하지 않는 CPU 및 8개 미만 꼬리 처리용
+	// ─────────────────────────────
+	void ComposeScalar(const FTransformSoA& Parent, const FTransformSoA& Child, FTransformSoA& Out, int32 Begin, int32 End)
+	{
+		for (int32 i = Begin; i < End; ++i)
+		{
+			Out.Set(i, Parent.Get(i).GetWorldTransform(Child.Get(i)));
+		}
+	}
+
+	void SlerpScalar(const FQuatSoA& A, const FQuatSoA& B, float Alpha, FQuatSoA& Out, int32 Begin, int32 End)
+	{
+		for (int32 i = Begin; i < End; ++i)
+		{
+			Out.Set(i, FQuat::Slerp(A.Get(i), B.Get(i), Alpha));
+		}
+	}
+
+	void NlerpScalar(const FQuatSoA& A, const FQuatSoA& B, float Alpha, FQuatSoA& Out, int32 Begin, int32 End)
+	{
+		for (int32 i = Begin; i < End; ++i)
+		{
+			Out.Set(i, FQuat::Nlerp(A.Get(i), B.Get(i), Alpha));
+		}
+	}
+
+	void NlerpScalar(const FQuatSoA& A, const FQuatSoA& B, const TArray<float>& Alphas, FQuatSoA& Out, int32 Begin, int32 End)
+	{
+		for (int32 i = Begin; i < End; ++i)
+		{
+			Out.Set(i, FQuat::Nlerp(A.Get(i), B.Get(i), Alphas[i]));
+		}
+	}
+
+	void LerpScalar(const FVectorSoA& A, const FVectorSoA& B, const TArray<float>& Alphas, FVectorSoA& Out, int32 Begin, int32 End)
+	{
+		for (int32 i = Begin; i < End; ++i)
+		{
+			Out.Set(i, FVector::Lerp(A.Get(i), B.Get(i), Alphas[i]));
+		}
+	}
+
+	void TransformPointsScalar(const FTransformSoA& Transforms, const FVectorSoA& Points, FVectorSoA& Out, int32 Begin, int32 End)
+	{
+		for (int32 i = Begin; i < End; ++i)
+		{
+			Out.Set(i, Transforms.Get(i).TransformPosition(Points.Get(i)));
+		}
+	}
+
+	void TransformPointsScalar(const FMatrix& M, const FVectorSoA& Points, FVectorSoA& Out, int32 Begin, int32 End)
+	{
+		for (int32 i = Begin; i < End; ++i)
+		{
+			const float PX = Points.X[i], PY = Points.Y[i], PZ = Points.Z[i];
+			Out.X[i] = PX * M.M[0][0] + PY * M.M[1][0] + PZ * M.M[2][0] + M.M[3][0];
+			Out.Y[i] = PX * M.M[0][1] + PY * M.M[1][1] + PZ * M.M[2][1] + M.M[3][1];
+			Out.Z[i] = PX * M.M[0][2] + PY * M.M[1][2] + PZ * M.M[2][2] + M.M[3][2];
+		}
+	}
+
+	// 중심은 변환하고, 반쪽 크기는 3x3 행렬 성분의 절댓값으로 투영한다 (Arvo 방식)
+	void TransformAABBsScalar(const FTransformSoA& Transforms, const FVectorSoA& LocalMin, const FVectorSoA& LocalMax,
+		FVectorSoA& OutMin, FVectorSoA& OutMax, int32 Begin, int32 End)
+	{
+		for (int32 i = Begin; i < End; ++i)
+		{
+			const FTransform T = Transforms.Get(i);
+			const FVector Min = LocalMin.Get(i);
+			const FVector Max = LocalMax.Get(i);
+			const FVector Center = (Min + Max) * 0.5f;
+			const FVector Extent = (Max - Min) * 0.5f;
+
+			const FVector WorldCenter = T.TransformPosition(Center);
+			// 축 방향 벡터를 변환해 각 축의 기여를 구한다
+			const FVector AxisX = T.TransformVector(FVector(Extent.X, 0.0f, 0.0f));
+			const FVector AxisY = T.TransformVector(FVector(0.0f, Extent.Y, 0.0f));
+			const FVector AxisZ = T.TransformVector(FVector(0.0f, 0.0f, Extent.Z));
+			const FVector WorldExtent(
+				std::fabs(AxisX.X) + std::fabs(AxisY.X) + std::fabs(AxisZ.X),
+				std::fabs(AxisX.Y) + std::fabs(AxisY.Y) + std::fabs(AxisZ.Y),
+				std::fabs(AxisX.Z) + std::fabs(AxisY.Z) + std::fabs(AxisZ.Z));
+
+			OutMin.Set(i, WorldCenter - WorldExtent);
+			OutMax.Set(i, WorldCenter + WorldExtent);
+		}
+	}
+
+	void TransformAABBsScalar(const FMatrix& M, const FVectorSoA& LocalMin, const FVectorSoA& LocalMax,
+		FVectorSoA& OutMin, FVectorSoA& OutMax, int32 Begin, int32 End)
+	{
+		for (int32 i = Begin; i < End; ++i)
+		{
+			const FVector Center = (LocalMin.Get(i) + LocalMax.Get(i)) * 0.5f;
+			const FVector Extent = (LocalMax.Get(i) - LocalMin.Get(i)) * 0.5f;
+
+			FVector WorldCenter;
+			FVector WorldExtent;
+			for (int32 Axis = 0; Axis < 3; ++Axis)
+			{
+				(&WorldCenter.X)[Axis] = Center.X * M.M[0][Axis] + Center.Y * M.M[1][Axis] + Center.Z * M.M[2][Axis] + M.M[3][Axis];
+				(&WorldExtent.X)[Axis] = Extent.X * std::fabs(M.M[0][Axis]) + Extent.Y * std::fabs(M.M[1][Axis]) + Extent.Z * std::fabs(M.M[2][Axis]);
+			}
+
+			OutMin.Set(i, WorldCenter - WorldExtent);
+			OutMax.Set(i, WorldCenter + WorldExtent);
+		}
+	}
+
+	// 3x3 부분의 역전치 = 여인수 행렬 / 행렬식. FMatrix3x4 는 열을 행으로 저장하므로 저장된 3x3 의 여인수를 같은 자리에 둔다
+	// (행렬식이 0 에 가까우면 나누지 않는다. 노말은 스키닝 후 정규화되므로 방향만 맞으면 된다)
+	FMatrix3x4 InverseTranspose3x3(const FMatrix3x4& A)
+	{
+		FMatrix3x4 Out;
+		for (int32 Row = 0; Row < 3; ++Row)
+		{
+			const int32 R1 = (Row + 1) % 3, R2 = (Row + 2) % 3;
+			for (int32 Col = 0; Col < 3; ++Col)
+			{
+				const int32 C1 = (Col + 1) % 3, C2 = (Col + 2) % 3;
+				Out.M[Row][Col] = A.M[R1][C1] * A.M[R2][C2] - A.M[R1][C2] * A.M[R2][C1];
+			}
+		}
+
+		const float Det = A.M[0][0] * Out.M[0][0] + A.M[0][1] * Out.M[0][1] + A.M[0][2] * Out.M[0][2];
+		const float InvDet = std::fabs(Det) > 1e-20f ? 1.0f / Det : 1.0f;
+		for (int32 Row = 0; Row < 3; ++Row)
+		{
+			for (int32 Col = 0; Col < 3; ++Col)
+			{
+				Out.M[Row][Col] *= InvDet;
+			}
+		}
+		return Out;
+	}
+
+	void BuildSkinningMatricesScalar(const FMatrix3x4SoA& InverseBindPoses, const FTransformSoA& ComponentPoses,
+		TArray<FMatrix3x4>& OutMatrices, TArray<FMatrix3x4>& OutNormalMatrices, int32 Begin, int32 End)
+	{
+		for (int32 i = Begin; i < End; ++i)
+		{
+			const FMatrix3x4 Skinning(InverseBindPoses.Get(i).ToMatrix() * ComponentPoses.Get(i).ToMatrix());
+			OutMatrices[i] = Skinning;
+			OutNormalMatrices[i] = InverseTranspose3x3(Skinning);
+		}
+	}
+
+	// ─────────────────────────────
+	// AVX2 커널 (8 레인)
+	// ─────────────────────────────
+	struct FVec8
+	{
+		__m256 X, Y, Z;
+	};
+
+	struct FQuat8
+	{
+		__m256 X, Y, Z, W;
+	};
+
+	inline FVec8 LoadVec8(const FVectorSoA& V, int32 Index)
+	{
+		return { _mm256_loadu_ps(&V.X[Index]), _mm256_loadu_ps(&V.Y[Index]), _mm256_loadu_ps(&V.Z[Index]) };
+	}
+
+	inline void StoreVec8(FVectorSoA& V, int32 Index, const FVec8& In)
+	{
+		_mm256_storeu_ps(&V.X[Index], In.X);
+		_mm256_storeu_ps(&V.Y[Index], In.Y);
+		_mm256_storeu_ps(&V.Z[Index], In.Z);
+	}
+
+	inline FQuat8 LoadQuat8(const FQuatSoA& Q, int32 Index)
+	{
+		return { _mm256_loadu_ps(&Q.X[Index]), _mm256_loadu_ps(&Q.Y[Index]), _mm256_loadu_ps(&Q.Z[Index]), _mm256_loadu_ps(&Q.W[Index]) };
+	}
+
+	inline void StoreQuat8(FQuatSoA& Q, int32 Index, const FQuat8& In)
+	{
+		_mm256_storeu_ps(&Q.X[Index], In.X);
+		_mm256_storeu_ps(&Q.Y[Index], In.Y);
+		_mm256_storeu_ps(&Q.Z[Index], In.Z);
+		_mm256_storeu_ps(&Q.W[Index], In.W);
+	}
+
+	inline FVec8 Mul8(const FVec8& A, const FVec8& B)
+	{
+		return { _mm256_mul_ps(A.X, B.X), _mm256_mul_ps(A.Y, B.Y), _mm256_mul_ps(A.Z, B.Z) };
+	}
+
+	inline FVec8 Add8(const FVec8& A, const FVec8& B)
+	{
+		return { _mm256_add_ps(A.X, B.X), _mm256_add_ps(A.Y, B.Y), _mm256_add_ps(A.Z, B.Z) };
+	}
+
+	inline FVec8 Sub8(const FVec8& A, const FVec8& B)
+	{
+		return { _mm256_sub_ps(A.X, B.X), _mm256_sub_ps(A.Y, B.Y), _mm256_sub_ps(A.Z, B.Z) };
+	}
+
+	inline FVec8 Scale8(const FVec8& A, __m256 S)
+	{
+		return { _mm256_mul_ps(A.X, S), _mm256_mul_ps(A.Y, S), _mm256_mul_ps(A.Z, S) };
+	}
+
+	inline __m256 Abs8(__m256 V)
+	{
+		return _mm256_andnot_ps(_mm256_set1_ps(-0.0f), V);
+	}
+
+	inline FVec8 Cross8(const FVec8& A, const FVec8& B)
+	{
+		return {
+			_mm256_fmsub_ps(A.Y, B.Z, _mm256_mul_ps(A.Z, B.Y)),
+			_mm256_fmsub_ps(A.Z, B.X, _mm256_mul_ps(A.X, B.Z)),
+			_mm256_fmsub_ps(A.X, B.Y, _mm256_mul_ps(A.Y, B.X))
+		};
+	}
+
+	// FQuat::operator* 와 같은 곱 순서
+	inline FQuat8 QuatMul8(const FQuat8& A, const FQuat8& B)
+	{
+		FQuat8 R;
+		R.X = _mm256_fmadd_ps(A.W, B.X, _mm256_fmadd_ps(A.X, B.W, _mm256_fmsub_ps(A.Y, B.Z, _mm256_mul_ps(A.Z, B.Y))));
+		R.Y = _mm256_fmadd_ps(A.W, B.Y, _mm256_fmadd_ps(A.Y, B.W, _mm256_fmsub_ps(A.Z, B.X, _mm256_mul_ps(A.X, B.Z))));
+		R.Z = _mm256_fmadd_ps(A.W, B.Z, _mm256_fmadd_ps(A.Z, B.W, _mm256_fmsub_ps(A.X, B.Y, _mm256_mul_ps(A.Y, B.X))));
+		R.W = _mm256_fnmadd_ps(A.Z, B.Z, _mm256_fnmadd_ps(A.Y, B.Y, _mm256_fnmadd_ps(A.X, B.X, _mm256_mul_ps(A.W, B.W))));
+		return R;
+	}
+
+	inline __m256 QuatDot8(const FQuat8& A, const FQuat8& B)
+	{
+		return _mm256_fmadd_ps(A.W, B.W, _mm256_fmadd_ps(A.Z, B.Z, _mm256_fmadd_ps(A.Y, B.Y, _mm256_mul_ps(A.X, B.X))));
+	}
+
+	// FQuat::Normalize 와 동일: 크기가 너무 작으면 항등 쿼터니언
+	inline FQuat8 NormalizeQuat8(const FQuat8& Q)
+	{
+		const __m256 Size = _mm256_sqrt_ps(QuatDot8(Q, Q));
+		const __m256 Valid = _mm256_cmp_ps(Size, _mm256_set1_ps(KINDA_SMALL_NUMBER), _CMP_GT_OQ);
+		const __m256 InvSize = _mm256_div_ps(_mm256_set1_ps(1.0f), Size);
+		FQuat8 R;
+		R.X = _mm256_and_ps(_mm256_mul_ps(Q.X, InvSize), Valid);
+		R.Y = _mm256_and_ps(_mm256_mul_ps(Q.Y, InvSize), Valid);
+		R.Z = _mm256_and_ps(_mm256_mul_ps(Q.Z, InvSize), Valid);
+		R.W = _mm256_blendv_ps(_mm256_set1_ps(1.0f), _mm256_mul_ps(Q.W, InvSize), Valid);
+		return R;
+	}
+
+	// FQuat::RotateVector 와 동일: v' = v + w * t + cross(q.xyz, t), t = 2 * cross(q.xyz, v)
+	inline FVec8 RotateVector8(const FQuat8& Q, const FVec8& V)
+	{
+		const FVec8 U{ Q.X, Q.Y, Q.Z };
+		const FVec8 T = Scale8(Cross8(U, V), _mm256_set1_ps(2.0f));
+		const FVec8 C = Cross8(U, T);
+		return {
+			_mm256_fmadd_ps(Q.W, T.X, _mm256_add_ps(V.X, C.X)),
+			_mm256_fmadd_ps(Q.W, T.Y, _mm256_add_ps(V.Y, C.Y)),
+			_mm256_fmadd_ps(Q.W, T.Z, _mm256_add_ps(V.Z, C.Z))
+		};
+	}
+
+	// 최단 경로가 되도록 B 의 부호를 A 쪽으로 맞춘다. OutDot 은 |dot|
+	inline FQuat8 AlignHemisphere8(const FQuat8& A, const FQuat8& B, __m256& OutDot)
+	{
+		const __m256 Dot = QuatDot8(A, B);
+		const __m256 SignMask = _mm256_and_ps(Dot, _mm256_set1_ps(-0.0f));
+		OutDot = _mm256_xor_ps(Dot, SignMask);
+		return { _mm256_xor_ps(B.X, SignMask), _mm256_xor_ps(B.Y, SignMask), _mm256_xor_ps(B.Z, SignMask), _mm256_xor_ps(B.W, SignMask) };
+	}
+
+	void ComposeAVX2(const FTransformSoA& Parent, const FTransformSoA& Child, FTransformSoA& Out, int32 Count)
+	{
+		int32 i = 0;
+		for (; i + 8 <= Count; i += 8)
+		{
+			const FVec8 PT = LoadVec8(Parent.Translation, i);
+			const FQuat8 PR = LoadQuat8(Parent.Rotation, i);
+			const FVec8 PS = LoadVec8(Parent.Scale3D, i);
+			const FVec8 CT = LoadVec8(Child.Translation, i);
+			const FQuat8 CR = LoadQuat8(Child.Rotation, i);
+			const FVec8 CS = LoadVec8(Child.Scale3D, i);
+
+			// 회전: 부모 * 자식, 스케일: 성분 곱, 위치: 부모 T + 부모 R(부모 S * 자식 T)
+			StoreQuat8(Out.Rotation, i, NormalizeQuat8(QuatMul8(PR, CR)));
+			StoreVec8(Out.Scale3D, i, Mul8(PS, CS));
+			StoreVec8(Out.Translation, i, Add8(PT, RotateVector8(PR, Mul8(CT, PS))));
+		}
+		ComposeScalar(Parent, Child, Out, i, Count);
+	}
+
+	/**
+	 * 삼각함수 없는 Slerp 근사 (D. Eberly, "A Fast and Accurate Algorithm for Computing SLERP").
+	 * sin(k*theta)/sin(theta) 를 cos(theta) 에 대한 8차 다항식으로 근사한다. cos(theta) >= 0 에서 유효.
+	 */
+	struct FSlerpCoefficients
+	{
+		float U[8];
+		float V[8];
+
+		FSlerpCoefficients()
+		{
+			constexpr float Mu = 1.85298109240830f;
+			for (int32 k = 0; k < 7; ++k)
+			{
+				const float i = static_cast<float>(k + 1);
+				U[k] = 1.0f / (i * (2.0f * i + 1.0f));
+				V[k] = i / (2.0f * i + 1.0f);
+			}
+			U[7] = Mu / (8.0f * 17.0f);
+			V[7] = Mu * 8.0f / 17.0f;
+		}
+	};
+
+	const FSlerpCoefficients GSlerpCoefficients;
+
+	// T*T 는 모든 레인이 같으므로 계수 (U * T^2 - V) 를 미리 구해 둔다
+	inline __m256 SlerpWeight8(__m256 XMinusOne, float T)
+	{
+		const float SqrT = T * T;
+		__m256 Acc = _mm256_set1_ps(1.0f);
+		for (int32 k = 7; k >= 0; --k)
+		{
+			const __m256 B = _mm256_mul_ps(_mm256_set1_ps(GSlerpCoefficients.U[k] * SqrT - GSlerpCoefficients.V[k]), XMinusOne);
+			Acc = _mm256_fmadd_ps(B, Acc, _mm256_set1_ps(1.0f));
+		}
+		return _mm256_mul_ps(_mm256_set1_ps(T), Acc);
+	}
+
+	void SlerpAVX2(const FQuatSoA& A, const FQuatSoA& B, float Alpha, FQuatSoA& Out, int32 Count)
+	{
+		int32 i = 0;
+		for (; i + 8 <= Count; i += 8)
+		{
+			const FQuat8 QA = LoadQuat8(A, i);
+			__m256 CosTheta;
+			const FQuat8 QB = AlignHemisphere8(QA, LoadQuat8(B, i), CosTheta);
+
+			const __m256 XMinusOne = _mm256_sub_ps(CosTheta, _mm256_set1_ps(1.0f));
+			const __m256 WeightB = SlerpWeight8(XMinusOne, Alpha);
+			const __m256 WeightA = SlerpWeight8(XMinusOne, 1.0f - Alpha);
+
+			FQuat8 R;
+			R.X = _mm256_fmadd_ps(WeightA, QA.X, _mm256_mul_ps(WeightB, QB.X));
+			R.Y = _mm256_fmadd_ps(WeightA, QA.Y, _mm256_mul_ps(WeightB, QB.Y));
+			R.Z = _mm256_fmadd_ps(WeightA, QA.Z, _mm256_mul_ps(WeightB, QB.Z));
+			R.W = _mm256_fmadd_ps(WeightA, QA.W, _mm256_mul_ps(WeightB, QB.W));
+			StoreQuat8(Out, i, NormalizeQuat8(R));
+		}
+		SlerpScalar(A, B, Alpha, Out, i, Count);
+	}
+
+	void NlerpAVX2(const FQuatSoA& A, const FQuatSoA& B, float Alpha, FQuatSoA& Out, int32 Count)
+	{
+		const __m256 T = _mm256_set1_ps(Alpha);
+		int32 i = 0;
+		for (; i + 8 <= Count; i += 8)
+		{
+			const FQuat8 QA = LoadQuat8(A, i);
+			__m256 Unused;
+			const FQuat8 QB = AlignHemisphere8(QA, LoadQuat8(B, i), Unused);
+
+			FQuat8 R;
+			R.X = _mm256_fmadd_ps(_mm256_sub_ps(QB.X, QA.X), T, QA.X);
+			R.Y = _mm256_fmadd_ps(_mm256_sub_ps(QB.Y, QA.Y), T, QA.Y);
+			R.Z = _mm256_fmadd_ps(_mm256_sub_ps(QB.Z, QA.Z), T, QA.Z);
+			R.W = _mm256_fmadd_ps(_mm256_sub_ps(QB.W, QA.W), T, QA.W);
+			StoreQuat8(Out, i, NormalizeQuat8(R));
+		}
+		NlerpScalar(A, B, Alpha, Out, i, Count);
+	}
+
+	void NlerpAVX2(const FQuatSoA& A, const FQuatSoA& B, const TArray<float>& Alphas, FQuatSoA& Out, int32 Count)
+	{
+		int32 i = 0;
+		for (; i + 8 <= Count; i += 8)
+		{
+			const __m256 T = _mm256_loadu_ps(&Alphas[i]);
+			const FQuat8 QA = LoadQuat8(A, i);
+			__m256 Unused;
+			const FQuat8 QB = AlignHemisphere8(QA, LoadQuat8(B, i), Unused);
+
+			FQuat8 R;
+			R.X = _mm256_fmadd_ps(_mm256_sub_ps(QB.X, QA.X), T, QA.X);
+			R.Y = _mm256_fmadd_ps(_mm256_sub_ps(QB.Y, QA.Y), T, QA.Y);
+			R.Z = _mm256_fmadd_ps(_mm256_sub_ps(QB.Z, QA.Z), T, QA.Z);
+			R.W = _mm256_fmadd_ps(_mm256_sub_ps(QB.W, QA.W), T, QA.W);
+			StoreQuat8(Out, i, NormalizeQuat8(R));
+		}
+		NlerpScalar(A, B, Alphas, Out, i, Count);
+	}
+
+	void LerpAVX2(const FVectorSoA& A, const FVectorSoA& B, const TArray<float>& Alphas, FVectorSoA& Out, int32 Count)
+	{
+		int32 i = 0;
+		for (; i + 8 <= Count; i += 8)
+		{
+			const __m256 T = _mm256_loadu_ps(&Alphas[i]);
+			const FVec8 VA = LoadVec8(A, i);
+			const FVec8 VB = LoadVec8(B, i);
+
+			FVec8 R;
+			R.X = _mm256_fmadd_ps(_mm256_sub_ps(VB.X, VA.X), T, VA.X);
+			R.Y = _mm256_fmadd_ps(_mm256_sub_ps(VB.Y, VA.Y), T, VA.Y);
+			R.Z = _mm256_fmadd_ps(_mm256_sub_ps(VB.Z, VA.Z), T, VA.Z);
+			StoreVec8(Out, i, R);
+		}
+		LerpScalar(A, B, Alphas, Out, i, Count);
+	}
+
+	void TransformPointsAVX2(const FTransformSoA& Transforms, const FVectorSoA& Points, FVectorSoA& Out, int32 Count)
+	{
+		int32 i = 0;
+		for (; i + 8 <= Count; i += 8)
+		{
+			const FVec8 Scaled = Mul8(LoadVec8(Points, i), LoadVec8(Transforms.Scale3D, i));
+			const FVec8 Rotated = RotateVector8(LoadQuat8(Transforms.Rotation, i), Scaled);
+			StoreVec8(Out, i, Add8(LoadVec8(Transforms.Translation, i), Rotated));
+		}
+		TransformPointsScalar(Transforms, Points, Out, i, Count);
+	}
+
+	void TransformPointsAVX2(const FMatrix& M, const FVectorSoA& Points, FVectorSoA& Out, int32 Count)
+	{
+		__m256 Mat[4][3];
+		for (int32 Row = 0; Row < 4; ++Row)
+		{
+			for (int32 Col = 0; Col < 3; ++Col)
+			{
+				Mat[Row][Col] = _mm256_set1_ps(M.M[Row][Col]);
+			}
+		}
+
+		int32 i = 0;
+		for (; i + 8 <= Count; i += 8)
+		{
+			const FVec8 P = LoadVec8(Points, i);
+			FVec8 R;
+			R.X = _mm256_fmadd_ps(P.Z, Mat[2][0], _mm256_fmadd_ps(P.Y, Mat[1][0], _mm256_fmadd_ps(P.X, Mat[0][0], Mat[3][0])));
+			R.Y = _mm256_fmadd_ps(P.Z, Mat[2][1], _mm256_fmadd_ps(P.Y, Mat[1][1], _mm256_fmadd_ps(P.X, Mat[0][1], Mat[3][1])));
+			R.Z = _mm256_fmadd_ps(P.Z, Mat[2][2], _mm256_fmadd_ps(P.Y, Mat[1][2], _mm256_fmadd_ps(P.X, Mat[0][2], Mat[3][2])));
+			StoreVec8(Out, i, R);
+		}
+		TransformPointsScalar(M, Points, Out, i, Count);
+	}
+
+	void TransformAABBsAVX2(const FTransformSoA& Transforms, const FVectorSoA& LocalMin, const FVectorSoA& LocalMax,
+		FVectorSoA& OutMin, FVectorSoA& OutMax, int32 Count)
+	{
+		const __m256 Half = _mm256_set1_ps(0.5f);
+		const __m256 One = _mm256_set1_ps(1.0f);
+		const __m256 Two = _mm256_set1_ps(2.0f);
+
+		int32 i = 0;
+		for (; i + 8 <= Count; i += 8)
+		{
+			const FVec8 Min = LoadVec8(LocalMin, i);
+			const FVec8 Max = LoadVec8(LocalMax, i);
+			const FQuat8 Q = LoadQuat8(Transforms.Rotation, i);
+			const FVec8 S = LoadVec8(Transforms.Scale3D, i);
+
+			const FVec8 Center = Scale8(Add8(Min, Max), Half);
+			// 스케일을 반쪽 크기에 미리 곱해 둔다 (음수 스케일도 절댓값으로)
+			const FVec8 Extent = Mul8(Scale8(Sub8(Max, Min), Half), FVec8{ Abs8(S.X), Abs8(S.Y), Abs8(S.Z) });
+
+			const FVec8 WorldCenter = Add8(LoadVec8(Transforms.Translation, i), RotateVector8(Q, Mul8(Center, S)));
+
+			// 쿼터니언 → 3x3 회전 행렬 (열벡터 기준, RotateVector 와 동일한 전개)
+			const __m256 XX = _mm256_mul_ps(Q.X, Q.X), YY = _mm256_mul_ps(Q.Y, Q.Y), ZZ = _mm256_mul_ps(Q.Z, Q.Z);
+			const __m256 XY = _mm256_mul_ps(Q.X, Q.Y), XZ = _mm256_mul_ps(Q.X, Q.Z), YZ = _mm256_mul_ps(Q.Y, Q.Z);
+			const __m256 WX = _mm256_mul_ps(Q.W, Q.X), WY = _mm256_mul_ps(Q.W, Q.Y), WZ = _mm256_mul_ps(Q.W, Q.Z);
+
+			const __m256 R00 = Abs8(_mm256_fnmadd_ps(Two, _mm256_add_ps(YY, ZZ), One));
+			const __m256 R01 = Abs8(_mm256_mul_ps(Two, _mm256_sub_ps(XY, WZ)));
+			const __m256 R02 = Abs8(_mm256_mul_ps(Two, _mm256_add_ps(XZ, WY)));
+			const __m256 R10 = Abs8(_mm256_mul_ps(Two, _mm256_add_ps(XY, WZ)));
+			const __m256 R11 = Abs8(_mm256_fnmadd_ps(Two, _mm256_add_ps(XX, ZZ), One));
+			const __m256 R12 = Abs8(_mm256_mul_ps(Two, _mm256_sub_ps(YZ, WX)));
+			const __m256 R20 = Abs8(_mm256_mul_ps(Two, _mm256_sub_ps(XZ, WY)));
+			const __m256 R21 = Abs8(_mm256_mul_ps(Two, _mm256_add_ps(YZ, WX)));
+			const __m256 R22 = Abs8(_mm256_fnmadd_ps(Two, _mm256_add_ps(XX, YY), One));
+
+			const FVec8 WorldExtent{
+				_mm256_fmadd_ps(R02, Extent.Z, _mm256_fmadd_ps(R01, Extent.Y, _mm256_mul_ps(R00, Extent.X))),
+				_mm256_fmadd_ps(R12, Extent.Z, _mm256_fmadd_ps(R11, Extent.Y, _mm256_mul_ps(R10, Extent.X))),
+				_mm256_fmadd_ps(R22, Extent.Z, _mm256_fmadd_ps(R21, Extent.Y, _mm256_mul_ps(R20, Extent.X)))
+			};
+
+			StoreVec8(OutMin, i, Sub8(WorldCenter, WorldExtent));
+			StoreVec8(OutMax, i, Add8(WorldCenter, WorldExtent));
+		}
+		TransformAABBsScalar(Transforms, LocalMin, LocalMax, OutMin, OutMax, i, Count);
+	}
+
+	void TransformAABBsAVX2(const FMatrix& M, const FVectorSoA& LocalMin, const FVectorSoA& LocalMax,
+		FVectorSoA& OutMin, FVectorSoA& OutMax, int32 Count)
+	{
+		__m256 Mat[4][3];
+		__m256 AbsMat[3][3];
+		for (int32 Row = 0; Row < 4; ++Row)
+		{
+			for (int32 Col = 0; Col < 3; ++Col)
+			{
+				Mat[Row][Col] = _mm256_set1_ps(M.M[Row][Col]);
+				if (Row < 3)
+				{
+					AbsMat[Row][Col] = _mm256_set1_ps(std::fabs(M.M[Row][Col]));
+				}
+			}
+		}
+
+		const __m256 Half = _mm256_set1_ps(0.5f);
+		int32 i = 0;
+		for (; i + 8 <= Count; i += 8)
+		{
+			const FVec8 Min = LoadVec8(LocalMin, i);
+			const FVec8 Max = LoadVec8(LocalMax, i);
+			const FVec8 C = Scale8(Add8(Min, Max), Half);
+			const FVec8 E = Scale8(Sub8(Max, Min), Half);
+
+			FVec8 WorldCenter;
+			WorldCenter.X = _mm256_fmadd_ps(C.Z, Mat[2][0], _mm256_fmadd_ps(C.Y, Mat[1][0], _mm256_fmadd_ps(C.X, Mat[0][0], Mat[3][0])));
+			WorldCenter.Y = _mm256_fmadd_ps(C.Z, Mat[2][1], _mm256_fmadd_ps(C.Y, Mat[1][1], _mm256_fmadd_ps(C.X, Mat[0][1], Mat[3][1])));
+			WorldCenter.Z = _mm256_fmadd_ps(C.Z, Mat[2][2], _mm256_fmadd_ps(C.Y, Mat[1][2], _mm256_fmadd_ps(C.X, Mat[0][2], Mat[3][2])));
+
+			FVec8 WorldExtent;
+			WorldExtent.X = _mm256_fmadd_ps(E.Z, AbsMat[2][0], _mm256_fmadd_ps(E.Y, AbsMat[1][0], _mm256_mul_ps(E.X, AbsMat[0][0])));
+			WorldExtent.Y = _mm256_fmadd_ps(E.Z, AbsMat[2][1], _mm256_fmadd_ps(E.Y, AbsMat[1][1], _mm256_mul_ps(E.X, AbsMat[0][1])));
+			WorldExtent.Z = _mm256_fmadd_ps(E.Z, AbsMat[2][2], _mm256_fmadd_ps(E.Y, AbsMat[1][2], _mm256_mul_ps(E.X, AbsMat[0][2])));
+
+			StoreVec8(OutMin, i, Sub8(WorldCenter, WorldExtent));
+			StoreVec8(OutMax, i, Add8(WorldCenter, WorldExtent));
+		}
+		TransformAABBsScalar(M, LocalMin, LocalMax, OutMin, OutMax, i, Count);
+	}
+
+	// 8 레인의 3x4 행렬을 AoS 로 흩어 쓴다
+	inline void StoreMatrix3x4x8(const __m256 (&In)[3][4], TArray<FMatrix3x4>& Out, int32 Index)
+	{
+		alignas(32) float Lanes[3][4][8];
+		for (int32 Row = 0; Row < 3; ++Row)
+		{
+			for (int32 Col = 0; Col < 4; ++Col)
+			{
+				_mm256_store_ps(Lanes[Row][Col], In[Row][Col]);
+			}
+		}
+		for (int32 Lane = 0; Lane < 8; ++Lane)
+		{
+			FMatrix3x4& Dst = Out[Index + Lane];
+			for (int32 Row = 0; Row < 3; ++Row)
+			{
+				for (int32 Col = 0; Col < 4; ++Col)
+				{
+					Dst.M[Row][Col] = Lanes[Row][Col][Lane];
+				}
+			}
+		}
+	}
+
+	void BuildSkinningMatricesAVX2(const FMatrix3x4SoA& InverseBindPoses, const FTransformSoA& ComponentPoses,
+		TArray<FMatrix3x4>& OutMatrices, TArray<FMatrix3x4>& OutNormalMatrices, int32 Count)
+	{
+		const __m256 One = _mm256_set1_ps(1.0f);
+
+		int32 i = 0;
+		for (; i + 8 <= Count; i += 8)
+		{
+			const FQuat8 Q = LoadQuat8(ComponentPoses.Rotation, i);
+			const FVec8 S = LoadVec8(ComponentPoses.Scale3D, i);
+			const FVec8 T = LoadVec8(ComponentPoses.Translation, i);
+
+			// 컴포넌트 포즈 행렬 C = S * R * T (FTransform::ToMatrix) 의 3x3 부분
+			const __m256 X2 = _mm256_add_ps(Q.X, Q.X), Y2 = _mm256_add_ps(Q.Y, Q.Y), Z2 = _mm256_add_ps(Q.Z, Q.Z);
+			const __m256 XX = _mm256_mul_ps(Q.X, X2), YY = _mm256_mul_ps(Q.Y, Y2), ZZ = _mm256_mul_ps(Q.Z, Z2);
+			const __m256 XY = _mm256_mul_ps(Q.X, Y2), XZ = _mm256_mul_ps(Q.X, Z2), YZ = _mm256_mul_ps(Q.Y, Z2);
+			const __m256 WX = _mm256_mul_ps(Q.W, X2), WY = _mm256_mul_ps(Q.W, Y2), WZ = _mm256_mul_ps(Q.W, Z2);
+
+			__m256 C[4][3];
+			C[0][0] = _mm256_mul_ps(_mm256_sub_ps(One, _mm256_add_ps(YY, ZZ)), S.X);
+			C[0][1] = _mm256_mul_ps(_mm256_add_ps(XY, WZ), S.X);
+			C[0][2] = _mm256_mul_ps(_mm256_sub_ps(XZ, WY), S.X);
+			C[1][0] = _mm256_mul_ps(_mm256_sub_ps(XY, WZ), S.Y);
+			C[1][1] = _mm256_mul_ps(_mm256_sub_ps(One, _mm256_add_ps(XX, ZZ)), S.Y);
+			C[1][2] = _mm256_mul_ps(_mm256_add_ps(YZ, WX), S.Y);
+			C[2][0] = _mm256_mul_ps(_mm256_add_ps(XZ, WY), S.Z);
+			C[2][1] = _mm256_mul_ps(_mm256_sub_ps(YZ, WX), S.Z);
+			C[2][2] = _mm256_mul_ps(_mm256_sub_ps(One, _mm256_add_ps(XX, YY)), S.Z);
+			C[3][0] = T.X;
+			C[3][1] = T.Y;
+			C[3][2] = T.Z;
+
+			// InverseBindPose (B) * C. B 의 행 r 은 InverseBindPoses.M[0..2][r]
+			__m256 B[3][4];
+			for (int32 Row = 0; Row < 3; ++Row)
+			{
+				for (int32 Col = 0; Col < 4; ++Col)
+				{
+					B[Row][Col] = _mm256_loadu_ps(&InverseBindPoses.M[Row][Col][i]);
+				}
+			}
+
+			__m256 Skinning[3][4];
+			for (int32 Axis = 0; Axis < 3; ++Axis)
+			{
+				for (int32 Row = 0; Row < 4; ++Row)
+				{
+					__m256 Sum = _mm256_fmadd_ps(B[2][Row], C[2][Axis], _mm256_fmadd_ps(B[1][Row], C[1][Axis], _mm256_mul_ps(B[0][Row], C[0][Axis])));
+					if (Row == 3)
+					{
+						Sum = _mm256_add_ps(Sum, C[3][Axis]);
+					}
+					Skinning[Axis][Row] = Sum;
+				}
+			}
+
+			// 역전치 = 여인수 / 행렬식 (InverseTranspose3x3 와 같은 식)
+			__m256 Normal[3][4];
+			for (int32 Row = 0; Row < 3; ++Row)
+			{
+				const int32 R1 = (Row + 1) % 3, R2 = (Row + 2) % 3;
+				for (int32 Col = 0; Col < 3; ++Col)
+				{
+					const int32 C1 = (Col + 1) % 3, C2 = (Col + 2) % 3;
+					Normal[Row][Col] = _mm256_fmsub_ps(Skinning[R1][C1], Skinning[R2][C2], _mm256_mul_ps(Skinning[R1][C2], Skinning[R2][C1]));
+				}
+				Normal[Row][3] = _mm256_setzero_ps();
+			}
+
+			const __m256 Det = _mm256_fmadd_ps(Skinning[0][2], Normal[0][2],
+				_mm256_fmadd_ps(Skinning[0][1], Normal[0][1], _mm256_mul_ps(Skinning[0][0], Normal[0][0])));
+			const __m256 Valid = _mm256_cmp_ps(Abs8(Det), _mm256_set1_ps(1e-20f), _CMP_GT_OQ);
+			const __m256 InvDet = _mm256_blendv_ps(One, _mm256_div_ps(One, Det), Valid);
+			for (int32 Row = 0; Row < 3; ++Row)
+			{
+				for (int32 Col = 0; Col < 3; ++Col)
+				{
+					Normal[Row][Col] = _mm256_mul_ps(Normal[Row][Col], InvDet);
+				}
+			}
+
+			StoreMatrix3x4x8(Skinning, OutMatrices, i);
+			StoreMatrix3x4x8(Normal, OutNormalMatrices, i);
+		}
+		BuildSkinningMatricesScalar(InverseBindPoses, ComponentPoses, OutMatrices, OutNormalMatrices, i, Count);
+	}
+}
+
+// ─────────────────────────────
+// FSoAMath
+// ─────────────────────────────
+bool FSoAMath::HasAVX2()
+{
+	static const bool bHasAVX2 = DetectAVX2();
+	return bHasAVX2;
+}
+
+void FSoAMath::SetUseSIMD(bool bEnable)
+{
+	GUseSIMD = bEnable;
+}
+
+bool FSoAMath::IsUsingSIMD()
+{
+	return ShouldUseAVX2();
+}
+
+bool FSoAMath::GetUseSIMD()
+{
+	return GUseSIMD;
+}
+
+void FSoAMath::ComposeTransforms(const FTransformSoA& Parent, const FTransformSoA& Child, FTransformSoA& Out)
+{
+	const int32 Count = Parent.Num();
+	assert(Child.Num() == Count);
+	Out.SetNum(Count);
+
+	if (ShouldUseAVX2())
+	{
+		ComposeAVX2(Parent, Child, Out, Count);
+	}
+	else
+	{
+		ComposeScalar(Parent, Child, Out, 0, Count);
+	}
+}
+
+void FSoAMath::SlerpQuats(const FQuatSoA& A, const FQuatSoA& B, float Alpha, FQuatSoA& Out)
+{
+	const int32 Count = A.Num();
+	assert(B.Num() == Count);
+	Out.SetNum(Count);
+
+	if (ShouldUseAVX2())
+	{
+		SlerpAVX2(A, B, Alpha, Out, Count);
+	}
+	else
+	{
+		SlerpScalar(A, B, Alpha, Out, 0, Count);
+	}
+}
+
+void FSoAMath::NlerpQuats(const FQuatSoA& A, const FQuatSoA& B, float Alpha, FQuatSoA& Out)
+{
+	const int32 Count = A.Num();
+	assert(B.Num() == Count);
+	Out.SetNum(Count);
+
+	if (ShouldUseAVX2())
+	{
+		NlerpAVX2(A, B, Alpha, Out, Count);
+	}
+	else
+	{
+		NlerpScalar(A, B, Alpha, Out, 0, Count);
+	}
+}
+
+void FSoAMath::NlerpQuats(const FQuatSoA& A, const FQuatSoA& B, const TArray<float>& Alphas, FQuatSoA& Out)
+{
+	const int32 Count = A.Num();
+	assert(B.Num() == Count && Alphas.Num() == Count);
+	Out.SetNum(Count);
+
+	if (ShouldUseAVX2())
+	{
+		NlerpAVX2(A, B, Alphas, Out, Count);
+	}
+	else
+	{
+		NlerpScalar(A, B, Alphas, Out, 0, Count);
+	}
+}
+
+void FSoAMath::LerpVectors(const FVectorSoA& A, const FVectorSoA& B, const TArray<float>& Alphas, FVectorSoA& Out)
+{
+	const int32 Count = A.Num();
+	assert(B.Num() == Count && Alphas.Num() == Count);
+	Out.SetNum(Count);
+
+	if (ShouldUseAVX2())
+	{
+		LerpAVX2(A, B, Alphas, Out, Count);
+	}
+	else
+	{
+		LerpScalar(A, B, Alphas, Out, 0, Count);
+	}
+}
+
+void FSoAMath::TransformPoints(const FTransformSoA& Transforms, const FVectorSoA& Points, FVectorSoA& Out)
+{
+	const int32 Count = Points.Num();
+	assert(Transforms.Num() == Count);
+	Out.SetNum(Count);
+
+	if (ShouldUseAVX2())
+	{
+		TransformPointsAVX2(Transforms, Points, Out, Count);
+	}
+	else
+	{
+		TransformPointsScalar(Transforms, Points, Out, 0, Count);
+	}
+}
+
+void FSoAMath::TransformPoints(const FMatrix& M, const FVectorSoA& Points, FVectorSoA& Out)
+{
+	const int32 Count = Points.Num();
+	Out.SetNum(Count);
+
+	if (ShouldUseAVX2())
+	{
+		TransformPointsAVX2(M, Points, Out, Count);
+	}
+	else
+	{
+		TransformPointsScalar(M, Points, Out, 0, Count);
+	}
+}
+
+void FSoAMath::TransformAABBs(const FTransformSoA& Transforms, const FVectorSoA& LocalMin, const FVectorSoA& LocalMax,
+	FVectorSoA& OutMin, FVectorSoA& OutMax)
+{
+	const int32 Count = LocalMin.Num();
+	assert(LocalMax.Num() == Count && Transforms.Num() == Count);
+	OutMin.SetNum(Count);
+	OutMax.SetNum(Count);
+
+	if (ShouldUseAVX2())
+	{
+		TransformAABBsAVX2(Transforms, LocalMin, LocalMax, OutMin, OutMax, Count);
+	}
+	else
+	{
+		TransformAABBsScalar(Transforms, LocalMin, LocalMax, OutMin, OutMax, 0, Count);
+	}
+}
+
+void FSoAMath::TransformAABBs(const FMatrix& M, const FVectorSoA& LocalMin, const FVectorSoA& LocalMax,
+	FVectorSoA& OutMin, FVectorSoA& OutMax)
+{
+	const int32 Count = LocalMin.Num();
+	assert(LocalMax.Num() == Count);
+	OutMin.SetNum(Count);
+	OutMax.SetNum(Count);
+
+	if (ShouldUseAVX2())
+	{
+		TransformAABBsAVX2(M, LocalMin, LocalMax, OutMin, OutMax, Count);
+	}
+	else
+	{
+		TransformAABBsScalar(M, LocalMin, LocalMax, OutMin, OutMax, 0, Count);
+	}
+}
+
+void FSoAMath::BuildSkinningMatrices(const FMatrix3x4SoA& InverseBindPoses, const FTransformSoA& ComponentPoses,
+	TArray<FMatrix3x4>& OutMatrices, TArray<FMatrix3x4>& OutNormalMatrices)
+{
+	const int32 Count = ComponentPoses.Num();
+	assert(InverseBindPoses.Num() == Count);
+	OutMatrices.resize(Count);
+	OutNormalMatrices.resize(Count);
+
+	if (ShouldUseAVX2())
+	{
+		BuildSkinningMatricesAVX2(InverseBindPoses, ComponentPoses, OutMatrices, OutNormalMatrices, Count);
+	}
+	else
+	{
+		BuildSkinningMatricesScalar(InverseBindPoses, ComponentPoses, OutMatrices, OutNormalMatrices, 0, Count);
+	}
+}
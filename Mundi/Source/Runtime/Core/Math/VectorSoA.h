@@ -0,0 +1,192 @@
+﻿#pragma once
+#include "Vector.h"
+
+// ─────────────────────────────
+// SoA(Structure of Arrays) 수학 스트림
+// 성분별로 배열을 나눠 두면 AVX2 로 8개 원소를 한 번에 처리할 수 있다.
+// (FVector/FQuat/FTransform 의 배열(AoS)을 그대로 쓰면 레인마다 셔플이 필요함)
+// ─────────────────────────────
+
+struct FVectorSoA
+{
+	TArray<float> X;
+	TArray<float> Y;
+	TArray<float> Z;
+
+	int32 Num() const { return static_cast<int32>(X.size()); }
+
+	void SetNum(int32 Count)
+	{
+		X.resize(Count); Y.resize(Count); Z.resize(Count);
+	}
+
+	void Set(int32 Index, const FVector& V)
+	{
+		X[Index] = V.X; Y[Index] = V.Y; Z[Index] = V.Z;
+	}
+
+	FVector Get(int32 Index) const
+	{
+		return FVector(X[Index], Y[Index], Z[Index]);
+	}
+
+	void FromAoS(const TArray<FVector>& Vectors);
+	void ToAoS(TArray<FVector>& OutVectors) const;
+};
+
+struct FQuatSoA
+{
+	TArray<float> X;
+	TArray<float> Y;
+	TArray<float> Z;
+	TArray<float> W;
+
+	int32 Num() const { return static_cast<int32>(X.size()); }
+
+	void SetNum(int32 Count)
+	{
+		X.resize(Count); Y.resize(Count); Z.resize(Count); W.resize(Count);
+	}
+
+	void Set(int32 Index, const FQuat& Q)
+	{
+		X[Index] = Q.X; Y[Index] = Q.Y; Z[Index] = Q.Z; W[Index] = Q.W;
+	}
+
+	FQuat Get(int32 Index) const
+	{
+		return FQuat(X[Index], Y[Index], Z[Index], W[Index]);
+	}
+
+	void FromAoS(const TArray<FQuat>& Quats);
+	void ToAoS(TArray<FQuat>& OutQuats) const;
+};
+
+struct FTransformSoA
+{
+	FVectorSoA Translation;
+	FQuatSoA   Rotation;
+	FVectorSoA Scale3D;
+
+	int32 Num() const { return Translation.Num(); }
+
+	void SetNum(int32 Count)
+	{
+		Translation.SetNum(Count); Rotation.SetNum(Count); Scale3D.SetNum(Count);
+	}
+
+	void Set(int32 Index, const FTransform& T)
+	{
+		Translation.Set(Index, T.Translation);
+		Rotation.Set(Index, T.Rotation);
+		Scale3D.Set(Index, T.Scale3D);
+	}
+
+	FTransform Get(int32 Index) const
+	{
+		return FTransform(Translation.Get(Index), Rotation.Get(Index), Scale3D.Get(Index));
+	}
+
+	void FromAoS(const TArray<FTransform>& Transforms);
+	void ToAoS(TArray<FTransform>& OutTransforms) const;
+};
+
+// affine 행렬 스트림 (FMatrix3x4 의 성분 M[Row][Col] 마다 배열 하나)
+struct FMatrix3x4SoA
+{
+	TArray<float> M[3][4];
+
+	int32 Num() const { return static_cast<int32>(M[0][0].size()); }
+
+	void SetNum(int32 Count)
+	{
+		for (int32 Row = 0; Row < 3; ++Row)
+		{
+			for (int32 Col = 0; Col < 4; ++Col)
+			{
+				M[Row][Col].resize(Count);
+			}
+		}
+	}
+
+	void Set(int32 Index, const FMatrix3x4& A)
+	{
+		for (int32 Row = 0; Row < 3; ++Row)
+		{
+			for (int32 Col = 0; Col < 4; ++Col)
+			{
+				M[Row][Col][Index] = A.M[Row][Col];
+			}
+		}
+	}
+
+	FMatrix3x4 Get(int32 Index) const
+	{
+		FMatrix3x4 A;
+		for (int32 Row = 0; Row < 3; ++Row)
+		{
+			for (int32 Col = 0; Col < 4; ++Col)
+			{
+				A.M[Row][Col] = M[Row][Col][Index];
+			}
+		}
+		return A;
+	}
+
+	void FromAoS(const TArray<FMatrix3x4>& Matrices);
+	void ToAoS(TArray<FMatrix3x4>& OutMatrices) const;
+};
+
+/**
+ * SoA 스트림용 배치 연산.
+ * - 첫 호출 때 CPUID 로 AVX2 + FMA (및 OS 의 YMM 상태 저장) 지원 여부를 확인해 커널을 고른다.
+ *   지원하지 않으면 FTransform/FQuat 의 스칼라 함수를 레인마다 호출하는 경로로 동작한다.
+ * - 출력 스트림은 입력 개수에 맞춰 크기가 조정된다. 출력이 입력과 같은 스트림이어도 된다.
+ * - 결과는 스칼라 함수와 부동소수 오차 범위 내에서 같다 (Slerp 는 다항식 근사, 최대 오차 ~1e-5).
+ */
+class FSoAMath
+{
+public:
+	// CPU 가 AVX2/FMA 경로를 지원하는지
+	static bool HasAVX2();
+
+	// 벤치마크/디버그용: false 면 지원하더라도 스칼라 경로 사용
+	static void SetUseSIMD(bool bEnable);
+	static bool IsUsingSIMD();
+	// SetUseSIMD 로 지정된 값 그대로 (AVX2 지원 여부와 무관). 토글 전후 복원용
+	static bool GetUseSIMD();
+
+	// Out[i] = Parent[i].GetWorldTransform(Child[i])
+	static void ComposeTransforms(const FTransformSoA& Parent, const FTransformSoA& Child, FTransformSoA& Out);
+
+	// Out[i] = FQuat::Slerp(A[i], B[i], Alpha)
+	static void SlerpQuats(const FQuatSoA& A, const FQuatSoA& B, float Alpha, FQuatSoA& Out);
+
+	// 최단 경로 선형 보간 후 정규화 (Slerp 보다 싸고 작은 각도에서는 거의 같음)
+	static void NlerpQuats(const FQuatSoA& A, const FQuatSoA& B, float Alpha, FQuatSoA& Out);
+	// 레인마다 비율이 다른 Nlerp: Out[i] = FQuat::Nlerp(A[i], B[i], Alphas[i])
+	static void NlerpQuats(const FQuatSoA& A, const FQuatSoA& B, const TArray<float>& Alphas, FQuatSoA& Out);
+
+	// Out[i] = FVector::Lerp(A[i], B[i], Alphas[i])
+	static void LerpVectors(const FVectorSoA& A, const FVectorSoA& B, const TArray<float>& Alphas, FVectorSoA& Out);
+
+	// Out[i] = Transforms[i].TransformPosition(Points[i])
+	static void TransformPoints(const FTransformSoA& Transforms, const FVectorSoA& Points, FVectorSoA& Out);
+
+	// Out[i] = Points[i] * M (affine 행렬 가정: w 나눗셈 없음)
+	static void TransformPoints(const FMatrix& M, const FVectorSoA& Points, FVectorSoA& Out);
+
+	// 로컬 AABB(LocalMin/LocalMax)를 각 레인의 트랜스폼으로 옮긴 월드 AABB (8꼭짓점을 감싸는 박스와 동일)
+	static void TransformAABBs(const FTransformSoA& Transforms, const FVectorSoA& LocalMin, const FVectorSoA& LocalMax,
+		FVectorSoA& OutMin, FVectorSoA& OutMax);
+
+	// 모든 AABB 를 같은 affine 행렬로 옮긴다
+	static void TransformAABBs(const FMatrix& M, const FVectorSoA& LocalMin, const FVectorSoA& LocalMax,
+		FVectorSoA& OutMin, FVectorSoA& OutMax);
+
+	// 스키닝 행렬: OutMatrices[i] = InverseBindPoses[i] * ComponentPoses[i].ToMatrix() (affine 3x4)
+	// OutNormalMatrices[i] 는 그 3x3 부분의 역전치 (이동 0). 4x4 역행렬 대신 여인수 / 행렬식으로 구한다
+	// 출력은 상수 버퍼 업로드와 CPU 스키닝에 바로 쓰는 AoS
+	static void BuildSkinningMatrices(const FMatrix3x4SoA& InverseBindPoses, const FTransformSoA& ComponentPoses,
+		TArray<FMatrix3x4>& OutMatrices, TArray<FMatrix3x4>& OutNormalMatrices);
+};
@@ -0,0 +1,154 @@
+﻿#include "pch.h"
+#include "FrameArena.h"
+#include <malloc.h>
+#include <algorithm>
+
+namespace
+{
+	inline SIZE_T AlignUp(SIZE_T Value, SIZE_T Alignment)
+	{
+		return (Value + Alignment - 1) & ~(Alignment - 1);
+	}
+}
+
+FFrameArena& FFrameArena::Get()
+{
+	static FFrameArena Instance;
+	return Instance;
+}
+
+FFrameArena::FFrameArena()
+{
+	for (FBuffer& Buffer : Buffers)
+	{
+		Buffer.Memory = static_cast<unsigned char*>(_aligned_malloc(DefaultCapacity, 64));
+		Buffer.Capacity = Buffer.Memory ? DefaultCapacity : 0;
+	}
+}
+
+FFrameArena::~FFrameArena()
+{
+	for (FBuffer& Buffer : Buffers)
+	{
+		ResetBuffer(Buffer);
+		_aligned_free(Buffer.Memory);
+		Buffer.Memory = nullptr;
+		Buffer.Capacity = 0;
+	}
+}
+
+void* FFrameArena::Allocate(SIZE_T Size, SIZE_T Alignment)
+{
+	if (Size == 0)
+	{
+		Size = 1;
+	}
+	Alignment = std::max<SIZE_T>(Alignment, alignof(std::max_align_t));
+
+	FBuffer& Buffer = Buffers[CurrentIndex.load(std::memory_order_acquire)];
+
+	// 정렬 때문에 앞쪽 패딩이 생길 수 있으므로 CAS 루프로 오프셋을 확보한다
+	SIZE_T Current = Buffer.Offset.load(std::memory_order_relaxed);
+	while (true)
+	{
+		const uintptr_t Base = reinterpret_cast<uintptr_t>(Buffer.Memory);
+		const SIZE_T Aligned = AlignUp(Base + Current, Alignment) - Base;
+		const SIZE_T NewOffset = Aligned + Size;
+		if (NewOffset > Buffer.Capacity)
+		{
+			break;
+		}
+		if (Buffer.Offset.compare_exchange_weak(Current, NewOffset, std::memory_order_relaxed))
+		{
+			return Buffer.Memory + Aligned;
+		}
+	}
+
+	// 버퍼가 모자람: 힙에서 받아 두고 리셋 때 해제
+	void* Ptr = _aligned_malloc(Size, Alignment);
+	if (Ptr)
+	{
+		std::lock_guard<std::mutex> Guard(Buffer.OverflowLock);
+		Buffer.OverflowBlocks.Add(Ptr);
+		Buffer.OverflowBytes += Size;
+	}
+	return Ptr;
+}
+
+void FFrameArena::Deallocate(void* Ptr, SIZE_T Size)
+{
+	if (!Ptr)
+	{
+		return;
+	}
+
+	FBuffer& Buffer = Buffers[CurrentIndex.load(std::memory_order_acquire)];
+	unsigned char* BytePtr = static_cast<unsigned char*>(Ptr);
+	if (BytePtr < Buffer.Memory || BytePtr >= Buffer.Memory + Buffer.Capacity)
+	{
+		return;
+	}
+
+	// 마지막 할당이었을 때만 되돌린다. 다른 스레드가 그 사이 할당했다면 CAS 실패로 그냥 둔다.
+	const SIZE_T Start = static_cast<SIZE_T>(BytePtr - Buffer.Memory);
+	SIZE_T Expected = Start + (Size == 0 ? 1 : Size);
+	Buffer.Offset.compare_exchange_strong(Expected, Start, std::memory_order_relaxed);
+}
+
+void FFrameArena::EndFrame()
+{
+	const uint32 FinishedIndex = CurrentIndex.load(std::memory_order_relaxed);
+	FBuffer& Finished = Buffers[FinishedIndex];
+
+	LastFrameUsedBytes = Finished.Offset.load(std::memory_order_relaxed) + Finished.OverflowBytes;
+	LastFrameOverflowCount = static_cast<uint32>(Finished.OverflowBlocks.Num());
+	PeakBytes = std::max(PeakBytes, LastFrameUsedBytes);
+
+	// 다음 버퍼는 두 프레임 전에 쓰던 버퍼이므로 안전하게 리셋할 수 있다
+	const uint32 NextIndex = FinishedIndex ^ 1u;
+	ResetBuffer(Buffers[NextIndex]);
+	CurrentIndex.store(NextIndex, std::memory_order_release);
+
+	++FrameIndex;
+}
+
+void FFrameArena::ResetBuffer(FBuffer& Buffer)
+{
+	std::lock_guard<std::mutex> Guard(Buffer.OverflowLock);
+
+	const bool bOverflowed = !Buffer.OverflowBlocks.IsEmpty();
+	const SIZE_T Required = Buffer.Offset.load(std::memory_order_relaxed) + Buffer.OverflowBytes;
+
+	for (void* Block : Buffer.OverflowBlocks)
+	{
+		_aligned_free(Block);
+	}
+	Buffer.OverflowBlocks.Empty();
+	Buffer.OverflowBytes = 0;
+
+	// 넘쳤던 버퍼는 다음 사용 전에 키운다 (1.5배 여유)
+	if (bOverflowed)
+	{
+		const SIZE_T NewCapacity = AlignUp(std::max(Buffer.Capacity * 2, Required + Required / 2), 64 * 1024);
+		unsigned char* NewMemory = static_cast<unsigned char*>(_aligned_malloc(NewCapacity, 64));
+		if (NewMemory)
+		{
+			_aligned_free(Buffer.Memory);
+			Buffer.Memory = NewMemory;
+			Buffer.Capacity = NewCapacity;
+		}
+	}
+
+	Buffer.Offset.store(0, std::memory_order_relaxed);
+}
+
+SIZE_T FFrameArena::GetUsedBytes() const
+{
+	const FBuffer& Buffer = Buffers[CurrentIndex.load(std::memory_order_acquire)];
+	return Buffer.Offset.load(std::memory_order_relaxed) + Buffer.OverflowBytes;
+}
+
+SIZE_T FFrameArena::GetCapacityBytes() const
+{
+	return Buffers[CurrentIndex.load(std::memory_order_acquire)].Capacity;
+}
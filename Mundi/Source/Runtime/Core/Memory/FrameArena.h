@@ -0,0 +1,104 @@
+﻿#pragma once
+#include <cstddef>
+#include <atomic>
+#include <mutex>
+#include "UEContainer.h"
+
+/**
+ * 프레임 단위 선형(bump) 할당기.
+ * - 버퍼 두 개를 번갈아 사용한다. EndFrame() 에서 다음 버퍼로 넘어가면서 그 버퍼를 통째로 리셋한다.
+ *   따라서 프레임 N 에서 받은 메모리는 프레임 N+1 이 끝날 때까지 유효하다.
+ * - 할당은 atomic 오프셋 증가 한 번이므로 여러 스레드에서 동시에 호출해도 안전하다.
+ * - 개별 해제는 없다. 버퍼가 모자라면 힙으로 넘치고(overflow) 다음 리셋 때 용량을 늘린다.
+ *
+ * 주의: 여기서 받은 메모리(및 TFrameArray)를 멤버로 저장해 다음 프레임 이후까지 들고 있으면 안 된다.
+ */
+class FFrameArena
+{
+public:
+	static FFrameArena& Get();
+
+	void* Allocate(SIZE_T Size, SIZE_T Alignment);
+
+	// 가장 최근 할당이면 오프셋을 되돌린다 (TArray 재할당 시 낭비 감소). 그 외에는 no-op.
+	void Deallocate(void* Ptr, SIZE_T Size);
+
+	// 프레임 끝에서 호출: 버퍼 교체 + 새 버퍼 리셋
+	void EndFrame();
+
+	// 통계
+	SIZE_T GetUsedBytes() const;
+	SIZE_T GetCapacityBytes() const;
+	SIZE_T GetLastFrameUsedBytes() const { return LastFrameUsedBytes; }
+	SIZE_T GetPeakBytes() const { return PeakBytes; }
+	uint32 GetLastFrameOverflowCount() const { return LastFrameOverflowCount; }
+	uint64 GetFrameIndex() const { return FrameIndex; }
+
+private:
+	FFrameArena();
+	~FFrameArena();
+	FFrameArena(const FFrameArena&) = delete;
+	FFrameArena& operator=(const FFrameArena&) = delete;
+
+	struct FBuffer
+	{
+		unsigned char* Memory = nullptr;
+		SIZE_T Capacity = 0;
+		std::atomic<SIZE_T> Offset{ 0 };
+
+		// 넘친 할당(힙) 목록. 리셋 때 해제한다.
+		std::mutex OverflowLock;
+		TArray<void*> OverflowBlocks;
+		SIZE_T OverflowBytes = 0;
+	};
+
+	void ResetBuffer(FBuffer& Buffer);
+
+	static constexpr SIZE_T DefaultCapacity = 4 * 1024 * 1024;
+
+	FBuffer Buffers[2];
+	std::atomic<uint32> CurrentIndex{ 0 };
+
+	SIZE_T LastFrameUsedBytes = 0;
+	SIZE_T PeakBytes = 0;
+	uint32 LastFrameOverflowCount = 0;
+	uint64 FrameIndex = 0;
+};
+
+/**
+ * FFrameArena 를 쓰는 STL 호환 할당자. TArray 의 할당자 정책으로 사용한다.
+ *   TArray<UMeshComponent*, TFrameAllocator<UMeshComponent*>> 또는 TFrameArray<UMeshComponent*>
+ */
+template<typename T>
+struct TFrameAllocator
+{
+	using value_type = T;
+
+	TFrameAllocator() noexcept = default;
+	template<typename U>
+	TFrameAllocator(const TFrameAllocator<U>&) noexcept {}
+
+	T* allocate(SIZE_T Count)
+	{
+		void* Ptr = FFrameArena::Get().Allocate(Count * sizeof(T), alignof(T));
+		if (!Ptr)
+		{
+			throw std::bad_alloc();
+		}
+		return static_cast<T*>(Ptr);
+	}
+
+	void deallocate(T* Ptr, SIZE_T Count) noexcept
+	{
+		FFrameArena::Get().Deallocate(Ptr, Count * sizeof(T));
+	}
+
+	template<typename U>
+	bool operator==(const TFrameAllocator<U>&) const noexcept { return true; }
+	template<typename U>
+	bool operator!=(const TFrameAllocator<U>&) const noexcept { return false; }
+};
+
+/** 이번 프레임 동안만 사용하는 임시 배열 */
+template<typename T>
+using TFrameArray = TArray<T, TFrameAllocator<T>>;
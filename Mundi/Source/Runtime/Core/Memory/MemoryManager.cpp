@@ -3,28 +3,315 @@
 #include <cstddef>
 #include <malloc.h>
 #include <algorithm>
+#include <mutex>
 
-uint32 FMemoryManager::TotalAllocationBytes = 0;
-uint32 FMemoryManager::TotalAllocationCount = 0;
+std::atomic<uint64> FMemoryManager::TotalAllocationBytes{ 0 };
+std::atomic<uint64> FMemoryManager::TotalAllocationCount{ 0 };
+
+namespace
+{
+	// 모든 블록 앞에 붙는 16바이트 헤더. 해제 시 어느 경로로 돌려보낼지 판단한다.
+	struct alignas(16) FAllocHeader
+	{
+		uint64 Size;        // 사용자가 요청한 크기
+		uint32 SizeClass;   // LargeSizeClass 이면 대형 블록
+		uint32 Padding;     // 대형 블록: Raw 시작부터 사용자 포인터까지 거리
+	};
+	static_assert(sizeof(FAllocHeader) == 16, "FAllocHeader must stay 16 bytes to keep pooled blocks 16-aligned");
+
+	constexpr uint32 LargeSizeClass = 0xFFFFFFFFu;
+	constexpr SIZE_T HeaderSize = sizeof(FAllocHeader);
+	constexpr SIZE_T SmallAlignment = 16;
+	constexpr SIZE_T PageSize = 64 * 1024;
+
+	constexpr uint32 SizeClassTable[FMemoryManager::NumSizeClasses] =
+	{
+		16, 32, 48, 64, 80, 96, 128, 160, 192, 256, 384, 512, 768, 1024
+	};
+
+	// (Size + 15) / 16 -> 사이즈 클래스 인덱스
+	struct FSizeClassLookup
+	{
+		uint8 Index[FMemoryManager::MaxSmallSize / 16 + 1] = {};
+
+		constexpr FSizeClassLookup()
+		{
+			uint32 Class = 0;
+			for (uint32 Slot = 0; Slot <= FMemoryManager::MaxSmallSize / 16; ++Slot)
+			{
+				while (SizeClassTable[Class] < Slot * 16)
+				{
+					++Class;
+				}
+				Index[Slot] = static_cast<uint8>(Class);
+			}
+		}
+	};
+	constexpr FSizeClassLookup SizeClassLookup;
+
+	struct FFreeBlock
+	{
+		FFreeBlock* Next;
+	};
+
+	inline SIZE_T GetBlockStride(uint32 SizeClass)
+	{
+		return HeaderSize + SizeClassTable[SizeClass];
+	}
+
+	// 스레드 캐시와 중앙 풀이 한 번에 주고받는 블록 수
+	inline uint32 GetBatchCount(uint32 SizeClass)
+	{
+		const SIZE_T Count = (16 * 1024) / GetBlockStride(SizeClass);
+		return static_cast<uint32>(std::clamp<SIZE_T>(Count, 8, 128));
+	}
+
+	// ── 통계 ───────────────────────────────────────────────
+	struct FSizeClassCounters
+	{
+		std::atomic<uint64> LiveCount{ 0 };
+		std::atomic<uint64> TotalAllocCount{ 0 };
+		std::atomic<uint64> ReservedBlockCount{ 0 };
+	};
+
+	FSizeClassCounters GSizeClassCounters[FMemoryManager::NumSizeClasses];
+	std::atomic<uint64> GTotalFreeCount{ 0 };
+	std::atomic<uint64> GTotalAllocCumulative{ 0 };
+	std::atomic<uint64> GSmallLiveBytes{ 0 };
+	std::atomic<uint64> GPoolReservedBytes{ 0 };
+	std::atomic<uint64> GLargeLiveBytes{ 0 };
+	std::atomic<uint64> GLargeLiveCount{ 0 };
+
+	// ── 중앙 풀 (사이즈 클래스별 잠금) ────────────────────────
+	struct FCentralPool
+	{
+		std::mutex Lock;
+		FFreeBlock* FreeList = nullptr;
+		uint32 FreeCount = 0;
+	};
+
+	FCentralPool GCentralPools[FMemoryManager::NumSizeClasses];
+
+	// 새 페이지를 받아 블록으로 잘라 중앙 풀에 넣는다. Lock 을 잡은 상태에서 호출.
+	bool GrowCentralPool(FCentralPool& Pool, uint32 SizeClass)
+	{
+		unsigned char* Page = static_cast<unsigned char*>(_aligned_malloc(PageSize, SmallAlignment));
+		if (!Page)
+		{
+			return false;
+		}
+
+		const SIZE_T Stride = GetBlockStride(SizeClass);
+		const SIZE_T BlockCount = PageSize / Stride;
+		for (SIZE_T i = 0; i < BlockCount; ++i)
+		{
+			FFreeBlock* Block = reinterpret_cast<FFreeBlock*>(Page + i * Stride);
+			Block->Next = Pool.FreeList;
+			Pool.FreeList = Block;
+		}
+		Pool.FreeCount += static_cast<uint32>(BlockCount);
+
+		GPoolReservedBytes.fetch_add(PageSize, std::memory_order_relaxed);
+		GSizeClassCounters[SizeClass].ReservedBlockCount.fetch_add(BlockCount, std::memory_order_relaxed);
+		return true;
+	}
+
+	// ── 스레드 캐시 ──────────────────────────────────────────
+	struct FThreadCacheBin
+	{
+		FFreeBlock* FreeList = nullptr;
+		uint32 Count = 0;
+	};
+
+	struct FThreadCache
+	{
+		FThreadCacheBin Bins[FMemoryManager::NumSizeClasses];
+
+		~FThreadCache();
+		void Flush();
+	};
+
+	// 스레드 종료(또는 프로세스 종료) 중 소멸된 캐시를 다시 쓰지 않도록 하는 플래그.
+	// trivially destructible 이라 FThreadCache 소멸 이후에도 안전하게 읽힌다.
+	thread_local bool GThreadCacheDead = false;
+	thread_local FThreadCache GThreadCache;
+
+	// 중앙 풀에서 Count 개를 떼어 Bin 에 채운다
+	bool RefillBin(FThreadCacheBin& Bin, uint32 SizeClass)
+	{
+		FCentralPool& Pool = GCentralPools[SizeClass];
+		const uint32 Batch = GetBatchCount(SizeClass);
+
+		std::lock_guard<std::mutex> Guard(Pool.Lock);
+		while (Pool.FreeCount < Batch)
+		{
+			if (!GrowCentralPool(Pool, SizeClass))
+			{
+				break;
+			}
+		}
+
+		uint32 Moved = 0;
+		while (Moved < Batch && Pool.FreeList)
+		{
+			FFreeBlock* Block = Pool.FreeList;
+			Pool.FreeList = Block->Next;
+			Block->Next = Bin.FreeList;
+			Bin.FreeList = Block;
+			++Moved;
+		}
+		Pool.FreeCount -= Moved;
+		Bin.Count += Moved;
+		return Moved > 0;
+	}
+
+	// Bin 에서 Count 개를 중앙 풀로 돌려보낸다
+	void ReleaseFromBin(FThreadCacheBin& Bin, uint32 SizeClass, uint32 Count)
+	{
+		if (Count == 0 || !Bin.FreeList)
+		{
+			return;
+		}
+
+		// 잠금 밖에서 반납할 체인을 먼저 끊어낸다
+		FFreeBlock* Head = Bin.FreeList;
+		FFreeBlock* Tail = Head;
+		uint32 Moved = 1;
+		while (Moved < Count && Tail->Next)
+		{
+			Tail = Tail->Next;
+			++Moved;
+		}
+		Bin.FreeList = Tail->Next;
+		Bin.Count -= Moved;
+
+		FCentralPool& Pool = GCentralPools[SizeClass];
+		std::lock_guard<std::mutex> Guard(Pool.Lock);
+		Tail->Next = Pool.FreeList;
+		Pool.FreeList = Head;
+		Pool.FreeCount += Moved;
+	}
+
+	void FThreadCache::Flush()
+	{
+		for (uint32 SizeClass = 0; SizeClass < FMemoryManager::NumSizeClasses; ++SizeClass)
+		{
+			ReleaseFromBin(Bins[SizeClass], SizeClass, Bins[SizeClass].Count);
+		}
+	}
+
+	FThreadCache::~FThreadCache()
+	{
+		Flush();
+		GThreadCacheDead = true;
+	}
+
+	void* AllocateSmall(uint32 SizeClass)
+	{
+		if (!GThreadCacheDead)
+		{
+			FThreadCacheBin& Bin = GThreadCache.Bins[SizeClass];
+			if (!Bin.FreeList && !RefillBin(Bin, SizeClass))
+			{
+				return nullptr;
+			}
+			FFreeBlock* Block = Bin.FreeList;
+			Bin.FreeList = Block->Next;
+			--Bin.Count;
+			return Block;
+		}
+
+		// 스레드 캐시가 이미 소멸된 경우 중앙 풀에서 직접 꺼낸다
+		FCentralPool& Pool = GCentralPools[SizeClass];
+		std::lock_guard<std::mutex> Guard(Pool.Lock);
+		if (!Pool.FreeList && !GrowCentralPool(Pool, SizeClass))
+		{
+			return nullptr;
+		}
+		FFreeBlock* Block = Pool.FreeList;
+		Pool.FreeList = Block->Next;
+		--Pool.FreeCount;
+		return Block;
+	}
+
+	void DeallocateSmall(void* Raw, uint32 SizeClass)
+	{
+		FFreeBlock* Block = static_cast<FFreeBlock*>(Raw);
+		if (!GThreadCacheDead)
+		{
+			FThreadCacheBin& Bin = GThreadCache.Bins[SizeClass];
+			Block->Next = Bin.FreeList;
+			Bin.FreeList = Block;
+			++Bin.Count;
+
+			// 다른 스레드가 할당한 블록을 이 스레드가 계속 해제하면 캐시가 무한히 커지므로 상한을 둔다
+			const uint32 Batch = GetBatchCount(SizeClass);
+			if (Bin.Count > Batch * 2)
+			{
+				ReleaseFromBin(Bin, SizeClass, Batch);
+			}
+			return;
+		}
+
+		FCentralPool& Pool = GCentralPools[SizeClass];
+		std::lock_guard<std::mutex> Guard(Pool.Lock);
+		Block->Next = Pool.FreeList;
+		Pool.FreeList = Block;
+		++Pool.FreeCount;
+	}
+}
 
 void* FMemoryManager::Allocate(SIZE_T Size, SIZE_T Alignment)
 {
-	SIZE_T TotalSize = Size + sizeof(SIZE_T);
-	SIZE_T FinalAlignment = std::max(Alignment, alignof(SIZE_T));
+	const SIZE_T FinalAlignment = std::max<SIZE_T>(Alignment, alignof(FAllocHeader));
+
+	void* UserPtr = nullptr;
+	if (Size <= MaxSmallSize && FinalAlignment <= SmallAlignment)
+	{
+		const uint32 SizeClass = SizeClassLookup.Index[(Size + 15) / 16];
+		unsigned char* Raw = static_cast<unsigned char*>(AllocateSmall(SizeClass));
+		if (!Raw)
+			return nullptr;
+
+		FAllocHeader* Header = reinterpret_cast<FAllocHeader*>(Raw);
+		Header->Size = Size;
+		Header->SizeClass = SizeClass;
+		Header->Padding = static_cast<uint32>(HeaderSize);
+		UserPtr = Raw + HeaderSize;
+
+		FSizeClassCounters& Counters = GSizeClassCounters[SizeClass];
+		Counters.LiveCount.fetch_add(1, std::memory_order_relaxed);
+		Counters.TotalAllocCount.fetch_add(1, std::memory_order_relaxed);
+		GSmallLiveBytes.fetch_add(Size, std::memory_order_relaxed);
+	}
+	else
+	{
+		// 헤더 뒤 사용자 포인터가 요청 정렬을 유지하도록 헤더 영역을 정렬 크기만큼 잡는다
+		const SIZE_T Padding = std::max(FinalAlignment, HeaderSize);
 
 #if defined(_MSC_VER) && defined(_DEBUG)
-	void* Raw = _aligned_malloc_dbg(TotalSize, FinalAlignment, nullptr, 0);
+		unsigned char* Raw = static_cast<unsigned char*>(_aligned_malloc_dbg(Size + Padding, FinalAlignment, nullptr, 0));
 #else
-	void* Raw = _aligned_malloc(TotalSize, FinalAlignment);
+		unsigned char* Raw = static_cast<unsigned char*>(_aligned_malloc(Size + Padding, FinalAlignment));
 #endif
-	if (!Raw)
-		return nullptr;
+		if (!Raw)
+			return nullptr;
 
-	*reinterpret_cast<SIZE_T*>(Raw) = Size;
-	TotalAllocationBytes += static_cast<uint32>(Size);
-	TotalAllocationCount++;
+		UserPtr = Raw + Padding;
+		FAllocHeader* Header = reinterpret_cast<FAllocHeader*>(static_cast<unsigned char*>(UserPtr) - HeaderSize);
+		Header->Size = Size;
+		Header->SizeClass = LargeSizeClass;
+		Header->Padding = static_cast<uint32>(Padding);
 
-	return static_cast<void*>(static_cast<unsigned char*>(Raw) + sizeof(SIZE_T));
+		GLargeLiveBytes.fetch_add(Size, std::memory_order_relaxed);
+		GLargeLiveCount.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	TotalAllocationBytes.fetch_add(Size, std::memory_order_relaxed);
+	TotalAllocationCount.fetch_add(1, std::memory_order_relaxed);
+	GTotalAllocCumulative.fetch_add(1, std::memory_order_relaxed);
+
+	return UserPtr;
 }
 
 void FMemoryManager::Deallocate(void* Ptr)
@@ -33,15 +320,92 @@ void FMemoryManager::Deallocate(void* Ptr)
 		return;
 
 	unsigned char* UserPtr = static_cast<unsigned char*>(Ptr);
-	unsigned char* Raw = UserPtr - sizeof(SIZE_T);
-	SIZE_T Size = *reinterpret_cast<SIZE_T*>(Raw);
+	const FAllocHeader* Header = reinterpret_cast<const FAllocHeader*>(UserPtr - HeaderSize);
+	const SIZE_T Size = static_cast<SIZE_T>(Header->Size);
+	const uint32 SizeClass = Header->SizeClass;
 
-	TotalAllocationBytes -= static_cast<uint32>(Size);
-	TotalAllocationCount--;
+	TotalAllocationBytes.fetch_sub(Size, std::memory_order_relaxed);
+	TotalAllocationCount.fetch_sub(1, std::memory_order_relaxed);
+	GTotalFreeCount.fetch_add(1, std::memory_order_relaxed);
+
+	if (SizeClass != LargeSizeClass)
+	{
+		GSizeClassCounters[SizeClass].LiveCount.fetch_sub(1, std::memory_order_relaxed);
+		GSmallLiveBytes.fetch_sub(Size, std::memory_order_relaxed);
+		DeallocateSmall(UserPtr - HeaderSize, SizeClass);
+		return;
+	}
 
+	GLargeLiveBytes.fetch_sub(Size, std::memory_order_relaxed);
+	GLargeLiveCount.fetch_sub(1, std::memory_order_relaxed);
+
+	unsigned char* Raw = UserPtr - Header->Padding;
 #if defined(_MSC_VER) && defined(_DEBUG)
 	_aligned_free_dbg(Raw);
 #else
 	_aligned_free(Raw);
 #endif
-}
\ No newline at end of file
+}
+
+FMemoryStats FMemoryManager::GetStats()
+{
+	FMemoryStats Stats;
+	Stats.LiveBytes = TotalAllocationBytes.load(std::memory_order_relaxed);
+	Stats.LiveCount = TotalAllocationCount.load(std::memory_order_relaxed);
+	Stats.TotalAllocCount = GTotalAllocCumulative.load(std::memory_order_relaxed);
+	Stats.TotalFreeCount = GTotalFreeCount.load(std::memory_order_relaxed);
+	Stats.SmallLiveBytes = GSmallLiveBytes.load(std::memory_order_relaxed);
+	Stats.PoolReservedBytes = GPoolReservedBytes.load(std::memory_order_relaxed);
+	Stats.LargeLiveBytes = GLargeLiveBytes.load(std::memory_order_relaxed);
+	Stats.LargeLiveCount = GLargeLiveCount.load(std::memory_order_relaxed);
+
+	Stats.SizeClasses.Reserve(NumSizeClasses);
+	for (uint32 SizeClass = 0; SizeClass < NumSizeClasses; ++SizeClass)
+	{
+		const FSizeClassCounters& Counters = GSizeClassCounters[SizeClass];
+
+		FMemorySizeClassStats ClassStats;
+		ClassStats.BlockSize = SizeClassTable[SizeClass];
+		ClassStats.LiveCount = Counters.LiveCount.load(std::memory_order_relaxed);
+		ClassStats.TotalAllocCount = Counters.TotalAllocCount.load(std::memory_order_relaxed);
+		ClassStats.ReservedBlockCount = Counters.ReservedBlockCount.load(std::memory_order_relaxed);
+		Stats.SizeClasses.Add(ClassStats);
+
+		Stats.PoolUsedBytes += ClassStats.LiveCount * GetBlockStride(SizeClass);
+	}
+
+	return Stats;
+}
+
+void FMemoryManager::DumpStats()
+{
+	const FMemoryStats Stats = GetStats();
+
+	UE_LOG("[Memory] Live: %.2f MB (%llu allocs), Cumulative: %llu allocs / %llu frees",
+		static_cast<double>(Stats.LiveBytes) / (1024.0 * 1024.0), Stats.LiveCount,
+		Stats.TotalAllocCount, Stats.TotalFreeCount);
+	UE_LOG("[Memory] Pool: reserved %.2f MB, used %.2f MB, fragmentation %.1f%%",
+		static_cast<double>(Stats.PoolReservedBytes) / (1024.0 * 1024.0),
+		static_cast<double>(Stats.PoolUsedBytes) / (1024.0 * 1024.0),
+		Stats.GetPoolFragmentation() * 100.0);
+	UE_LOG("[Memory] Large: %.2f MB (%llu allocs)",
+		static_cast<double>(Stats.LargeLiveBytes) / (1024.0 * 1024.0), Stats.LargeLiveCount);
+
+	for (const FMemorySizeClassStats& ClassStats : Stats.SizeClasses)
+	{
+		if (ClassStats.ReservedBlockCount == 0)
+		{
+			continue;
+		}
+		UE_LOG("  <= %4u B : live %8llu / reserved %8llu, total %10llu",
+			ClassStats.BlockSize, ClassStats.LiveCount, ClassStats.ReservedBlockCount, ClassStats.TotalAllocCount);
+	}
+}
+
+void FMemoryManager::FlushThreadCache()
+{
+	if (!GThreadCacheDead)
+	{
+		GThreadCache.Flush();
+	}
+}
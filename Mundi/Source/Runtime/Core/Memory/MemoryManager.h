@@ -1,7 +1,50 @@
 ﻿#pragma once
 #include <cstddef>
+#include <atomic>
 #include "UEContainer.h"
 
+// 사이즈 클래스 하나의 통계 (히스토그램 한 칸)
+struct FMemorySizeClassStats
+{
+	uint32 BlockSize = 0;          // 이 클래스가 담당하는 최대 요청 크기
+	uint64 LiveCount = 0;          // 현재 살아있는 블록 수
+	uint64 TotalAllocCount = 0;    // 누적 할당 횟수
+	uint64 ReservedBlockCount = 0; // 페이지로 확보된 전체 블록 수
+};
+
+// 런타임 조회용 메모리 통계 스냅샷
+struct FMemoryStats
+{
+	uint64 LiveBytes = 0;           // 사용자가 요청한 크기 기준 현재 사용량
+	uint64 LiveCount = 0;
+	uint64 TotalAllocCount = 0;     // 누적 할당/해제 횟수
+	uint64 TotalFreeCount = 0;
+
+	uint64 SmallLiveBytes = 0;      // 풀에서 나간 요청 크기 합
+	uint64 PoolReservedBytes = 0;   // 풀 페이지로 OS에서 받아온 바이트
+	uint64 PoolUsedBytes = 0;       // 풀 블록 크기 기준 사용량 (헤더 포함)
+
+	uint64 LargeLiveBytes = 0;      // 대형 블록 경로 사용량
+	uint64 LargeLiveCount = 0;
+
+	TArray<FMemorySizeClassStats> SizeClasses;
+
+	// 풀 내부 단편화 비율: 확보했지만 요청 크기로 쓰이지 않는 바이트 비율
+	double GetPoolFragmentation() const
+	{
+		return PoolReservedBytes > 0
+			? 1.0 - static_cast<double>(SmallLiveBytes) / static_cast<double>(PoolReservedBytes)
+			: 0.0;
+	}
+};
+
+/**
+ * UObject 전용 할당기.
+ * - 작은 블록(<= MaxSmallSize, 정렬 <= 16)은 사이즈 클래스별 풀에서 할당한다.
+ *   각 스레드는 thread_local 캐시를 갖고, 부족하거나 넘칠 때만 중앙 풀(잠금)과 배치 단위로 주고받는다.
+ * - 큰 블록이나 정렬 요구가 큰 블록은 _aligned_malloc 경로로 보낸다.
+ * - 모든 카운터는 64비트 atomic 이므로 로딩 스레드에서 할당해도 안전하다.
+ */
 class FMemoryManager
 {
 public:
@@ -9,7 +52,18 @@ public:
 	static void* Allocate(SIZE_T Size, SIZE_T Alignment);
 	static void  Deallocate(void* Ptr);
 
+	// 현재 통계 스냅샷 (히스토그램 포함)
+	static FMemoryStats GetStats();
+	// 콘솔에 사이즈 클래스별 히스토그램 출력
+	static void DumpStats();
+
+	// 현재 스레드 캐시를 중앙 풀로 반납 (워커 스레드 종료 전 호출 권장)
+	static void FlushThreadCache();
+
 public:
-	static uint32 TotalAllocationBytes;
-	static uint32 TotalAllocationCount;
-};
\ No newline at end of file
+	static constexpr SIZE_T MaxSmallSize = 1024;
+	static constexpr uint32 NumSizeClasses = 14;
+
+	static std::atomic<uint64> TotalAllocationBytes;
+	static std::atomic<uint64> TotalAllocationCount;
+};
@@ -0,0 +1,55 @@
+﻿#include "pch.h"
+#include "Benchmark.h"
+#include <cctype>
+
+namespace BenchmarkDetail
+{
+	volatile uint64 GSink = 0;
+}
+
+TArray<FBenchmarkEntry>& FBenchmarkRegistry::GetEntries()
+{
+	// 정적 초기화 순서 문제를 피하기 위해 함수 내 static 사용
+	static TArray<FBenchmarkEntry> GEntries;
+	return GEntries;
+}
+
+void FBenchmarkRegistry::Register(const char* Name, const char* Description, FBenchmarkFunc Func)
+{
+	GetEntries().Add({ Name, Description, Func });
+}
+
+const TArray<FBenchmarkEntry>& FBenchmarkRegistry::GetAll()
+{
+	return GetEntries();
+}
+
+bool FBenchmarkRegistry::Run(const char* Name)
+{
+	for (const FBenchmarkEntry& Entry : GetEntries())
+	{
+		const char* A = Entry.Name;
+		const char* B = Name;
+		while (*A && *B && std::toupper((unsigned char)*A) == std::toupper((unsigned char)*B))
+		{
+			++A;
+			++B;
+		}
+		if (*A == '\0' && *B == '\0')
+		{
+			UE_LOG("[Bench] %s - %s", Entry.Name, Entry.Description);
+			Entry.Func();
+			return true;
+		}
+	}
+	return false;
+}
+
+void FBenchmarkRegistry::LogList()
+{
+	UE_LOG("[Bench] Available benchmarks (BENCH <NAME>):");
+	for (const FBenchmarkEntry& Entry : GetEntries())
+	{
+		UE_LOG("  %s - %s", Entry.Name, Entry.Description);
+	}
+}
@@ -0,0 +1,70 @@
+﻿#pragma once
+#include "UEContainer.h"
+#include "PlatformTime.h"
+
+/**
+ * 엔진 내장 마이크로 벤치마크 레지스트리.
+ * 콘솔에서 "BENCH" 로 목록을, "BENCH <이름>" 으로 실행한다. 결과는 UE_LOG 로 출력된다.
+ *
+ *   IMPLEMENT_BENCHMARK(HASH, "TMap vs TFlatMap")
+ *   {
+ *       ...
+ *   }
+ */
+using FBenchmarkFunc = void(*)();
+
+struct FBenchmarkEntry
+{
+	const char* Name = nullptr;
+	const char* Description = nullptr;
+	FBenchmarkFunc Func = nullptr;
+};
+
+class FBenchmarkRegistry
+{
+public:
+	static void Register(const char* Name, const char* Description, FBenchmarkFunc Func);
+	static const TArray<FBenchmarkEntry>& GetAll();
+
+	// 이름(대소문자 무시)으로 실행. 없으면 false
+	static bool Run(const char* Name);
+	static void LogList();
+
+private:
+	static TArray<FBenchmarkEntry>& GetEntries();
+};
+
+struct FBenchmarkRegistrar
+{
+	FBenchmarkRegistrar(const char* Name, const char* Description, FBenchmarkFunc Func)
+	{
+		FBenchmarkRegistry::Register(Name, Description, Func);
+	}
+};
+
+// 최적화로 측정 대상 코드가 제거되지 않도록 결과를 흘려보내는 곳
+namespace BenchmarkDetail
+{
+	extern volatile uint64 GSink;
+}
+
+inline void BenchmarkKeep(uint64 Value)
+{
+	BenchmarkDetail::GSink = BenchmarkDetail::GSink + Value;
+}
+
+// 생성 시점부터 지난 시간 (벤치마크 구간 측정용)
+class FBenchTimer
+{
+public:
+	FBenchTimer() : Start(FPlatformTime::Cycles64()) {}
+	double GetMs() const { return FPlatformTime::ToMilliseconds(FPlatformTime::Cycles64() - Start); }
+
+private:
+	uint64 Start;
+};
+
+#define IMPLEMENT_BENCHMARK(Name, Description) \
+	static void Benchmark_##Name(); \
+	static FBenchmarkRegistrar GBenchmarkRegistrar_##Name(#Name, Description, &Benchmark_##Name); \
+	static void Benchmark_##Name()
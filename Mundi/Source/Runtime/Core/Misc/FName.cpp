@@ -1,62 +1,273 @@
 ﻿#include "pch.h"
 #include "Name.h"
+#include <atomic>
+#include <mutex>
 
+/**
+ * FNamePool 구현
+ * - 엔트리는 고정 크기 청크에 추가만 된다(append-only). 청크는 옮겨지지 않으므로 Get() 이 돌려준 참조는 영구히 유효하다.
+ * - 해시 테이블 슬롯은 (해시 상위 32비트 | 엔트리 인덱스 + 1) 을 담은 atomic<uint64> 하나다.
+ *   조회는 잠금 없이 슬롯을 acquire 로 읽고, 삽입만 뮤텍스로 직렬화한다.
+ * - 테이블을 키울 때는 새 테이블을 만들어 통째로 교체한다. 이전 테이블은 조회 중인 스레드가 있을 수 있으므로
+ *   해제하지 않고 보관한다 (크기가 기하급수로 커지므로 총량은 최종 테이블의 2배 이하).
+ * - 대소문자 무시 해시/비교를 원본 문자열 위에서 바로 계산하므로 조회 시 소문자 사본을 만들지 않는다.
+ */
 namespace
 {
-    // NameMap을 안전하게 가져오는 getter
-    static TMap<FString, uint32>& GetNameMap()
+    constexpr uint32 EntriesPerChunkShift = 12;
+    constexpr uint32 EntriesPerChunk = 1u << EntriesPerChunkShift; // 4096
+    constexpr uint32 MaxChunks = 1024;                               // 최대 약 4M 개 이름
+    constexpr uint32 InitialTableSize = 4096;
+
+    inline char ToLowerAscii(char C)
     {
-        // 함수 내의 static 변수는 처음 호출될 때 스레드에 안전하게
-        // 단 한 번만 초기화됩니다.
-        static TMap<FString, uint32> GNameMap;
-        return GNameMap;
+        return (C >= 'A' && C <= 'Z') ? static_cast<char>(C + ('a' - 'A')) : C;
     }
 
-    // Entries를 안전하게 가져오는 getter
-    static TArray<FNameEntry>& GetEntries()
+    // 대소문자 무시 FNV-1a (64비트)
+    inline uint64 HashNameNoCase(const char* Str, SIZE_T Len)
     {
-        static TArray<FNameEntry> GEntries;
-        return GEntries;
+        uint64 Hash = 14695981039346656037ull;
+        for (SIZE_T i = 0; i < Len; ++i)
+        {
+            Hash ^= static_cast<unsigned char>(ToLowerAscii(Str[i]));
+            Hash *= 1099511628211ull;
+        }
+        return Hash;
     }
 
-    // FString을 소문자로 변환하는 헬퍼 함수
-    static FString ToLower(const FString& InStr)
+    // Lower 는 이미 소문자
+    inline bool EqualsNoCase(const FString& Lower, const char* Str, SIZE_T Len)
+    {
+        if (Lower.size() != Len)
+        {
+            return false;
+        }
+        for (SIZE_T i = 0; i < Len; ++i)
+        {
+            if (Lower[i] != ToLowerAscii(Str[i]))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    struct FNameHashTable
+    {
+        explicit FNameHashTable(uint32 InSize)
+            : Size(InSize), Slots(new std::atomic<uint64>[InSize])
+        {
+            for (uint32 i = 0; i < Size; ++i)
+            {
+                Slots[i].store(0, std::memory_order_relaxed);
+            }
+        }
+
+        ~FNameHashTable()
+        {
+            delete[] Slots;
+        }
+
+        const uint32 Size; // 2의 거듭제곱
+        std::atomic<uint64>* Slots;
+    };
+
+    inline uint64 MakeSlot(uint64 Hash, uint32 Index)
     {
-        FString Result = InStr;
-        std::transform(Result.begin(), Result.end(), Result.begin(),
-            [](unsigned char c) { return std::tolower(c); });
-        return Result;
+        return (Hash & 0xFFFFFFFF00000000ull) | static_cast<uint64>(Index + 1);
     }
+
+    class FNamePoolImpl
+    {
+    public:
+        static FNamePoolImpl& Get()
+        {
+            // 함수 내의 static 변수는 처음 호출될 때 스레드에 안전하게
+            // 단 한 번만 초기화됩니다.
+            static FNamePoolImpl Instance;
+            return Instance;
+        }
+
+        uint32 Add(const char* Str, SIZE_T Len)
+        {
+            const uint64 Hash = HashNameNoCase(Str, Len);
+
+            // 1) 잠금 없는 조회: 대부분의 호출(이미 등록된 이름)은 여기서 끝난다
+            uint32 Found = Find(Table.load(std::memory_order_acquire), Hash, Str, Len);
+            if (Found != InvalidIndex)
+            {
+                return Found;
+            }
+
+            // 2) 삽입은 직렬화. 그 사이 다른 스레드가 넣었을 수 있으므로 다시 찾는다
+            std::lock_guard<std::mutex> Lock(WriteLock);
+            FNameHashTable* Current = Table.load(std::memory_order_relaxed);
+            Found = Find(Current, Hash, Str, Len);
+            if (Found != InvalidIndex)
+            {
+                return Found;
+            }
+
+            const uint32 NewIndex = NumEntries.load(std::memory_order_relaxed);
+            FNameEntry* Chunk = GetOrAllocateChunk(NewIndex >> EntriesPerChunkShift);
+            if (!Chunk)
+            {
+                return InvalidIndex;
+            }
+
+            FNameEntry& Entry = Chunk[NewIndex & (EntriesPerChunk - 1)];
+            Entry.Display.assign(Str, Len);
+            Entry.Comparison.resize(Len);
+            for (SIZE_T i = 0; i < Len; ++i)
+            {
+                Entry.Comparison[i] = ToLowerAscii(Str[i]);
+            }
+            // 엔트리 내용이 보인 다음에 개수/슬롯이 보여야 한다
+            NumEntries.store(NewIndex + 1, std::memory_order_release);
+
+            // 로드율 50% 를 넘으면 키운다
+            if ((NewIndex + 1) * 2 > Current->Size)
+            {
+                Current = Grow(Current);
+            }
+            InsertSlot(Current, MakeSlot(Hash, NewIndex), Hash);
+            return NewIndex;
+        }
+
+        const FNameEntry* GetEntry(uint32 Index) const
+        {
+            if (Index >= NumEntries.load(std::memory_order_acquire))
+            {
+                return nullptr;
+            }
+            const FNameEntry* Chunk = Chunks[Index >> EntriesPerChunkShift].load(std::memory_order_acquire);
+            return Chunk ? &Chunk[Index & (EntriesPerChunk - 1)] : nullptr;
+        }
+
+        uint32 Num() const
+        {
+            return NumEntries.load(std::memory_order_acquire);
+        }
+
+    private:
+        static constexpr uint32 InvalidIndex = 0xFFFFFFFFu;
+
+        FNamePoolImpl()
+        {
+            Table.store(new FNameHashTable(InitialTableSize), std::memory_order_release);
+            for (auto& Chunk : Chunks)
+            {
+                Chunk.store(nullptr, std::memory_order_relaxed);
+            }
+        }
+
+        // 프로그램 종료 시점까지 살아있어야 하므로 명시적으로 해제하지 않는다
+        // (정적 소멸 순서상 다른 전역 객체의 소멸자에서 FName 을 쓸 수 있음)
+        ~FNamePoolImpl() = default;
+
+        uint32 Find(const FNameHashTable* InTable, uint64 Hash, const char* Str, SIZE_T Len) const
+        {
+            const uint32 Mask = InTable->Size - 1;
+            const uint64 HashTag = Hash & 0xFFFFFFFF00000000ull;
+            uint32 SlotIndex = static_cast<uint32>(Hash) & Mask;
+            while (true)
+            {
+                const uint64 Slot = InTable->Slots[SlotIndex].load(std::memory_order_acquire);
+                if (Slot == 0)
+                {
+                    return InvalidIndex;
+                }
+                if ((Slot & 0xFFFFFFFF00000000ull) == HashTag)
+                {
+                    const uint32 Index = static_cast<uint32>(Slot) - 1;
+                    const FNameEntry* Entry = GetEntry(Index);
+                    if (Entry && EqualsNoCase(Entry->Comparison, Str, Len))
+                    {
+                        return Index;
+                    }
+                }
+                SlotIndex = (SlotIndex + 1) & Mask;
+            }
+        }
+
+        static void InsertSlot(FNameHashTable* InTable, uint64 Slot, uint64 Hash)
+        {
+            const uint32 Mask = InTable->Size - 1;
+            uint32 SlotIndex = static_cast<uint32>(Hash) & Mask;
+            while (InTable->Slots[SlotIndex].load(std::memory_order_relaxed) != 0)
+            {
+                SlotIndex = (SlotIndex + 1) & Mask;
+            }
+            InTable->Slots[SlotIndex].store(Slot, std::memory_order_release);
+        }
+
+        // WriteLock 안에서만 호출
+        FNameHashTable* Grow(FNameHashTable* Old)
+        {
+            FNameHashTable* NewTable = new FNameHashTable(Old->Size * 2);
+            const uint32 Count = NumEntries.load(std::memory_order_relaxed);
+            for (uint32 Index = 0; Index + 1 < Count; ++Index)
+            {
+                const FNameEntry* Entry = GetEntry(Index);
+                const uint64 Hash = HashNameNoCase(Entry->Comparison.data(), Entry->Comparison.size());
+                InsertSlot(NewTable, MakeSlot(Hash, Index), Hash);
+            }
+
+            // 아직 이전 테이블을 읽는 스레드가 있을 수 있으므로 보관만 한다
+            RetiredTables.Add(Old);
+            Table.store(NewTable, std::memory_order_release);
+            return NewTable;
+        }
+
+        // WriteLock 안에서만 호출
+        FNameEntry* GetOrAllocateChunk(uint32 ChunkIndex)
+        {
+            if (ChunkIndex >= MaxChunks)
+            {
+                return nullptr;
+            }
+            FNameEntry* Chunk = Chunks[ChunkIndex].load(std::memory_order_relaxed);
+            if (!Chunk)
+            {
+                Chunk = new FNameEntry[EntriesPerChunk];
+                Chunks[ChunkIndex].store(Chunk, std::memory_order_release);
+            }
+            return Chunk;
+        }
+
+        std::atomic<FNameHashTable*> Table{ nullptr };
+        std::atomic<FNameEntry*> Chunks[MaxChunks];
+        std::atomic<uint32> NumEntries{ 0 };
+
+        std::mutex WriteLock;
+        TArray<FNameHashTable*> RetiredTables;
+    };
 }
 
 uint32 FNamePool::Add(const FString& InStr)
 {
-    FString Lower = ToLower(InStr);
-
-    // 전역 변수 대신 getter를 통해 접근
-    TMap<FString, uint32>& NameMap = GetNameMap();
-    TArray<FNameEntry>& Entries = GetEntries();
-
-    auto it = NameMap.find(Lower);
-    if (it != NameMap.end())
-        return it->second;
+    return Add(InStr.c_str(), InStr.size());
+}
 
-    uint32 NewIndex = (uint32)Entries.size();
-    Entries.push_back({ InStr, Lower });
-    NameMap[Lower] = NewIndex;
-    return NewIndex;
+uint32 FNamePool::Add(const char* InStr, SIZE_T InLen)
+{
+    return FNamePoolImpl::Get().Add(InStr, InLen);
 }
 
 const FNameEntry& FNamePool::Get(uint32 Index)
 {
-    // 전역 변수 대신 getter를 통해 접근
-    TArray<FNameEntry>& Entries = GetEntries();
-
-    // (안전성 강화) 경계 검사 추가
-    if (Index >= Entries.size())
+    // (안전성 강화) 경계 검사
+    const FNameEntry* Entry = FNamePoolImpl::Get().GetEntry(Index);
+    if (!Entry)
     {
         static FNameEntry InvalidEntry = { "Invalid", "invalid" };
         return InvalidEntry;
     }
-    return Entries[Index];
-}
\ No newline at end of file
+    return *Entry;
+}
+
+uint32 FNamePool::Num()
+{
+    return FNamePoolImpl::Get().Num();
+}
@@ -0,0 +1,621 @@
+﻿#include "pch.h"
+#include "JobSystem.h"
+#include <chrono>
+
+struct FJob
+{
+	std::function<void()> Function;
+	FJobCounter* Counter = nullptr;
+	const char* Name = nullptr;
+};
+
+namespace
+{
+	// 0 = 메인 스레드, 1.. = 워커, -1 = 그 외
+	thread_local int32 GWorkerIndex = -1;
+	thread_local uint32 GStealSeed = 0x9E3779B9u;
+
+	// 워커 하나의 덱 크기. 넘치면 전역 큐로 간다
+	constexpr int64 QueueCapacity = 4096;
+	// 잠들기 전에 작업을 다시 찾아보는 횟수
+	constexpr int32 SpinCountBeforeSleep = 64;
+
+	uint64 NowNs()
+	{
+		return static_cast<uint64>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+			std::chrono::steady_clock::now().time_since_epoch()).count());
+	}
+
+	uint32 NextRandom()
+	{
+		// xorshift32
+		uint32 X = GStealSeed;
+		X ^= X << 13;
+		X ^= X >> 17;
+		X ^= X << 5;
+		GStealSeed = X;
+		return X;
+	}
+}
+
+/**
+ * Chase-Lev work-stealing 덱 (Le et al. 2013, 고정 크기).
+ * Push/Pop 은 소유 스레드만, Steal 은 아무 스레드나 호출할 수 있다.
+ */
+class FJobSystem::FWorkStealingQueue
+{
+public:
+	bool Push(FJob* Job)
+	{
+		const int64 B = Bottom.load(std::memory_order_relaxed);
+		const int64 T = Top.load(std::memory_order_acquire);
+		if (B - T >= QueueCapacity)
+		{
+			return false;
+		}
+		Buffer[B & (QueueCapacity - 1)].store(Job, std::memory_order_relaxed);
+		Bottom.store(B + 1, std::memory_order_release);
+		return true;
+	}
+
+	FJob* Pop()
+	{
+		const int64 B = Bottom.load(std::memory_order_relaxed) - 1;
+		Bottom.store(B, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		int64 T = Top.load(std::memory_order_relaxed);
+
+		if (T > B)
+		{
+			// 비어 있음
+			Bottom.store(B + 1, std::memory_order_relaxed);
+			return nullptr;
+		}
+
+		FJob* Job = Buffer[B & (QueueCapacity - 1)].load(std::memory_order_relaxed);
+		if (T == B)
+		{
+			// 마지막 하나는 도둑과 경쟁한다
+			if (!Top.compare_exchange_strong(T, T + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+			{
+				Job = nullptr;
+			}
+			Bottom.store(B + 1, std::memory_order_relaxed);
+		}
+		return Job;
+	}
+
+	FJob* Steal()
+	{
+		int64 T = Top.load(std::memory_order_acquire);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		const int64 B = Bottom.load(std::memory_order_acquire);
+		if (T >= B)
+		{
+			return nullptr;
+		}
+
+		FJob* Job = Buffer[T & (QueueCapacity - 1)].load(std::memory_order_relaxed);
+		if (!Top.compare_exchange_strong(T, T + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+		{
+			// 다른 스레드가 먼저 가져감
+			return nullptr;
+		}
+		return Job;
+	}
+
+	bool IsEmpty() const
+	{
+		return Top.load(std::memory_order_acquire) >= Bottom.load(std::memory_order_acquire);
+	}
+
+private:
+	alignas(64) std::atomic<int64> Top{ 0 };
+	alignas(64) std::atomic<int64> Bottom{ 0 };
+	alignas(64) std::atomic<FJob*> Buffer[QueueCapacity] = {};
+};
+
+struct FJobSystem::FWorkerState
+{
+	FWorkStealingQueue Queue;
+
+	alignas(64) std::atomic<uint64> JobsExecuted{ 0 };
+	std::atomic<uint64> JobsStolen{ 0 };
+	std::atomic<uint64> BusyNs{ 0 };
+};
+
+FJobSystem& FJobSystem::Get()
+{
+	static FJobSystem Instance;
+	return Instance;
+}
+
+FJobSystem::~FJobSystem()
+{
+	Shutdown();
+}
+
+void FJobSystem::Initialize(int32 NumWorkers)
+{
+	if (bRunning)
+	{
+		return;
+	}
+
+	if (NumWorkers < 0)
+	{
+		const int32 HardwareThreads = static_cast<int32>(std::thread::hardware_concurrency());
+		NumWorkers = std::max(0, HardwareThreads - 1);
+	}
+
+	GWorkerIndex = 0;
+	bStopping = false;
+	States.Empty();
+	for (int32 i = 0; i <= NumWorkers; ++i)
+	{
+		States.Emplace(std::make_unique<FWorkerState>());
+	}
+
+	bRunning = true;
+	Workers.reserve(NumWorkers);
+	for (int32 i = 1; i <= NumWorkers; ++i)
+	{
+		Workers.emplace_back([this, i]() { WorkerMain(i); });
+	}
+
+	UE_LOG("[JobSystem] Started %d worker threads", NumWorkers);
+}
+
+void FJobSystem::Shutdown()
+{
+	if (!bRunning)
+	{
+		return;
+	}
+
+	{
+		std::lock_guard<std::mutex> Lock(SleepLock);
+		bStopping = true;
+	}
+	SleepCondition.notify_all();
+
+	for (std::thread& Worker : Workers)
+	{
+		Worker.join();
+	}
+	Workers.clear();
+
+	// 남은 작업은 카운터를 기다리는 쪽이 있을 수 있으므로 여기서 마저 실행한다
+	bRunning = false;
+	for (bool bFound = true; bFound; )
+	{
+		bFound = false;
+		for (std::unique_ptr<FWorkerState>& State : States)
+		{
+			while (FJob* Job = State->Queue.Steal())
+			{
+				Execute(Job, 0, false);
+				bFound = true;
+			}
+		}
+
+		TArray<FJob*> Pending;
+		{
+			std::lock_guard<std::mutex> Lock(GlobalLock);
+			Pending = std::move(GlobalQueue);
+			GlobalQueue.Empty();
+			GlobalQueueNum = 0;
+		}
+		{
+			std::lock_guard<std::mutex> Lock(MainThreadLock);
+			for (FJob* Job : MainThreadQueue)
+			{
+				Pending.Add(Job);
+			}
+			MainThreadQueue.Empty();
+		}
+		for (FJob* Job : Pending)
+		{
+			Execute(Job, 0, false);
+			bFound = true;
+		}
+	}
+
+	States.Empty();
+	GWorkerIndex = -1;
+}
+
+int32 FJobSystem::GetCurrentWorkerIndex()
+{
+	return GWorkerIndex;
+}
+
+void FJobSystem::Run(std::function<void()> Function, FJobCounter* Counter, const char* Name)
+{
+	if (!bRunning)
+	{
+		Function();
+		return;
+	}
+
+	if (Counter)
+	{
+		Counter->Pending.fetch_add(1, std::memory_order_relaxed);
+	}
+	Schedule(new FJob{ std::move(Function), Counter, Name });
+}
+
+void FJobSystem::RunAfter(FJobCounter& Dependency, std::function<void()> Function, FJobCounter* Counter, const char* Name)
+{
+	if (Counter)
+	{
+		Counter->Pending.fetch_add(1, std::memory_order_relaxed);
+	}
+	FJob* Job = new FJob{ std::move(Function), Counter, Name };
+
+	{
+		// FinishCounter 의 마지막 감소와 같은 락 안에서 판단해야 후속 작업이 유실되지 않는다
+		std::lock_guard<std::mutex> Lock(Dependency.ContinuationLock);
+		if (Dependency.Pending.load(std::memory_order_acquire) != 0)
+		{
+			Dependency.Continuations.Add(Job);
+			return;
+		}
+	}
+
+	if (bRunning)
+	{
+		Schedule(Job);
+	}
+	else
+	{
+		Execute(Job, GWorkerIndex, false);
+	}
+}
+
+void FJobSystem::RunOnMainThread(std::function<void()> Function, FJobCounter* Counter, const char* Name)
+{
+	if (!bRunning)
+	{
+		Function();
+		return;
+	}
+
+	if (Counter)
+	{
+		Counter->Pending.fetch_add(1, std::memory_order_relaxed);
+	}
+	std::lock_guard<std::mutex> Lock(MainThreadLock);
+	MainThreadQueue.Add(new FJob{ std::move(Function), Counter, Name });
+}
+
+void FJobSystem::ProcessMainThreadJobs()
+{
+	TArray<FJob*> Jobs;
+	{
+		std::lock_guard<std::mutex> Lock(MainThreadLock);
+		if (MainThreadQueue.IsEmpty())
+		{
+			return;
+		}
+		Jobs = std::move(MainThreadQueue);
+		MainThreadQueue.Empty();
+	}
+
+	// 실행 중에 추가된 작업은 다음 호출에서 처리한다
+	for (FJob* Job : Jobs)
+	{
+		Execute(Job, 0, false);
+	}
+}
+
+void FJobSystem::Wait(FJobCounter& Counter)
+{
+	const int32 WorkerIndex = GWorkerIndex;
+	while (!Counter.IsDone())
+	{
+		if (WorkerIndex == 0)
+		{
+			FJob* MainJob = nullptr;
+			{
+				std::lock_guard<std::mutex> Lock(MainThreadLock);
+				if (!MainThreadQueue.IsEmpty())
+				{
+					MainJob = MainThreadQueue.Pop();
+				}
+			}
+			if (MainJob)
+			{
+				Execute(MainJob, 0, false);
+				continue;
+			}
+		}
+
+		if (bRunning && TryRunOneJob(WorkerIndex))
+		{
+			continue;
+		}
+		std::this_thread::yield();
+	}
+
+	// 마지막 감소를 한 스레드가 카운터 락을 놓을 때까지 기다린다 (반환 직후 카운터가 파괴될 수 있음)
+	std::lock_guard<std::mutex> Lock(Counter.ContinuationLock);
+}
+
+void FJobSystem::ParallelFor(int32 Num, int32 MinBatchSize, const std::function<void(int32 Begin, int32 End)>& Body, const char* Name)
+{
+	if (Num <= 0)
+	{
+		return;
+	}
+
+	MinBatchSize = std::max(1, MinBatchSize);
+	const int32 NumThreads = bRunning ? GetNumWorkers() + 1 : 1;
+	if (NumThreads == 1 || Num <= MinBatchSize)
+	{
+		Body(0, Num);
+		return;
+	}
+
+	// 스레드 수보다 잘게 나누어 먼저 끝난 스레드가 남은 구간을 가져가게 한다
+	const int32 NumBatches = std::min((Num + MinBatchSize - 1) / MinBatchSize, NumThreads * 4);
+	const int32 BatchSize = (Num + NumBatches - 1) / NumBatches;
+	std::atomic<int32> NextBatch{ 0 };
+
+	auto RunBatches = [&]()
+	{
+		for (;;)
+		{
+			const int32 Batch = NextBatch.fetch_add(1, std::memory_order_relaxed);
+			if (Batch >= NumBatches)
+			{
+				break;
+			}
+			const int32 Begin = Batch * BatchSize;
+			Body(Begin, std::min(Num, Begin + BatchSize));
+		}
+	};
+
+	FJobCounter Counter;
+	const int32 NumHelpers = std::min(NumThreads - 1, NumBatches - 1);
+	for (int32 i = 0; i < NumHelpers; ++i)
+	{
+		Run(RunBatches, &Counter, Name);
+	}
+	RunBatches();
+	Wait(Counter);
+}
+
+TArray<FJobWorkerStats> FJobSystem::GetStats() const
+{
+	TArray<FJobWorkerStats> Result;
+	Result.Reserve(States.Num());
+	for (const std::unique_ptr<FWorkerState>& State : States)
+	{
+		FJobWorkerStats Stats;
+		Stats.JobsExecuted = State->JobsExecuted.load(std::memory_order_relaxed);
+		Stats.JobsStolen = State->JobsStolen.load(std::memory_order_relaxed);
+		Stats.BusyNs = State->BusyNs.load(std::memory_order_relaxed);
+		Result.Add(Stats);
+	}
+	return Result;
+}
+
+void FJobSystem::ResetStats()
+{
+	for (std::unique_ptr<FWorkerState>& State : States)
+	{
+		State->JobsExecuted = 0;
+		State->JobsStolen = 0;
+		State->BusyNs = 0;
+	}
+}
+
+void FJobSystem::LogStats() const
+{
+	const TArray<FJobWorkerStats> Stats = GetStats();
+	for (int32 i = 0; i < Stats.Num(); ++i)
+	{
+		UE_LOG("[JobSystem] %s %2d: jobs %llu (stolen %llu), busy %.3fms",
+			i == 0 ? "main  " : "worker", i,
+			Stats[i].JobsExecuted, Stats[i].JobsStolen, static_cast<double>(Stats[i].BusyNs) / 1.0e6);
+	}
+}
+
+void FJobSystem::WorkerMain(int32 WorkerIndex)
+{
+	GWorkerIndex = WorkerIndex;
+	GStealSeed = 0x9E3779B9u * static_cast<uint32>(WorkerIndex + 1);
+
+	while (true)
+	{
+		// 작업을 찾기 전에 읽어 두어야, 찾는 사이에 들어온 작업의 알림을 놓치지 않는다
+		const uint64 Epoch = WorkEpoch.load(std::memory_order_seq_cst);
+
+		bool bFound = false;
+		for (int32 Spin = 0; Spin < SpinCountBeforeSleep && !bFound; ++Spin)
+		{
+			bFound = TryRunOneJob(WorkerIndex);
+			if (!bFound)
+			{
+				std::this_thread::yield();
+			}
+		}
+		if (bFound)
+		{
+			continue;
+		}
+
+		std::unique_lock<std::mutex> Lock(SleepLock);
+		if (bStopping)
+		{
+			break;
+		}
+		NumSleeping.fetch_add(1, std::memory_order_seq_cst);
+		SleepCondition.wait(Lock, [this, Epoch]()
+		{
+			return bStopping.load() || WorkEpoch.load(std::memory_order_seq_cst) != Epoch;
+		});
+		NumSleeping.fetch_sub(1, std::memory_order_seq_cst);
+		if (bStopping)
+		{
+			break;
+		}
+	}
+}
+
+void FJobSystem::Schedule(FJob* Job)
+{
+	const int32 WorkerIndex = GWorkerIndex;
+	if (WorkerIndex < 0 || WorkerIndex >= States.Num() || !States[WorkerIndex]->Queue.Push(Job))
+	{
+		std::lock_guard<std::mutex> Lock(GlobalLock);
+		GlobalQueue.Add(Job);
+		GlobalQueueNum.fetch_add(1, std::memory_order_release);
+	}
+	WakeWorkers();
+}
+
+FJob* FJobSystem::FindJob(int32 WorkerIndex, bool& bOutStolen)
+{
+	bOutStolen = false;
+
+	// 1) 자기 덱 (최근에 넣은 작업부터: 캐시에 남아있을 가능성이 높다)
+	if (WorkerIndex >= 0 && WorkerIndex < States.Num())
+	{
+		if (FJob* Job = States[WorkerIndex]->Queue.Pop())
+		{
+			return Job;
+		}
+	}
+
+	// 2) 전역 큐
+	if (GlobalQueueNum.load(std::memory_order_acquire) > 0)
+	{
+		std::lock_guard<std::mutex> Lock(GlobalLock);
+		if (!GlobalQueue.IsEmpty())
+		{
+			GlobalQueueNum.fetch_sub(1, std::memory_order_relaxed);
+			return GlobalQueue.Pop();
+		}
+	}
+
+	// 3) 다른 덱에서 훔치기. 시작 위치를 무작위로 해서 한 덱에 몰리지 않게 한다
+	const int32 NumStates = States.Num();
+	if (NumStates > 1)
+	{
+		const int32 Start = static_cast<int32>(NextRandom() % static_cast<uint32>(NumStates));
+		for (int32 i = 0; i < NumStates; ++i)
+		{
+			const int32 Victim = (Start + i) % NumStates;
+			if (Victim == WorkerIndex)
+			{
+				continue;
+			}
+			if (FJob* Job = States[Victim]->Queue.Steal())
+			{
+				bOutStolen = true;
+				return Job;
+			}
+		}
+	}
+	return nullptr;
+}
+
+bool FJobSystem::TryRunOneJob(int32 WorkerIndex)
+{
+	bool bStolen = false;
+	FJob* Job = FindJob(WorkerIndex, bStolen);
+	if (!Job)
+	{
+		return false;
+	}
+	Execute(Job, WorkerIndex, bStolen);
+	return true;
+}
+
+void FJobSystem::Execute(FJob* Job, int32 WorkerIndex, bool bStolen)
+{
+	const uint64 StartNs = NowNs();
+	Job->Function();
+	const uint64 EndNs = NowNs();
+
+	if (WorkerIndex >= 0 && WorkerIndex < States.Num())
+	{
+		FWorkerState& State = *States[WorkerIndex];
+		State.JobsExecuted.fetch_add(1, std::memory_order_relaxed);
+		State.BusyNs.fetch_add(EndNs - StartNs, std::memory_order_relaxed);
+		if (bStolen)
+		{
+			State.JobsStolen.fetch_add(1, std::memory_order_relaxed);
+		}
+	}
+
+	if (const FJobProfileHook Hook = ProfileHook.load(std::memory_order_acquire))
+	{
+		FJobProfileEvent Event;
+		Event.Name = Job->Name;
+		Event.WorkerIndex = WorkerIndex;
+		Event.StartNs = StartNs;
+		Event.EndNs = EndNs;
+		Event.bStolen = bStolen;
+		Hook(Event);
+	}
+
+	FJobCounter* Counter = Job->Counter;
+	delete Job;
+	FinishCounter(Counter);
+}
+
+void FJobSystem::FinishCounter(FJobCounter* Counter)
+{
+	if (!Counter)
+	{
+		return;
+	}
+
+	// 마지막이 아니면 락 없이 감소. 감소한 뒤에는 카운터를 건드리지 않는다
+	int32 Pending = Counter->Pending.load(std::memory_order_relaxed);
+	while (Pending > 1)
+	{
+		if (Counter->Pending.compare_exchange_weak(Pending, Pending - 1, std::memory_order_acq_rel, std::memory_order_relaxed))
+		{
+			return;
+		}
+	}
+
+	// 마지막 감소는 락 안에서 해야 Wait/RunAfter 와 엇갈리지 않는다
+	TArray<FJob*> Ready;
+	{
+		std::lock_guard<std::mutex> Lock(Counter->ContinuationLock);
+		if (Counter->Pending.fetch_sub(1, std::memory_order_acq_rel) == 1)
+		{
+			Ready = std::move(Counter->Continuations);
+			Counter->Continuations.Empty();
+		}
+	}
+
+	for (FJob* Job : Ready)
+	{
+		if (bRunning)
+		{
+			Schedule(Job);
+		}
+		else
+		{
+			Execute(Job, GWorkerIndex, false);
+		}
+	}
+}
+
+void FJobSystem::WakeWorkers()
+{
+	WorkEpoch.fetch_add(1, std::memory_order_seq_cst);
+	if (NumSleeping.load(std::memory_order_seq_cst) > 0)
+	{
+		{
+			std::lock_guard<std::mutex> Lock(SleepLock);
+		}
+		SleepCondition.notify_one();
+	}
+}
@@ -0,0 +1,146 @@
+﻿#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include "UEContainer.h"
+
+struct FJob;
+
+/**
+ * 작업(Job) 완료 카운터.
+ * - FJobSystem::Run 에 넘기면 실행 전 1 증가, 작업이 끝나면 1 감소한다.
+ * - FJobSystem::Wait 로 0 이 될 때까지 기다리거나, RunAfter 의 선행 조건으로 쓴다.
+ * - 0 이 되어 후속 작업이 예약되기 전에 다시 사용하면 안 된다 (Wait 이후 재사용).
+ */
+class FJobCounter
+{
+public:
+	FJobCounter() = default;
+	FJobCounter(const FJobCounter&) = delete;
+	FJobCounter& operator=(const FJobCounter&) = delete;
+
+	bool IsDone() const { return Pending.load(std::memory_order_acquire) == 0; }
+	int32 GetPending() const { return Pending.load(std::memory_order_acquire); }
+
+private:
+	friend class FJobSystem;
+
+	std::atomic<int32> Pending{ 0 };
+
+	// 이 카운터가 0 이 되면 예약할 작업 (RunAfter)
+	std::mutex ContinuationLock;
+	TArray<FJob*> Continuations;
+};
+
+// 작업 하나의 실행 기록. 프로파일 훅으로 전달된다 (시간은 steady_clock 나노초)
+struct FJobProfileEvent
+{
+	const char* Name = nullptr;
+	int32 WorkerIndex = -1;   // 0 = 메인 스레드, 1.. = 워커
+	uint64 StartNs = 0;
+	uint64 EndNs = 0;
+	bool bStolen = false;     // 다른 워커의 큐에서 훔쳐 온 작업
+};
+
+using FJobProfileHook = void(*)(const FJobProfileEvent& Event);
+
+// 워커별 누적 통계 (ResetStats 이후)
+struct FJobWorkerStats
+{
+	uint64 JobsExecuted = 0;
+	uint64 JobsStolen = 0;
+	uint64 BusyNs = 0;
+};
+
+/**
+ * 엔진 공용 작업 스케줄러.
+ * - 워커마다 Chase-Lev work-stealing 덱을 둔다. 자기 덱은 LIFO 로 꺼내고, 비면 다른 덱의 반대쪽에서 훔친다.
+ * - 메인 스레드도 덱을 하나 가지며(인덱스 0) Wait 중에는 다른 작업을 대신 실행한다.
+ * - RunOnMainThread 작업은 ProcessMainThreadJobs() (매 프레임) 또는 메인 스레드의 Wait 안에서만 실행된다.
+ * - Initialize 전이거나 워커가 0 개면 모든 작업은 호출한 스레드에서 바로 실행된다.
+ * - std::thread 만 사용하므로 플랫폼 의존성이 없다.
+ */
+class FJobSystem
+{
+public:
+	static FJobSystem& Get();
+
+	// NumWorkers < 0 이면 (하드웨어 스레드 수 - 1). 호출한 스레드가 메인 스레드가 된다
+	void Initialize(int32 NumWorkers = -1);
+	void Shutdown();
+
+	bool IsRunning() const { return bRunning; }
+	int32 GetNumWorkers() const { return static_cast<int32>(Workers.size()); }
+
+	// 작업 예약. Counter 가 있으면 완료 시 감소한다
+	void Run(std::function<void()> Function, FJobCounter* Counter = nullptr, const char* Name = nullptr);
+	// Dependency 가 0 이 된 뒤 실행
+	void RunAfter(FJobCounter& Dependency, std::function<void()> Function, FJobCounter* Counter = nullptr, const char* Name = nullptr);
+	// 메인 스레드 전용 작업 (D3D 컨텍스트, UObject 생성/삭제 등)
+	void RunOnMainThread(std::function<void()> Function, FJobCounter* Counter = nullptr, const char* Name = nullptr);
+
+	// 메인 루프에서 프레임마다 호출
+	void ProcessMainThreadJobs();
+
+	// Counter 가 0 이 될 때까지 다른 작업을 실행하며 기다린다
+	void Wait(FJobCounter& Counter);
+
+	/**
+	 * [0, Num) 을 MinBatchSize 이상의 구간으로 나누어 병렬 실행. Body(Begin, End) 는 구간 단위로 호출된다.
+	 * 호출한 스레드도 참여하고, 모든 구간이 끝난 뒤 반환한다.
+	 */
+	void ParallelFor(int32 Num, int32 MinBatchSize, const std::function<void(int32 Begin, int32 End)>& Body, const char* Name = nullptr);
+
+	// 0 = 메인 스레드, 1.. = 워커, -1 = 그 외 스레드
+	static int32 GetCurrentWorkerIndex();
+	static bool IsMainThread() { return GetCurrentWorkerIndex() == 0; }
+
+	// ── 프로파일링 ──
+	// 훅은 작업이 끝날 때마다 실행한 스레드에서 호출된다 (nullptr 로 해제)
+	void SetProfileHook(FJobProfileHook Hook) { ProfileHook.store(Hook, std::memory_order_release); }
+	// 인덱스 0 은 메인 스레드
+	TArray<FJobWorkerStats> GetStats() const;
+	void ResetStats();
+	void LogStats() const;
+
+private:
+	FJobSystem() = default;
+	~FJobSystem();
+	FJobSystem(const FJobSystem&) = delete;
+	FJobSystem& operator=(const FJobSystem&) = delete;
+
+	class FWorkStealingQueue;
+	struct FWorkerState;
+
+	void WorkerMain(int32 WorkerIndex);
+	void Schedule(FJob* Job);
+	FJob* FindJob(int32 WorkerIndex, bool& bOutStolen);
+	bool TryRunOneJob(int32 WorkerIndex);
+	void Execute(FJob* Job, int32 WorkerIndex, bool bStolen);
+	void FinishCounter(FJobCounter* Counter);
+	void WakeWorkers();
+
+	TArray<std::unique_ptr<FWorkerState>> States;   // 0 = 메인 스레드
+	std::vector<std::thread> Workers;
+
+	// 덱이 없는 스레드(메인/워커 외)가 넣은 작업, 덱이 가득 찼을 때의 넘침
+	std::mutex GlobalLock;
+	TArray<FJob*> GlobalQueue;
+	std::atomic<int32> GlobalQueueNum{ 0 };
+
+	std::mutex MainThreadLock;
+	TArray<FJob*> MainThreadQueue;
+
+	// 잠든 워커 깨우기. 작업을 넣을 때마다 WorkEpoch 가 증가한다
+	std::mutex SleepLock;
+	std::condition_variable SleepCondition;
+	std::atomic<uint64> WorkEpoch{ 0 };
+	std::atomic<int32> NumSleeping{ 0 };
+
+	std::atomic<FJobProfileHook> ProfileHook{ nullptr };
+	std::atomic<bool> bStopping{ false };
+	bool bRunning = false;
+};
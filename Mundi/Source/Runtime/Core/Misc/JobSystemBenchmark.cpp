@@ -0,0 +1,89 @@
+﻿#include "pch.h"
+#include "JobSystem.h"
+#include "Benchmark.h"
+
+namespace
+{
+	constexpr int32 NumElements = 1 << 22;
+	constexpr int32 NumEmptyJobs = 20000;
+
+	// 원소당 수십 사이클 정도의 연산 (스키닝/컬링 같은 배치 처리 흉내)
+	void Kernel(const float* In, float* Out, int32 Begin, int32 End)
+	{
+		for (int32 i = Begin; i < End; ++i)
+		{
+			const float X = In[i];
+			Out[i] = std::sqrt(X * X + 1.0f) * std::sin(X) + std::cos(X * 0.5f);
+		}
+	}
+}
+
+IMPLEMENT_BENCHMARK(JOBS, "Job system: serial vs ParallelFor on a 4M element kernel, per-job scheduling overhead, dependency chain")
+{
+	FJobSystem& Jobs = FJobSystem::Get();
+
+	TArray<float> In(NumElements);
+	TArray<float> Out(NumElements);
+	for (int32 i = 0; i < NumElements; ++i)
+	{
+		In[i] = static_cast<float>(i % 1000) * 0.01f;
+	}
+
+	double SerialMs = 0.0;
+	{
+		FBenchTimer Timer;
+		Kernel(In.data(), Out.data(), 0, NumElements);
+		SerialMs = Timer.GetMs();
+	}
+	BenchmarkKeep(static_cast<uint64>(Out[NumElements / 2] * 1000.0f));
+
+	Jobs.ResetStats();
+	double ParallelMs = 0.0;
+	{
+		FBenchTimer Timer;
+		Jobs.ParallelFor(NumElements, 16384, [&](int32 Begin, int32 End)
+		{
+			Kernel(In.data(), Out.data(), Begin, End);
+		}, "BenchKernel");
+		ParallelMs = Timer.GetMs();
+	}
+	BenchmarkKeep(static_cast<uint64>(Out[NumElements / 2] * 1000.0f));
+
+	// 빈 작업을 예약하고 모두 기다리는 데 드는 비용
+	double EmptyMs = 0.0;
+	{
+		std::atomic<int32> Sum{ 0 };
+		FJobCounter Counter;
+		FBenchTimer Timer;
+		for (int32 i = 0; i < NumEmptyJobs; ++i)
+		{
+			Jobs.Run([&Sum]() { Sum.fetch_add(1, std::memory_order_relaxed); }, &Counter, "BenchEmpty");
+		}
+		Jobs.Wait(Counter);
+		EmptyMs = Timer.GetMs();
+		BenchmarkKeep(static_cast<uint64>(Sum.load()));
+	}
+
+	// 선행 작업 1000 개 -> 후속 작업 하나의 의존성 해제 지연
+	double ChainMs = 0.0;
+	{
+		std::atomic<int32> Sum{ 0 };
+		FJobCounter Producers;
+		FJobCounter Consumer;
+		FBenchTimer Timer;
+		for (int32 i = 0; i < 1000; ++i)
+		{
+			Jobs.Run([&Sum]() { Sum.fetch_add(1, std::memory_order_relaxed); }, &Producers, "BenchProducer");
+		}
+		Jobs.RunAfter(Producers, [&Sum]() { Sum.fetch_add(1000, std::memory_order_relaxed); }, &Consumer, "BenchConsumer");
+		Jobs.Wait(Consumer);
+		ChainMs = Timer.GetMs();
+		BenchmarkKeep(static_cast<uint64>(Sum.load()));
+	}
+
+	UE_LOG("[Bench] Jobs (%d workers + main): kernel serial %.3fms | ParallelFor %.3fms  x%.2f",
+		Jobs.GetNumWorkers(), SerialMs, ParallelMs, ParallelMs > 0.0 ? SerialMs / ParallelMs : 0.0);
+	UE_LOG("[Bench] Jobs: %d empty jobs %.3fms (%.0fns/job) | 1000->1 dependency %.3fms",
+		NumEmptyJobs, EmptyMs, EmptyMs * 1.0e6 / NumEmptyJobs, ChainMs);
+	Jobs.LogStats();
+}
@@ -5,6 +5,7 @@
 #include <vector>
 #include <algorithm>
 #include <unordered_map>
+#include <cstring>
 #include"UEContainer.h"
 // ──────────────────────────────
 // FNameEntry & Pool
@@ -15,11 +16,15 @@ struct FNameEntry
     FString Comparison; // lower-case
 };
 
+// 스레드 안전: 조회는 잠금 없이, 새 이름 삽입만 내부 뮤텍스로 직렬화된다.
+// Get() 이 반환한 참조는 프로그램이 끝날 때까지 유효하다 (엔트리는 청크에 추가만 됨).
 class FNamePool
 {
 public:
     static uint32 Add(const FString& InStr);
+    static uint32 Add(const char* InStr, SIZE_T InLen);
     static const FNameEntry& Get(uint32 Index);
+    static uint32 Num();
 };
 
 // ──────────────────────────────
@@ -31,12 +36,12 @@ struct FName
     uint32 ComparisonIndex = -1;
 
     FName() = default;
-    FName(const char* InStr) { Init(FString(InStr)); }
-    FName(const FString& InStr) { Init(InStr); }
+    FName(const char* InStr) { Init(InStr, std::strlen(InStr)); }
+    FName(const FString& InStr) { Init(InStr.c_str(), InStr.size()); }
 
-    void Init(const FString& InStr)
+    void Init(const char* InStr, SIZE_T InLen)
     {
-        int32_t Index = FNamePool::Add(InStr);
+        int32_t Index = FNamePool::Add(InStr, InLen);
         DisplayIndex = Index;
         ComparisonIndex = Index; // 필요시 다른 규칙 적용 가능
     }
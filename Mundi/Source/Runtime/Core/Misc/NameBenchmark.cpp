@@ -0,0 +1,155 @@
+﻿#include "pch.h"
+#include "Benchmark.h"
+#include "PlatformTime.h"
+#include "Name.h"
+#include <thread>
+#include <mutex>
+#include <atomic>
+
+namespace
+{
+	// 비교용: 이전 FNamePool 방식 (소문자 사본 + TMap) 에 전역 뮤텍스를 씌운 구현
+	class FLegacyNamePool
+	{
+	public:
+		uint32 Add(const FString& InStr)
+		{
+			FString Lower = InStr;
+			std::transform(Lower.begin(), Lower.end(), Lower.begin(),
+				[](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+
+			std::lock_guard<std::mutex> Lock(Mutex);
+			auto It = NameMap.find(Lower);
+			if (It != NameMap.end())
+			{
+				return It->second;
+			}
+			const uint32 NewIndex = static_cast<uint32>(Entries.size());
+			Entries.push_back({ InStr, Lower });
+			NameMap[Lower] = NewIndex;
+			return NewIndex;
+		}
+
+	private:
+		std::mutex Mutex;
+		TMap<FString, uint32> NameMap;
+		TArray<FNameEntry> Entries;
+	};
+
+	// NumThreads 개 스레드가 동시에 Body(ThreadIndex) 를 실행하는 데 걸린 시간(ms)
+	template<typename FuncType>
+	double RunOnThreads(int32 NumThreads, FuncType Body)
+	{
+		std::atomic<int32> Ready{ 0 };
+		std::atomic<bool> bGo{ false };
+		TArray<std::thread> Threads;
+		Threads.Reserve(NumThreads);
+
+		for (int32 t = 0; t < NumThreads; ++t)
+		{
+			Threads.emplace_back([&, t]()
+			{
+				Ready.fetch_add(1);
+				while (!bGo.load(std::memory_order_acquire))
+				{
+					std::this_thread::yield();
+				}
+				Body(t);
+			});
+		}
+
+		while (Ready.load() < NumThreads)
+		{
+			std::this_thread::yield();
+		}
+
+		const uint64 Start = FPlatformTime::Cycles64();
+		bGo.store(true, std::memory_order_release);
+		for (std::thread& Thread : Threads)
+		{
+			Thread.join();
+		}
+		return FPlatformTime::ToMilliseconds(FPlatformTime::Cycles64() - Start);
+	}
+}
+
+IMPLEMENT_BENCHMARK(FNAME, "FName construction throughput from N threads (lock-free pool vs locked TMap)")
+{
+	// 본 트랙 이름처럼 대부분은 이미 등록된 이름을 다시 만드는 패턴 (대소문자 섞음)
+	constexpr int32 NumSharedNames = 2048;
+	constexpr int32 NamesPerThread = 200000;
+	constexpr int32 NewNameEvery = 16; // 1/16 은 스레드마다 새로운 이름
+
+	TArray<FString> SharedNames;
+	SharedNames.Reserve(NumSharedNames);
+	for (int32 i = 0; i < NumSharedNames; ++i)
+	{
+		SharedNames.Add((i % 2 ? "Bench_Bone_" : "BENCH_bone_") + std::to_string(i));
+	}
+	for (const FString& Name : SharedNames)
+	{
+		FName Warm(Name);
+		(void)Warm;
+	}
+
+	static int32 RunCounter = 0;
+	++RunCounter;
+
+	const uint32 HardwareThreads = std::max(1u, std::thread::hardware_concurrency());
+	for (int32 NumThreads = 1; NumThreads <= static_cast<int32>(HardwareThreads) && NumThreads <= 16; NumThreads *= 2)
+	{
+		// 실행마다 새 이름이 실제로 새 이름이 되도록 접두사를 바꾼다
+		const FString Prefix = "BenchNew_" + std::to_string(RunCounter) + "_" + std::to_string(NumThreads) + "_";
+
+		TArray<TArray<FString>> PerThreadNames(NumThreads);
+		for (int32 t = 0; t < NumThreads; ++t)
+		{
+			TArray<FString>& Names = PerThreadNames[t];
+			Names.Reserve(NamesPerThread);
+			for (int32 i = 0; i < NamesPerThread; ++i)
+			{
+				if (i % NewNameEvery == 0)
+				{
+					Names.Add(Prefix + std::to_string(t) + "_" + std::to_string(i));
+				}
+				else
+				{
+					Names.Add(SharedNames[(i * 7 + t * 131) % NumSharedNames]);
+				}
+			}
+		}
+
+		const double PoolMs = RunOnThreads(NumThreads, [&](int32 ThreadIndex)
+		{
+			uint64 Acc = 0;
+			for (const FString& Name : PerThreadNames[ThreadIndex])
+			{
+				Acc += FName(Name).ComparisonIndex;
+			}
+			BenchmarkKeep(Acc);
+		});
+
+		FLegacyNamePool Legacy;
+		for (const FString& Name : SharedNames)
+		{
+			Legacy.Add(Name);
+		}
+		const double LegacyMs = RunOnThreads(NumThreads, [&](int32 ThreadIndex)
+		{
+			uint64 Acc = 0;
+			for (const FString& Name : PerThreadNames[ThreadIndex])
+			{
+				Acc += Legacy.Add(Name);
+			}
+			BenchmarkKeep(Acc);
+		});
+
+		const double TotalOps = static_cast<double>(NumThreads) * NamesPerThread;
+		UE_LOG("[Bench] FName x%2d threads: pool %8.2fms (%6.2f Mops/s)  locked TMap %8.2fms (%6.2f Mops/s)  x%.2f",
+			NumThreads,
+			PoolMs, TotalOps / (PoolMs * 1000.0),
+			LegacyMs, TotalOps / (LegacyMs * 1000.0),
+			LegacyMs / PoolMs);
+	}
+	UE_LOG("[Bench] FName pool entries: %u", FNamePool::Num());
+}
@@ -1,12 +1,15 @@
 ﻿#pragma once
 
-#include "ObjectFactory.h"
+#include "Object.h"
 
+// TObject 와 그 하위 클래스 객체만 순회한다 (클래스별 객체 리스트를 따라감)
+// 순회 중 현재 객체를 삭제해도 안전하다 (다음 객체를 미리 잡아 둠)
 template<typename TObject>
 class TObjectIterator
 {
 public:
 	TObjectIterator()
+		: Classes(&TObject::StaticClass()->GetSelfAndDerivedClasses())
 	{
 		++(*this); // 첫 번째 유효 객체로 이동
 	}
@@ -14,16 +17,20 @@ public:
 	// 다음 객체로 이동
 	TObjectIterator& operator++()
 	{
-		++CurrentIndex;
-		AdvanceToNextValidObject();
+		Current = Next;
+		while (!Current && ++ClassIndex < Classes->Num())
+		{
+			Current = (*Classes)[ClassIndex]->FirstObject;
+		}
+		Next = Current ? Current->NextOfClass : nullptr;
 		return *this;
 	}
 
 	// 현재 객체에 접근
 	TObject* operator*() const
 	{
-		// 이 시점의 CurrentIndex는 유효한 TObject를 가리키고 있어야 함
-		return static_cast<TObject*>(GUObjectArray[CurrentIndex]);
+		// 클래스 리스트에서 꺼낸 객체이므로 항상 TObject 이다
+		return static_cast<TObject*>(Current);
 	}
 
 	// 현재 객체에 접근 (포인터 연산자)
@@ -35,34 +42,18 @@ public:
 	// 비교 연산자
 	bool operator!=(const TObjectIterator& Other) const
 	{
-		return CurrentIndex != Other.CurrentIndex;
+		return Current != Other.Current;
 	}
 
 	// bool 변환 연산자
 	explicit operator bool() const
 	{
-		// CurrentIndex가 배열 범위 내에 있는지 확인
-		return CurrentIndex < GUObjectArray.Num();
-	}
-
-private:
-	// 현재 인덱스부터 시작하여 다음 유효 객체를 찾는 헬퍼 함수
-	void AdvanceToNextValidObject()
-	{
-		while (CurrentIndex < GUObjectArray.Num())
-		{
-			UObject* Object = GUObjectArray[CurrentIndex];
-			// 현재 객체가 유효하고, TObject 타입이면 검색 종료
-			if (Object && Object->IsA<TObject>())
-			{
-				break;
-			}
-
-			// 다음 인덱스로 이동
-			++CurrentIndex;
-		}
+		return Current != nullptr;
 	}
 
 private:
-	int32 CurrentIndex = -1;
+	const TArray<UClass*>* Classes = nullptr;
+	int32 ClassIndex = -1;
+	UObject* Current = nullptr;
+	UObject* Next = nullptr;
 };
@@ -1,5 +1,64 @@
 ﻿#include "pch.h"
 
+namespace
+{
+    void AssignClassTreeRange(const UClass* Class, const TMap<const UClass*, TArray<const UClass*>>& Children, int32& Counter)
+    {
+        Class->ClassTreeIndex = Counter++;
+        auto It = Children.find(Class);
+        if (It != Children.end())
+        {
+            for (const UClass* Child : It->second)
+            {
+                AssignClassTreeRange(Child, Children, Counter);
+            }
+        }
+        Class->ClassTreeLast = Counter - 1;
+    }
+}
+
+void UClass::BuildClassTree()
+{
+    const TArray<UClass*>& Classes = GetAllClasses();
+
+    // UObject 처럼 등록되지 않는 조상도 Super 를 따라가며 포함한다
+    for (UClass* Class : Classes)
+    {
+        for (const UClass* C = Class; C; C = C->Super)
+        {
+            C->ClassTreeIndex = C->ClassTreeLast = -1;
+        }
+    }
+
+    TMap<const UClass*, TArray<const UClass*>> Children;
+    TArray<const UClass*> Roots;
+    for (UClass* Class : Classes)
+    {
+        // ClassTreeIndex == -2: 이미 수집됨
+        for (const UClass* C = Class; C && C->ClassTreeIndex == -1; C = C->Super)
+        {
+            C->ClassTreeIndex = -2;
+            if (C->Super)
+            {
+                Children[C->Super].Add(C);
+            }
+            else
+            {
+                Roots.Add(C);
+            }
+        }
+    }
+
+    // 상속 깊이만큼만 재귀한다
+    int32 Counter = 0;
+    for (const UClass* Root : Roots)
+    {
+        AssignClassTreeRange(Root, Children, Counter);
+    }
+
+    ClassTreeNum = Classes.Num();
+}
+
 FString UObject::GetName()
 {
     return ObjectName.ToString();
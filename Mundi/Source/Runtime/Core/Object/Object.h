@@ -1,6 +1,7 @@
 ﻿#pragma once
 #include "UEContainer.h"
 #include "ObjectFactory.h"
+#include "WeakObjectPtr.h"
 #include "MemoryManager.h"
 #include "Name.h"
 #include "Property.h"
@@ -27,27 +28,57 @@ struct UClass
     const char* DisplayName = nullptr;         // UI 표시 이름
     const char* Description = nullptr;         // 툴팁 설명
     mutable TArray<FProperty> CachedAllProperties;  // GetAllProperties() 캐시 (성능 최적화)
+    mutable TArray<UClass*> CachedDerivedClasses;   // GetSelfAndDerivedClasses() 캐시
+    mutable int32 CachedDerivedClassesVersion = -1; // 캐시 시점의 등록 클래스 수
     mutable bool bAllPropertiesCached = false;      // 캐시 유효성 플래그
 
+    // 정확히 이 클래스인 살아있는 객체들의 연결 리스트 (ObjectFactory 가 관리, 하위 클래스 객체는 제외)
+    UObject* FirstObject = nullptr;
+    UObject* LastObject = nullptr;
+    int32 NumObjects = 0;
+
     constexpr UClass() = default;
     constexpr UClass(const char* n, const UClass* s, SIZE_T z)
         :Name(n), Super(s), Size(z)
     {
     }
+    // 클래스 트리 DFS 전위 순번과 마지막 자손의 순번 (BuildClassTree 가 채움)
+    // Base 의 [ClassTreeIndex, ClassTreeLast] 구간 안에 있으면 Base 의 자손이다
+    mutable int32 ClassTreeIndex = -1;
+    mutable int32 ClassTreeLast = -1;
+
+    // 읽기 전용이라 잡 워커에서도 부를 수 있다 (Cast/IsA)
     bool IsChildOf(const UClass* Base) const noexcept
     {
         if (!Base) return false;
-        for (auto c = this; c; c = c->Super)
+        if (this == Base) return true;
+
+        assert(IsClassTreeBuilt() && "UClass::BuildClassTree must run at engine startup");
+        if (ClassTreeIndex >= 0 && Base->ClassTreeIndex >= 0)
+        {
+            return Base->ClassTreeIndex < ClassTreeIndex && ClassTreeIndex <= Base->ClassTreeLast;
+        }
+
+        // 트리에 없는 클래스 (등록되지 않았거나 트리를 만든 뒤에 처음 StaticClass 가 불린 UClass)
+        for (auto c = Super; c; c = c->Super)
             if (c == Base) return true;
         return false;
     }
 
+    // 등록된 클래스와 그 조상 전체에 DFS 구간을 매긴다.
+    // 정적 클래스 등록이 끝난 뒤 엔진 초기화(Startup)에서 워커를 띄우기 전에 한 번 부른다
+    static void BuildClassTree();
+    static bool IsClassTreeBuilt() { return ClassTreeNum >= 0; }
+
     static TArray<UClass*>& GetAllClasses()
     {
         static TArray<UClass*> AllClasses;
         return AllClasses;
     }
 
+    // 클래스 트리를 만들 때의 등록 클래스 수 (-1 = 아직 안 만듦)
+    inline static int32 ClassTreeNum = -1;
+
     static void SignUpClass(UClass* InClass)
     {
         if (InClass)
@@ -125,6 +156,26 @@ public:
         return CachedAllProperties;
     }
 
+    // 자신과 모든 하위 클래스 (TObjectIterator 용, 클래스 등록이 늘면 다시 계산)
+    const TArray<UClass*>& GetSelfAndDerivedClasses() const
+    {
+        const int32 NumClasses = GetAllClasses().Num();
+        if (CachedDerivedClassesVersion != NumClasses)
+        {
+            CachedDerivedClasses.clear();
+            CachedDerivedClasses.Add(const_cast<UClass*>(this));
+            for (UClass* Class : GetAllClasses())
+            {
+                if (Class && Class != this && Class->IsChildOf(this))
+                {
+                    CachedDerivedClasses.Add(Class);
+                }
+            }
+            CachedDerivedClassesVersion = NumClasses;
+        }
+        return CachedDerivedClasses;
+    }
+
     static TArray<UClass*> GetAllSpawnableActors()
     {
         TArray<UClass*> Result;
@@ -287,6 +338,10 @@ public:
 
     FName    ObjectName;   // 이 프로젝트에서는 고유하지 않는 라벨로 사용
 
+    // 같은 클래스 객체 리스트 링크 (ObjectFactory 가 관리, 복사 생성 후 새로 연결됨)
+    UObject* PrevOfClass = nullptr;
+    UObject* NextOfClass = nullptr;
+
     // 정적: 타입 메타 반환 (이름을 StaticClass로!)
     static UClass* StaticClass()
     {
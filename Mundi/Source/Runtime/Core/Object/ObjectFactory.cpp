@@ -1,7 +1,102 @@
 ﻿#include "pch.h"
 #include "ObjectFactory.h"
+#include "FlatHashMap.h"
 // 전역 오브젝트 배열 정의 (한 번만!)
 TArray<UObject*> GUObjectArray;
+TArray<uint32> GUObjectSerialNumbers;
+
+namespace
+{
+    // 비어 있는 슬롯 (LIFO). 슬롯 0 은 "없음"(피킹 ID 0 등)으로 쓰이므로 예약하고 재사용하지 않는다
+    TArray<int32> GUObjectFreeSlots;
+    // DeleteObject 가 포인터를 역참조하지 않고 관리 대상인지 확인하기 위한 역색인
+    TFlatMap<const UObject*, int32> GUObjectIndexMap;
+
+    uint32 NextSerialNumber(uint32 Serial)
+    {
+        // 0 은 무효 핸들용
+        return (Serial + 1 == 0) ? 1 : Serial + 1;
+    }
+
+    int32 AllocateObjectSlot(UObject* Obj)
+    {
+        if (GUObjectArray.IsEmpty())
+        {
+            GUObjectArray.Add(nullptr);
+            if (GUObjectSerialNumbers.IsEmpty())
+            {
+                GUObjectSerialNumbers.Add(1);
+            }
+        }
+
+        int32 Index;
+        if (!GUObjectFreeSlots.IsEmpty())
+        {
+            Index = GUObjectFreeSlots.Pop();
+            GUObjectArray[Index] = Obj;
+        }
+        else
+        {
+            Index = GUObjectArray.Add(Obj);
+            // 잘려 나갔던 슬롯이면 이전 세대 번호를 이어서 쓴다 (세대 배열은 줄이지 않음)
+            if (Index >= GUObjectSerialNumbers.Num())
+            {
+                GUObjectSerialNumbers.Add(1);
+            }
+        }
+        GUObjectIndexMap.Add(Obj, Index);
+        return Index;
+    }
+
+    void FreeObjectSlot(int32 Index)
+    {
+        GUObjectIndexMap.Remove(GUObjectArray[Index]);
+        GUObjectArray[Index] = nullptr;
+        GUObjectSerialNumbers[Index] = NextSerialNumber(GUObjectSerialNumbers[Index]);
+        GUObjectFreeSlots.Add(Index);
+    }
+
+    // 정확히 그 클래스인 객체들의 이중 연결 리스트. TObjectIterator 가 타입별로 순회할 때 사용
+    void LinkToClassList(UObject* Obj)
+    {
+        UClass* Class = Obj->GetClass();
+        Obj->PrevOfClass = Class->LastObject;
+        Obj->NextOfClass = nullptr;
+        if (Class->LastObject)
+        {
+            Class->LastObject->NextOfClass = Obj;
+        }
+        else
+        {
+            Class->FirstObject = Obj;
+        }
+        Class->LastObject = Obj;
+        ++Class->NumObjects;
+    }
+
+    void UnlinkFromClassList(UObject* Obj)
+    {
+        UClass* Class = Obj->GetClass();
+        if (Obj->PrevOfClass)
+        {
+            Obj->PrevOfClass->NextOfClass = Obj->NextOfClass;
+        }
+        else
+        {
+            Class->FirstObject = Obj->NextOfClass;
+        }
+        if (Obj->NextOfClass)
+        {
+            Obj->NextOfClass->PrevOfClass = Obj->PrevOfClass;
+        }
+        else
+        {
+            Class->LastObject = Obj->PrevOfClass;
+        }
+        --Class->NumObjects;
+        Obj->PrevOfClass = Obj->NextOfClass = nullptr;
+    }
+}
 
 namespace ObjectFactory
 {
@@ -29,26 +124,10 @@ namespace ObjectFactory
         UObject* Obj = ConstructObject(Class);
         if (!Obj) return nullptr;
 
-        int32 idx = -1;
-
-        // TODO(SlotReuse): Null slot reuse optimization for memory efficiency
-        // Currently always appends to end (memory grows continuously).
-        // To enable null slot reuse:
-        // 1. Uncomment the loop below to search for nullptr slots first
-        // 2. Uncomment UUID validation in LuaObjectProxy.cpp IsValidUObject()
-        //
-        // for (int32 i = 0; i < GUObjectArray.Num(); ++i) {
-        //     if (GUObjectArray[i] == nullptr) {
-        //         idx = i;
-        //         GUObjectArray[i] = Obj;
-        //         break;
-        //     }
-        // }
-        // if (idx == -1) {
-            idx = GUObjectArray.Add(Obj);
-        // }
-
+        // 빈 슬롯을 O(1)로 재사용. 이전 점유자를 가리키던 약한 참조는 세대 번호로 걸러진다
+        const int32 idx = AllocateObjectSlot(Obj);
         Obj->InternalIndex = static_cast<uint32>(idx);
+        LinkToClassList(Obj);
 
         static TMap<UClass*, int> NameCounters;
         int Count = ++NameCounters[Class];
@@ -69,25 +148,10 @@ namespace ObjectFactory
     {
         if (!Obj) return nullptr;
 
-        int32 idx = -1;
-
-        // TODO(SlotReuse): Same as NewObject() - null slot reuse optimization
-        // To enable:
-        // 1. Uncomment the search loop below
-        // 2. Uncomment UUID validation in LuaObjectProxy.cpp IsValidUObject()
-        //
-        // for (int32 i = 0; i < GUObjectArray.Num(); ++i) {
-        //     if (GUObjectArray[i] == nullptr) {
-        //         idx = i;
-        //         GUObjectArray[i] = Obj;
-        //         break;
-        //     }
-        // }
-        // if (idx == -1) {
-            idx = GUObjectArray.Add(Obj);
-        // }
-
+        // 복사 생성된 객체는 원본의 인덱스/리스트 링크를 그대로 갖고 있으므로 새로 발급
+        const int32 idx = AllocateObjectSlot(Obj);
         Obj->InternalIndex = static_cast<uint32>(idx);
+        LinkToClassList(Obj);
 
         static TMap<UClass*, int> NameCounters;
         int Count = ++NameCounters[Class];
@@ -109,24 +173,17 @@ namespace ObjectFactory
     {
         if (!Obj) return;
 
-        // Important: DO NOT dereference Obj fields before verifying it is still in GUObjectArray.
-        int32 foundIndex = -1;
-        for (int32 i = 0; i < GUObjectArray.Num(); ++i)
-        {
-            if (GUObjectArray[i] == Obj)
-            {
-                foundIndex = i;
-                break;
-            }
-        }
-        if (foundIndex < 0)
+        // Important: DO NOT dereference Obj fields before verifying it is still managed.
+        int32* Found = GUObjectIndexMap.Find(Obj);
+        if (!Found)
         {
             // Not managed or already deleted.
             return;
         }
 
-        GUObjectArray[foundIndex] = nullptr;
-        // Safe to delete now; Obj still valid since we found it in GUObjectArray
+        FreeObjectSlot(*Found);
+        UnlinkFromClassList(Obj);
+        // Safe to delete now; Obj still valid since it was in the index map
         Obj->DestroyInternal();
     }
 
@@ -140,28 +197,58 @@ namespace ObjectFactory
                 DeleteObject(Obj);
             }
         }
+        // 세대 번호는 남겨 두어 종료 전 발급된 약한 참조가 새 객체를 가리키지 않게 한다
         GUObjectArray.Empty();
         GUObjectArray.Shrink();
+        GUObjectFreeSlots.Empty();
+        GUObjectIndexMap.Empty();
     }
 
-    // (선택) null 슬롯 압축
     void CompactNullSlots()
     {
-        int32 write = 0;
-        for (int32 read = 0; read < GUObjectArray.Num(); ++read)
+        // 인덱스가 약한 참조/피킹 ID 로 쓰이므로 객체를 옮기지 않고 끝의 빈 슬롯만 잘라낸다
+        int32 NewNum = GUObjectArray.Num();
+        while (NewNum > 1 && GUObjectArray[NewNum - 1] == nullptr)
         {
-            if (UObject* Obj = GUObjectArray[read])
-            {
-                if (write != read)
-                {
-                    GUObjectArray[write] = Obj;
-                    Obj->InternalIndex = static_cast<uint32>(write);
-                    GUObjectArray[read] = nullptr;
-                }
-                ++write;
-            }
+            --NewNum;
         }
-        // 크기(Num) 축소 + 불필요한 capacity도 반환
-        GUObjectArray.SetNum(write);
+        if (NewNum == GUObjectArray.Num())
+        {
+            return;
+        }
+
+        // 세대 번호 배열은 그대로 두므로 잘린 슬롯이 다시 쓰일 때도 이전 핸들은 무효로 남는다
+        GUObjectArray.SetNum(NewNum);
+        GUObjectArray.Shrink();
+        GUObjectFreeSlots.erase(std::remove_if(GUObjectFreeSlots.begin(), GUObjectFreeSlots.end(),
+            [NewNum](int32 Index) { return Index >= NewNum; }), GUObjectFreeSlots.end());
+    }
+
+    UObject* ResolveObjectHandle(uint32 Index, uint32 SerialNumber)
+    {
+        if (SerialNumber == 0 || Index >= static_cast<uint32>(GUObjectArray.Num()))
+        {
+            return nullptr;
+        }
+        return GUObjectSerialNumbers[Index] == SerialNumber ? GUObjectArray[Index] : nullptr;
+    }
+
+    bool IsLiveObject(const UObject* Obj)
+    {
+        return Obj && GUObjectIndexMap.Find(Obj) != nullptr;
+    }
+
+    uint32 GetObjectSerialNumber(uint32 Index)
+    {
+        if (Index >= static_cast<uint32>(GUObjectArray.Num()) || !GUObjectArray[Index])
+        {
+            return 0;
+        }
+        return GUObjectSerialNumbers[Index];
+    }
+
+    int32 GetNumLiveObjects()
+    {
+        return GUObjectIndexMap.Num();
     }
 }
@@ -6,6 +6,8 @@
 class UObject;
 struct UClass;
 extern TArray<UObject*> GUObjectArray;
+// 슬롯별 세대 번호. 슬롯이 비워질 때마다 증가하므로 (인덱스, 세대) 쌍이 객체 하나를 유일하게 가리킨다
+extern TArray<uint32> GUObjectSerialNumbers;
 
 // ── ObjectFactory 네임스페이스 ─────────────────────────────
 namespace ObjectFactory
@@ -46,8 +48,17 @@ namespace ObjectFactory
     void DeleteObject(UObject* Obj);
     // 종료시 일괄 정리
     void DeleteAll(bool bCallBeginDestroy = true);
-    // Null 슬롯 압축하여 배열 크기 축소
+    // 배열 끝의 빈 슬롯을 잘라 크기 축소 (살아있는 객체의 인덱스는 바뀌지 않음)
     void CompactNullSlots();
+
+    // (인덱스, 세대)로 객체 조회. 삭제되었거나 슬롯이 재사용되었으면 nullptr (객체를 역참조하지 않음)
+    UObject* ResolveObjectHandle(uint32 Index, uint32 SerialNumber);
+    // 포인터가 아직 관리 중인 객체인지 (객체를 역참조하지 않음)
+    bool IsLiveObject(const UObject* Obj);
+    // 현재 슬롯의 세대 번호 (범위 밖이면 0 = 무효)
+    uint32 GetObjectSerialNumber(uint32 Index);
+    // 살아있는 객체 수 (GUObjectArray.Num() 은 빈 슬롯 포함)
+    int32 GetNumLiveObjects();
 }
 
 // ── 등록 매크로 ─────────────────────────────────────────────
@@ -0,0 +1,106 @@
+﻿#include "pch.h"
+#include "ObjectIterator.h"
+#include "SceneComponent.h"
+#include "MovementComponent.h"
+#include "RotatingMovementComponent.h"
+#include "Benchmark.h"
+
+namespace
+{
+	// 대부분은 씬 컴포넌트, 찾는 타입은 1% 만 섞는다 (에디터/스크립트의 타입별 검색 상황)
+	constexpr int32 RareEvery = 100;
+	constexpr int32 NumChurn = 100000;
+	constexpr int32 NumIterations = 20;
+}
+
+IMPLEMENT_BENCHMARK(OBJECTS, "UObject registry: create/delete churn, TObjectIterator vs full GUObjectArray scan, weak pointer resolve")
+{
+	for (int32 NumObjects : { 10000, 100000 })
+	{
+		TArray<UObject*> Objects;
+		Objects.Reserve(NumObjects);
+		for (int32 i = 0; i < NumObjects; ++i)
+		{
+			if (i % RareEvery == 0)
+			{
+				Objects.Add(NewObject<URotatingMovementComponent>());
+			}
+			else
+			{
+				Objects.Add(NewObject<USceneComponent>());
+			}
+		}
+
+		// 무작위 위치 삭제 + 생성 반복. 빈 슬롯 재사용과 역색인 삭제 경로를 측정한다
+		double ChurnMs = 0.0;
+		{
+			uint32 Seed = 12345;
+			FBenchTimer Timer;
+			for (int32 i = 0; i < NumChurn; ++i)
+			{
+				Seed = Seed * 1664525u + 1013904223u;
+				const int32 Victim = static_cast<int32>(Seed % static_cast<uint32>(Objects.Num()));
+				ObjectFactory::DeleteObject(Objects[Victim]);
+				Objects[Victim] = NewObject<USceneComponent>();
+			}
+			ChurnMs = Timer.GetMs();
+		}
+
+		uint64 Acc = 0;
+		double ScanMs = 0.0;
+		{
+			FBenchTimer Timer;
+			for (int32 Iter = 0; Iter < NumIterations; ++Iter)
+			{
+				for (UObject* Obj : GUObjectArray)
+				{
+					if (Obj && Obj->IsA<UMovementComponent>())
+					{
+						Acc += Obj->InternalIndex;
+					}
+				}
+			}
+			ScanMs = Timer.GetMs() / NumIterations;
+		}
+
+		double IteratorMs = 0.0;
+		{
+			FBenchTimer Timer;
+			for (int32 Iter = 0; Iter < NumIterations; ++Iter)
+			{
+				for (TObjectIterator<UMovementComponent> It; It; ++It)
+				{
+					Acc += It->InternalIndex;
+				}
+			}
+			IteratorMs = Timer.GetMs() / NumIterations;
+		}
+
+		double ResolveMs = 0.0;
+		{
+			TArray<TWeakObjectPtr<UObject>> Handles;
+			Handles.Reserve(Objects.Num());
+			for (UObject* Obj : Objects)
+			{
+				Handles.Add(TWeakObjectPtr<UObject>(Obj));
+			}
+
+			FBenchTimer Timer;
+			for (const TWeakObjectPtr<UObject>& Handle : Handles)
+			{
+				Acc += Handle.IsValid() ? 1 : 0;
+			}
+			ResolveMs = Timer.GetMs();
+		}
+		BenchmarkKeep(Acc);
+
+		UE_LOG("[Bench] Objects %6d: churn %d delete+new %.3fms | find subclass: scan %.3fms, iterator %.3fms x%.1f | weak resolve %.3fms",
+			NumObjects, NumChurn, ChurnMs, ScanMs, IteratorMs, IteratorMs > 0.0 ? ScanMs / IteratorMs : 0.0, ResolveMs);
+
+		for (UObject* Obj : Objects)
+		{
+			ObjectFactory::DeleteObject(Obj);
+		}
+		ObjectFactory::CompactNullSlots();
+	}
+}
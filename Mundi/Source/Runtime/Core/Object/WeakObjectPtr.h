@@ -0,0 +1,54 @@
+﻿#pragma once
+#include "ObjectFactory.h"
+
+// Weak object pointer validated by GUObjectArray slot generation
+// - Stores (InternalIndex, SerialNumber) instead of a raw pointer
+// - Get() returns nullptr once the object is deleted, even if its slot was reused
+// - Never dereferences the object to check validity
+// - Hash specialization provided below for unordered_map/set
+template<typename T>
+class TWeakObjectPtr
+{
+public:
+    using ElementType = T;
+
+    TWeakObjectPtr() = default;
+    TWeakObjectPtr(std::nullptr_t) {}
+    explicit TWeakObjectPtr(T* InPtr)
+    {
+        if (InPtr)
+        {
+            ObjectIndex = InPtr->InternalIndex;
+            SerialNumber = ObjectFactory::GetObjectSerialNumber(ObjectIndex);
+        }
+    }
+
+    bool IsValid() const { return Get() != nullptr; }
+    T* Get() const { return static_cast<T*>(ObjectFactory::ResolveObjectHandle(ObjectIndex, SerialNumber)); }
+    void Reset() { ObjectIndex = 0; SerialNumber = 0; }
+
+    T& operator*() const { return *Get(); }
+    T* operator->() const { return Get(); }
+
+    // 삭제된 뒤에도 같은 키로 비교/해시되도록 핸들 값으로 비교한다
+    bool operator==(const TWeakObjectPtr& Other) const { return ObjectIndex == Other.ObjectIndex && SerialNumber == Other.SerialNumber; }
+    bool operator!=(const TWeakObjectPtr& Other) const { return !(*this == Other); }
+
+    uint32 GetObjectIndex() const { return ObjectIndex; }
+    uint32 GetSerialNumber() const { return SerialNumber; }
+
+private:
+    uint32 ObjectIndex = 0;
+    uint32 SerialNumber = 0;   // 0 = 무효
+};
+
+namespace std {
+    template <typename T>
+    struct hash<TWeakObjectPtr<T>>
+    {
+        size_t operator()(const TWeakObjectPtr<T>& Key) const noexcept
+        {
+            return hash<uint64>()((static_cast<uint64>(Key.GetSerialNumber()) << 32) | Key.GetObjectIndex());
+        }
+    };
+}
@@ -0,0 +1,528 @@
+﻿#include "pch.h"
+#include "AnimCompression.h"
+#include "Source/Runtime/Core/Misc/VertexData.h"
+#include <algorithm>
+
+namespace
+{
+	// smallest-three 에서 남는 세 성분은 [-1/√2, 1/√2] 범위
+	constexpr float QuatComponentRange = 0.70710678f;
+	constexpr float QuatComponentMax = 32767.0f;   // 15비트
+	constexpr float RangeQuantMax = 65535.0f;      // 16비트
+	constexpr int32 MaxCompressedFrames = 65536;   // 프레임 번호를 uint16 으로 저장
+
+	uint16 QuantizeRange(float Value, float Min, float Extent)
+	{
+		if (Extent <= 0.0f)
+		{
+			return 0;
+		}
+		const float Unit = FMath::Clamp((Value - Min) / Extent, 0.0f, 1.0f);
+		return static_cast<uint16>(Unit * RangeQuantMax + 0.5f);
+	}
+
+	FVector DequantizeVector(const uint16* Values, const FVector& Min, const FVector& Extent)
+	{
+		return FVector(
+			Min.X + static_cast<float>(Values[0]) * (Extent.X / RangeQuantMax),
+			Min.Y + static_cast<float>(Values[1]) * (Extent.Y / RangeQuantMax),
+			Min.Z + static_cast<float>(Values[2]) * (Extent.Z / RangeQuantMax));
+	}
+
+	// 두 회전 사이 각도 (도). acos(dot) 는 작은 각도에서 float 정밀도가 부족하므로 상대 회전의 벡터부로 계산
+	float QuatAngleDegrees(const FQuat& A, const FQuat& B)
+	{
+		// conj(A) * B
+		const float W = A.W * B.W + A.X * B.X + A.Y * B.Y + A.Z * B.Z;
+		const float X = A.W * B.X - B.W * A.X - (A.Y * B.Z - A.Z * B.Y);
+		const float Y = A.W * B.Y - B.W * A.Y - (A.Z * B.X - A.X * B.Z);
+		const float Z = A.W * B.Z - B.W * A.Z - (A.X * B.Y - A.Y * B.X);
+		const float VectorLength = std::sqrt(X * X + Y * Y + Z * Z);
+		return RadiansToDegrees(2.0f * std::atan2(VectorLength, std::fabs(W)));
+	}
+
+	// FrameTime 을 감싸는 두 키와 보간 비율. 범위 밖이면 양 끝 키
+	void FindKeySegment(const TArray<uint16>& KeyFrames, float FrameTime, int32& OutKey0, int32& OutKey1, float& OutAlpha)
+	{
+		const int32 LastKey = KeyFrames.Num() - 1;
+		OutAlpha = 0.0f;
+		if (FrameTime <= static_cast<float>(KeyFrames[0]))
+		{
+			OutKey0 = OutKey1 = 0;
+			return;
+		}
+		if (FrameTime >= static_cast<float>(KeyFrames[LastKey]))
+		{
+			OutKey0 = OutKey1 = LastKey;
+			return;
+		}
+
+		// FrameTime 보다 뒤에 있는 첫 키
+		auto It = std::upper_bound(KeyFrames.begin(), KeyFrames.end(), FrameTime,
+			[](float Time, uint16 Frame) { return Time < static_cast<float>(Frame); });
+		OutKey1 = static_cast<int32>(It - KeyFrames.begin());
+		OutKey0 = OutKey1 - 1;
+
+		const float Frame0 = static_cast<float>(KeyFrames[OutKey0]);
+		const float Frame1 = static_cast<float>(KeyFrames[OutKey1]);
+		OutAlpha = (FrameTime - Frame0) / (Frame1 - Frame0);
+	}
+
+	// 앞에서부터 구간을 최대한 길게 늘려, 구간 양 끝 키로 보간한 값이 모든 중간 프레임에서 허용 오차 안인 키만 남긴다
+	// 첫/마지막 프레임은 항상 남긴다. IsWithinTolerance(Key0, Key1, Frame)
+	template<typename ToleranceFunc>
+	void ReduceKeys(int32 NumKeys, ToleranceFunc IsWithinTolerance, TArray<int32>& OutKeptFrames)
+	{
+		OutKeptFrames.Empty();
+		OutKeptFrames.Add(0);
+
+		int32 Anchor = 0;
+		for (int32 End = 2; End < NumKeys; ++End)
+		{
+			bool bFits = true;
+			for (int32 Frame = Anchor + 1; Frame < End; ++Frame)
+			{
+				if (!IsWithinTolerance(Anchor, End, Frame))
+				{
+					bFits = false;
+					break;
+				}
+			}
+
+			// Anchor ~ End - 1 까지가 한 구간
+			if (!bFits)
+			{
+				Anchor = End - 1;
+				OutKeptFrames.Add(Anchor);
+			}
+		}
+
+		if (NumKeys > 1)
+		{
+			OutKeptFrames.Add(NumKeys - 1);
+		}
+	}
+
+	void CompressVectorChannel(const TArray<FVector>& Keys, const FVector& DefaultValue, float Tolerance, FCompressedVectorChannel& Out)
+	{
+		Out = FCompressedVectorChannel();
+		if (Keys.IsEmpty())
+		{
+			Out.RangeMin = DefaultValue;
+			return;
+		}
+
+		FVector Min = Keys[0];
+		FVector Max = Keys[0];
+		for (const FVector& Key : Keys)
+		{
+			Min = FVector(FMath::Min(Min.X, Key.X), FMath::Min(Min.Y, Key.Y), FMath::Min(Min.Z, Key.Z));
+			Max = FVector(FMath::Max(Max.X, Key.X), FMath::Max(Max.Y, Key.Y), FMath::Max(Max.Z, Key.Z));
+		}
+
+		// 상수 접기: 모든 키가 범위 중심에서 허용 오차 안
+		const FVector Center = (Min + Max) * 0.5f;
+		bool bConstant = true;
+		for (const FVector& Key : Keys)
+		{
+			if (FVector::Distance(Key, Center) > Tolerance)
+			{
+				bConstant = false;
+				break;
+			}
+		}
+		if (bConstant)
+		{
+			Out.RangeMin = Center;
+			return;
+		}
+
+		Out.RangeMin = Min;
+		Out.RangeExtent = Max - Min;
+
+		// 모든 프레임을 먼저 양자화하고, 키 줄이기는 복원값 기준으로 오차를 잰다 (양자화 오차까지 포함)
+		const int32 NumKeys = Keys.Num();
+		TArray<uint16> Quantized;
+		TArray<FVector> Decoded;
+		Quantized.SetNum(NumKeys * 3);
+		Decoded.SetNum(NumKeys);
+		for (int32 i = 0; i < NumKeys; ++i)
+		{
+			uint16* Q = &Quantized[i * 3];
+			Q[0] = QuantizeRange(Keys[i].X, Min.X, Out.RangeExtent.X);
+			Q[1] = QuantizeRange(Keys[i].Y, Min.Y, Out.RangeExtent.Y);
+			Q[2] = QuantizeRange(Keys[i].Z, Min.Z, Out.RangeExtent.Z);
+			Decoded[i] = DequantizeVector(Q, Min, Out.RangeExtent);
+		}
+
+		TArray<int32> KeptFrames;
+		ReduceKeys(NumKeys, [&](int32 Key0, int32 Key1, int32 Frame)
+		{
+			const float Alpha = static_cast<float>(Frame - Key0) / static_cast<float>(Key1 - Key0);
+			return FVector::Distance(FVector::Lerp(Decoded[Key0], Decoded[Key1], Alpha), Keys[Frame]) <= Tolerance;
+		}, KeptFrames);
+
+		Out.KeyFrames.Reserve(KeptFrames.Num());
+		Out.Values.Reserve(KeptFrames.Num() * 3);
+		for (int32 Frame : KeptFrames)
+		{
+			Out.KeyFrames.Add(static_cast<uint16>(Frame));
+			Out.Values.Add(Quantized[Frame * 3 + 0]);
+			Out.Values.Add(Quantized[Frame * 3 + 1]);
+			Out.Values.Add(Quantized[Frame * 3 + 2]);
+		}
+	}
+
+	void CompressRotationChannel(const TArray<FQuat>& InKeys, float ToleranceDegrees, FCompressedRotationChannel& Out)
+	{
+		Out = FCompressedRotationChannel();
+		if (InKeys.IsEmpty())
+		{
+			return;
+		}
+
+		TArray<FQuat> Keys = InKeys;
+		for (FQuat& Key : Keys)
+		{
+			Key.Normalize();
+		}
+
+		bool bConstant = true;
+		for (const FQuat& Key : Keys)
+		{
+			if (QuatAngleDegrees(Key, Keys[0]) > ToleranceDegrees)
+			{
+				bConstant = false;
+				break;
+			}
+		}
+		if (bConstant)
+		{
+			Out.ConstantValue = Keys[0];
+			return;
+		}
+
+		const int32 NumKeys = Keys.Num();
+		TArray<uint16> Quantized;
+		TArray<FQuat> Decoded;
+		Quantized.SetNum(NumKeys * 3);
+		Decoded.SetNum(NumKeys);
+		for (int32 i = 0; i < NumKeys; ++i)
+		{
+			FAnimCompression::PackQuat48(Keys[i], &Quantized[i * 3]);
+			Decoded[i] = FAnimCompression::UnpackQuat48(&Quantized[i * 3]);
+		}
+
+		TArray<int32> KeptFrames;
+		ReduceKeys(NumKeys, [&](int32 Key0, int32 Key1, int32 Frame)
+		{
+			const float Alpha = static_cast<float>(Frame - Key0) / static_cast<float>(Key1 - Key0);
+			return QuatAngleDegrees(FQuat::Nlerp(Decoded[Key0], Decoded[Key1], Alpha), Keys[Frame]) <= ToleranceDegrees;
+		}, KeptFrames);
+
+		Out.KeyFrames.Reserve(KeptFrames.Num());
+		Out.Values.Reserve(KeptFrames.Num() * 3);
+		for (int32 Frame : KeptFrames)
+		{
+			Out.KeyFrames.Add(static_cast<uint16>(Frame));
+			Out.Values.Add(Quantized[Frame * 3 + 0]);
+			Out.Values.Add(Quantized[Frame * 3 + 1]);
+			Out.Values.Add(Quantized[Frame * 3 + 2]);
+		}
+	}
+
+	// UAnimSequence 의 원본 보간과 같은 규칙으로 정수 프레임의 원본 키
+	FTransform SampleRawFrame(const FRawAnimSequenceTrack& Track, int32 Frame)
+	{
+		FTransform Result;
+		if (!Track.PosKeys.IsEmpty())
+		{
+			Result.Translation = Track.PosKeys[FMath::Min(Frame, Track.PosKeys.Num() - 1)];
+		}
+		if (!Track.RotKeys.IsEmpty())
+		{
+			Result.Rotation = Track.RotKeys[FMath::Min(Frame, Track.RotKeys.Num() - 1)];
+		}
+		if (!Track.ScaleKeys.IsEmpty())
+		{
+			Result.Scale3D = Track.ScaleKeys[FMath::Min(Frame, Track.ScaleKeys.Num() - 1)];
+		}
+		return Result;
+	}
+
+	void AccumulateChannelStats(bool bConstant, int32 NumKeys, FAnimCompressionStats& Stats)
+	{
+		++Stats.TotalChannels;
+		if (bConstant)
+		{
+			++Stats.ConstantChannels;
+			++Stats.CompressedKeys;
+		}
+		else
+		{
+			Stats.CompressedKeys += NumKeys;
+		}
+	}
+}
+
+// ============================================================
+// 채널 복원
+// ============================================================
+
+FVector FCompressedVectorChannel::GetKey(int32 KeyIndex) const
+{
+	return DequantizeVector(&Values[KeyIndex * 3], RangeMin, RangeExtent);
+}
+
+void FCompressedVectorChannel::GetKeyPair(float FrameTime, FVector& OutKey0, FVector& OutKey1, float& OutAlpha) const
+{
+	if (IsConstant())
+	{
+		OutKey0 = OutKey1 = RangeMin;
+		OutAlpha = 0.0f;
+		return;
+	}
+
+	int32 Key0, Key1;
+	FindKeySegment(KeyFrames, FrameTime, Key0, Key1, OutAlpha);
+	OutKey0 = GetKey(Key0);
+	OutKey1 = Key1 == Key0 ? OutKey0 : GetKey(Key1);
+}
+
+FVector FCompressedVectorChannel::Sample(float FrameTime) const
+{
+	FVector Key0, Key1;
+	float Alpha;
+	GetKeyPair(FrameTime, Key0, Key1, Alpha);
+	return FVector::Lerp(Key0, Key1, Alpha);
+}
+
+int32 FCompressedVectorChannel::GetNumBytes() const
+{
+	return KeyFrames.Num() * sizeof(uint16) + Values.Num() * sizeof(uint16) + sizeof(FVector) * 2;
+}
+
+FQuat FCompressedRotationChannel::GetKey(int32 KeyIndex) const
+{
+	return FAnimCompression::UnpackQuat48(&Values[KeyIndex * 3]);
+}
+
+void FCompressedRotationChannel::GetKeyPair(float FrameTime, FQuat& OutKey0, FQuat& OutKey1, float& OutAlpha) const
+{
+	if (IsConstant())
+	{
+		OutKey0 = OutKey1 = ConstantValue;
+		OutAlpha = 0.0f;
+		return;
+	}
+
+	int32 Key0, Key1;
+	FindKeySegment(KeyFrames, FrameTime, Key0, Key1, OutAlpha);
+	OutKey0 = GetKey(Key0);
+	OutKey1 = Key1 == Key0 ? OutKey0 : GetKey(Key1);
+}
+
+FQuat FCompressedRotationChannel::Sample(float FrameTime) const
+{
+	FQuat Key0, Key1;
+	float Alpha;
+	GetKeyPair(FrameTime, Key0, Key1, Alpha);
+	if (Alpha == 0.0f)
+	{
+		return Key0;
+	}
+	return FQuat::Nlerp(Key0, Key1, Alpha);
+}
+
+int32 FCompressedRotationChannel::GetNumBytes() const
+{
+	return KeyFrames.Num() * sizeof(uint16) + Values.Num() * sizeof(uint16) + sizeof(FQuat);
+}
+
+// ============================================================
+// FAnimCompression
+// ============================================================
+
+void FAnimCompression::PackQuat48(const FQuat& Q, uint16 Out[3])
+{
+	float C[4] = { Q.X, Q.Y, Q.Z, Q.W };
+	const float Length = std::sqrt(C[0] * C[0] + C[1] * C[1] + C[2] * C[2] + C[3] * C[3]);
+	if (Length < KINDA_SMALL_NUMBER)
+	{
+		C[0] = C[1] = C[2] = 0.0f;
+		C[3] = 1.0f;
+	}
+	else
+	{
+		for (float& Component : C)
+		{
+			Component /= Length;
+		}
+	}
+
+	int32 Largest = 0;
+	for (int32 i = 1; i < 4; ++i)
+	{
+		if (std::fabs(C[i]) > std::fabs(C[Largest]))
+		{
+			Largest = i;
+		}
+	}
+
+	// q 와 -q 는 같은 회전이므로 빠지는 성분이 양수가 되도록 뒤집는다 (복원 시 sqrt 로 구함)
+	const float Sign = C[Largest] < 0.0f ? -1.0f : 1.0f;
+	int32 Slot = 0;
+	for (int32 i = 0; i < 4; ++i)
+	{
+		if (i == Largest)
+		{
+			continue;
+		}
+		const float Unit = FMath::Clamp(C[i] * Sign * (0.5f / QuatComponentRange) + 0.5f, 0.0f, 1.0f);
+		Out[Slot++] = static_cast<uint16>(Unit * QuatComponentMax + 0.5f);
+	}
+
+	Out[0] |= static_cast<uint16>((Largest & 1) << 15);
+	Out[1] |= static_cast<uint16>(((Largest >> 1) & 1) << 15);
+}
+
+FQuat FAnimCompression::UnpackQuat48(const uint16 In[3])
+{
+	const int32 Largest = (In[0] >> 15) | ((In[1] >> 15) << 1);
+
+	float C[4];
+	float SumSquared = 0.0f;
+	int32 Slot = 0;
+	for (int32 i = 0; i < 4; ++i)
+	{
+		if (i == Largest)
+		{
+			continue;
+		}
+		const float Unit = static_cast<float>(In[Slot++] & 0x7FFF) / QuatComponentMax;
+		C[i] = (Unit * 2.0f - 1.0f) * QuatComponentRange;
+		SumSquared += C[i] * C[i];
+	}
+	C[Largest] = std::sqrt(FMath::Max(0.0f, 1.0f - SumSquared));
+
+	return FQuat(C[0], C[1], C[2], C[3]);
+}
+
+bool FAnimCompression::CompressTracks(
+	const TArray<FBoneAnimationTrack>& Tracks,
+	const FAnimCompressionSettings& Settings,
+	TArray<FCompressedBoneTrack>& OutTracks)
+{
+	OutTracks.Empty();
+
+	for (const FBoneAnimationTrack& Track : Tracks)
+	{
+		if (Track.InternalTrack.GetNumKeys() > MaxCompressedFrames)
+		{
+			return false;
+		}
+	}
+
+	OutTracks.SetNum(Tracks.Num());
+	for (int32 i = 0; i < Tracks.Num(); ++i)
+	{
+		const FRawAnimSequenceTrack& Raw = Tracks[i].InternalTrack;
+		FCompressedBoneTrack& Compressed = OutTracks[i];
+
+		CompressVectorChannel(Raw.PosKeys, FVector(0, 0, 0), Settings.PositionTolerance, Compressed.Position);
+		CompressRotationChannel(Raw.RotKeys, Settings.RotationToleranceDegrees, Compressed.Rotation);
+		CompressVectorChannel(Raw.ScaleKeys, FVector(1, 1, 1), Settings.ScaleTolerance, Compressed.Scale);
+	}
+	return true;
+}
+
+FAnimCompressionStats FAnimCompression::MeasureCompression(
+	const TArray<FBoneAnimationTrack>& Tracks,
+	const TArray<FCompressedBoneTrack>& CompressedTracks,
+	const FSkeleton* Skeleton,
+	int32 NumFrames)
+{
+	FAnimCompressionStats Stats;
+	if (Tracks.Num() != CompressedTracks.Num())
+	{
+		return Stats;
+	}
+
+	// 크기
+	for (int32 i = 0; i < Tracks.Num(); ++i)
+	{
+		const FRawAnimSequenceTrack& Raw = Tracks[i].InternalTrack;
+		const FCompressedBoneTrack& Compressed = CompressedTracks[i];
+
+		Stats.RawBytes += Raw.PosKeys.Num() * sizeof(FVector) + Raw.RotKeys.Num() * sizeof(FQuat) + Raw.ScaleKeys.Num() * sizeof(FVector);
+		Stats.RawKeys += Raw.PosKeys.Num() + Raw.RotKeys.Num() + Raw.ScaleKeys.Num();
+		Stats.CompressedBytes += Compressed.GetNumBytes();
+
+		AccumulateChannelStats(Compressed.Position.IsConstant(), Compressed.Position.KeyFrames.Num(), Stats);
+		AccumulateChannelStats(Compressed.Rotation.IsConstant(), Compressed.Rotation.KeyFrames.Num(), Stats);
+		AccumulateChannelStats(Compressed.Scale.IsConstant(), Compressed.Scale.KeyFrames.Num(), Stats);
+	}
+
+	// 컴포넌트 공간 비교용: 본 -> 트랙. 트랙이 없는 본은 identity (GetBoneTransformAtTime 과 동일)
+	const int32 NumBones = Skeleton ? Skeleton->Bones.Num() : 0;
+	TArray<int32> BoneToTrack;
+	BoneToTrack.SetNum(NumBones, -1);
+	for (int32 i = 0; i < Tracks.Num(); ++i)
+	{
+		const int32 BoneIndex = Tracks[i].BoneTreeIndex;
+		if (BoneIndex >= 0 && BoneIndex < NumBones && BoneToTrack[BoneIndex] < 0)
+		{
+			BoneToTrack[BoneIndex] = i;
+		}
+	}
+
+	TArray<FTransform> RawLocal, CompressedLocal;
+	TArray<FTransform> RawComponent, CompressedComponent;
+	RawLocal.SetNum(Tracks.Num());
+	CompressedLocal.SetNum(Tracks.Num());
+	RawComponent.SetNum(NumBones);
+	CompressedComponent.SetNum(NumBones);
+
+	for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+	{
+		// 로컬 공간 채널 오차
+		for (int32 i = 0; i < Tracks.Num(); ++i)
+		{
+			RawLocal[i] = SampleRawFrame(Tracks[i].InternalTrack, Frame);
+			CompressedLocal[i] = CompressedTracks[i].Sample(static_cast<float>(Frame));
+
+			Stats.MaxPositionError = FMath::Max(Stats.MaxPositionError, FVector::Distance(RawLocal[i].Translation, CompressedLocal[i].Translation));
+			Stats.MaxRotationErrorDegrees = FMath::Max(Stats.MaxRotationErrorDegrees, QuatAngleDegrees(RawLocal[i].Rotation, CompressedLocal[i].Rotation));
+			Stats.MaxScaleError = FMath::Max(Stats.MaxScaleError, FVector::Distance(RawLocal[i].Scale3D, CompressedLocal[i].Scale3D));
+		}
+
+		// 컴포넌트 공간 본 위치 오차 (부모가 자식보다 앞에 있다고 가정, USkeletalMeshComponent 와 동일)
+		for (int32 BoneIndex = 0; BoneIndex < NumBones; ++BoneIndex)
+		{
+			const int32 TrackIndex = BoneToTrack[BoneIndex];
+			const FTransform RawBone = TrackIndex >= 0 ? RawLocal[TrackIndex] : FTransform();
+			const FTransform CompressedBone = TrackIndex >= 0 ? CompressedLocal[TrackIndex] : FTransform();
+
+			const int32 ParentIndex = Skeleton->Bones[BoneIndex].ParentIndex;
+			if (ParentIndex < 0 || ParentIndex >= BoneIndex)
+			{
+				RawComponent[BoneIndex] = RawBone;
+				CompressedComponent[BoneIndex] = CompressedBone;
+			}
+			else
+			{
+				RawComponent[BoneIndex] = RawComponent[ParentIndex].GetWorldTransform(RawBone);
+				CompressedComponent[BoneIndex] = CompressedComponent[ParentIndex].GetWorldTransform(CompressedBone);
+			}
+
+			const float BoneError = FVector::Distance(RawComponent[BoneIndex].Translation, CompressedComponent[BoneIndex].Translation);
+			if (BoneError > Stats.MaxBoneError)
+			{
+				Stats.MaxBoneError = BoneError;
+				Stats.MaxBoneErrorIndex = BoneIndex;
+			}
+		}
+	}
+
+	return Stats;
+}
@@ -0,0 +1,160 @@
+﻿#pragma once
+#include "AnimationTypes.h"
+
+struct FSkeleton;
+
+// 애니메이션 압축 허용 오차 (로컬 공간, 키 줄이기 기준)
+struct FAnimCompressionSettings
+{
+	float PositionTolerance = 0.0005f;       // 위치 (미터)
+	float RotationToleranceDegrees = 0.05f;  // 회전 (도)
+	float ScaleTolerance = 0.001f;           // 스케일
+};
+
+// 압축된 위치/스케일 채널
+// - 상수 채널: KeyFrames 가 비어 있고 RangeMin 이 값
+// - 그 외: KeyFrames[i] 프레임의 값 = RangeMin + Values[i * 3 + Axis] / 65535 * RangeExtent, 키 사이 프레임은 선형 보간
+struct FCompressedVectorChannel
+{
+	TArray<uint16> KeyFrames;   // 남긴 키의 프레임 번호 (오름차순, 첫/마지막 프레임 포함)
+	TArray<uint16> Values;      // 키마다 xyz 16비트씩
+	FVector RangeMin = FVector(0, 0, 0);
+	FVector RangeExtent = FVector(0, 0, 0);
+
+	bool IsConstant() const { return KeyFrames.IsEmpty(); }
+	FVector GetKey(int32 KeyIndex) const;
+	// FrameTime 을 감싸는 두 키 값과 보간 비율 (배치 보간용). 상수 채널이면 두 키 모두 상수 값
+	void GetKeyPair(float FrameTime, FVector& OutKey0, FVector& OutKey1, float& OutAlpha) const;
+	FVector Sample(float FrameTime) const;
+	int32 GetNumBytes() const;
+
+	friend FArchive& operator<<(FArchive& Ar, FCompressedVectorChannel& Data)
+	{
+		if (Ar.IsSaving())
+		{
+			Serialization::WriteArray(Ar, Data.KeyFrames);
+			Serialization::WriteArray(Ar, Data.Values);
+		}
+		else if (Ar.IsLoading())
+		{
+			Serialization::ReadArray(Ar, Data.KeyFrames);
+			Serialization::ReadArray(Ar, Data.Values);
+			if (Data.Values.Num() != Data.KeyFrames.Num() * 3)
+			{
+				throw std::runtime_error("Cache corrupt: Compressed vector channel size mismatch.");
+			}
+		}
+		Ar << Data.RangeMin;
+		Ar << Data.RangeExtent;
+		return Ar;
+	}
+};
+
+// 압축된 회전 채널
+// - 상수 채널: KeyFrames 가 비어 있고 ConstantValue 가 값
+// - 그 외: 키마다 48비트 smallest-three 쿼터니언 (PackQuat48), 키 사이 프레임은 Nlerp (포즈 샘플링과 동일)
+struct FCompressedRotationChannel
+{
+	TArray<uint16> KeyFrames;
+	TArray<uint16> Values;      // 키마다 16비트 3개
+	FQuat ConstantValue = FQuat::Identity();
+
+	bool IsConstant() const { return KeyFrames.IsEmpty(); }
+	FQuat GetKey(int32 KeyIndex) const;
+	void GetKeyPair(float FrameTime, FQuat& OutKey0, FQuat& OutKey1, float& OutAlpha) const;
+	FQuat Sample(float FrameTime) const;
+	int32 GetNumBytes() const;
+
+	friend FArchive& operator<<(FArchive& Ar, FCompressedRotationChannel& Data)
+	{
+		if (Ar.IsSaving())
+		{
+			Serialization::WriteArray(Ar, Data.KeyFrames);
+			Serialization::WriteArray(Ar, Data.Values);
+		}
+		else if (Ar.IsLoading())
+		{
+			Serialization::ReadArray(Ar, Data.KeyFrames);
+			Serialization::ReadArray(Ar, Data.Values);
+			if (Data.Values.Num() != Data.KeyFrames.Num() * 3)
+			{
+				throw std::runtime_error("Cache corrupt: Compressed rotation channel size mismatch.");
+			}
+		}
+		Ar << Data.ConstantValue;
+		return Ar;
+	}
+};
+
+// 본 하나의 압축 트랙 (FBoneAnimationTrack 과 같은 순서로 보관)
+struct FCompressedBoneTrack
+{
+	FCompressedVectorChannel Position;
+	FCompressedRotationChannel Rotation;
+	FCompressedVectorChannel Scale;
+
+	// FrameTime = 시간(초) * 프레임 레이트
+	FTransform Sample(float FrameTime) const
+	{
+		return FTransform(Position.Sample(FrameTime), Rotation.Sample(FrameTime), Scale.Sample(FrameTime));
+	}
+
+	int32 GetNumBytes() const { return Position.GetNumBytes() + Rotation.GetNumBytes() + Scale.GetNumBytes(); }
+
+	friend FArchive& operator<<(FArchive& Ar, FCompressedBoneTrack& Data)
+	{
+		Ar << Data.Position;
+		Ar << Data.Rotation;
+		Ar << Data.Scale;
+		return Ar;
+	}
+};
+
+// 압축 결과 통계 (모든 프레임에서 원본과 비교)
+struct FAnimCompressionStats
+{
+	int32 RawBytes = 0;
+	int32 CompressedBytes = 0;
+	int32 RawKeys = 0;              // 채널별 원본 키 개수 합
+	int32 CompressedKeys = 0;       // 키 줄이기 후 남은 키 개수 합
+	int32 ConstantChannels = 0;     // 상수로 접힌 채널 수
+	int32 TotalChannels = 0;
+
+	float MaxPositionError = 0.0f;          // 로컬 위치 최대 오차
+	float MaxRotationErrorDegrees = 0.0f;   // 로컬 회전 최대 오차 (도)
+	float MaxScaleError = 0.0f;
+	// 컴포넌트 공간 본 위치 최대 오차. 부모 회전 오차가 자식 위치로 전파된 결과 (스켈레톤이 없으면 0)
+	float MaxBoneError = 0.0f;
+	int32 MaxBoneErrorIndex = -1;
+
+	float GetCompressionRatio() const
+	{
+		return CompressedBytes > 0 ? static_cast<float>(RawBytes) / static_cast<float>(CompressedBytes) : 0.0f;
+	}
+};
+
+// 애니메이션 트랙 압축
+// 1. 채널 값이 모든 프레임에서 허용 오차 안이면 상수로 접는다
+// 2. 값을 양자화한다 (위치/스케일: 채널 범위 기준 16비트, 회전: 48비트 smallest-three)
+// 3. 양자화된 키 사이를 보간(위치/스케일 Lerp, 회전 Nlerp)했을 때 원본과의 오차가 허용 오차 안이면 중간 키를 버린다 (앞에서부터 최대한 길게)
+class FAnimCompression
+{
+public:
+	// OutTracks[i] = Tracks[i] 의 압축 결과. 프레임 수가 uint16 범위를 넘으면 false
+	static bool CompressTracks(
+		const TArray<FBoneAnimationTrack>& Tracks,
+		const FAnimCompressionSettings& Settings,
+		TArray<FCompressedBoneTrack>& OutTracks);
+
+	// 원본과 압축 결과를 0 ~ NumFrames - 1 모든 프레임에서 비교해 크기/오차 통계 계산
+	static FAnimCompressionStats MeasureCompression(
+		const TArray<FBoneAnimationTrack>& Tracks,
+		const TArray<FCompressedBoneTrack>& CompressedTracks,
+		const FSkeleton* Skeleton,
+		int32 NumFrames);
+
+	// 48비트 smallest-three: 가장 큰 성분을 빼고 나머지 셋을 15비트씩 저장
+	// 빠진 성분 인덱스(2비트)는 Out[0], Out[1] 의 최상위 비트에 둔다
+	static void PackQuat48(const FQuat& Q, uint16 Out[3]);
+	static FQuat UnpackQuat48(const uint16 In[3]);
+};
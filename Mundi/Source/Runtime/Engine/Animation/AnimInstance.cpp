@@ -21,15 +21,8 @@ void UAnimInstance::UpdateAnimation(float DeltaSeconds)
 	// 2. TODO: Lua 스크립트 업데이트 (향후 구현)
 	// LuaUpdateAnimation(DeltaSeconds);
 
-	// 3. 포즈 추출 + Notify 수집 (트리 누적 패턴)
-	//    GetAnimationPose()가 트리를 순회하며:
-	//    - 각 노드가 포즈 계산
-	//    - 각 노드가 Notify 수집하여 FPoseContext.AnimNotifies에 추가
-	FPoseContext FinalPose;
-	GetAnimationPose(FinalPose);
-
-	// 4. 수집된 Notify 트리거 (프레임워크가 자동 처리)
-	TriggerAnimNotifies(FinalPose);
+	// 3. 포즈 추출 + Notify 수집은 월드 애니메이션 단계에서 컴포넌트마다 병렬로 (GetAnimationPose)
+	// 4. 수집된 Notify 트리거는 그 뒤 게임 스레드에서 (TriggerAnimNotifies)
 }
 
 // ========================================
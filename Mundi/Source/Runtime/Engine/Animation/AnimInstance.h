@@ -17,11 +17,14 @@ public:
 	// ========================================
 
 	// 최종 업데이트 함수 (하위 클래스에서 오버라이드 금지)
-	// 전체 애니메이션 파이프라인을 정의
+	// 게임 스레드 단계: 각 노드의 시간과 상태 전이만 갱신한다
+	// 이후 단계는 월드의 애니메이션 단계가 처리 (USkeletalMeshComponent::EvaluateAnimation / DispatchAnimNotifies)
+	//   GetAnimationPose (컴포넌트마다 워커 스레드에서 병렬) -> TriggerAnimNotifies (게임 스레드 동기화 지점)
 	void UpdateAnimation(float DeltaSeconds);
 
 	// 포즈 추출 (하위 클래스에서 구현)
 	// Unreal 방식: 트리를 순회하며 각 노드가 OutPose.AnimNotifies에 Notify 추가
+	// 워커 스레드에서 호출되므로 노드 상태는 읽기만 하고 로그/액터/Lua 에 접근하지 않는다
 	virtual void GetAnimationPose(struct FPoseContext& OutPose);
 
 	// ========================================
@@ -40,7 +43,7 @@ public:
 	// ========================================
 
 	// Notify 트리거링 (Unreal 방식)
-	// FPoseContext에 수집된 Notify들을 일괄 트리거
+	// FPoseContext에 수집된 Notify들을 일괄 트리거 (게임 스레드 전용)
 	void TriggerAnimNotifies(const struct FPoseContext& Pose);
 
 	// Owner component 접근자
@@ -0,0 +1,201 @@
+﻿#include "pch.h"
+#include <random>
+#include "AnimSequence.h"
+#include "VectorSoA.h"
+#include "Source/Runtime/Core/Misc/VertexData.h"
+#include "Benchmark.h"
+
+namespace
+{
+	constexpr int32 NumCharacters = 128;
+	constexpr int32 NumBones = 67;          // James 스켈레톤 규모
+	constexpr int32 NumFrames = 300;        // 30fps 10초
+	constexpr int32 NumTicks = 60;
+
+	// 부모가 자식보다 앞에 오는 트리 (척추 체인 + 가지)
+	void BuildSkeleton(FSkeleton& OutSkeleton, std::mt19937& Random)
+	{
+		OutSkeleton.Bones.SetNum(NumBones);
+		for (int32 i = 0; i < NumBones; ++i)
+		{
+			FBone& Bone = OutSkeleton.Bones[i];
+			Bone.Name = "Bone_" + std::to_string(i);
+			Bone.ParentIndex = i == 0 ? -1 : static_cast<int32>(Random() % static_cast<uint32>(i));
+			OutSkeleton.BoneNameToIndex[Bone.Name] = i;
+		}
+	}
+
+	// 본마다 부드러운 회전 + 일부 본만 위치가 움직이는 클립. 트랙 순서는 본 순서와 다르게 섞는다
+	void BuildTracks(TArray<FBoneAnimationTrack>& OutTracks, std::mt19937& Random)
+	{
+		std::uniform_real_distribution<float> Unit(-1.0f, 1.0f);
+		std::uniform_real_distribution<float> Speed(0.5f, 3.0f);
+
+		OutTracks.Empty();
+		for (int32 BoneIndex = 0; BoneIndex < NumBones; ++BoneIndex)
+		{
+			FBoneAnimationTrack Track(FName("Bone_" + std::to_string(BoneIndex)), BoneIndex);
+			FVector Axis(Unit(Random), Unit(Random), Unit(Random));
+			if (Axis.SizeSquared() < 1e-4f)
+			{
+				Axis = FVector(0.0f, 0.0f, 1.0f);
+			}
+			const float Frequency = Speed(Random);
+			const float Phase = Unit(Random) * PI;
+			const FVector Offset(Unit(Random) * 0.2f, Unit(Random) * 0.2f, 0.1f + Unit(Random) * 0.05f);
+			const bool bMovingPosition = BoneIndex % 8 == 0;
+
+			for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+			{
+				const float Time = static_cast<float>(Frame) / 30.0f;
+				const float Angle = std::sin(Time * Frequency + Phase) * 0.8f;
+				Track.InternalTrack.RotKeys.Add(FQuat::FromAxisAngle(Axis, Angle));
+				Track.InternalTrack.PosKeys.Add(bMovingPosition ? Offset + FVector(0.0f, std::sin(Time * Frequency) * 0.3f, 0.0f) : Offset);
+				Track.InternalTrack.ScaleKeys.Add(FVector(1.0f, 1.0f, 1.0f));
+			}
+			OutTracks.Add(Track);
+		}
+		std::shuffle(OutTracks.begin(), OutTracks.end(), Random);
+	}
+
+	// 기존 구현: 본마다 트랙 선형 탐색, 프레임 위치 재계산, 스칼라 Slerp
+	void SampleLegacyPose(const UAnimSequence& Anim, float Time, FPoseContext& OutPose)
+	{
+		const TArray<FBoneAnimationTrack>& Tracks = Anim.GetBoneAnimationTracks();
+		OutPose.SetNumBones(NumBones);
+		for (int32 BoneIndex = 0; BoneIndex < NumBones; ++BoneIndex)
+		{
+			const FBoneAnimationTrack* Track = nullptr;
+			for (const FBoneAnimationTrack& T : Tracks)
+			{
+				if (T.BoneTreeIndex == BoneIndex)
+				{
+					Track = &T;
+					break;
+				}
+			}
+			if (!Track || Track->InternalTrack.IsEmpty())
+			{
+				OutPose.BoneTransforms[BoneIndex] = FTransform();
+				continue;
+			}
+
+			const FRawAnimSequenceTrack& Raw = Track->InternalTrack;
+			const float FrameTime = Time * Anim.FrameRate.AsDecimal();
+			const int32 Frame0 = FMath::Clamp(static_cast<int32>(FrameTime), 0, Raw.RotKeys.Num() - 1);
+			const int32 Frame1 = FMath::Clamp(Frame0 + 1, 0, Raw.RotKeys.Num() - 1);
+			const float Alpha = FMath::Frac(FrameTime);
+
+			OutPose.BoneTransforms[BoneIndex] = FTransform(
+				FMath::Lerp(Raw.PosKeys[Frame0], Raw.PosKeys[Frame1], Alpha),
+				FQuat::Slerp(Raw.RotKeys[Frame0], Raw.RotKeys[Frame1], Alpha),
+				FMath::Lerp(Raw.ScaleKeys[Frame0], Raw.ScaleKeys[Frame1], Alpha));
+		}
+	}
+
+	float MaxPoseError(const FPoseContext& A, const FPoseContext& B)
+	{
+		float MaxError = 0.0f;
+		for (int32 i = 0; i < A.BoneTransforms.Num(); ++i)
+		{
+			const FTransform& TA = A.BoneTransforms[i];
+			const FTransform& TB = B.BoneTransforms[i];
+			const float Sign = FQuat::Dot(TA.Rotation, TB.Rotation) < 0.0f ? -1.0f : 1.0f;
+			MaxError = std::max(MaxError, FVector::Distance(TA.Translation, TB.Translation));
+			MaxError = std::max(MaxError, std::fabs(TA.Rotation.X - TB.Rotation.X * Sign));
+			MaxError = std::max(MaxError, std::fabs(TA.Rotation.Y - TB.Rotation.Y * Sign));
+			MaxError = std::max(MaxError, std::fabs(TA.Rotation.Z - TB.Rotation.Z * Sign));
+			MaxError = std::max(MaxError, std::fabs(TA.Rotation.W - TB.Rotation.W * Sign));
+		}
+		return MaxError;
+	}
+}
+
+IMPLEMENT_BENCHMARK(ANIMPOSE, "Animation pose sampling for 128 characters x 67 bones: per-bone track scan + Slerp vs bone->track table + batched SoA Nlerp (raw and compressed tracks)")
+{
+	std::mt19937 Random(2024);
+
+	FSkeleton Skeleton;
+	BuildSkeleton(Skeleton, Random);
+
+	TArray<FBoneAnimationTrack> Tracks;
+	BuildTracks(Tracks, Random);
+
+	UAnimSequence* RawAnim = NewObject<UAnimSequence>();
+	RawAnim->FrameRate = FFrameRate(30, 1);
+	RawAnim->NumberOfFrames = NumFrames;
+	RawAnim->SequenceLength = static_cast<float>(NumFrames - 1) / 30.0f;
+	RawAnim->Skeleton = &Skeleton;
+	RawAnim->SetBoneTracks(Tracks);
+	RawAnim->BuildBoneTrackMap();
+
+	UAnimSequence* CompressedAnim = NewObject<UAnimSequence>();
+	CompressedAnim->FrameRate = RawAnim->FrameRate;
+	CompressedAnim->NumberOfFrames = NumFrames;
+	CompressedAnim->SequenceLength = RawAnim->SequenceLength;
+	CompressedAnim->Skeleton = &Skeleton;
+	CompressedAnim->SetBoneTracks(Tracks);
+	CompressedAnim->CompressAnimation();
+	CompressedAnim->BuildBoneTrackMap();
+
+	// 캐릭터마다 재생 위치가 다르다
+	std::uniform_real_distribution<float> StartTime(0.0f, RawAnim->SequenceLength);
+	TArray<float> CharacterTimes;
+	for (int32 i = 0; i < NumCharacters; ++i)
+	{
+		CharacterTimes.Add(StartTime(Random));
+	}
+
+	TArray<FPoseContext> Poses;
+	Poses.SetNum(NumCharacters);
+	const float DeltaTime = 1.0f / 60.0f;
+
+	auto RunTicks = [&](auto&& SamplePose)
+	{
+		FBenchTimer Timer;
+		for (int32 Tick = 0; Tick < NumTicks; ++Tick)
+		{
+			for (int32 i = 0; i < NumCharacters; ++i)
+			{
+				const float Time = std::fmod(CharacterTimes[i] + Tick * DeltaTime, RawAnim->SequenceLength);
+				SamplePose(Time, Poses[i]);
+			}
+		}
+		return Timer.GetMs() / NumTicks;
+	};
+
+	const bool bPrevUseSIMD = FSoAMath::GetUseSIMD();
+
+	const double LegacyMs = RunTicks([&](float Time, FPoseContext& Pose) { SampleLegacyPose(*RawAnim, Time, Pose); });
+
+	FSoAMath::SetUseSIMD(false);
+	const double BatchedScalarMs = RunTicks([&](float Time, FPoseContext& Pose) { RawAnim->GetAnimationPose(Pose, FAnimExtractContext(Time, true)); });
+
+	FSoAMath::SetUseSIMD(true);
+	const double BatchedSIMDMs = RunTicks([&](float Time, FPoseContext& Pose) { RawAnim->GetAnimationPose(Pose, FAnimExtractContext(Time, true)); });
+	const double CompressedMs = RunTicks([&](float Time, FPoseContext& Pose) { CompressedAnim->GetAnimationPose(Pose, FAnimExtractContext(Time, true)); });
+
+	// 정확도: Slerp -> Nlerp 차이와 압축 오차
+	float MaxNlerpError = 0.0f;
+	float MaxCompressedError = 0.0f;
+	for (int32 i = 0; i < NumCharacters; ++i)
+	{
+		FPoseContext Legacy, Batched, Compressed;
+		SampleLegacyPose(*RawAnim, CharacterTimes[i], Legacy);
+		RawAnim->GetAnimationPose(Batched, FAnimExtractContext(CharacterTimes[i], true));
+		CompressedAnim->GetAnimationPose(Compressed, FAnimExtractContext(CharacterTimes[i], true));
+		MaxNlerpError = std::max(MaxNlerpError, MaxPoseError(Legacy, Batched));
+		MaxCompressedError = std::max(MaxCompressedError, MaxPoseError(Batched, Compressed));
+	}
+
+	FSoAMath::SetUseSIMD(bPrevUseSIMD);
+
+	UE_LOG("[Bench] AnimPose %d chars x %d bones, per tick: legacy %.3fms | batched scalar %.3fms | batched SIMD %.3fms  x%.1f | compressed %.3fms",
+		NumCharacters, NumBones, LegacyMs, BatchedScalarMs, BatchedSIMDMs,
+		BatchedSIMDMs > 0.0 ? LegacyMs / BatchedSIMDMs : 0.0, CompressedMs);
+	UE_LOG("[Bench] AnimPose max diff: Nlerp vs Slerp %.2e, compressed vs raw %.2e (compression ratio %.2f)",
+		MaxNlerpError, MaxCompressedError, CompressedAnim->GetCompressionStats().GetCompressionRatio());
+
+	ObjectFactory::DeleteObject(RawAnim);
+	ObjectFactory::DeleteObject(CompressedAnim);
+}
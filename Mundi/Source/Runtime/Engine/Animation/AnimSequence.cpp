@@ -2,53 +2,187 @@
 #include "AnimSequence.h"
 #include "GlobalConsole.h"
 #include "Source/Runtime/Core/Misc/VertexData.h" 
+#include "VectorSoA.h"
+
+namespace
+{
+	// 포즈 샘플링 작업 버퍼. 스레드마다 하나씩 두고 재사용한다
+	struct FPoseSampleScratch
+	{
+		FTransformSoA Key0;
+		FTransformSoA Key1;
+		TArray<float> PositionAlpha;
+		TArray<float> RotationAlpha;
+		TArray<float> ScaleAlpha;
+		FTransformSoA Result;
+
+		void SetNum(int32 NumBones)
+		{
+			Key0.SetNum(NumBones);
+			Key1.SetNum(NumBones);
+			PositionAlpha.SetNum(NumBones);
+			RotationAlpha.SetNum(NumBones);
+			ScaleAlpha.SetNum(NumBones);
+		}
+	};
+
+	thread_local FPoseSampleScratch GPoseSampleScratch;
+
+	// 원본 키에서 Frame0, Frame0 + 1 의 두 키 (InterpolatePosition 등과 같은 범위 처리)
+	template<typename T>
+	void GetRawKeyPair(const TArray<T>& Keys, const T& DefaultValue, int32 Frame0, T& OutKey0, T& OutKey1)
+	{
+		if (Keys.IsEmpty())
+		{
+			OutKey0 = OutKey1 = DefaultValue;
+			return;
+		}
+
+		const int32 LastKey = Keys.Num() - 1;
+		OutKey0 = Keys[FMath::Min(Frame0, LastKey)];
+		OutKey1 = Keys[FMath::Min(Frame0 + 1, LastKey)];
+	}
+}
 
 void UAnimSequence::GetAnimationPose(FPoseContext& OutPose, const FAnimExtractContext& Context)
 {
-	// 스켈레톤이 없으면 실패
+	// 스켈레톤이 없으면 실패 (애니메이션 단계의 워커 스레드에서도 불리므로 로그는 남기지 않는다)
 	if (!Skeleton)
 	{
-		UE_LOG("UAnimSequence::GetAnimationPose - No skeleton assigned");
 		return;
 	}
 
-	// 본 개수만큼 포즈 초기화
+	// 본 -> 트랙 표는 게임 스레드에서 미리 만든다 (로드 / 에셋 지정 시점).
+	// 여러 컴포넌트가 같은 시퀀스를 동시에 샘플링하므로 여기서 만들지 않고, 표가 없으면 트랙을 선형 탐색한다
+	const bool bUseTrackMap = IsBoneTrackMapValid();
 	const int32 NumBones = Skeleton->Bones.Num();
-	OutPose.SetNumBones(NumBones);
 
-	// 모든 본에 대해 애니메이션 트랙에서 현재 시간의 트랜스폼 추출
+	// 프레임 위치는 샘플마다 한 번만 계산 (압축 트랙은 채널마다 남은 키가 달라 비율을 따로 구한다)
+	const float FrameTime = Context.CurrentTime * FrameRate.AsDecimal();
+	const int32 RawFrame0 = FMath::Max(static_cast<int32>(FrameTime), 0);
+	const float RawAlpha = FMath::Frac(FrameTime);
+
+	FPoseSampleScratch& Scratch = GPoseSampleScratch;
+	Scratch.SetNum(NumBones);
+
+	// 1. 본마다 보간할 두 키와 비율을 SoA 로 모은다
 	for (int32 BoneIndex = 0; BoneIndex < NumBones; ++BoneIndex)
 	{
-		OutPose.BoneTransforms[BoneIndex] = GetBoneTransformAtTime(BoneIndex, Context.CurrentTime);
+		FVector Position0, Position1, Scale0, Scale1;
+		FQuat Rotation0, Rotation1;
+		float PositionAlpha = 0.0f;
+		float RotationAlpha = 0.0f;
+		float ScaleAlpha = 0.0f;
+
+		const int32 TrackIndex = bUseTrackMap ? BoneToTrack[BoneIndex] : FindTrackIndex(BoneIndex);
+		if (TrackIndex < 0)
+		{
+			// 애니메이션 트랙이 없으면 identity (T-Pose 유지)
+			Position0 = Position1 = FVector(0, 0, 0);
+			Rotation0 = Rotation1 = FQuat::Identity();
+			Scale0 = Scale1 = FVector(1, 1, 1);
+		}
+		else if (TrackIndex < CompressedTracks.Num())
+		{
+			const FCompressedBoneTrack& Track = CompressedTracks[TrackIndex];
+			Track.Position.GetKeyPair(FrameTime, Position0, Position1, PositionAlpha);
+			Track.Rotation.GetKeyPair(FrameTime, Rotation0, Rotation1, RotationAlpha);
+			Track.Scale.GetKeyPair(FrameTime, Scale0, Scale1, ScaleAlpha);
+		}
+		else
+		{
+			const FRawAnimSequenceTrack& RawTrack = BoneAnimationTracks[TrackIndex].InternalTrack;
+			GetRawKeyPair(RawTrack.PosKeys, FVector(0, 0, 0), RawFrame0, Position0, Position1);
+			GetRawKeyPair(RawTrack.RotKeys, FQuat::Identity(), RawFrame0, Rotation0, Rotation1);
+			GetRawKeyPair(RawTrack.ScaleKeys, FVector(1, 1, 1), RawFrame0, Scale0, Scale1);
+			PositionAlpha = RotationAlpha = ScaleAlpha = RawAlpha;
+		}
+
+		Scratch.Key0.Translation.Set(BoneIndex, Position0);
+		Scratch.Key1.Translation.Set(BoneIndex, Position1);
+		Scratch.Key0.Rotation.Set(BoneIndex, Rotation0);
+		Scratch.Key1.Rotation.Set(BoneIndex, Rotation1);
+		Scratch.Key0.Scale3D.Set(BoneIndex, Scale0);
+		Scratch.Key1.Scale3D.Set(BoneIndex, Scale1);
+		Scratch.PositionAlpha[BoneIndex] = PositionAlpha;
+		Scratch.RotationAlpha[BoneIndex] = RotationAlpha;
+		Scratch.ScaleAlpha[BoneIndex] = ScaleAlpha;
 	}
+
+	// 2. 모든 본을 한 번에 보간
+	FSoAMath::LerpVectors(Scratch.Key0.Translation, Scratch.Key1.Translation, Scratch.PositionAlpha, Scratch.Result.Translation);
+	FSoAMath::NlerpQuats(Scratch.Key0.Rotation, Scratch.Key1.Rotation, Scratch.RotationAlpha, Scratch.Result.Rotation);
+	FSoAMath::LerpVectors(Scratch.Key0.Scale3D, Scratch.Key1.Scale3D, Scratch.ScaleAlpha, Scratch.Result.Scale3D);
+
+	Scratch.Result.ToAoS(OutPose.BoneTransforms);
 }
 
-FTransform UAnimSequence::GetBoneTransformAtTime(int32 BoneIndex, float Time) const
+void UAnimSequence::BuildBoneTrackMap()
 {
-	// 스켈레톤 범위 체크
-	if (!Skeleton || BoneIndex < 0 || BoneIndex >= Skeleton->Bones.Num())
+	const int32 NumBones = Skeleton ? Skeleton->Bones.Num() : 0;
+	BoneToTrack.assign(NumBones, -1);
+
+	// 같은 본을 가리키는 트랙이 여럿이면 앞의 것 (기존 선형 탐색과 동일)
+	for (int32 TrackIndex = 0; TrackIndex < BoneAnimationTracks.Num(); ++TrackIndex)
 	{
-		return FTransform();
+		const int32 BoneIndex = BoneAnimationTracks[TrackIndex].BoneTreeIndex;
+		if (BoneIndex >= 0 && BoneIndex < NumBones && BoneToTrack[BoneIndex] < 0)
+		{
+			BoneToTrack[BoneIndex] = TrackIndex;
+		}
 	}
 
-	// BoneAnimationTracks 배열에서 BoneTreeIndex로 매칭되는 트랙 찾기
-	const FBoneAnimationTrack* Track = nullptr;
-	for (const FBoneAnimationTrack& T : BoneAnimationTracks)
+	BoneTrackMapSkeleton = Skeleton;
+}
+
+bool UAnimSequence::IsBoneTrackMapValid() const
+{
+	return Skeleton && BoneTrackMapSkeleton == Skeleton && BoneToTrack.Num() == Skeleton->Bones.Num();
+}
+
+int32 UAnimSequence::FindTrackIndex(int32 BoneIndex) const
+{
+	if (IsBoneTrackMapValid())
 	{
-		if (T.BoneTreeIndex == BoneIndex)
+		return BoneToTrack[BoneIndex];
+	}
+
+	for (int32 i = 0; i < BoneAnimationTracks.Num(); ++i)
+	{
+		if (BoneAnimationTracks[i].BoneTreeIndex == BoneIndex)
 		{
-			Track = &T;
-			break;
+			return i;
 		}
 	}
+	return -1;
+}
+
+FTransform UAnimSequence::GetBoneTransformAtTime(int32 BoneIndex, float Time) const
+{
+	// 스켈레톤 범위 체크
+	if (!Skeleton || BoneIndex < 0 || BoneIndex >= Skeleton->Bones.Num())
+	{
+		return FTransform();
+	}
 
 	// 애니메이션 트랙이 없으면 identity (T-Pose 유지)
-	if (!Track || Track->InternalTrack.IsEmpty())
+	const int32 TrackIndex = FindTrackIndex(BoneIndex);
+	if (TrackIndex < 0)
 	{
 		return FTransform();
 	}
 
-	const FRawAnimSequenceTrack& RawTrack = Track->InternalTrack;
+	// 압축 트랙에서 복원
+	if (TrackIndex < CompressedTracks.Num())
+	{
+		return CompressedTracks[TrackIndex].Sample(Time * FrameRate.AsDecimal());
+	}
+
+	const FRawAnimSequenceTrack& RawTrack = BoneAnimationTracks[TrackIndex].InternalTrack;
+	if (RawTrack.IsEmpty())
+	{
+		return FTransform();
+	}
 
 	// 각 컴포넌트 보간
 	FVector Position = InterpolatePosition(RawTrack.PosKeys, Time);
@@ -112,6 +246,34 @@ FVector UAnimSequence::InterpolateScale(const TArray<FVector>& Keys, float Time)
 	return FMath::Lerp(Keys[Frame0], Keys[Frame1], Alpha);
 }
 
+bool UAnimSequence::CompressAnimation(const FAnimCompressionSettings& Settings)
+{
+	TArray<FCompressedBoneTrack> NewTracks;
+	if (!FAnimCompression::CompressTracks(BoneAnimationTracks, Settings, NewTracks))
+	{
+		UE_LOG("UAnimSequence::CompressAnimation - Too many frames to compress (%d), keeping raw tracks", NumberOfFrames);
+		return false;
+	}
+
+	CompressionStats = FAnimCompression::MeasureCompression(BoneAnimationTracks, NewTracks, Skeleton, NumberOfFrames);
+	CompressedTracks = std::move(NewTracks);
+
+	// 원본 키는 더 이상 쓰지 않는다
+	for (FBoneAnimationTrack& Track : BoneAnimationTracks)
+	{
+		Track.InternalTrack = FRawAnimSequenceTrack();
+	}
+
+	const FAnimCompressionStats& Stats = CompressionStats;
+	UE_LOG("[ANIMATION] Compressed '%s': %d -> %d bytes (ratio %.2f), keys %d -> %d, constant channels %d/%d",
+		   GetFilePath().c_str(), Stats.RawBytes, Stats.CompressedBytes, Stats.GetCompressionRatio(),
+		   Stats.RawKeys, Stats.CompressedKeys, Stats.ConstantChannels, Stats.TotalChannels);
+	UE_LOG("[ANIMATION] Max error: position %.5f, rotation %.4f deg, scale %.5f, bone %.5f (bone %d)",
+		   Stats.MaxPositionError, Stats.MaxRotationErrorDegrees, Stats.MaxScaleError,
+		   Stats.MaxBoneError, Stats.MaxBoneErrorIndex);
+	return true;
+}
+
 void UAnimSequence::Serialize(const bool bInIsLoading, JSON& InOutHandle)
 {
 	Super::Serialize(bInIsLoading, InOutHandle);
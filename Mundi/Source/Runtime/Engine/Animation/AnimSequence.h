@@ -1,5 +1,6 @@
 ﻿#pragma once
 #include "AnimSequenceBase.h"
+#include "AnimCompression.h"
 #include "UAnimSequence.generated.h"
 
 UCLASS(DisplayName = "애니메이션 시퀀스", Description = "키프레임 애니메이션 데이터")
@@ -22,6 +23,7 @@ public:
 	int32 NumberOfKeys = 0;
 
 	// 포즈 추출 구현
+	// 프레임 위치는 한 번만 계산하고, 본마다 두 키를 SoA 로 모은 뒤 모든 본을 한 번에 보간한다 (위치/스케일 Lerp, 회전 Nlerp)
 	virtual void GetAnimationPose(FPoseContext& OutPose, const FAnimExtractContext& Context) override;
 
 	// 특정 시간의 본 트랜스폼 가져오기 (보간)
@@ -31,8 +33,21 @@ public:
 	const TArray<FBoneAnimationTrack>& GetBoneAnimationTracks() const { return BoneAnimationTracks; }
 
 	// 본 트랙 추가 (FBX Loader가 사용)
-	void AddBoneTrack(const FBoneAnimationTrack& Track) { BoneAnimationTracks.Add(Track); }
-	void SetBoneTracks(const TArray<FBoneAnimationTrack>& Tracks) { BoneAnimationTracks = Tracks; }
+	void AddBoneTrack(const FBoneAnimationTrack& Track) { BoneAnimationTracks.Add(Track); BoneToTrack.Empty(); }
+	// 트랙 교체. 기존 압축 데이터는 버린다
+	void SetBoneTracks(const TArray<FBoneAnimationTrack>& Tracks) { BoneAnimationTracks = Tracks; CompressedTracks.Empty(); BoneToTrack.Empty(); }
+
+	// 스켈레톤 본 인덱스 -> 트랙 인덱스 표 생성. 로드 후 스켈레톤을 지정한 다음 호출한다
+	// GetAnimationPose 는 여러 스레드에서 동시에 불리므로 표를 만들지 않는다. 표가 없거나 스켈레톤이 바뀌었으면
+	// 게임 스레드에서 재생을 지정할 때 (AnimSingleNodeInstance / AnimStateMachine) 다시 만든다
+	void BuildBoneTrackMap();
+	bool IsBoneTrackMapValid() const;
+
+	// 원본 트랙을 압축하고 원본 키는 버린다 (트랙 이름/본 인덱스는 유지)
+	// 이후 포즈 추출은 압축 트랙에서 복원한다
+	bool CompressAnimation(const FAnimCompressionSettings& Settings = FAnimCompressionSettings());
+	bool IsCompressed() const { return !CompressedTracks.IsEmpty(); }
+	const FAnimCompressionStats& GetCompressionStats() const { return CompressionStats; }
 
 	// 직렬화 (JSON)
 	virtual void Serialize(const bool bInIsLoading, JSON& InOutHandle) override;
@@ -42,6 +57,12 @@ public:
 	{
 		if (Ar.IsSaving())
 		{
+			// 0. 캐시 포맷 식별자
+			uint32 Magic = AnimCacheMagic;
+			uint32 Version = AnimCacheVersion;
+			Ar << Magic;
+			Ar << Version;
+
 			// 1. FrameRate 저장
 			Ar << Anim.FrameRate;
 
@@ -59,9 +80,28 @@ public:
 			{
 				Ar << Track;
 			}
+
+			// 5. 압축 트랙 저장 (BoneAnimationTracks 와 같은 순서)
+			uint32 CompressedCount = static_cast<uint32>(Anim.CompressedTracks.Num());
+			Ar << CompressedCount;
+			for (auto& Track : Anim.CompressedTracks)
+			{
+				Ar << Track;
+			}
+			Ar << Anim.CompressionStats;
 		}
 		else if (Ar.IsLoading())
 		{
+			// 0. 캐시 포맷 확인 (예전 포맷이면 예외 -> 호출자가 캐시를 다시 만든다)
+			uint32 Magic = 0;
+			uint32 Version = 0;
+			Ar << Magic;
+			Ar << Version;
+			if (Magic != AnimCacheMagic || Version != AnimCacheVersion)
+			{
+				throw std::runtime_error("Animation cache format is outdated.");
+			}
+
 			// 1. FrameRate 로드
 			Ar << Anim.FrameRate;
 
@@ -87,14 +127,43 @@ public:
 			{
 				Ar << Anim.BoneAnimationTracks[i];
 			}
+
+			// 5. 압축 트랙 로드 (없거나 트랙 수와 같아야 한다)
+			uint32 CompressedCount;
+			Ar << CompressedCount;
+			if (CompressedCount != 0 && CompressedCount != TrackCount)
+			{
+				throw std::runtime_error("Cache corrupt: Compressed animation track count mismatch.");
+			}
+
+			Anim.CompressedTracks.SetNum(CompressedCount);
+			for (uint32 i = 0; i < CompressedCount; ++i)
+			{
+				Ar << Anim.CompressedTracks[i];
+			}
+			Ar << Anim.CompressionStats;
 		}
 		return Ar;
 	}
 
 private:
-	// 본별 애니메이션 트랙
+	// 바이너리 캐시 식별자 ('ANIM') / 포맷 버전. 포맷이 바뀌면 버전을 올린다
+	static constexpr uint32 AnimCacheMagic = 0x4D494E41;
+	static constexpr uint32 AnimCacheVersion = 3;
+
+	// 본별 애니메이션 트랙 (압축 후에는 키가 비어 있다)
 	TArray<FBoneAnimationTrack> BoneAnimationTracks;
 
+	// 본별 압축 트랙 (BoneAnimationTracks 와 같은 순서, 압축 전에는 비어 있음)
+	TArray<FCompressedBoneTrack> CompressedTracks;
+	FAnimCompressionStats CompressionStats;
+
+	// 스켈레톤 본 인덱스 -> 트랙 인덱스 (트랙이 없는 본은 -1)
+	TArray<int32> BoneToTrack;
+	const FSkeleton* BoneTrackMapSkeleton = nullptr;
+
+	int32 FindTrackIndex(int32 BoneIndex) const;
+
 	// FBX Loader가 데이터를 채울 수 있도록
 	friend class UFbxLoader;
 
@@ -7,6 +7,12 @@ void UAnimSingleNodeInstance::SetAnimationAsset(UAnimSequence* NewAsset)
 {
 	CurrentSequence = NewAsset;
 	InternalTime = 0.0f;
+
+	// 포즈 추출은 애니메이션 단계의 워커 스레드에서 하므로 본 -> 트랙 표는 여기서 준비
+	if (CurrentSequence && !CurrentSequence->IsBoneTrackMapValid())
+	{
+		CurrentSequence->BuildBoneTrackMap();
+	}
 	PreviousInternalTime = 0.0f;
 }
 
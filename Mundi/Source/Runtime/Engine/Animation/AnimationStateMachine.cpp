@@ -12,6 +12,12 @@ void UAnimStateMachine::AddState(FName StateName, UAnimSequence* Animation, bool
     NewState.bLoop = bLoop;
     NewState.PlayRate = PlayRate;
 
+    // 포즈 추출은 애니메이션 단계의 워커 스레드에서 하므로 본 -> 트랙 표는 여기서 준비
+    if (Animation && !Animation->IsBoneTrackMapValid())
+    {
+        Animation->BuildBoneTrackMap();
+    }
+
     States.Add(StateName, NewState);
 }
 
@@ -0,0 +1,296 @@
+﻿#include "pch.h"
+#include "CPUSkinning.h"
+#include "JobSystem.h"
+#include "Source/Runtime/Core/Misc/VertexData.h"
+#include <immintrin.h> // AVX2, FMA
+
+// ─────────────────────────────
+// FSkinningStreams
+// ─────────────────────────────
+void FSkinningStreams::Build(const TArray<FSkinnedVertex>& Vertices, int32 NumBones)
+{
+	Reset();
+	if (Vertices.IsEmpty() || NumBones <= 0 || NumBones > 256)
+	{
+		return;
+	}
+
+	const int32 Count = Vertices.Num();
+	Positions.SetNum(Count);
+	Normals.SetNum(Count);
+	Tangents.SetNum(Count);
+	BoneIndices.SetNum(Count);
+	BoneWeights.SetNum(Count);
+
+	for (int32 i = 0; i < Count; ++i)
+	{
+		const FSkinnedVertex& Vertex = Vertices[i];
+		Positions.Set(i, Vertex.Position);
+		Normals.Set(i, Vertex.Normal);
+		Tangents.Set(i, FVector(Vertex.Tangent.X, Vertex.Tangent.Y, Vertex.Tangent.Z));
+
+		uint32 Quantized[4];
+		int32 Sum = 0;
+		int32 Largest = 0;
+		for (int32 k = 0; k < 4; ++k)
+		{
+			if (Vertex.BoneIndices[k] >= static_cast<uint32>(NumBones))
+			{
+				// 스켈레톤 밖을 가리키는 정점이 있으면 기존 경로에 맡긴다
+				Reset();
+				return;
+			}
+			const float Weight = FMath::Clamp(Vertex.BoneWeights[k], 0.0f, 1.0f);
+			Quantized[k] = static_cast<uint32>(Weight * 255.0f + 0.5f);
+			Sum += static_cast<int32>(Quantized[k]);
+			if (Quantized[k] > Quantized[Largest])
+			{
+				Largest = k;
+			}
+		}
+
+		// 합이 1 이 되도록 반올림 오차 보정 (가중치가 전혀 없는 정점은 그대로 0)
+		if (Sum > 0)
+		{
+			Quantized[Largest] = static_cast<uint32>(static_cast<int32>(Quantized[Largest]) + 255 - Sum);
+		}
+
+		uint32 PackedIndices = 0;
+		uint32 PackedWeights = 0;
+		for (int32 k = 0; k < 4; ++k)
+		{
+			PackedIndices |= (Vertex.BoneIndices[k] & 0xFF) << (8 * k);
+			PackedWeights |= (Quantized[k] & 0xFF) << (8 * k);
+		}
+		BoneIndices[i] = PackedIndices;
+		BoneWeights[i] = PackedWeights;
+	}
+}
+
+void FSkinningStreams::Reset()
+{
+	Positions.SetNum(0);
+	Normals.SetNum(0);
+	Tangents.SetNum(0);
+	BoneIndices.Empty();
+	BoneWeights.Empty();
+}
+
+namespace
+{
+	constexpr float InvWeightScale = 1.0f / 255.0f;
+
+	// ─────────────────────────────
+	// 스칼라 커널 (AVX2 미지원 CPU 및 8개 미만 꼬리)
+	// ─────────────────────────────
+	void SkinVertexScalar(const FSkinningStreams& Streams, const FMatrix3x4* SkinningMatrices, const FMatrix3x4* NormalMatrices,
+		FSkinnedVertex& OutVertex, int32 Index)
+	{
+		float M[3][4] = {};
+		float N[3][3] = {};
+
+		const uint32 PackedIndices = Streams.BoneIndices[Index];
+		const uint32 PackedWeights = Streams.BoneWeights[Index];
+		for (int32 k = 0; k < 4; ++k)
+		{
+			const uint32 QuantizedWeight = (PackedWeights >> (8 * k)) & 0xFF;
+			if (QuantizedWeight == 0)
+			{
+				continue;
+			}
+
+			const float Weight = static_cast<float>(QuantizedWeight) * InvWeightScale;
+			const uint32 BoneIndex = (PackedIndices >> (8 * k)) & 0xFF;
+			const FMatrix3x4& SkinMatrix = SkinningMatrices[BoneIndex];
+			const FMatrix3x4& NormalMatrix = NormalMatrices[BoneIndex];
+			for (int32 Row = 0; Row < 3; ++Row)
+			{
+				for (int32 Col = 0; Col < 4; ++Col)
+				{
+					M[Row][Col] += Weight * SkinMatrix.M[Row][Col];
+				}
+				for (int32 Col = 0; Col < 3; ++Col)
+				{
+					N[Row][Col] += Weight * NormalMatrix.M[Row][Col];
+				}
+			}
+		}
+
+		const FVector P = Streams.Positions.Get(Index);
+		const FVector Nrm = Streams.Normals.Get(Index);
+		const FVector T = Streams.Tangents.Get(Index);
+
+		OutVertex.Position = FVector(
+			M[0][0] * P.X + M[0][1] * P.Y + M[0][2] * P.Z + M[0][3],
+			M[1][0] * P.X + M[1][1] * P.Y + M[1][2] * P.Z + M[1][3],
+			M[2][0] * P.X + M[2][1] * P.Y + M[2][2] * P.Z + M[2][3]);
+
+		OutVertex.Normal = FVector(
+			N[0][0] * Nrm.X + N[0][1] * Nrm.Y + N[0][2] * Nrm.Z,
+			N[1][0] * Nrm.X + N[1][1] * Nrm.Y + N[1][2] * Nrm.Z,
+			N[2][0] * Nrm.X + N[2][1] * Nrm.Y + N[2][2] * Nrm.Z).GetSafeNormal();
+
+		const FVector TangentDir = FVector(
+			M[0][0] * T.X + M[0][1] * T.Y + M[0][2] * T.Z,
+			M[1][0] * T.X + M[1][1] * T.Y + M[1][2] * T.Z,
+			M[2][0] * T.X + M[2][1] * T.Y + M[2][2] * T.Z).GetSafeNormal();
+		OutVertex.Tangent.X = TangentDir.X;
+		OutVertex.Tangent.Y = TangentDir.Y;
+		OutVertex.Tangent.Z = TangentDir.Z;
+	}
+
+	// ─────────────────────────────
+	// AVX2 커널 (8 정점)
+	// ─────────────────────────────
+
+	// FVector::GetSafeNormal 과 동일: 길이가 너무 작으면 0
+	inline void Normalize8(__m256& X, __m256& Y, __m256& Z)
+	{
+		const __m256 Size = _mm256_sqrt_ps(_mm256_fmadd_ps(Z, Z, _mm256_fmadd_ps(Y, Y, _mm256_mul_ps(X, X))));
+		const __m256 Valid = _mm256_cmp_ps(Size, _mm256_set1_ps(KINDA_SMALL_NUMBER), _CMP_GT_OQ);
+		const __m256 InvSize = _mm256_and_ps(_mm256_div_ps(_mm256_set1_ps(1.0f), Size), Valid);
+		X = _mm256_mul_ps(X, InvSize);
+		Y = _mm256_mul_ps(Y, InvSize);
+		Z = _mm256_mul_ps(Z, InvSize);
+	}
+
+	void SkinVerticesAVX2(const FSkinningStreams& Streams, const FMatrix3x4* SkinningMatrices, const FMatrix3x4* NormalMatrices,
+		TArray<FSkinnedVertex>& OutVertices, int32 Begin, int32 End, int32& OutNext)
+	{
+		const float* SkinBase = &SkinningMatrices[0].M[0][0];
+		const float* NormalBase = &NormalMatrices[0].M[0][0];
+		const __m256i ByteMask = _mm256_set1_epi32(0xFF);
+		const __m256i MatrixStride = _mm256_set1_epi32(static_cast<int32>(sizeof(FMatrix3x4) / sizeof(float)));
+		const __m256 WeightScale = _mm256_set1_ps(InvWeightScale);
+
+		int32 i = Begin;
+		for (; i + 8 <= End; i += 8)
+		{
+			const __m256i PackedIndices = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&Streams.BoneIndices[i]));
+			const __m256i PackedWeights = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&Streams.BoneWeights[i]));
+
+			// 정점마다 영향 본 행렬의 가중 합
+			__m256 M[3][4];
+			__m256 N[3][3];
+			for (int32 Row = 0; Row < 3; ++Row)
+			{
+				for (int32 Col = 0; Col < 4; ++Col)
+				{
+					M[Row][Col] = _mm256_setzero_ps();
+				}
+				for (int32 Col = 0; Col < 3; ++Col)
+				{
+					N[Row][Col] = _mm256_setzero_ps();
+				}
+			}
+
+			for (int32 k = 0; k < 4; ++k)
+			{
+				const __m256i QuantizedWeight = _mm256_and_si256(_mm256_srli_epi32(PackedWeights, 8 * k), ByteMask);
+				// 8 정점 모두 k 번째 영향이 없으면 건너뛴다 (대부분의 정점은 본 1~2개)
+				if (_mm256_testz_si256(QuantizedWeight, QuantizedWeight))
+				{
+					continue;
+				}
+
+				const __m256 Weight = _mm256_mul_ps(_mm256_cvtepi32_ps(QuantizedWeight), WeightScale);
+				const __m256i BoneIndex = _mm256_and_si256(_mm256_srli_epi32(PackedIndices, 8 * k), ByteMask);
+				const __m256i Offset = _mm256_mullo_epi32(BoneIndex, MatrixStride);
+
+				for (int32 Row = 0; Row < 3; ++Row)
+				{
+					for (int32 Col = 0; Col < 4; ++Col)
+					{
+						M[Row][Col] = _mm256_fmadd_ps(Weight, _mm256_i32gather_ps(SkinBase + Row * 4 + Col, Offset, 4), M[Row][Col]);
+					}
+					for (int32 Col = 0; Col < 3; ++Col)
+					{
+						N[Row][Col] = _mm256_fmadd_ps(Weight, _mm256_i32gather_ps(NormalBase + Row * 4 + Col, Offset, 4), N[Row][Col]);
+					}
+				}
+			}
+
+			const __m256 PX = _mm256_loadu_ps(&Streams.Positions.X[i]);
+			const __m256 PY = _mm256_loadu_ps(&Streams.Positions.Y[i]);
+			const __m256 PZ = _mm256_loadu_ps(&Streams.Positions.Z[i]);
+			const __m256 NX = _mm256_loadu_ps(&Streams.Normals.X[i]);
+			const __m256 NY = _mm256_loadu_ps(&Streams.Normals.Y[i]);
+			const __m256 NZ = _mm256_loadu_ps(&Streams.Normals.Z[i]);
+			const __m256 TX = _mm256_loadu_ps(&Streams.Tangents.X[i]);
+			const __m256 TY = _mm256_loadu_ps(&Streams.Tangents.Y[i]);
+			const __m256 TZ = _mm256_loadu_ps(&Streams.Tangents.Z[i]);
+
+			// 0..2 위치, 3..5 노말, 6..8 탄젠트
+			__m256 Out[9];
+			for (int32 Row = 0; Row < 3; ++Row)
+			{
+				Out[Row] = _mm256_fmadd_ps(M[Row][2], PZ, _mm256_fmadd_ps(M[Row][1], PY, _mm256_fmadd_ps(M[Row][0], PX, M[Row][3])));
+				Out[3 + Row] = _mm256_fmadd_ps(N[Row][2], NZ, _mm256_fmadd_ps(N[Row][1], NY, _mm256_mul_ps(N[Row][0], NX)));
+				Out[6 + Row] = _mm256_fmadd_ps(M[Row][2], TZ, _mm256_fmadd_ps(M[Row][1], TY, _mm256_mul_ps(M[Row][0], TX)));
+			}
+			Normalize8(Out[3], Out[4], Out[5]);
+			Normalize8(Out[6], Out[7], Out[8]);
+
+			// 바뀐 속성만 정점 버퍼 배치로 흩어 쓴다
+			alignas(32) float Lanes[9][8];
+			for (int32 Attribute = 0; Attribute < 9; ++Attribute)
+			{
+				_mm256_store_ps(Lanes[Attribute], Out[Attribute]);
+			}
+			for (int32 Lane = 0; Lane < 8; ++Lane)
+			{
+				FSkinnedVertex& Vertex = OutVertices[i + Lane];
+				Vertex.Position = FVector(Lanes[0][Lane], Lanes[1][Lane], Lanes[2][Lane]);
+				Vertex.Normal = FVector(Lanes[3][Lane], Lanes[4][Lane], Lanes[5][Lane]);
+				Vertex.Tangent.X = Lanes[6][Lane];
+				Vertex.Tangent.Y = Lanes[7][Lane];
+				Vertex.Tangent.Z = Lanes[8][Lane];
+			}
+		}
+		OutNext = i;
+	}
+}
+
+// ─────────────────────────────
+// FCPUSkinning
+// ─────────────────────────────
+void FCPUSkinning::SkinVertices(
+	const FSkinningStreams& Streams,
+	const TArray<FMatrix3x4>& SkinningMatrices,
+	const TArray<FMatrix3x4>& NormalMatrices,
+	TArray<FSkinnedVertex>& OutVertices)
+{
+	const int32 Count = Streams.Num();
+	assert(OutVertices.Num() == Count);
+	if (Count == 0 || SkinningMatrices.IsEmpty())
+	{
+		return;
+	}
+
+	// 정점끼리 독립이므로 구간마다 나눠 처리
+	FJobSystem::Get().ParallelFor(Count, MinVerticesPerJob, [&](int32 Begin, int32 End)
+	{
+		SkinVertexRange(Streams, SkinningMatrices, NormalMatrices, OutVertices, Begin, End);
+	}, "CPUSkinning");
+}
+
+void FCPUSkinning::SkinVertexRange(
+	const FSkinningStreams& Streams,
+	const TArray<FMatrix3x4>& SkinningMatrices,
+	const TArray<FMatrix3x4>& NormalMatrices,
+	TArray<FSkinnedVertex>& OutVertices,
+	int32 Begin,
+	int32 End)
+{
+	assert(NormalMatrices.Num() == SkinningMatrices.Num());
+
+	int32 i = Begin;
+	if (FSoAMath::IsUsingSIMD())
+	{
+		SkinVerticesAVX2(Streams, SkinningMatrices.data(), NormalMatrices.data(), OutVertices, Begin, End, i);
+	}
+	for (; i < End; ++i)
+	{
+		SkinVertexScalar(Streams, SkinningMatrices.data(), NormalMatrices.data(), OutVertices[i], i);
+	}
+}
@@ -0,0 +1,48 @@
+﻿#pragma once
+#include "VectorSoA.h"
+
+struct FSkinnedVertex;
+
+// CPU 스키닝 입력 스트림 (메시 로드 시 한 번 만든다)
+// FSkinnedVertex(~100바이트) 대신 스키닝에 필요한 속성만 성분별 배열로 나눠 둔다
+// - 본 인덱스/가중치는 정점마다 8비트 4개 (uint32 하나). 가중치는 255 = 1.0, 합이 255 가 되도록 반올림 오차를 가장 큰 가중치에 몰아준다
+// - 본이 256개를 넘으면 8비트 인덱스로 표현할 수 없으므로 만들지 않는다 (IsValid() == false)
+struct FSkinningStreams
+{
+	FVectorSoA Positions;
+	FVectorSoA Normals;
+	FVectorSoA Tangents;            // xyz (w 는 출력 정점에 그대로 남아 있다)
+	TArray<uint32> BoneIndices;     // 정점마다 [0..7] 0번, [8..15] 1번, ... 영향 본 인덱스
+	TArray<uint32> BoneWeights;     // BoneIndices 와 같은 배치의 가중치
+
+	int32 Num() const { return Positions.Num(); }
+	bool IsValid() const { return Num() > 0; }
+
+	void Build(const TArray<FSkinnedVertex>& Vertices, int32 NumBones);
+	void Reset();
+};
+
+// 스트림 기반 CPU 스키닝
+// - 정점 구간을 잡 시스템으로 나누고, 구간 안은 AVX2 로 8 정점씩 처리 (본 행렬은 gather). 미지원 CPU 와 꼬리는 스칼라
+// - 결과는 OutVertices 의 Position / Normal / Tangent.xyz 에만 쓴다. UV, 컬러, 본 데이터는 호출자가 원본에서 한 번 복사해 둔다
+// - 위치/탄젠트는 스키닝 행렬, 노말은 노말 행렬을 가중 합한 뒤 정규화 (USkinnedMeshComponent 의 기존 정점별 경로와 같은 식)
+class FCPUSkinning
+{
+public:
+	static constexpr int32 MinVerticesPerJob = 2048;
+
+	static void SkinVertices(
+		const FSkinningStreams& Streams,
+		const TArray<FMatrix3x4>& SkinningMatrices,
+		const TArray<FMatrix3x4>& NormalMatrices,
+		TArray<FSkinnedVertex>& OutVertices);
+
+	// [Begin, End) 구간만 호출한 스레드에서 처리
+	static void SkinVertexRange(
+		const FSkinningStreams& Streams,
+		const TArray<FMatrix3x4>& SkinningMatrices,
+		const TArray<FMatrix3x4>& NormalMatrices,
+		TArray<FSkinnedVertex>& OutVertices,
+		int32 Begin,
+		int32 End);
+};
@@ -0,0 +1,165 @@
+﻿#include "pch.h"
+#include <random>
+#include "CPUSkinning.h"
+#include "VectorSoA.h"
+#include "Source/Runtime/Core/Misc/VertexData.h"
+#include "Benchmark.h"
+
+namespace
+{
+	constexpr int32 NumVertices = 100000;
+	constexpr int32 NumBones = 67;          // James 스켈레톤 규모
+	constexpr int32 NumIterations = 20;
+
+	// 정점마다 본 1~4개, 가중치 합 1 (FBX 로더와 동일)
+	void BuildVertices(TArray<FSkinnedVertex>& OutVertices, std::mt19937& Random)
+	{
+		std::uniform_real_distribution<float> Unit(-1.0f, 1.0f);
+		std::uniform_real_distribution<float> Positive(0.05f, 1.0f);
+
+		OutVertices.SetNum(NumVertices);
+		for (int32 i = 0; i < NumVertices; ++i)
+		{
+			FSkinnedVertex& Vertex = OutVertices[i];
+			Vertex.Position = FVector(Unit(Random), Unit(Random), Unit(Random) + 1.0f);
+			Vertex.Normal = FVector(Unit(Random), Unit(Random), 1.0f).GetSafeNormal();
+			const FVector Tangent = FVector(1.0f, Unit(Random), Unit(Random)).GetSafeNormal();
+			Vertex.Tangent = FVector4(Tangent.X, Tangent.Y, Tangent.Z, i % 2 == 0 ? 1.0f : -1.0f);
+
+			const int32 NumInfluences = 1 + static_cast<int32>(Random() % 4u);
+			float Sum = 0.0f;
+			for (int32 k = 0; k < 4; ++k)
+			{
+				Vertex.BoneIndices[k] = static_cast<uint32>(Random() % static_cast<uint32>(NumBones));
+				Vertex.BoneWeights[k] = k < NumInfluences ? Positive(Random) : 0.0f;
+				Sum += Vertex.BoneWeights[k];
+			}
+			for (int32 k = 0; k < 4; ++k)
+			{
+				Vertex.BoneWeights[k] /= Sum;
+			}
+		}
+	}
+
+	// 한 정점에 영향을 주는 본들은 실제로 비슷하게 움직이므로 회전 범위를 제한한다
+	void BuildMatrices(TArray<FMatrix3x4>& OutMatrices, TArray<FMatrix3x4>& OutNormalMatrices, std::mt19937& Random)
+	{
+		std::uniform_real_distribution<float> Unit(-1.0f, 1.0f);
+		std::uniform_real_distribution<float> Scale(0.8f, 1.2f);
+
+		OutMatrices.SetNum(NumBones);
+		OutNormalMatrices.SetNum(NumBones);
+		for (int32 i = 0; i < NumBones; ++i)
+		{
+			FVector Axis(Unit(Random), Unit(Random), Unit(Random));
+			if (Axis.SizeSquared() < 1e-4f)
+			{
+				Axis = FVector(0.0f, 0.0f, 1.0f);
+			}
+			const FTransform Transform(
+				FVector(Unit(Random), Unit(Random), Unit(Random)) * 0.2f,
+				FQuat::FromAxisAngle(Axis, Unit(Random) * 0.5f),
+				FVector(Scale(Random), Scale(Random), Scale(Random)));
+			const FMatrix Matrix = Transform.ToMatrix();
+			OutMatrices[i] = FMatrix3x4(Matrix);
+			OutNormalMatrices[i] = FMatrix3x4(Matrix.Inverse().Transpose());
+		}
+	}
+
+	// 기존 구현: 정점마다 영향 본별 행렬 변환 후 가중 합 (USkinnedMeshComponent::SkinVertex*)
+	void SkinLegacy(const TArray<FSkinnedVertex>& SrcVertices, const TArray<FMatrix3x4>& Matrices,
+		const TArray<FMatrix3x4>& NormalMatrices, TArray<FSkinnedVertex>& OutVertices)
+	{
+		for (int32 i = 0; i < SrcVertices.Num(); ++i)
+		{
+			const FSkinnedVertex& Src = SrcVertices[i];
+			const FVector TangentDir(Src.Tangent.X, Src.Tangent.Y, Src.Tangent.Z);
+			FVector Position(0.0f, 0.0f, 0.0f);
+			FVector Normal(0.0f, 0.0f, 0.0f);
+			FVector Tangent(0.0f, 0.0f, 0.0f);
+			for (int32 k = 0; k < 4; ++k)
+			{
+				const float Weight = Src.BoneWeights[k];
+				if (Weight > 0.0f)
+				{
+					Position += Matrices[Src.BoneIndices[k]].TransformPosition(Src.Position) * Weight;
+					Normal += NormalMatrices[Src.BoneIndices[k]].TransformVector(Src.Normal) * Weight;
+					Tangent += Matrices[Src.BoneIndices[k]].TransformVector(TangentDir) * Weight;
+				}
+			}
+			FSkinnedVertex& Dst = OutVertices[i];
+			Dst.Position = Position;
+			Dst.Normal = Normal.GetSafeNormal();
+			const FVector FinalTangent = Tangent.GetSafeNormal();
+			Dst.Tangent = FVector4(FinalTangent.X, FinalTangent.Y, FinalTangent.Z, Src.Tangent.W);
+			Dst.UV = Src.UV;
+		}
+	}
+
+	// 위치 오차와 노말/탄젠트 오차 (가중치 8비트 양자화 오차 포함)
+	void MeasureError(const TArray<FSkinnedVertex>& A, const TArray<FSkinnedVertex>& B, float& OutPositionError, float& OutDirectionError)
+	{
+		OutPositionError = 0.0f;
+		OutDirectionError = 0.0f;
+		for (int32 i = 0; i < A.Num(); ++i)
+		{
+			OutPositionError = std::max(OutPositionError, FVector::Distance(A[i].Position, B[i].Position));
+			OutDirectionError = std::max(OutDirectionError, FVector::Distance(A[i].Normal, B[i].Normal));
+			OutDirectionError = std::max(OutDirectionError, FVector::Distance(
+				FVector(A[i].Tangent.X, A[i].Tangent.Y, A[i].Tangent.Z),
+				FVector(B[i].Tangent.X, B[i].Tangent.Y, B[i].Tangent.Z)));
+		}
+	}
+}
+
+IMPLEMENT_BENCHMARK(CPUSKIN, "CPU skinning of 100k vertices x 67 bones: per-vertex AoS loop vs packed SoA streams (scalar, AVX2, AVX2 + job system)")
+{
+	std::mt19937 Random(2024);
+
+	TArray<FSkinnedVertex> SrcVertices;
+	BuildVertices(SrcVertices, Random);
+
+	TArray<FMatrix3x4> Matrices, NormalMatrices;
+	BuildMatrices(Matrices, NormalMatrices, Random);
+
+	FSkinningStreams Streams;
+	Streams.Build(SrcVertices, NumBones);
+
+	TArray<FSkinnedVertex> LegacyVertices = SrcVertices;
+	TArray<FSkinnedVertex> StreamVertices = SrcVertices;
+
+	auto Run = [&](auto&& Skin)
+	{
+		FBenchTimer Timer;
+		for (int32 Iteration = 0; Iteration < NumIterations; ++Iteration)
+		{
+			Skin();
+		}
+		return Timer.GetMs() / NumIterations;
+	};
+
+	const bool bPrevUseSIMD = FSoAMath::GetUseSIMD();
+
+	const double LegacyMs = Run([&]() { SkinLegacy(SrcVertices, Matrices, NormalMatrices, LegacyVertices); });
+
+	FSoAMath::SetUseSIMD(false);
+	const double ScalarMs = Run([&]() { FCPUSkinning::SkinVertexRange(Streams, Matrices, NormalMatrices, StreamVertices, 0, NumVertices); });
+
+	FSoAMath::SetUseSIMD(true);
+	const double SIMDMs = Run([&]() { FCPUSkinning::SkinVertexRange(Streams, Matrices, NormalMatrices, StreamVertices, 0, NumVertices); });
+	const double ParallelMs = Run([&]() { FCPUSkinning::SkinVertices(Streams, Matrices, NormalMatrices, StreamVertices); });
+
+	float PositionError = 0.0f;
+	float DirectionError = 0.0f;
+	MeasureError(LegacyVertices, StreamVertices, PositionError, DirectionError);
+
+	FSoAMath::SetUseSIMD(bPrevUseSIMD);
+
+	auto VertsPerMs = [](double Ms) { return Ms > 0.0 ? NumVertices / Ms : 0.0; };
+	UE_LOG("[Bench] CPUSkin %d verts x %d bones, verts/ms: legacy %.0f (%.3fms) | streams scalar %.0f (%.3fms) | streams SIMD %.0f (%.3fms) | SIMD + jobs %.0f (%.3fms)  x%.1f",
+		NumVertices, NumBones,
+		VertsPerMs(LegacyMs), LegacyMs, VertsPerMs(ScalarMs), ScalarMs, VertsPerMs(SIMDMs), SIMDMs, VertsPerMs(ParallelMs), ParallelMs,
+		ParallelMs > 0.0 ? LegacyMs / ParallelMs : 0.0);
+	UE_LOG("[Bench] CPUSkin max diff vs legacy: position %.2e, normal/tangent %.2e (8-bit weights), stream input %d bytes/vert vs %d",
+		PositionError, DirectionError, static_cast<int32>(sizeof(float) * 9 + sizeof(uint32) * 2), static_cast<int32>(sizeof(FSkinnedVertex)));
+}
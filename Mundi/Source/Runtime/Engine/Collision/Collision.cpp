@@ -77,7 +77,9 @@ namespace Collision
     bool OverlapSphereAndSphere(const FShape& ShapeA, const FTransform& TransformA, const FShape& ShapeB, const FTransform& TransformB)
     {
         FVector Dist = TransformA.Translation - TransformB.Translation;
-        float SumRadius = ShapeA.Sphere.SphereRadius + ShapeB.Sphere.SphereRadius;
+        // 반지름에 스케일 적용 (구-박스/캡슐 판정과 같은 기준)
+        float SumRadius = ShapeA.Sphere.SphereRadius * UniformScaleMax(AbsVec(TransformA.Scale3D))
+            + ShapeB.Sphere.SphereRadius * UniformScaleMax(AbsVec(TransformB.Scale3D));
 
         return Dist.SizeSquared() <= SumRadius * SumRadius;
     }
@@ -0,0 +1,792 @@
+﻿#include "pch.h"
+#include <cfloat>
+#include "CollisionQuery.h"
+#include "AABB.h"
+#include "Picking.h"
+#include "MeshBVH.h"
+#include "StaticMesh.h"
+#include "StaticMeshComponent.h"
+#include "ResourceManager.h"
+
+namespace
+{
+	// 구 스윕의 전진 반복 상한과 접촉 허용 오차
+	constexpr int32 MaxAdvanceIterations = 32;
+	constexpr float ContactTolerance = 1e-4f;
+
+	FVector ClampToBox(const FVector& Point, const FAABB& Box)
+	{
+		return FVector(
+			std::clamp(Point.X, Box.Min.X, Box.Max.X),
+			std::clamp(Point.Y, Box.Min.Y, Box.Max.Y),
+			std::clamp(Point.Z, Box.Min.Z, Box.Max.Z));
+	}
+
+	// 진행 방향 반대쪽 (방향이 없으면 위쪽)
+	FVector OpposeDirection(const FVector& Delta)
+	{
+		return Delta.IsZero() ? FVector(0.0f, 0.0f, 1.0f) : -Delta.GetSafeNormal();
+	}
+
+	// 삼각형 ABC 위에서 P 에 가장 가까운 점 (보로노이 영역 판정)
+	FVector ClosestPointOnTriangle(const FVector& P, const FVector& A, const FVector& B, const FVector& C)
+	{
+		const FVector AB = B - A;
+		const FVector AC = C - A;
+		const FVector AP = P - A;
+		const float D1 = FVector::Dot(AB, AP);
+		const float D2 = FVector::Dot(AC, AP);
+		if (D1 <= 0.0f && D2 <= 0.0f) return A;
+
+		const FVector BP = P - B;
+		const float D3 = FVector::Dot(AB, BP);
+		const float D4 = FVector::Dot(AC, BP);
+		if (D3 >= 0.0f && D4 <= D3) return B;
+
+		const float VC = D1 * D4 - D3 * D2;
+		if (VC <= 0.0f && D1 >= 0.0f && D3 <= 0.0f)
+		{
+			return A + AB * (D1 / (D1 - D3));
+		}
+
+		const FVector CP = P - C;
+		const float D5 = FVector::Dot(AB, CP);
+		const float D6 = FVector::Dot(AC, CP);
+		if (D6 >= 0.0f && D5 <= D6) return C;
+
+		const float VB = D5 * D2 - D1 * D6;
+		if (VB <= 0.0f && D2 >= 0.0f && D6 <= 0.0f)
+		{
+			return A + AC * (D2 / (D2 - D6));
+		}
+
+		const float VA = D3 * D6 - D5 * D4;
+		if (VA <= 0.0f && (D4 - D3) >= 0.0f && (D5 - D6) >= 0.0f)
+		{
+			return B + (C - B) * ((D4 - D3) / ((D4 - D3) + (D5 - D6)));
+		}
+
+		const float Denom = 1.0f / (VA + VB + VC);
+		return A + AB * (VB * Denom) + AC * (VC * Denom);
+	}
+
+	// 선분 Start + Delta * t 가 구(Center, Radius)에 처음 들어가는 t (0~1). 시작부터 안쪽이면 false (겹침은 따로 판정)
+	bool SegmentSphere(const FVector& Start, const FVector& Delta, const FVector& Center, float Radius, float& OutTime)
+	{
+		const FVector M = Start - Center;
+		const float A = FVector::Dot(Delta, Delta);
+		const float B = FVector::Dot(M, Delta);
+		const float C = FVector::Dot(M, M) - Radius * Radius;
+		if (C <= 0.0f || B >= 0.0f || A < 1e-12f)
+		{
+			return false;
+		}
+		const float Discriminant = B * B - A * C;
+		if (Discriminant < 0.0f)
+		{
+			return false;
+		}
+		const float Time = (-B - std::sqrt(Discriminant)) / A;
+		if (Time > 1.0f)
+		{
+			return false;
+		}
+		OutTime = std::max(Time, 0.0f);
+		return true;
+	}
+
+	// 선분이 변 P0-P1 을 축으로 하는 반지름 Radius 원기둥 옆면에 처음 닿는 t (축 구간 안에서만)
+	bool SegmentEdgeCylinder(const FVector& Start, const FVector& Delta, const FVector& P0, const FVector& P1, float Radius, float& OutTime)
+	{
+		const FVector Axis = P1 - P0;
+		const float AxisLengthSquared = FVector::Dot(Axis, Axis);
+		if (AxisLengthSquared < 1e-12f)
+		{
+			return false;
+		}
+
+		// 축에 수직인 성분만 남겨 2D 원과의 교차로 푼다
+		const FVector M = Start - P0;
+		const FVector PerpDelta = Delta - Axis * (FVector::Dot(Delta, Axis) / AxisLengthSquared);
+		const FVector PerpM = M - Axis * (FVector::Dot(M, Axis) / AxisLengthSquared);
+		const float A = FVector::Dot(PerpDelta, PerpDelta);
+		const float B = FVector::Dot(PerpM, PerpDelta);
+		const float C = FVector::Dot(PerpM, PerpM) - Radius * Radius;
+		if (C <= 0.0f || B >= 0.0f || A < 1e-12f)
+		{
+			return false;
+		}
+		const float Discriminant = B * B - A * C;
+		if (Discriminant < 0.0f)
+		{
+			return false;
+		}
+		const float Time = (-B - std::sqrt(Discriminant)) / A;
+		if (Time > 1.0f)
+		{
+			return false;
+		}
+
+		const float AxisParam = FVector::Dot(M + Delta * Time, Axis) / AxisLengthSquared;
+		if (AxisParam < 0.0f || AxisParam > 1.0f)
+		{
+			return false;
+		}
+		OutTime = std::max(Time, 0.0f);
+		return true;
+	}
+
+	// 구를 Start -> Start + Delta 로 쓸 때 삼각형 ABC 에 처음 닿는 시점 (월드 공간).
+	// 면 -> 변(원기둥) -> 꼭짓점(구) 순으로 가장 이른 접촉을 찾는다
+	bool SweepSphereTriangle(const FVector& Start, const FVector& Delta, float Radius, const FVector& A, const FVector& B, const FVector& C,
+		float& OutTime, FVector& OutNormal, FVector& OutImpactPoint, bool& bOutStartPenetrating)
+	{
+		// 시작 겹침
+		const FVector StartClosest = ClosestPointOnTriangle(Start, A, B, C);
+		const FVector StartOffset = Start - StartClosest;
+		const float StartDistance = StartOffset.Size();
+		if (StartDistance < Radius - ContactTolerance)
+		{
+			OutTime = 0.0f;
+			bOutStartPenetrating = true;
+			OutNormal = StartDistance > KINDA_SMALL_NUMBER ? StartOffset / StartDistance : OpposeDirection(Delta);
+			OutImpactPoint = StartClosest;
+			return true;
+		}
+
+		float BestTime = FLT_MAX;
+		FVector BestContact;
+
+		// 면: 평면까지 거리가 Radius 가 되는 시점의 접점이 삼각형 안이면 그것이 첫 접촉
+		const FVector FaceNormal = FVector::Cross(B - A, C - A).GetSafeNormal();
+		if (!FaceNormal.IsZero())
+		{
+			float PlaneDistance = FVector::Dot(Start - A, FaceNormal);
+			float Approach = FVector::Dot(Delta, FaceNormal);
+			FVector SideNormal = FaceNormal;
+			if (PlaneDistance < 0.0f)
+			{
+				PlaneDistance = -PlaneDistance;
+				Approach = -Approach;
+				SideNormal = -FaceNormal;
+			}
+			if (Approach < 0.0f && PlaneDistance >= Radius)
+			{
+				const float Time = (PlaneDistance - Radius) / -Approach;
+				if (Time <= 1.0f)
+				{
+					const FVector Contact = Start + Delta * Time - SideNormal * Radius;
+					if ((ClosestPointOnTriangle(Contact, A, B, C) - Contact).SizeSquared() < ContactTolerance * ContactTolerance)
+					{
+						BestTime = Time;
+						BestContact = Contact;
+					}
+				}
+			}
+		}
+
+		// 면 안쪽에서 닿았으면 변/꼭짓점이 그보다 먼저 닿을 수 없다
+		if (BestTime == FLT_MAX)
+		{
+			const FVector Vertices[3] = { A, B, C };
+			for (int32 Edge = 0; Edge < 3; ++Edge)
+			{
+				const FVector& P0 = Vertices[Edge];
+				const FVector& P1 = Vertices[(Edge + 1) % 3];
+				float Time;
+				if (SegmentEdgeCylinder(Start, Delta, P0, P1, Radius, Time) && Time < BestTime)
+				{
+					const FVector Axis = P1 - P0;
+					const float AxisParam = FVector::Dot(Start + Delta * Time - P0, Axis) / FVector::Dot(Axis, Axis);
+					BestTime = Time;
+					BestContact = P0 + Axis * AxisParam;
+				}
+				if (SegmentSphere(Start, Delta, P0, Radius, Time) && Time < BestTime)
+				{
+					BestTime = Time;
+					BestContact = P0;
+				}
+			}
+		}
+
+		if (BestTime == FLT_MAX)
+		{
+			return false;
+		}
+
+		const FVector Offset = Start + Delta * BestTime - BestContact;
+		const float Distance = Offset.Size();
+		OutTime = BestTime;
+		bOutStartPenetrating = false;
+		OutNormal = Distance > KINDA_SMALL_NUMBER ? Offset / Distance : OpposeDirection(Delta);
+		OutImpactPoint = BestContact;
+		return true;
+	}
+
+	// 두 선분 P0-P1, Q0-Q1 의 최근접점 매개변수 (각각 0~1)
+	void ClosestSegmentSegment(const FVector& P0, const FVector& P1, const FVector& Q0, const FVector& Q1, float& OutS, float& OutT)
+	{
+		const FVector D1 = P1 - P0;
+		const FVector D2 = Q1 - Q0;
+		const FVector R = P0 - Q0;
+		const float A = FVector::Dot(D1, D1);
+		const float E = FVector::Dot(D2, D2);
+		const float F = FVector::Dot(D2, R);
+		if (A < 1e-12f && E < 1e-12f)
+		{
+			OutS = OutT = 0.0f;
+			return;
+		}
+		if (A < 1e-12f)
+		{
+			OutS = 0.0f;
+			OutT = std::clamp(F / E, 0.0f, 1.0f);
+			return;
+		}
+		const float C = FVector::Dot(D1, R);
+		if (E < 1e-12f)
+		{
+			OutT = 0.0f;
+			OutS = std::clamp(-C / A, 0.0f, 1.0f);
+			return;
+		}
+
+		const float B = FVector::Dot(D1, D2);
+		const float Denom = A * E - B * B;
+		OutS = Denom > 1e-12f ? std::clamp((B * F - C * E) / Denom, 0.0f, 1.0f) : 0.0f;
+		OutT = (B * OutS + F) / E;
+		if (OutT < 0.0f)
+		{
+			OutT = 0.0f;
+			OutS = std::clamp(-C / A, 0.0f, 1.0f);
+		}
+		else if (OutT > 1.0f)
+		{
+			OutT = 1.0f;
+			OutS = std::clamp((B - C) / A, 0.0f, 1.0f);
+		}
+	}
+
+	// 선분 P0-P1 이 삼각형 ABC 를 관통하면 그 점
+	bool SegmentCrossesTriangle(const FVector& P0, const FVector& P1, const FVector& A, const FVector& B, const FVector& C, FVector& OutPoint)
+	{
+		const FVector Normal = FVector::Cross(B - A, C - A);
+		const float D0 = FVector::Dot(P0 - A, Normal);
+		const float D1 = FVector::Dot(P1 - A, Normal);
+		if ((D0 > 0.0f && D1 > 0.0f) || (D0 < 0.0f && D1 < 0.0f) || D0 == D1)
+		{
+			return false;
+		}
+		const FVector Point = P0 + (P1 - P0) * (D0 / (D0 - D1));
+		if ((ClosestPointOnTriangle(Point, A, B, C) - Point).SizeSquared() > ContactTolerance * ContactTolerance)
+		{
+			return false;
+		}
+		OutPoint = Point;
+		return true;
+	}
+
+	// Z 축 캡슐(반구 중심 Start ± (HalfHeight - Radius))을 Start -> Start + Delta 로 쓸 때 삼각형 ABC 에 처음 닿는 시점.
+	// 캡슐은 축 선분 + 구이므로 첫 접촉은 양 끝 반구, 삼각형 꼭짓점 vs 몸통, 삼각형 변 vs 몸통(축과 비스듬히) 중 하나다.
+	// 축이 삼각형 면 안쪽과 평행하게 닿는 경우는 같은 시점에 반구나 변 접촉으로도 잡힌다
+	bool SweepCapsuleTriangle(const FVector& Start, const FVector& Delta, float Radius, float HalfHeight, const FVector& A, const FVector& B, const FVector& C,
+		float& OutTime, FVector& OutNormal, FVector& OutImpactPoint, bool& bOutStartPenetrating)
+	{
+		const FVector AxisOffset(0.0f, 0.0f, std::max(HalfHeight - Radius, 0.0f));
+		const FVector Bottom = Start - AxisOffset;
+		const FVector Top = Start + AxisOffset;
+		const FVector Axis = Top - Bottom;
+		const FVector Vertices[3] = { A, B, C };
+
+		// 시작 겹침: 축 선분과 삼각형 사이 거리 (관통, 양 끝점 vs 삼각형, 축 vs 변)
+		FVector CrossPoint;
+		if (SegmentCrossesTriangle(Bottom, Top, A, B, C, CrossPoint))
+		{
+			OutTime = 0.0f;
+			bOutStartPenetrating = true;
+			OutNormal = OpposeDirection(Delta);
+			OutImpactPoint = CrossPoint;
+			return true;
+		}
+		FVector StartAxisPoint = Bottom;
+		FVector StartTrianglePoint = ClosestPointOnTriangle(Bottom, A, B, C);
+		float StartDistanceSquared = (StartAxisPoint - StartTrianglePoint).SizeSquared();
+		auto ConsiderStart = [&](const FVector& AxisPoint, const FVector& TrianglePoint)
+		{
+			const float DistanceSquared = (AxisPoint - TrianglePoint).SizeSquared();
+			if (DistanceSquared < StartDistanceSquared)
+			{
+				StartDistanceSquared = DistanceSquared;
+				StartAxisPoint = AxisPoint;
+				StartTrianglePoint = TrianglePoint;
+			}
+		};
+		ConsiderStart(Top, ClosestPointOnTriangle(Top, A, B, C));
+		for (int32 Edge = 0; Edge < 3; ++Edge)
+		{
+			const FVector& P0 = Vertices[Edge];
+			const FVector& P1 = Vertices[(Edge + 1) % 3];
+			float S, T;
+			ClosestSegmentSegment(Bottom, Top, P0, P1, S, T);
+			ConsiderStart(Bottom + Axis * S, P0 + (P1 - P0) * T);
+		}
+		const float StartDistance = std::sqrt(StartDistanceSquared);
+		if (StartDistance < Radius - ContactTolerance)
+		{
+			OutTime = 0.0f;
+			bOutStartPenetrating = true;
+			OutNormal = StartDistance > KINDA_SMALL_NUMBER ? (StartAxisPoint - StartTrianglePoint) / StartDistance : OpposeDirection(Delta);
+			OutImpactPoint = StartTrianglePoint;
+			return true;
+		}
+
+		float BestTime = FLT_MAX;
+		FVector BestNormal;
+		FVector BestContact;
+
+		// 양 끝 반구
+		for (const FVector& SphereCenter : { Bottom, Top })
+		{
+			float Time;
+			FVector Normal, ImpactPoint;
+			bool bStartPenetrating;
+			if (SweepSphereTriangle(SphereCenter, Delta, Radius, A, B, C, Time, Normal, ImpactPoint, bStartPenetrating) && Time < BestTime)
+			{
+				BestTime = Time;
+				BestNormal = Normal;
+				BestContact = ImpactPoint;
+			}
+		}
+
+		// 꼭짓점 vs 몸통: 캡슐 기준으로 꼭짓점이 -Delta 로 움직여 축 원기둥 옆면에 닿는 시점
+		for (const FVector& Vertex : Vertices)
+		{
+			float Time;
+			if (SegmentEdgeCylinder(Vertex, -Delta, Bottom, Top, Radius, Time) && Time < BestTime)
+			{
+				const FVector MovedBottom = Bottom + Delta * Time;
+				const float AxisParam = FVector::Dot(Vertex - MovedBottom, Axis) / FVector::Dot(Axis, Axis);
+				BestTime = Time;
+				BestNormal = (MovedBottom + Axis * AxisParam - Vertex).GetSafeNormal();
+				BestContact = Vertex;
+			}
+		}
+
+		// 변 vs 몸통: 두 직선의 공통 수직 거리가 Radius 가 되는 시점에 최근접점이 둘 다 선분 안쪽이면 접촉
+		for (int32 Edge = 0; Edge < 3; ++Edge)
+		{
+			const FVector& P0 = Vertices[Edge];
+			const FVector& P1 = Vertices[(Edge + 1) % 3];
+			FVector Normal = FVector::Cross(P1 - P0, Axis);
+			if (Normal.SizeSquared() < 1e-12f)
+			{
+				continue;
+			}
+			Normal = Normal.GetSafeNormal();
+
+			float Separation = FVector::Dot(Bottom - P0, Normal);
+			float Approach = FVector::Dot(Delta, Normal);
+			if (Separation < 0.0f)
+			{
+				Separation = -Separation;
+				Approach = -Approach;
+				Normal = -Normal;
+			}
+			if (Approach >= 0.0f || Separation < Radius)
+			{
+				continue;
+			}
+			const float Time = (Separation - Radius) / -Approach;
+			if (Time > 1.0f || Time >= BestTime)
+			{
+				continue;
+			}
+
+			float S, T;
+			ClosestSegmentSegment(Bottom + Delta * Time, Top + Delta * Time, P0, P1, S, T);
+			if (S <= 0.0f || S >= 1.0f || T <= 0.0f || T >= 1.0f)
+			{
+				continue;
+			}
+			BestTime = Time;
+			BestNormal = Normal;
+			BestContact = P0 + (P1 - P0) * T;
+		}
+
+		if (BestTime == FLT_MAX)
+		{
+			return false;
+		}
+		OutTime = BestTime;
+		bOutStartPenetrating = false;
+		OutNormal = BestNormal.IsZero() ? OpposeDirection(Delta) : BestNormal;
+		OutImpactPoint = BestContact;
+		return true;
+	}
+
+	// 축 정렬 박스(Start, HalfExtent)를 Start -> Start + Delta 로 쓸 때 삼각형 ABC 에 처음 닿는 시점.
+	// 볼록 다면체끼리이므로 분리축 13개 (박스 면 3, 삼각형 면 1, 박스 축 x 삼각형 변 9) 에서
+	// 투영 구간이 겹치는 시간 구간의 교집합을 구하면, 그 시작이 첫 접촉이고 그때의 축이 접촉 법선이다
+	bool SweepBoxTriangle(const FVector& Start, const FVector& Delta, const FVector& HalfExtent, const FVector& A, const FVector& B, const FVector& C,
+		float& OutTime, FVector& OutNormal, FVector& OutImpactPoint, bool& bOutStartPenetrating)
+	{
+		const FVector Vertices[3] = { A, B, C };
+		const FVector Edges[3] = { B - A, C - B, A - C };
+		const FVector BoxAxes[3] = { FVector(1.0f, 0.0f, 0.0f), FVector(0.0f, 1.0f, 0.0f), FVector(0.0f, 0.0f, 1.0f) };
+
+		FVector Axes[13];
+		int32 NumAxes = 0;
+		for (const FVector& BoxAxis : BoxAxes)
+		{
+			Axes[NumAxes++] = BoxAxis;
+		}
+		Axes[NumAxes++] = FVector::Cross(Edges[0], Edges[1]);
+		for (const FVector& BoxAxis : BoxAxes)
+		{
+			for (const FVector& Edge : Edges)
+			{
+				Axes[NumAxes++] = FVector::Cross(BoxAxis, Edge);
+			}
+		}
+
+		float Enter = -FLT_MAX;
+		float Exit = FLT_MAX;
+		FVector EnterNormal = OpposeDirection(Delta);
+		for (int32 i = 0; i < NumAxes; ++i)
+		{
+			// 평행한 변끼리의 외적은 축이 아니다
+			const float LengthSquared = Axes[i].SizeSquared();
+			if (LengthSquared < 1e-12f)
+			{
+				continue;
+			}
+			const FVector Axis = Axes[i] / std::sqrt(LengthSquared);
+
+			const float Center = FVector::Dot(Start, Axis);
+			const float Extent = HalfExtent.X * std::abs(Axis.X) + HalfExtent.Y * std::abs(Axis.Y) + HalfExtent.Z * std::abs(Axis.Z);
+			float TriangleMin = FLT_MAX;
+			float TriangleMax = -FLT_MAX;
+			for (const FVector& Vertex : Vertices)
+			{
+				const float Projection = FVector::Dot(Vertex, Axis);
+				TriangleMin = std::min(TriangleMin, Projection);
+				TriangleMax = std::max(TriangleMax, Projection);
+			}
+
+			// 박스 구간이 Speed * t 만큼 움직여 Low <= Speed * t <= High 일 때 이 축에서 겹친다.
+			// 허용 오차만큼 좁혀서 닿기만 한 것(바닥에 놓인 박스를 옆이나 위로 옮기는 경우)은 겹침으로 보지 않는다
+			const float Low = TriangleMin - (Center + Extent) + ContactTolerance;
+			const float High = TriangleMax - (Center - Extent) - ContactTolerance;
+			const float Speed = FVector::Dot(Delta, Axis);
+			if (std::abs(Speed) < 1e-8f)
+			{
+				if (Low > 0.0f || High < 0.0f)
+				{
+					return false;
+				}
+				continue;
+			}
+
+			float T0 = Low / Speed;
+			float T1 = High / Speed;
+			FVector Normal = -Axis;
+			if (Speed < 0.0f)
+			{
+				std::swap(T0, T1);
+				Normal = Axis;
+			}
+			if (T0 > Enter)
+			{
+				Enter = T0;
+				EnterNormal = Normal;
+			}
+			Exit = std::min(Exit, T1);
+			if (Enter > Exit || Exit < 0.0f || Enter > 1.0f)
+			{
+				return false;
+			}
+		}
+
+		if (Enter <= 0.0f)
+		{
+			OutTime = 0.0f;
+			bOutStartPenetrating = true;
+			OutNormal = OpposeDirection(Delta);
+			OutImpactPoint = ClosestPointOnTriangle(Start, A, B, C);
+			return true;
+		}
+
+		// 접점: 접촉 시점 박스 중심에서 가장 가까운 삼각형 위의 점
+		OutTime = Enter;
+		bOutStartPenetrating = false;
+		OutNormal = EnterNormal;
+		OutImpactPoint = ClosestPointOnTriangle(Start + Delta * Enter, A, B, C);
+		return true;
+	}
+
+	// 스윕 모양별 삼각형 판정 (선은 반지름 0 인 구)
+	bool SweepShapeTriangle(const FVector& Start, const FVector& Delta, const FCollisionShape& Shape, const FVector& A, const FVector& B, const FVector& C,
+		float& OutTime, FVector& OutNormal, FVector& OutImpactPoint, bool& bOutStartPenetrating)
+	{
+		switch (Shape.Kind)
+		{
+		case ECollisionShapeKind::Capsule:
+			return SweepCapsuleTriangle(Start, Delta, Shape.Radius, Shape.HalfHeight, A, B, C, OutTime, OutNormal, OutImpactPoint, bOutStartPenetrating);
+		case ECollisionShapeKind::Box:
+			return SweepBoxTriangle(Start, Delta, Shape.HalfExtent, A, B, C, OutTime, OutNormal, OutImpactPoint, bOutStartPenetrating);
+		default:
+			return SweepSphereTriangle(Start, Delta, Shape.Radius, A, B, C, OutTime, OutNormal, OutImpactPoint, bOutStartPenetrating);
+		}
+	}
+
+	// 선분 슬랩 테스트. OutAxis = 진입한 면의 축 (시작점이 안쪽이면 -1)
+	bool SegmentAABB(const FVector& Start, const FVector& Delta, const FVector& Min, const FVector& Max, float& OutEnterTime, int32& OutAxis)
+	{
+		float Enter = -FLT_MAX;
+		float Exit = 1.0f;
+		int32 EnterAxis = -1;
+		for (int32 Axis = 0; Axis < 3; ++Axis)
+		{
+			const float S = Start[Axis];
+			const float D = Delta[Axis];
+			if (std::abs(D) < 1e-8f)
+			{
+				if (S < Min[Axis] || S > Max[Axis])
+				{
+					return false;
+				}
+				continue;
+			}
+
+			const float InvD = 1.0f / D;
+			float T0 = (Min[Axis] - S) * InvD;
+			float T1 = (Max[Axis] - S) * InvD;
+			if (T0 > T1)
+			{
+				std::swap(T0, T1);
+			}
+			if (T0 > Enter)
+			{
+				Enter = T0;
+				EnterAxis = Axis;
+			}
+			Exit = std::min(Exit, T1);
+			if (Enter > Exit)
+			{
+				return false;
+			}
+		}
+		if (Exit < 0.0f)
+		{
+			return false;
+		}
+
+		if (Enter <= 0.0f)
+		{
+			OutEnterTime = 0.0f;
+			OutAxis = -1;
+		}
+		else
+		{
+			OutEnterTime = Enter;
+			OutAxis = EnterAxis;
+		}
+		return true;
+	}
+}
+
+namespace CollisionQuery
+{
+	bool IntersectSegmentAABB(const FVector& Start, const FVector& Delta, const FAABB& Box, const FVector& Extent, float& OutEnterTime)
+	{
+		int32 Axis;
+		return SegmentAABB(Start, Delta, Box.Min - Extent, Box.Max + Extent, OutEnterTime, Axis);
+	}
+
+	bool SweepAABB(const FVector& Start, const FVector& Delta, const FCollisionShape& Shape, const FAABB& Box,
+		float& OutTime, FVector& OutNormal, FVector& OutImpactPoint, bool& bOutStartPenetrating)
+	{
+		// 1) 박스를 모양의 반 크기만큼 키운 박스(민코프스키 합)와 중심 선분의 교차
+		const FVector Extent = Shape.GetExtent();
+		float EnterTime = 0.0f;
+		int32 EnterAxis = -1;
+		if (!SegmentAABB(Start, Delta, Box.Min - Extent, Box.Max + Extent, EnterTime, EnterAxis))
+		{
+			return false;
+		}
+
+		if (Shape.Kind != ECollisionShapeKind::Sphere)
+		{
+			// 축 정렬 박스끼리는 키운 박스가 정확하다 (캡슐은 감싸는 박스로 근사)
+			OutTime = EnterTime;
+			bOutStartPenetrating = EnterAxis < 0;
+			if (bOutStartPenetrating)
+			{
+				OutNormal = OpposeDirection(Delta);
+			}
+			else
+			{
+				OutNormal = FVector(0.0f, 0.0f, 0.0f);
+				OutNormal[EnterAxis] = Delta[EnterAxis] > 0.0f ? -1.0f : 1.0f;
+			}
+			OutImpactPoint = ClampToBox(Start + Delta * OutTime, Box);
+			return true;
+		}
+
+		// 2) 구: 키운 박스의 모서리/꼭짓점은 실제로는 둥글다.
+		//    박스까지 거리 - 반지름 만큼은 겹치지 않고 전진할 수 있으므로 접촉할 때까지 반복 전진 (conservative advancement)
+		const float Radius = Shape.Radius;
+		const float Length = Delta.Size();
+		float Time = EnterTime;
+		for (int32 Iteration = 0; Iteration < MaxAdvanceIterations; ++Iteration)
+		{
+			const FVector Center = Start + Delta * Time;
+			const FVector Closest = ClampToBox(Center, Box);
+			const FVector Offset = Center - Closest;
+			const float Distance = Offset.Size();
+			if (Distance <= Radius + ContactTolerance)
+			{
+				OutTime = Time;
+				bOutStartPenetrating = Time == 0.0f && Distance < Radius - ContactTolerance;
+				OutNormal = Distance > KINDA_SMALL_NUMBER ? Offset / Distance : OpposeDirection(Delta);
+				OutImpactPoint = Closest;
+				return true;
+			}
+			if (Length < KINDA_SMALL_NUMBER)
+			{
+				return false;
+			}
+
+			Time += (Distance - Radius) / Length;
+			if (Time > 1.0f)
+			{
+				return false;
+			}
+		}
+		// 스치듯 지나가는 경우 (수렴 전에 반복 상한)
+		return false;
+	}
+
+	bool SweepStaticMesh(const UStaticMeshComponent* Component, const FVector& Start, const FVector& Delta, const FCollisionShape& Shape,
+		float& OutTime, FVector& OutNormal, FVector& OutImpactPoint, bool& bOutStartPenetrating)
+	{
+		UStaticMesh* MeshRes = Component->GetStaticMesh();
+		if (!MeshRes)
+		{
+			return false;
+		}
+
+		// RaycastStaticMesh 와 같은 이유로 캐시된 BVH 만 읽는다
+		const FMeshBVH* BVH = UResourceManager::GetInstance().GetMeshBVH(MeshRes->GetAssetPathFileName());
+		if (!BVH)
+		{
+			return false;
+		}
+
+		// 스윕이 지나가는 월드 박스를 로컬로 옮겨 후보 삼각형만 모은다 (비균등 스케일이어도 보수적)
+		const FMatrix WorldMatrix = Component->GetWorldMatrix();
+		const FMatrix InvWorld = WorldMatrix.InverseAffine();
+		const FVector End = Start + Delta;
+		const FVector Inflate = Shape.GetExtent();
+		FVector SweepMin = Start;
+		FVector SweepMax = Start;
+		const FAABB SweepBounds(SweepMin.ComponentMin(End) - Inflate, SweepMax.ComponentMax(End) + Inflate);
+
+		FVector LocalMin(FLT_MAX, FLT_MAX, FLT_MAX);
+		FVector LocalMax(-FLT_MAX, -FLT_MAX, -FLT_MAX);
+		for (const FVector& Corner : SweepBounds.GetVertices())
+		{
+			const FVector LocalCorner = InvWorld.TransformPosition(Corner);
+			LocalMin = LocalMin.ComponentMin(LocalCorner);
+			LocalMax = LocalMax.ComponentMax(LocalCorner);
+		}
+
+		thread_local TArray<FVector> Triangles;
+		Triangles.clear();
+		BVH->GatherTriangles(FAABB(LocalMin, LocalMax), Triangles);
+
+		// 스윕 모양은 월드 축 정렬이므로 삼각형을 월드로 옮겨 판정한다 (메시 회전/스케일과 무관)
+		bool bHit = false;
+		OutTime = FLT_MAX;
+		for (int32 i = 0; i + 2 < Triangles.Num(); i += 3)
+		{
+			float Time;
+			FVector Normal, ImpactPoint;
+			bool bStartPenetrating;
+			if (!SweepShapeTriangle(Start, Delta, Shape,
+				WorldMatrix.TransformPosition(Triangles[i]),
+				WorldMatrix.TransformPosition(Triangles[i + 1]),
+				WorldMatrix.TransformPosition(Triangles[i + 2]),
+				Time, Normal, ImpactPoint, bStartPenetrating))
+			{
+				continue;
+			}
+			if (Time < OutTime)
+			{
+				bHit = true;
+				OutTime = Time;
+				OutNormal = Normal;
+				OutImpactPoint = ImpactPoint;
+				bOutStartPenetrating = bStartPenetrating;
+			}
+		}
+		return bHit;
+	}
+
+	bool RaycastStaticMesh(const UStaticMeshComponent* Component, const FVector& Start, const FVector& Direction, float MaxDistance,
+		float& OutDistance, FVector& OutNormal)
+	{
+		UStaticMesh* MeshRes = Component->GetStaticMesh();
+		if (!MeshRes)
+		{
+			return false;
+		}
+
+		// 여러 스레드에서 부르므로 빌드하지 않고 캐시된 BVH 만 읽는다 (메시 로드 시 만들어짐)
+		const FMeshBVH* BVH = UResourceManager::GetInstance().GetMeshBVH(MeshRes->GetAssetPathFileName());
+		if (!BVH)
+		{
+			return false;
+		}
+
+		// 로컬 공간에서의 레이로 변환
+		const FMatrix WorldMatrix = Component->GetWorldMatrix();
+		const FMatrix InvWorld = WorldMatrix.InverseAffine();
+		const FVector4 LocalOrigin4 = FVector4(Start.X, Start.Y, Start.Z, 1.0f) * InvWorld;
+		const FVector4 LocalDir4 = FVector4(Direction.X, Direction.Y, Direction.Z, 0.0f) * InvWorld;
+		const FRay LocalRay{ FVector(LocalOrigin4.X, LocalOrigin4.Y, LocalOrigin4.Z), FVector(LocalDir4.X, LocalDir4.Y, LocalDir4.Z) };
+
+		float LocalDistance = 0.0f;
+		FVector LocalNormal;
+		if (!BVH->IntersectRay(LocalRay, LocalDistance, LocalNormal))
+		{
+			return false;
+		}
+
+		// 로컬 교차점을 월드로 되돌려 월드 거리 계산
+		const FVector4 HitWorld4 = FVector4(
+			LocalRay.Origin.X + LocalRay.Direction.X * LocalDistance,
+			LocalRay.Origin.Y + LocalRay.Direction.Y * LocalDistance,
+			LocalRay.Origin.Z + LocalRay.Direction.Z * LocalDistance, 1.0f) * WorldMatrix;
+		const float WorldDistance = (FVector(HitWorld4.X, HitWorld4.Y, HitWorld4.Z) - Start).Size();
+		if (WorldDistance > MaxDistance)
+		{
+			return false;
+		}
+
+		// 법선은 역행렬의 전치로 변환 (비균등 스케일 대응)
+		FVector WorldNormal(
+			InvWorld.M[0][0] * LocalNormal.X + InvWorld.M[0][1] * LocalNormal.Y + InvWorld.M[0][2] * LocalNormal.Z,
+			InvWorld.M[1][0] * LocalNormal.X + InvWorld.M[1][1] * LocalNormal.Y + InvWorld.M[1][2] * LocalNormal.Z,
+			InvWorld.M[2][0] * LocalNormal.X + InvWorld.M[2][1] * LocalNormal.Y + InvWorld.M[2][2] * LocalNormal.Z);
+		WorldNormal = WorldNormal.GetSafeNormal();
+		if (FVector::Dot(WorldNormal, Direction) > 0.0f)
+		{
+			WorldNormal = -WorldNormal;
+		}
+
+		OutDistance = WorldDistance;
+		OutNormal = WorldNormal;
+		return true;
+	}
+}
@@ -0,0 +1,126 @@
+﻿#pragma once
+#include "Vector.h"
+
+class AActor;
+class UPrimitiveComponent;
+class UStaticMeshComponent;
+struct FAABB;
+
+// 스윕에 쓰는 모양. 모두 월드 축 정렬 (캡슐은 Z 축이 길이 방향)
+enum class ECollisionShapeKind : uint8
+{
+	Line,       // 레이/선분 (두께 없음)
+	Sphere,
+	Capsule,
+	Box,
+};
+
+struct FCollisionShape
+{
+	ECollisionShapeKind Kind = ECollisionShapeKind::Line;
+	float Radius = 0.0f;
+	float HalfHeight = 0.0f;    // 캡슐 전체 높이의 절반 (반구 포함)
+	FVector HalfExtent;         // 박스
+
+	static FCollisionShape MakeLine() { return FCollisionShape(); }
+	static FCollisionShape MakeSphere(float InRadius)
+	{
+		FCollisionShape Shape;
+		Shape.Kind = ECollisionShapeKind::Sphere;
+		Shape.Radius = InRadius;
+		return Shape;
+	}
+	static FCollisionShape MakeCapsule(float InRadius, float InHalfHeight)
+	{
+		FCollisionShape Shape;
+		Shape.Kind = ECollisionShapeKind::Capsule;
+		Shape.Radius = InRadius;
+		Shape.HalfHeight = std::max(InHalfHeight, InRadius);
+		return Shape;
+	}
+	static FCollisionShape MakeBox(const FVector& InHalfExtent)
+	{
+		FCollisionShape Shape;
+		Shape.Kind = ECollisionShapeKind::Box;
+		Shape.HalfExtent = InHalfExtent;
+		return Shape;
+	}
+
+	bool IsLine() const { return Kind == ECollisionShapeKind::Line; }
+
+	// 모양을 감싸는 축 정렬 박스의 반 크기
+	FVector GetExtent() const
+	{
+		switch (Kind)
+		{
+		case ECollisionShapeKind::Sphere:  return FVector(Radius, Radius, Radius);
+		case ECollisionShapeKind::Capsule: return FVector(Radius, Radius, HalfHeight);
+		case ECollisionShapeKind::Box:     return HalfExtent;
+		default:                           return FVector(0.0f, 0.0f, 0.0f);
+		}
+	}
+};
+
+// 쿼리 하나의 결과 한 건
+struct FQueryHit
+{
+	AActor* Actor = nullptr;
+	UPrimitiveComponent* Component = nullptr;
+	FVector Location;       // 맞은 순간 모양의 중심 (레이는 ImpactPoint 와 같음)
+	FVector ImpactPoint;    // 맞은 표면 위의 점
+	FVector Normal;         // 맞은 표면의 법선 (쿼리 방향 반대쪽)
+	float Distance = 0.0f;  // Start 에서 Location 까지
+	bool bStartPenetrating = false;   // 시작 위치에서 이미 겹쳐 있음 (Distance = 0)
+
+	bool operator<(const FQueryHit& Other) const { return Distance < Other.Distance; }
+};
+
+/**
+ * 월드 BVH 에 대한 스윕/레이 쿼리.
+ * - Start -> End 로 Shape 를 쓸고 지나가며 맞은 프리미티브를 찾는다. Shape 가 Line 이면 레이캐스트.
+ * - bMultiHit 이면 경로 위의 모든 프리미티브를 거리순으로, 아니면 가장 가까운 하나만.
+ * - 스태틱 메시는 삼각형(FMeshBVH) 단위로, 그 외 프리미티브는 월드 AABB 단위로 판정한다.
+ *   구 스윕은 AABB 와의 정확한 접촉 시점, 박스 스윕은 AABB 민코프스키 합으로 정확하고 캡슐은 감싸는 박스로 근사한다.
+ *   스태틱 메시는 스윕도 삼각형 단위로 판정한다: 구/캡슐/박스 모두 삼각형과의 정확한 첫 접촉 (시작 위치와 무관).
+ * - bBlockingOnly 이면 bBlockComponent 가 꺼진 프리미티브는 건너뛴다 (발사체처럼 막히는 것만 필요한 쿼리용).
+ * - 트리는 마지막 UWorldPartitionManager::Update 시점의 바운드를 쓴다.
+ */
+struct FCollisionQuery
+{
+	FVector Start;
+	FVector End;
+	FCollisionShape Shape;
+	bool bMultiHit = false;
+	bool bBlockingOnly = false;
+	const AActor* IgnoredActor = nullptr;
+};
+
+struct FCollisionQueryResult
+{
+	TArray<FQueryHit> Hits;    // 거리 오름차순
+
+	bool HasHit() const { return !Hits.IsEmpty(); }
+	const FQueryHit* GetFirstHit() const { return Hits.IsEmpty() ? nullptr : &Hits[0]; }
+};
+
+namespace CollisionQuery
+{
+	/**
+	 * Shape 를 Start -> Start + Delta 로 쓸 때 Box 와 처음 닿는 시점 (0~1).
+	 * 시작부터 겹치면 OutTime = 0, bStartPenetrating. OutNormal 은 Box 표면 법선, OutImpactPoint 는 Box 위의 접점.
+	 */
+	bool SweepAABB(const FVector& Start, const FVector& Delta, const FCollisionShape& Shape, const FAABB& Box,
+		float& OutTime, FVector& OutNormal, FVector& OutImpactPoint, bool& bOutStartPenetrating);
+
+	// Box 를 Extent 만큼 키워 선분과 교차 (BVH 노드 컬링용, 법선 없이 진입 시점만)
+	bool IntersectSegmentAABB(const FVector& Start, const FVector& Delta, const FAABB& Box, const FVector& Extent, float& OutEnterTime);
+
+	// Shape 를 Start -> Start + Delta 로 쓸 때 스태틱 메시 삼각형과 처음 닿는 시점 (0~1, 월드 공간). 선은 반지름 0 인 구로 본다.
+	// 시작부터 삼각형과 겹치면 OutTime = 0, bStartPenetrating. RaycastStaticMesh 처럼 여러 스레드에서 동시에 호출 가능
+	bool SweepStaticMesh(const UStaticMeshComponent* Component, const FVector& Start, const FVector& Delta, const FCollisionShape& Shape,
+		float& OutTime, FVector& OutNormal, FVector& OutImpactPoint, bool& bOutStartPenetrating);
+
+	// 스태틱 메시 삼각형 레이캐스트 (월드 공간). 캐시된 FMeshBVH 만 읽으므로 여러 스레드에서 동시에 호출 가능
+	bool RaycastStaticMesh(const UStaticMeshComponent* Component, const FVector& Start, const FVector& Direction, float MaxDistance,
+		float& OutDistance, FVector& OutNormal);
+}
@@ -4,6 +4,7 @@
 #include "Frustum.h"
 #include "CameraComponent.h"
 #include <immintrin.h> // For SSE, AVX, FMA instructions
+#include <cfloat>
 
 
 
@@ -152,6 +153,51 @@ FFrustum CreateFrustumFromCamera(const UCameraComponent& Camera, float OverrideA
     return Result;
 }
 
+namespace
+{
+    // 평면 a*x + b*y + c*z + d >= 0 (클립 내부) 을 dot(N, X) - D >= 0 형태로 정규화
+    FPlane MakePlaneFromClip(float A, float B, float C, float D)
+    {
+        const float Len = std::sqrt(A * A + B * B + C * C);
+        if (Len <= 0.0f)
+        {
+            // 퇴화된 평면: 항상 통과
+            return FPlane{ FVector4(0.0f, 0.0f, 0.0f, 0.0f), -FLT_MAX };
+        }
+        const float InvLen = 1.0f / Len;
+        return FPlane{ FVector4(A * InvLen, B * InvLen, C * InvLen, 0.0f), -D * InvLen };
+    }
+}
+
+FFrustum CreateFrustumFromViewProjection(const FMatrix& ViewProj)
+{
+    // row-vector 규약(p' = p * VP)이므로 클립 좌표의 성분 i 는 VP 의 i 번째 열과의 내적이다.
+    // 클립 내부: -w <= x <= w, -w <= y <= w, 0 <= z <= w
+    float Col[4][4];
+    for (int32 i = 0; i < 4; ++i)
+    {
+        for (int32 r = 0; r < 4; ++r)
+        {
+            Col[i][r] = ViewProj.M[r][i];
+        }
+    }
+    // w + Sign * (성분 i)
+    const auto CombineW = [&Col](int32 i, float Sign)
+    {
+        return MakePlaneFromClip(Col[3][0] + Sign * Col[i][0], Col[3][1] + Sign * Col[i][1],
+            Col[3][2] + Sign * Col[i][2], Col[3][3] + Sign * Col[i][3]);
+    };
+
+    FFrustum Result;
+    Result.LeftFace = CombineW(0, +1.0f);
+    Result.RightFace = CombineW(0, -1.0f);
+    Result.BottomFace = CombineW(1, +1.0f);
+    Result.TopFace = CombineW(1, -1.0f);
+    Result.NearFace = MakePlaneFromClip(Col[2][0], Col[2][1], Col[2][2], Col[2][3]);
+    Result.FarFace = CombineW(2, -1.0f);
+    return Result;
+}
+
 // ------------------------------------------------------------
 // AABB vs 프러스텀 판정
 //  - 각 평면에 대해: 중심의 부호 + 박스의 "프로젝션 반경"으로 배제 테스트
@@ -26,6 +26,8 @@ struct FFrustum
 };
 
 FFrustum CreateFrustumFromCamera(const UCameraComponent& Camera, float OverrideAspect = -1.0f);
+// View * Projection 행렬(row-vector, D3D 깊이 0~1)에서 평면 추출. 직교/원근, 그림자 뷰 모두 사용 가능
+FFrustum CreateFrustumFromViewProjection(const FMatrix& ViewProj);
 bool IsAABBVisible(const FFrustum& Frustum, const FAABB& Bound);
 bool IsAABBIntersects(const FFrustum& Frustum, const FAABB& Bound);
 
@@ -0,0 +1,429 @@
+﻿#include "pch.h"
+#include "NarrowPhase.h"
+#include "AABB.h"
+#include "Collision.h"
+#include "ShapeComponent.h"
+#include <immintrin.h>
+
+namespace
+{
+    using namespace Collision;
+
+    // 종류 조합 (KindA <= KindB 로 정규화)
+    enum EPairKernel : int32
+    {
+        BoxBox = 0,
+        BoxSphere,
+        BoxCapsule,
+        SphereSphere,
+        SphereCapsule,
+        CapsuleCapsule,
+        NumPairKernels
+    };
+
+    // [KindA][KindB] -> 커널 (KindA <= KindB 만 사용)
+    constexpr EPairKernel PairKernelLUT[3][3] =
+    {
+        /* Box    */ { BoxBox,       BoxSphere,     BoxCapsule },
+        /* Sphere */ { BoxSphere,    SphereSphere,  SphereCapsule },
+        /* Capsule*/ { BoxCapsule,   SphereCapsule, CapsuleCapsule }
+    };
+
+    // ㅡㅡㅡㅡㅡㅡㅡㅡㅡㅡ스칼라 판정ㅡㅡㅡㅡㅡㅡㅡㅡㅡㅡ
+    inline bool SphereSphereScalar(const FVector& Pos0, float Radius0, const FVector& Pos1, float Radius1)
+    {
+        const FVector d = Pos0 - Pos1;
+        const float rs = Radius0 + Radius1;
+        return d.SizeSquared() <= rs * rs;
+    }
+
+    // ㅡㅡㅡㅡㅡㅡㅡㅡㅡㅡSSE 4쌍 판정ㅡㅡㅡㅡㅡㅡㅡㅡㅡㅡ
+    // 레인 i = 그룹 안의 i 번째 쌍. 결과는 레인별 마스크 (겹치면 모든 비트 1)
+    struct FVector4x
+    {
+        __m128 X, Y, Z;
+    };
+
+    struct FOBB4x
+    {
+        FVector4x Center;
+        FVector4x Axes[3];
+        __m128 HalfExtent[3];
+    };
+
+    inline FVector4x Sub(const FVector4x& A, const FVector4x& B)
+    {
+        return { _mm_sub_ps(A.X, B.X), _mm_sub_ps(A.Y, B.Y), _mm_sub_ps(A.Z, B.Z) };
+    }
+
+    inline __m128 Dot(const FVector4x& A, const FVector4x& B)
+    {
+        return _mm_add_ps(_mm_add_ps(_mm_mul_ps(A.X, B.X), _mm_mul_ps(A.Y, B.Y)), _mm_mul_ps(A.Z, B.Z));
+    }
+
+    inline FVector4x Cross(const FVector4x& A, const FVector4x& B)
+    {
+        return {
+            _mm_sub_ps(_mm_mul_ps(A.Y, B.Z), _mm_mul_ps(A.Z, B.Y)),
+            _mm_sub_ps(_mm_mul_ps(A.Z, B.X), _mm_mul_ps(A.X, B.Z)),
+            _mm_sub_ps(_mm_mul_ps(A.X, B.Y), _mm_mul_ps(A.Y, B.X))
+        };
+    }
+
+    inline __m128 Abs(__m128 V)
+    {
+        return _mm_andnot_ps(_mm_set1_ps(-0.0f), V);
+    }
+
+    inline bool AllLanes(__m128 Mask)
+    {
+        return _mm_movemask_ps(Mask) == 0xF;
+    }
+
+    inline FVector4x GatherVector(const FVector& V0, const FVector& V1, const FVector& V2, const FVector& V3)
+    {
+        return { _mm_setr_ps(V0.X, V1.X, V2.X, V3.X), _mm_setr_ps(V0.Y, V1.Y, V2.Y, V3.Y), _mm_setr_ps(V0.Z, V1.Z, V2.Z, V3.Z) };
+    }
+
+    inline FVector4x GatherCenter(const FWorldShape* const S[4])
+    {
+        return GatherVector(S[0]->Obb.Center, S[1]->Obb.Center, S[2]->Obb.Center, S[3]->Obb.Center);
+    }
+
+    inline FVector4x GatherP0(const FWorldShape* const S[4])
+    {
+        return GatherVector(S[0]->P0, S[1]->P0, S[2]->P0, S[3]->P0);
+    }
+
+    inline FVector4x GatherP1(const FWorldShape* const S[4])
+    {
+        return GatherVector(S[0]->P1, S[1]->P1, S[2]->P1, S[3]->P1);
+    }
+
+    inline __m128 GatherRadius(const FWorldShape* const S[4])
+    {
+        return _mm_setr_ps(S[0]->Radius, S[1]->Radius, S[2]->Radius, S[3]->Radius);
+    }
+
+    inline FOBB4x GatherOBB(const FWorldShape* const S[4])
+    {
+        FOBB4x Out;
+        Out.Center = GatherCenter(S);
+        for (int32 i = 0; i < 3; ++i)
+        {
+            Out.Axes[i] = GatherVector(S[0]->Obb.Axes[i], S[1]->Obb.Axes[i], S[2]->Obb.Axes[i], S[3]->Obb.Axes[i]);
+            Out.HalfExtent[i] = _mm_setr_ps(S[0]->Obb.HalfExtent[i], S[1]->Obb.HalfExtent[i], S[2]->Obb.HalfExtent[i], S[3]->Obb.HalfExtent[i]);
+        }
+        return Out;
+    }
+
+    inline __m128 SphereSphere4(const FVector4x& C0, __m128 R0, const FVector4x& C1, __m128 R1)
+    {
+        const FVector4x d = Sub(C0, C1);
+        const __m128 rs = _mm_add_ps(R0, R1);
+        return _mm_cmple_ps(Dot(d, d), _mm_mul_ps(rs, rs));
+    }
+
+    // Overlap_Sphere_OBB 와 같은 식: OBB 축 좌표로 클램프한 최근접점까지 거리
+    inline __m128 SphereOBB4(const FVector4x& Center, __m128 Radius, const FOBB4x& B)
+    {
+        const FVector4x Dist = Sub(Center, B.Center);
+        __m128 Dist2 = _mm_setzero_ps();
+        for (int32 i = 0; i < 3; ++i)
+        {
+            const __m128 d = Dot(Dist, B.Axes[i]);
+            const __m128 h = B.HalfExtent[i];
+            const __m128 Clamped = _mm_min_ps(_mm_max_ps(d, _mm_sub_ps(_mm_setzero_ps(), h)), h);
+            const __m128 Diff = _mm_sub_ps(d, Clamped);
+            Dist2 = _mm_add_ps(Dist2, _mm_mul_ps(Diff, Diff));
+        }
+        return _mm_cmple_ps(Dist2, _mm_mul_ps(Radius, Radius));
+    }
+
+    // Overlap_OBB_OBB 와 같은 15축 SAT. 축을 정규화하지 않고 양변에 같은 길이가 곱해진 채로 비교한다
+    inline __m128 OBBOBB4(const FOBB4x& A, const FOBB4x& B)
+    {
+        const __m128 Eps = _mm_set1_ps(1e-6f);
+        const FVector4x D = Sub(B.Center, A.Center);
+        __m128 Separated = _mm_setzero_ps();
+
+        auto TestAxis = [&](const FVector4x& Axis)
+            {
+                const __m128 ra = _mm_add_ps(_mm_add_ps(
+                    _mm_mul_ps(A.HalfExtent[0], Abs(Dot(A.Axes[0], Axis))),
+                    _mm_mul_ps(A.HalfExtent[1], Abs(Dot(A.Axes[1], Axis)))),
+                    _mm_mul_ps(A.HalfExtent[2], Abs(Dot(A.Axes[2], Axis))));
+                const __m128 rb = _mm_add_ps(_mm_add_ps(
+                    _mm_mul_ps(B.HalfExtent[0], Abs(Dot(B.Axes[0], Axis))),
+                    _mm_mul_ps(B.HalfExtent[1], Abs(Dot(B.Axes[1], Axis)))),
+                    _mm_mul_ps(B.HalfExtent[2], Abs(Dot(B.Axes[2], Axis))));
+
+                // 축이 너무 짧으면(평행·중복) 건너뜀
+                const __m128 Valid = _mm_cmpge_ps(Dot(Axis, Axis), Eps);
+                const __m128 Gap = _mm_cmpgt_ps(Abs(Dot(D, Axis)), _mm_add_ps(ra, rb));
+                Separated = _mm_or_ps(Separated, _mm_and_ps(Valid, Gap));
+            };
+
+        for (int32 i = 0; i < 3; ++i)
+        {
+            TestAxis(A.Axes[i]);
+        }
+        for (int32 i = 0; i < 3; ++i)
+        {
+            TestAxis(B.Axes[i]);
+        }
+
+        // 네 쌍 모두 면 법선에서 분리되면 교차축은 건너뜀
+        if (!AllLanes(Separated))
+        {
+            for (int32 i = 0; i < 3; ++i)
+            {
+                for (int32 j = 0; j < 3; ++j)
+                {
+                    TestAxis(Cross(A.Axes[i], B.Axes[j]));
+                }
+            }
+        }
+        return _mm_cmpeq_ps(Separated, _mm_setzero_ps());
+    }
+
+    // First/Second 는 종류가 KindA <= KindB 순으로 정렬된 4쌍
+    using FPairKernel = __m128(*)(const FWorldShape* const First[4], const FWorldShape* const Second[4]);
+
+    __m128 KernelBoxBox(const FWorldShape* const First[4], const FWorldShape* const Second[4])
+    {
+        return OBBOBB4(GatherOBB(First), GatherOBB(Second));
+    }
+
+    __m128 KernelBoxSphere(const FWorldShape* const First[4], const FWorldShape* const Second[4])
+    {
+        return SphereOBB4(GatherCenter(Second), GatherRadius(Second), GatherOBB(First));
+    }
+
+    // 캡슐은 구 - OBB - 구로 구성되었다고 가정했다 (Collision.cpp 와 같음)
+    __m128 KernelBoxCapsule(const FWorldShape* const First[4], const FWorldShape* const Second[4])
+    {
+        const FOBB4x Box = GatherOBB(First);
+        const __m128 Radius = GatherRadius(Second);
+
+        __m128 Hit = OBBOBB4(GatherOBB(Second), Box);
+        if (AllLanes(Hit))
+        {
+            return Hit;
+        }
+        Hit = _mm_or_ps(Hit, SphereOBB4(GatherP1(Second), Radius, Box));
+        Hit = _mm_or_ps(Hit, SphereOBB4(GatherP0(Second), Radius, Box));
+        return Hit;
+    }
+
+    __m128 KernelSphereSphere(const FWorldShape* const First[4], const FWorldShape* const Second[4])
+    {
+        return SphereSphere4(GatherCenter(First), GatherRadius(First), GatherCenter(Second), GatherRadius(Second));
+    }
+
+    __m128 KernelSphereCapsule(const FWorldShape* const First[4], const FWorldShape* const Second[4])
+    {
+        const FVector4x Center = GatherCenter(First);
+        const __m128 SphereRadius = GatherRadius(First);
+        const __m128 CapsuleRadius = GatherRadius(Second);
+
+        __m128 Hit = SphereOBB4(Center, SphereRadius, GatherOBB(Second));
+        if (AllLanes(Hit))
+        {
+            return Hit;
+        }
+        Hit = _mm_or_ps(Hit, SphereSphere4(Center, SphereRadius, GatherP1(Second), CapsuleRadius));
+        Hit = _mm_or_ps(Hit, SphereSphere4(Center, SphereRadius, GatherP0(Second), CapsuleRadius));
+        return Hit;
+    }
+
+    __m128 KernelCapsuleCapsule(const FWorldShape* const First[4], const FWorldShape* const Second[4])
+    {
+        const FOBB4x CoreA = GatherOBB(First);
+        const FOBB4x CoreB = GatherOBB(Second);
+
+        // 1) Core vs Core
+        __m128 Hit = OBBOBB4(CoreA, CoreB);
+        if (AllLanes(Hit))
+        {
+            return Hit;
+        }
+
+        const FVector4x ABottom = GatherP0(First);
+        const FVector4x ATop = GatherP1(First);
+        const FVector4x BBottom = GatherP0(Second);
+        const FVector4x BTop = GatherP1(Second);
+        const __m128 RadiusA = GatherRadius(First);
+        const __m128 RadiusB = GatherRadius(Second);
+
+        // 2) Core vs Sphere
+        Hit = _mm_or_ps(Hit, SphereOBB4(BTop, RadiusB, CoreA));
+        Hit = _mm_or_ps(Hit, SphereOBB4(BBottom, RadiusB, CoreA));
+        Hit = _mm_or_ps(Hit, SphereOBB4(ATop, RadiusA, CoreB));
+        Hit = _mm_or_ps(Hit, SphereOBB4(ABottom, RadiusA, CoreB));
+        if (AllLanes(Hit))
+        {
+            return Hit;
+        }
+
+        // 3) Sphere Sphere
+        Hit = _mm_or_ps(Hit, SphereSphere4(ATop, RadiusA, BTop, RadiusB));
+        Hit = _mm_or_ps(Hit, SphereSphere4(ATop, RadiusA, BBottom, RadiusB));
+        Hit = _mm_or_ps(Hit, SphereSphere4(ABottom, RadiusA, BTop, RadiusB));
+        Hit = _mm_or_ps(Hit, SphereSphere4(ABottom, RadiusA, BBottom, RadiusB));
+        return Hit;
+    }
+
+    constexpr FPairKernel PairKernels[NumPairKernels] =
+    {
+        &KernelBoxBox, &KernelBoxSphere, &KernelBoxCapsule,
+        &KernelSphereSphere, &KernelSphereCapsule, &KernelCapsuleCapsule
+    };
+
+    inline void GetOrderedPair(const TArray<FWorldShape>& Shapes, const FShapePairIndex& Pair, const FWorldShape*& OutFirst, const FWorldShape*& OutSecond)
+    {
+        OutFirst = &Shapes[Pair.A];
+        OutSecond = &Shapes[Pair.B];
+        if (OutFirst->Kind > OutSecond->Kind)
+        {
+            std::swap(OutFirst, OutSecond);
+        }
+    }
+}
+
+namespace Collision
+{
+    void BuildWorldShape(const FShape& Shape, const FTransform& Transform, FWorldShape& Out)
+    {
+        Out.Kind = Shape.Kind;
+        switch (Shape.Kind)
+        {
+        case EShapeKind::Box:
+            BuildOBB(Shape, Transform, Out.Obb);
+            Out.P0 = Out.P1 = Out.Obb.Center;
+            Out.Radius = 0.0f;
+            break;
+
+        case EShapeKind::Sphere:
+            // 구 중심과 반지름(비등방 스케일 상계 적용)
+            Out.Obb = FOBB();
+            Out.Obb.Center = Transform.Translation;
+            Out.P0 = Out.P1 = Transform.Translation;
+            Out.Radius = Shape.Sphere.SphereRadius * UniformScaleMax(AbsVec(Transform.Scale3D));
+            break;
+
+        case EShapeKind::Capsule:
+            BuildCapsuleCoreOBB(Shape, Transform, Out.Obb);
+            BuildCapsule(Shape, Transform, Out.P0, Out.P1, Out.Radius);
+            break;
+        }
+    }
+
+    FAABB GetWorldShapeBounds(const FWorldShape& Shape)
+    {
+        // Obb 를 월드 축에 투영한 반 크기. 구는 Obb 가 크기 0 이라 중심점만 남는다
+        FVector ObbExtent;
+        for (int32 Axis = 0; Axis < 3; ++Axis)
+        {
+            ObbExtent[Axis] = Shape.Obb.HalfExtent[0] * std::fabs(Shape.Obb.Axes[0][Axis])
+                + Shape.Obb.HalfExtent[1] * std::fabs(Shape.Obb.Axes[1][Axis])
+                + Shape.Obb.HalfExtent[2] * std::fabs(Shape.Obb.Axes[2][Axis]);
+        }
+        const FAABB ObbBounds(Shape.Obb.Center - ObbExtent, Shape.Obb.Center + ObbExtent);
+
+        // 캡슐 양 끝 반구 (박스는 반지름 0)
+        const FVector RadiusExtent(Shape.Radius, Shape.Radius, Shape.Radius);
+        const FAABB EndBounds = FAABB::Union(
+            FAABB(Shape.P0 - RadiusExtent, Shape.P0 + RadiusExtent),
+            FAABB(Shape.P1 - RadiusExtent, Shape.P1 + RadiusExtent));
+
+        return FAABB::Union(ObbBounds, EndBounds);
+    }
+
+    bool CheckOverlap(const FWorldShape& InA, const FWorldShape& InB)
+    {
+        const FWorldShape* A = &InA;
+        const FWorldShape* B = &InB;
+        if (A->Kind > B->Kind)
+        {
+            std::swap(A, B);
+        }
+
+        switch (PairKernelLUT[static_cast<int32>(A->Kind)][static_cast<int32>(B->Kind)])
+        {
+        case BoxBox:
+            return Overlap_OBB_OBB(A->Obb, B->Obb);
+
+        case BoxSphere:
+            return Overlap_Sphere_OBB(B->Obb.Center, B->Radius, A->Obb);
+
+        case BoxCapsule:
+            return Overlap_OBB_OBB(B->Obb, A->Obb)
+                || Overlap_Sphere_OBB(B->P1, B->Radius, A->Obb)
+                || Overlap_Sphere_OBB(B->P0, B->Radius, A->Obb);
+
+        case SphereSphere:
+            return SphereSphereScalar(A->Obb.Center, A->Radius, B->Obb.Center, B->Radius);
+
+        case SphereCapsule:
+            return Overlap_Sphere_OBB(A->Obb.Center, A->Radius, B->Obb)
+                || SphereSphereScalar(A->Obb.Center, A->Radius, B->P1, B->Radius)
+                || SphereSphereScalar(A->Obb.Center, A->Radius, B->P0, B->Radius);
+
+        case CapsuleCapsule:
+            return Overlap_OBB_OBB(A->Obb, B->Obb)
+                || Overlap_Sphere_OBB(B->P1, B->Radius, A->Obb)
+                || Overlap_Sphere_OBB(B->P0, B->Radius, A->Obb)
+                || Overlap_Sphere_OBB(A->P1, A->Radius, B->Obb)
+                || Overlap_Sphere_OBB(A->P0, A->Radius, B->Obb)
+                || SphereSphereScalar(A->P1, A->Radius, B->P1, B->Radius)
+                || SphereSphereScalar(A->P1, A->Radius, B->P0, B->Radius)
+                || SphereSphereScalar(A->P0, A->Radius, B->P1, B->Radius)
+                || SphereSphereScalar(A->P0, A->Radius, B->P0, B->Radius);
+
+        default:
+            return false;
+        }
+    }
+
+    void CheckOverlapBatch(const TArray<FWorldShape>& Shapes, const TArray<FShapePairIndex>& Pairs, TArray<uint8>& OutOverlaps)
+    {
+        const int32 NumPairs = Pairs.Num();
+        OutOverlaps.SetNum(NumPairs);
+
+        // 1) 종류 조합별로 쌍 인덱스를 모은다 (같은 커널을 연속으로 돌린다)
+        TArray<int32> Groups[NumPairKernels];
+        for (int32 i = 0; i < NumPairs; ++i)
+        {
+            const FWorldShape* First = nullptr;
+            const FWorldShape* Second = nullptr;
+            GetOrderedPair(Shapes, Pairs[i], First, Second);
+            Groups[PairKernelLUT[static_cast<int32>(First->Kind)][static_cast<int32>(Second->Kind)]].Add(i);
+        }
+
+        // 2) 4쌍씩 SoA 로 모아 판정. 남는 레인은 그룹의 마지막 쌍으로 채우고 결과는 버린다
+        for (int32 Kernel = 0; Kernel < NumPairKernels; ++Kernel)
+        {
+            const TArray<int32>& Group = Groups[Kernel];
+            const int32 NumGroupPairs = Group.Num();
+            for (int32 Begin = 0; Begin < NumGroupPairs; Begin += 4)
+            {
+                const int32 NumLanes = std::min(4, NumGroupPairs - Begin);
+
+                const FWorldShape* First[4];
+                const FWorldShape* Second[4];
+                for (int32 Lane = 0; Lane < 4; ++Lane)
+                {
+                    const int32 PairIndex = Group[Begin + std::min(Lane, NumLanes - 1)];
+                    GetOrderedPair(Shapes, Pairs[PairIndex], First[Lane], Second[Lane]);
+                }
+
+                const int32 HitBits = _mm_movemask_ps(PairKernels[Kernel](First, Second));
+                for (int32 Lane = 0; Lane < NumLanes; ++Lane)
+                {
+                    OutOverlaps[Group[Begin + Lane]] = static_cast<uint8>((HitBits >> Lane) & 1);
+                }
+            }
+        }
+    }
+}
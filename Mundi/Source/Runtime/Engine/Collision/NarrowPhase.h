@@ -0,0 +1,45 @@
+﻿#pragma once
+#include "OBB.h"
+
+struct FAABB;
+struct FShape;
+enum class EShapeKind : uint8;
+
+namespace Collision
+{
+    /**
+     * 셰이프 하나의 월드 공간 데이터. FShape + FTransform 에서 프레임당 한 번 계산해 여러 쌍이 공유한다.
+     * - Box    : Obb = 스케일 적용 OBB
+     * - Sphere : Obb.Center = 중심, Radius = 스케일 적용 반지름
+     * - Capsule: Obb = 몸통 OBB (R, R, 반높이), P0/P1 = 아래/위 반구 중심, Radius = 반구 반지름
+     */
+    struct FWorldShape
+    {
+        FOBB Obb;
+        FVector P0;
+        FVector P1;
+        float Radius = 0.0f;
+        EShapeKind Kind;
+    };
+
+    // 월드 셰이프 배열에 대한 인덱스 쌍
+    struct FShapePairIndex
+    {
+        int32 A;
+        int32 B;
+    };
+
+    void BuildWorldShape(const FShape& Shape, const FTransform& Transform, FWorldShape& Out);
+
+    // 월드 셰이프를 감싸는 AABB (Obb 와 P0/P1 반지름 구의 합집합)
+    FAABB GetWorldShapeBounds(const FWorldShape& Shape);
+
+    // 한 쌍 스칼라 판정 (OverlapLUT 와 같은 결과)
+    bool CheckOverlap(const FWorldShape& A, const FWorldShape& B);
+
+    /**
+     * 배치 내로우 페이즈. 쌍을 종류 조합별로 묶은 뒤 4쌍씩 SoA 로 모아 SSE 커널로 판정한다.
+     * OutOverlaps[i] = Pairs[i] 가 겹치면 1.
+     */
+    void CheckOverlapBatch(const TArray<FWorldShape>& Shapes, const TArray<FShapePairIndex>& Pairs, TArray<uint8>& OutOverlaps);
+}
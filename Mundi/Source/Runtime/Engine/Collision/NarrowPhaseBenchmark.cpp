@@ -0,0 +1,127 @@
+﻿#include "pch.h"
+#include <random>
+#include "NarrowPhase.h"
+#include "Collision.h"
+#include "ShapeComponent.h"
+#include "Benchmark.h"
+
+namespace
+{
+	constexpr int32 NumPairs = 50000;
+	constexpr int32 NumRepeats = 10;
+	constexpr float SpawnRange = 2.5f;   // 셰이프 크기(0.5~2) 대비 좁게 흩어 브로드 페이즈 후보 쌍처럼 상당수가 겹치게
+
+	const char* KindNames[3] = { "Box", "Sphere", "Capsule" };
+
+	FShape MakeRandomShape(EShapeKind Kind, std::mt19937& Random)
+	{
+		std::uniform_real_distribution<float> Size(0.5f, 2.0f);
+		FShape Shape;
+		Shape.Kind = Kind;
+		switch (Kind)
+		{
+		case EShapeKind::Box:
+			Shape.Box.BoxExtent = FVector(Size(Random), Size(Random), Size(Random));
+			break;
+		case EShapeKind::Sphere:
+			Shape.Sphere.SphereRadius = Size(Random);
+			break;
+		case EShapeKind::Capsule:
+			Shape.Capsule.CapsuleRadius = Size(Random) * 0.5f;
+			Shape.Capsule.CapsuleHalfHeight = Shape.Capsule.CapsuleRadius + Size(Random);
+			break;
+		}
+		return Shape;
+	}
+
+	FTransform MakeRandomTransform(std::mt19937& Random)
+	{
+		std::uniform_real_distribution<float> Position(-SpawnRange, SpawnRange);
+		std::uniform_real_distribution<float> Unit(-1.0f, 1.0f);
+		std::uniform_real_distribution<float> Angle(0.0f, 2.0f * PI);
+		std::uniform_real_distribution<float> Scale(0.5f, 1.5f);
+
+		FVector Axis(Unit(Random), Unit(Random), Unit(Random));
+		if (Axis.SizeSquared() < 1e-4f)
+		{
+			Axis = FVector(0.0f, 0.0f, 1.0f);
+		}
+		return FTransform(FVector(Position(Random), Position(Random), Position(Random)),
+			FQuat::FromAxisAngle(Axis, Angle(Random)),
+			FVector(Scale(Random), Scale(Random), Scale(Random)));
+	}
+}
+
+IMPLEMENT_BENCHMARK(NARROWPHASE, "Shape overlap narrow phase: per-pair OverlapLUT vs batched SSE kernels (precomputed world shapes), all 9 kind combinations")
+{
+	std::mt19937 Random(4321);
+
+	for (int32 KindA = 0; KindA < 3; ++KindA)
+	{
+		for (int32 KindB = 0; KindB < 3; ++KindB)
+		{
+			// 쌍마다 셰이프 두 개 (브로드 페이즈 후보 쌍을 흉내)
+			TArray<FShape> Shapes;
+			TArray<FTransform> Transforms;
+			Shapes.Reserve(NumPairs * 2);
+			Transforms.Reserve(NumPairs * 2);
+			TArray<Collision::FShapePairIndex> Pairs;
+			Pairs.Reserve(NumPairs);
+			for (int32 i = 0; i < NumPairs; ++i)
+			{
+				Shapes.Add(MakeRandomShape(static_cast<EShapeKind>(KindA), Random));
+				Transforms.Add(MakeRandomTransform(Random));
+				Shapes.Add(MakeRandomShape(static_cast<EShapeKind>(KindB), Random));
+				Transforms.Add(MakeRandomTransform(Random));
+				Pairs.Add({ i * 2, i * 2 + 1 });
+			}
+
+			// 이전 방식: 쌍마다 LUT 호출, 매번 OBB/캡슐 재구성
+			TArray<uint8> ScalarResults;
+			ScalarResults.SetNum(NumPairs);
+			double ScalarMs = 0.0;
+			for (int32 Repeat = 0; Repeat < NumRepeats; ++Repeat)
+			{
+				FBenchTimer Timer;
+				for (int32 i = 0; i < NumPairs; ++i)
+				{
+					const Collision::FShapePairIndex& Pair = Pairs[i];
+					ScalarResults[i] = Collision::OverlapLUT[KindA][KindB](Shapes[Pair.A], Transforms[Pair.A], Shapes[Pair.B], Transforms[Pair.B]) ? 1 : 0;
+				}
+				ScalarMs += Timer.GetMs();
+			}
+
+			// 배치: 셰이프당 한 번 월드 데이터 계산 + 종류 조합별 SSE 커널
+			TArray<Collision::FWorldShape> WorldShapes;
+			WorldShapes.SetNum(Shapes.Num());
+			TArray<uint8> BatchResults;
+			double BatchMs = 0.0;
+			for (int32 Repeat = 0; Repeat < NumRepeats; ++Repeat)
+			{
+				FBenchTimer Timer;
+				for (int32 i = 0; i < Shapes.Num(); ++i)
+				{
+					Collision::BuildWorldShape(Shapes[i], Transforms[i], WorldShapes[i]);
+				}
+				Collision::CheckOverlapBatch(WorldShapes, Pairs, BatchResults);
+				BatchMs += Timer.GetMs();
+			}
+
+			int32 NumOverlaps = 0;
+			int32 NumMismatches = 0;
+			for (int32 i = 0; i < NumPairs; ++i)
+			{
+				NumOverlaps += BatchResults[i];
+				NumMismatches += (BatchResults[i] != ScalarResults[i]) ? 1 : 0;
+			}
+
+			const double TotalPairs = static_cast<double>(NumPairs) * NumRepeats;
+			UE_LOG("[Bench] Narrow %-7s vs %-7s: OverlapLUT %.2f Mpairs/s | batched SSE %.2f Mpairs/s  x%.1f | %d%% overlap, %d mismatches",
+				KindNames[KindA], KindNames[KindB],
+				ScalarMs > 0.0 ? TotalPairs / (ScalarMs * 1000.0) : 0.0,
+				BatchMs > 0.0 ? TotalPairs / (BatchMs * 1000.0) : 0.0,
+				BatchMs > 0.0 ? ScalarMs / BatchMs : 0.0,
+				NumOverlaps * 100 / NumPairs, NumMismatches);
+		}
+	}
+}
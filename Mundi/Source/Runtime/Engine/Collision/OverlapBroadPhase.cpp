@@ -0,0 +1,327 @@
+﻿#include "pch.h"
+#include "OverlapBroadPhase.h"
+#include "ShapeComponent.h"
+#include "NarrowPhase.h"
+#include "World.h"
+
+namespace
+{
+	inline bool OverlapsYZ(const FAABB& A, const FAABB& B)
+	{
+		return A.Min.Y <= B.Max.Y && B.Min.Y <= A.Max.Y &&
+			A.Min.Z <= B.Max.Z && B.Min.Z <= A.Max.Z;
+	}
+
+	// 오브젝트 배열 슬롯은 살아 있는 동안 바뀌지 않고 겹치지 않는다. 팩토리 밖에서 만든 오브젝트만 UUID 로
+	inline bool IsOrderedBefore(const UShapeComponent* A, const UShapeComponent* B)
+	{
+		return A->InternalIndex != B->InternalIndex ? A->InternalIndex < B->InternalIndex : A->UUID < B->UUID;
+	}
+
+	// 이벤트를 보낼 수 있는 셰이프 (살아 있고, 소유 액터가 활성)
+	inline bool CanGenerateOverlap(const UShapeComponent* Shape)
+	{
+		if (!Shape || Shape->IsPendingDestroy() || !Shape->GetGenerateOverlapEvents())
+		{
+			return false;
+		}
+		AActor* Owner = Shape->GetOwner();
+		return Owner && !Owner->IsPendingDestroy() && Owner->IsActorActive();
+	}
+
+	// 셰이프 틱에서 겹침을 검사하던 때와 같은 조건. 에디터에서는 bTickInEditor 액터의 셰이프만
+	inline bool IsShapeTicking(const UShapeComponent* Shape, bool bPie)
+	{
+		const AActor* Owner = Shape->GetOwner();
+		return Owner->CanEverTick() && (Owner->CanTickInEditor() || bPie) && Shape->IsComponentTickEnabled();
+	}
+}
+
+FOverlapPair::FOverlapPair(UShapeComponent* InA, UShapeComponent* InB)
+	: A(IsOrderedBefore(InA, InB) ? InA : InB)
+	, B(IsOrderedBefore(InA, InB) ? InB : InA)
+{
+	SortKey = (static_cast<uint64>(A->InternalIndex) << 32) | B->InternalIndex;
+	TieKey = (static_cast<uint64>(A->UUID) << 32) | B->UUID;
+}
+
+void FOverlapBroadPhase::Register(UShapeComponent* Shape)
+{
+	if (!Shape || RegisteredShapes.Contains(Shape))
+	{
+		return;
+	}
+	RegisteredShapes.Add(Shape);
+
+	// 바운드와 정렬 위치는 다음 갱신에서 잡는다 (셰이프 크기는 하위 클래스 OnRegister 에서 등록 뒤에 정해지기도 한다)
+	Proxies.Add({ Shape, FAABB() });
+	DirtyShapes.Add(Shape);
+}
+
+void FOverlapBroadPhase::Unregister(UShapeComponent* Shape)
+{
+	if (!Shape || !RegisteredShapes.Remove(Shape))
+	{
+		return;
+	}
+
+	// 정렬 순서를 유지한 채 제거
+	Proxies.erase(std::remove_if(Proxies.begin(), Proxies.end(),
+		[Shape](const FProxy& Proxy) { return Proxy.Shape == Shape; }), Proxies.end());
+	DirtyShapes.Remove(Shape);
+	PendingBounds.Remove(Shape);
+
+	auto ContainsShape = [Shape](const FOverlapPair& Pair) { return Pair.A == Shape || Pair.B == Shape; };
+	CurrentPairs.erase(std::remove_if(CurrentPairs.begin(), CurrentPairs.end(), ContainsShape), CurrentPairs.end());
+	PreviousPairs.erase(std::remove_if(PreviousPairs.begin(), PreviousPairs.end(), ContainsShape), PreviousPairs.end());
+}
+
+void FOverlapBroadPhase::MarkDirty(UShapeComponent* Shape)
+{
+	if (RegisteredShapes.Contains(Shape))
+	{
+		DirtyShapes.Add(Shape);
+	}
+}
+
+void FOverlapBroadPhase::UpdateBounds(UShapeComponent* Shape, const FAABB& Bounds)
+{
+	if (RegisteredShapes.Contains(Shape))
+	{
+		PendingBounds.Add(Shape, Bounds);
+	}
+}
+
+void FOverlapBroadPhase::FlushDirtyBounds()
+{
+	if (DirtyShapes.IsEmpty() && PendingBounds.IsEmpty())
+	{
+		return;
+	}
+
+	for (FProxy& Proxy : Proxies)
+	{
+		if (const FAABB* Bounds = PendingBounds.Find(Proxy.Shape))
+		{
+			Proxy.Bounds = *Bounds;
+		}
+		else if (DirtyShapes.Contains(Proxy.Shape))
+		{
+			Proxy.Bounds = Proxy.Shape->GetWorldAABB();
+		}
+	}
+	DirtyShapes.Empty();
+	PendingBounds.Empty();
+}
+
+void FOverlapBroadPhase::SortProxies()
+{
+	// 지난 프레임 순서에서 조금만 바뀌므로 삽입 정렬. 이동량이 커지면(순간이동, 대량 등록) 전체 정렬로 전환
+	const int32 NumProxies = Proxies.Num();
+	const int64 MaxShifts = 8 * static_cast<int64>(NumProxies) + 64;
+	int64 NumShifts = 0;
+
+	for (int32 i = 1; i < NumProxies; ++i)
+	{
+		const FProxy Key = Proxies[i];
+		int32 j = i;
+		while (j > 0 && Proxies[j - 1].Bounds.Min.X > Key.Bounds.Min.X)
+		{
+			Proxies[j] = Proxies[j - 1];
+			--j;
+			++NumShifts;
+		}
+		Proxies[j] = Key;
+
+		if (NumShifts > MaxShifts)
+		{
+			std::sort(Proxies.begin(), Proxies.end(),
+				[](const FProxy& A, const FProxy& B) { return A.Bounds.Min.X < B.Bounds.Min.X; });
+			return;
+		}
+	}
+}
+
+void FOverlapBroadPhase::SweepProxies(TArray<Collision::FShapePairIndex>& OutPairs) const
+{
+	OutPairs.clear();
+
+	// X 축 스윕: 다음 프록시의 Min.X 가 내 Max.X 를 넘으면 그 뒤로는 겹칠 수 없다
+	const int32 NumProxies = Proxies.Num();
+	for (int32 i = 0; i < NumProxies; ++i)
+	{
+		const FProxy& Proxy = Proxies[i];
+		const float MaxX = Proxy.Bounds.Max.X;
+		for (int32 j = i + 1; j < NumProxies && Proxies[j].Bounds.Min.X <= MaxX; ++j)
+		{
+			if (OverlapsYZ(Proxy.Bounds, Proxies[j].Bounds))
+			{
+				OutPairs.Add({ i, j });
+			}
+		}
+	}
+}
+
+void FOverlapBroadPhase::FindCandidatePairs(TArray<FOverlapPair>& OutPairs)
+{
+	FlushDirtyBounds();
+	SortProxies();
+	SweepProxies(CandidateIndexPairs);
+
+	OutPairs.clear();
+	OutPairs.Reserve(CandidateIndexPairs.Num());
+	for (const Collision::FShapePairIndex& Pair : CandidateIndexPairs)
+	{
+		OutPairs.Add(FOverlapPair(Proxies[Pair.A].Shape, Proxies[Pair.B].Shape));
+	}
+	NumCandidatePairs = OutPairs.Num();
+}
+
+int32 FOverlapBroadPhase::GetOrBuildWorldShape(int32 ProxyIndex)
+{
+	int32& WorldShapeIndex = ProxyWorldShapeIndices[ProxyIndex];
+	if (WorldShapeIndex < 0)
+	{
+		const UShapeComponent* Shape = Proxies[ProxyIndex].Shape;
+		FShape LocalShape;
+		Shape->GetShape(LocalShape);
+
+		Collision::FWorldShape WorldShape;
+		Collision::BuildWorldShape(LocalShape, Shape->GetWorldTransform(), WorldShape);
+		WorldShapeIndex = WorldShapes.Add(WorldShape);
+	}
+	return WorldShapeIndex;
+}
+
+void FOverlapBroadPhase::UpdateOverlaps(UWorld* World)
+{
+	FlushDirtyBounds();
+	SortProxies();
+	SweepProxies(CandidateIndexPairs);
+	NumCandidatePairs = CandidateIndexPairs.Num();
+
+	// 필터. 살아남은 쌍의 셰이프만 월드 데이터를 (셰이프당 한 번) 만든다
+	ProxyWorldShapeIndices.assign(Proxies.Num(), -1);
+	WorldShapes.clear();
+	NarrowPairs.clear();
+	NarrowPairShapes.clear();
+	for (const Collision::FShapePairIndex& Pair : CandidateIndexPairs)
+	{
+		UShapeComponent* ShapeA = Proxies[Pair.A].Shape;
+		UShapeComponent* ShapeB = Proxies[Pair.B].Shape;
+		if (!CanGenerateOverlap(ShapeA) || !CanGenerateOverlap(ShapeB))
+		{
+			continue;
+		}
+		if (ShapeA->GetOwner() == ShapeB->GetOwner())
+		{
+			continue;
+		}
+		// 적어도 한쪽이 틱해야 검사한다 (틱하는 셰이프가 상대를 검사하고 양쪽에 이벤트를 보내던 방식)
+		if (!IsShapeTicking(ShapeA, World->bPie) && !IsShapeTicking(ShapeB, World->bPie))
+		{
+			continue;
+		}
+		NarrowPairs.Add({ GetOrBuildWorldShape(Pair.A), GetOrBuildWorldShape(Pair.B) });
+		NarrowPairShapes.Add(FOverlapPair(ShapeA, ShapeB));
+	}
+
+	// 배치 내로우 페이즈
+	Collision::CheckOverlapBatch(WorldShapes, NarrowPairs, NarrowOverlaps);
+
+	CurrentPairs.clear();
+	for (int32 i = 0; i < NarrowPairShapes.Num(); ++i)
+	{
+		if (NarrowOverlaps[i])
+		{
+			CurrentPairs.Add(NarrowPairShapes[i]);
+		}
+	}
+	std::sort(CurrentPairs.begin(), CurrentPairs.end());
+
+	PublishOverlapInfos();
+
+	// 지난 프레임 목록과 비교 (둘 다 정렬됨)
+	TArray<FOverlapPair> BeginPairs;
+	TArray<FOverlapPair> EndPairs;
+	std::set_difference(CurrentPairs.begin(), CurrentPairs.end(), PreviousPairs.begin(), PreviousPairs.end(), std::back_inserter(BeginPairs));
+	std::set_difference(PreviousPairs.begin(), PreviousPairs.end(), CurrentPairs.begin(), CurrentPairs.end(), std::back_inserter(EndPairs));
+
+	// 이벤트 핸들러가 셰이프를 등록/해제할 수 있으므로 목록을 먼저 확정
+	PreviousPairs = CurrentPairs;
+
+	for (const FOverlapPair& Pair : BeginPairs)
+	{
+		DispatchBeginOverlap(World, Pair);
+	}
+	for (const FOverlapPair& Pair : EndPairs)
+	{
+		DispatchEndOverlap(World, Pair);
+	}
+}
+
+void FOverlapBroadPhase::PublishOverlapInfos()
+{
+	for (const FProxy& Proxy : Proxies)
+	{
+		Proxy.Shape->OverlapInfos.clear();
+	}
+	for (const FOverlapPair& Pair : CurrentPairs)
+	{
+		FOverlapInfo InfoA;
+		InfoA.OtherActor = Pair.B->GetOwner();
+		InfoA.Other = Pair.B;
+		Pair.A->OverlapInfos.Add(InfoA);
+
+		FOverlapInfo InfoB;
+		InfoB.OtherActor = Pair.A->GetOwner();
+		InfoB.Other = Pair.A;
+		Pair.B->OverlapInfos.Add(InfoB);
+	}
+}
+
+void FOverlapBroadPhase::DispatchBeginOverlap(UWorld* World, const FOverlapPair& Pair)
+{
+	if (Pair.A->IsPendingDestroy() || Pair.B->IsPendingDestroy())
+	{
+		return;
+	}
+
+	AActor* Owner = Pair.A->GetOwner();
+	AActor* OtherOwner = Pair.B->GetOwner();
+
+	// 같은 액터 쌍은 프레임당 한 번만
+	if (!(Owner && OtherOwner && World && World->TryMarkOverlapPair(Owner, OtherOwner)))
+	{
+		return;
+	}
+
+	// 양방향 호출
+	Owner->OnComponentBeginOverlap.Broadcast(Pair.A, Pair.B);
+	OtherOwner->OnComponentBeginOverlap.Broadcast(Pair.B, Pair.A);
+
+	// Hit호출. 쌍의 A/B 는 정렬 키일 뿐이므로 양쪽 모두에 보낸다
+	Owner->OnComponentHit.Broadcast(Pair.A, Pair.B);
+	OtherOwner->OnComponentHit.Broadcast(Pair.B, Pair.A);
+}
+
+void FOverlapBroadPhase::DispatchEndOverlap(UWorld* World, const FOverlapPair& Pair)
+{
+	if (Pair.A->IsPendingDestroy() || Pair.B->IsPendingDestroy())
+	{
+		return;
+	}
+
+	AActor* Owner = Pair.A->GetOwner();
+	AActor* OtherOwner = Pair.B->GetOwner();
+
+	// 같은 액터 쌍은 프레임당 한 번만
+	if (!(Owner && OtherOwner && World && World->TryMarkOverlapPair(Owner, OtherOwner)))
+	{
+		return;
+	}
+
+	// 양방향 호출
+	Owner->OnComponentEndOverlap.Broadcast(Pair.A, Pair.B);
+	OtherOwner->OnComponentEndOverlap.Broadcast(Pair.B, Pair.A);
+}
@@ -0,0 +1,91 @@
+﻿#pragma once
+#include "AABB.h"
+#include "FlatHashMap.h"
+#include "NarrowPhase.h"
+
+class UShapeComponent;
+class UWorld;
+
+// AABB 가 겹친 셰이프 쌍. A < B (오브젝트 InternalIndex, 같으면 UUID 순) 로 정규화해서 쌍 목록을 정렬/비교한다
+// 주소 순이 아니므로 실행마다 A/B 와 이벤트 순서가 같다
+struct FOverlapPair
+{
+	UShapeComponent* A = nullptr;
+	UShapeComponent* B = nullptr;
+	uint64 SortKey = 0;     // (A 의 InternalIndex << 32) | B 의 InternalIndex
+	uint64 TieKey = 0;      // 같은 식의 UUID (팩토리 밖에서 만든 오브젝트끼리 구분용)
+
+	FOverlapPair() = default;
+	FOverlapPair(UShapeComponent* InA, UShapeComponent* InB);
+
+	bool operator==(const FOverlapPair& Other) const { return A == Other.A && B == Other.B; }
+	bool operator<(const FOverlapPair& Other) const { return SortKey != Other.SortKey ? SortKey < Other.SortKey : TieKey < Other.TieKey; }
+};
+
+/**
+ * 월드 단위 셰이프 충돌 브로드 페이즈 (sweep and prune).
+ * - 등록된 UShapeComponent 의 월드 AABB 를 Min.X 순으로 정렬해 두고, X 구간이 겹치는 것끼리만 Y/Z 를 비교해 후보 쌍을 만든다.
+ *   프레임 사이 이동이 작아 거의 정렬된 상태이므로 삽입 정렬로 선형에 가깝게 다시 정렬된다.
+ * - 바운드는 OnTransformUpdated 에서 MarkDirty 된 셰이프만 다시 읽는다.
+ * - UpdateOverlaps() 는 프레임당 한 번: 후보 쌍 -> 필터 -> 배치 내로우 페이즈(Collision::CheckOverlapBatch) -> 이번 프레임 쌍 목록.
+ *   셰이프의 월드 데이터(OBB/캡슐 끝점/반지름)는 후보 쌍에 들어간 셰이프마다 한 번만 만든다.
+ *   지난 프레임 목록과 비교해 새로 생긴 쌍은 Begin, 사라진 쌍은 End 이벤트를 보낸다.
+ */
+class FOverlapBroadPhase
+{
+public:
+	void Register(UShapeComponent* Shape);
+	// 이 셰이프가 들어간 쌍은 이벤트 없이 버린다
+	void Unregister(UShapeComponent* Shape);
+	// 다음 갱신 때 GetWorldAABB() 로 바운드를 다시 읽는다
+	void MarkDirty(UShapeComponent* Shape);
+	// 바운드를 직접 지정. MarkDirty/UpdateBounds 는 등록된 셰이프만 받는다
+	void UpdateBounds(UShapeComponent* Shape, const FAABB& Bounds);
+
+	// 프레임당 한 번 (액터 틱 이후)
+	void UpdateOverlaps(UWorld* World);
+
+	// 더티 바운드 반영 + 정렬/스윕으로 AABB 가 겹치는 후보 쌍만 구한다 (필터/내로우 페이즈 없음)
+	void FindCandidatePairs(TArray<FOverlapPair>& OutPairs);
+
+	// 마지막 UpdateOverlaps 의 겹침 쌍 (정렬됨)
+	const TArray<FOverlapPair>& GetOverlapPairs() const { return CurrentPairs; }
+	int32 Num() const { return Proxies.Num(); }
+	int32 GetNumCandidatePairs() const { return NumCandidatePairs; }
+
+private:
+	struct FProxy
+	{
+		UShapeComponent* Shape;
+		FAABB Bounds;
+	};
+
+	void FlushDirtyBounds();
+	void SortProxies();
+	// 정렬된 Proxies 를 X 축으로 스윕해 AABB 가 겹치는 프록시 인덱스 쌍을 만든다
+	void SweepProxies(TArray<Collision::FShapePairIndex>& OutPairs) const;
+	// 프록시의 월드 셰이프를 (이번 프레임에 처음 쓰일 때) 만들고 WorldShapes 인덱스를 돌려준다
+	int32 GetOrBuildWorldShape(int32 ProxyIndex);
+	void DispatchBeginOverlap(UWorld* World, const FOverlapPair& Pair);
+	void DispatchEndOverlap(UWorld* World, const FOverlapPair& Pair);
+	void PublishOverlapInfos();
+
+	// Bounds.Min.X 오름차순
+	TArray<FProxy> Proxies;
+
+	TFlatSet<UShapeComponent*> RegisteredShapes;
+	TFlatSet<UShapeComponent*> DirtyShapes;
+	TFlatMap<UShapeComponent*, FAABB> PendingBounds;
+
+	// UpdateOverlaps 작업 버퍼 (프레임마다 재사용)
+	TArray<Collision::FShapePairIndex> CandidateIndexPairs;
+	TArray<int32> ProxyWorldShapeIndices;   // 프록시 -> WorldShapes 인덱스 (-1 = 아직 안 만듦)
+	TArray<Collision::FWorldShape> WorldShapes;
+	TArray<Collision::FShapePairIndex> NarrowPairs;
+	TArray<FOverlapPair> NarrowPairShapes;
+	TArray<uint8> NarrowOverlaps;
+
+	TArray<FOverlapPair> CurrentPairs;
+	TArray<FOverlapPair> PreviousPairs;
+	int32 NumCandidatePairs = 0;
+};
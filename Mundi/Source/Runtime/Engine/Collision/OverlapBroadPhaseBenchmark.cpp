@@ -0,0 +1,118 @@
+﻿#include "pch.h"
+#include <random>
+#include "OverlapBroadPhase.h"
+#include "SphereComponent.h"
+#include "Benchmark.h"
+
+namespace
+{
+	constexpr int32 ShapeCounts[] = { 1000, 5000, 10000 };
+	constexpr int32 NumFrames = 30;
+	constexpr int32 NumBruteForceFrames = 3;   // O(N^2) 는 큰 N 에서 몇 프레임만
+	constexpr float ShapeHalfSize = 1.5f;
+
+	// 모든 셰이프가 매 프레임 조금씩 움직인다 (파이어볼/타일이 많은 경우)
+	FVector ShapeCenter(int32 Index, int32 Frame, float WorldSize)
+	{
+		const float Angle = static_cast<float>(Index) * 0.61f + static_cast<float>(Frame) * 0.03f;
+		const float Radius = 2.0f + static_cast<float>(Index % 17);
+		const float BaseX = static_cast<float>((Index * 7919) % 1000) / 1000.0f * WorldSize;
+		const float BaseY = static_cast<float>((Index * 104729) % 1000) / 1000.0f * WorldSize;
+		return FVector(BaseX + Radius * std::cos(Angle), BaseY + Radius * std::sin(Angle), static_cast<float>(Index % 8));
+	}
+
+	FAABB MakeBox(const FVector& Center)
+	{
+		const FVector Half(ShapeHalfSize, ShapeHalfSize, ShapeHalfSize);
+		return FAABB(Center - Half, Center + Half);
+	}
+
+	// 이전 방식과 같은 모든 쌍 검사 (AABB 만)
+	int32 CountPairsBruteForce(const TArray<FAABB>& Bounds)
+	{
+		int32 NumPairs = 0;
+		const int32 Num = Bounds.Num();
+		for (int32 i = 0; i < Num; ++i)
+		{
+			for (int32 j = i + 1; j < Num; ++j)
+			{
+				if (Bounds[i].Intersects(Bounds[j]))
+				{
+					++NumPairs;
+				}
+			}
+		}
+		return NumPairs;
+	}
+}
+
+IMPLEMENT_BENCHMARK(OVERLAP, "Shape overlap broad phase: O(N^2) pair scan vs sweep and prune, 1k/5k/10k moving shapes")
+{
+	for (int32 NumShapes : ShapeCounts)
+	{
+		// 셰이프 밀도를 N 과 무관하게 유지
+		const float WorldSize = std::sqrt(static_cast<float>(NumShapes)) * 20.0f;
+
+		TArray<USphereComponent*> Shapes;
+		Shapes.Reserve(NumShapes);
+		FOverlapBroadPhase BroadPhase;
+		for (int32 i = 0; i < NumShapes; ++i)
+		{
+			USphereComponent* Shape = NewObject<USphereComponent>();
+			Shapes.Add(Shape);
+			BroadPhase.Register(Shape);
+			BroadPhase.UpdateBounds(Shape, MakeBox(ShapeCenter(i, 0, WorldSize)));
+		}
+
+		TArray<FOverlapPair> Pairs;
+		BroadPhase.FindCandidatePairs(Pairs);   // 첫 정렬은 측정에서 제외
+
+		double SweepMs = 0.0;
+		int64 NumSweepPairs = 0;
+		for (int32 Frame = 1; Frame <= NumFrames; ++Frame)
+		{
+			FBenchTimer Timer;
+			for (int32 i = 0; i < NumShapes; ++i)
+			{
+				BroadPhase.UpdateBounds(Shapes[i], MakeBox(ShapeCenter(i, Frame, WorldSize)));
+			}
+			BroadPhase.FindCandidatePairs(Pairs);
+			SweepMs += Timer.GetMs();
+			NumSweepPairs += Pairs.Num();
+		}
+
+		double BruteForceMs = 0.0;
+		bool bPairsMatch = true;
+		TArray<FAABB> Bounds;
+		Bounds.SetNum(NumShapes);
+		for (int32 Frame = 1; Frame <= NumBruteForceFrames; ++Frame)
+		{
+			FBenchTimer Timer;
+			for (int32 i = 0; i < NumShapes; ++i)
+			{
+				Bounds[i] = MakeBox(ShapeCenter(i, Frame, WorldSize));
+			}
+			const int32 NumPairs = CountPairsBruteForce(Bounds);
+			BruteForceMs += Timer.GetMs();
+
+			for (int32 i = 0; i < NumShapes; ++i)
+			{
+				BroadPhase.UpdateBounds(Shapes[i], Bounds[i]);
+			}
+			BroadPhase.FindCandidatePairs(Pairs);
+			bPairsMatch = bPairsMatch && (Pairs.Num() == NumPairs);
+		}
+
+		const double SweepPerFrame = SweepMs / NumFrames;
+		const double BruteForcePerFrame = BruteForceMs / NumBruteForceFrames;
+		UE_LOG("[Bench] Overlap %5d shapes: O(N^2) %.3fms/frame | sweep and prune %.3fms/frame (%lld pairs/frame, %s)  x%.1f",
+			NumShapes, BruteForcePerFrame, SweepPerFrame, NumSweepPairs / NumFrames,
+			bPairsMatch ? "pairs match" : "PAIR MISMATCH", SweepPerFrame > 0.0 ? BruteForcePerFrame / SweepPerFrame : 0.0);
+
+		for (USphereComponent* Shape : Shapes)
+		{
+			BroadPhase.Unregister(Shape);
+			ObjectFactory::DeleteObject(Shape);
+		}
+	}
+}
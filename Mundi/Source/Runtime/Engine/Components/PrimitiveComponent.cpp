@@ -4,7 +4,7 @@
 #include "Actor.h"
 #include "WorldPartitionManager.h"
 // IMPLEMENT_CLASS is now auto-generated in .generated.cpp
-UPrimitiveComponent::UPrimitiveComponent() : bGenerateOverlapEvents(true)
+UPrimitiveComponent::UPrimitiveComponent() : bGenerateOverlapEvents(true), bBlockComponent(false)
 {
 }
 
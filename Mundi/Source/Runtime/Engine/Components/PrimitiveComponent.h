@@ -70,6 +70,8 @@ public:
     // Overlap event generation toggle API
     void SetGenerateOverlapEvents(bool bEnable) { bGenerateOverlapEvents = bEnable; }
     bool GetGenerateOverlapEvents() const { return bGenerateOverlapEvents; }
+    void SetBlockComponent(bool bEnable) { bBlockComponent = bEnable; }
+    bool GetBlockComponent() const { return bBlockComponent; }
 
     // ───── 직렬화 ────────────────────────────
     void Serialize(const bool bInIsLoading, JSON& InOutHandle) override;
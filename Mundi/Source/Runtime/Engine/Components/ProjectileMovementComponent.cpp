@@ -3,6 +3,10 @@
 #include "SceneComponent.h"
 #include "Actor.h"
 #include "ObjectFactory.h"
+#include "World.h"
+#include "WorldPartitionManager.h"
+#include "CollisionQuery.h"
+#include "PrimitiveComponent.h"
 // IMPLEMENT_CLASS is now auto-generated in .generated.cpp
 UProjectileMovementComponent::UProjectileMovementComponent()
     : Gravity(-9.80f)  // Z-Up 좌표계에서 중력은 Z방향으로 -980 cm/s^2
@@ -16,7 +20,11 @@ UProjectileMovementComponent::UProjectileMovementComponent()
     , ProjectileLifespan(0.0f)  // 0 = 무제한
     , CurrentLifetime(0.0f)
     , bAutoDestroyWhenLifespanExceeded(false)
+    , bSweepCollision(false)
+    , SweepRadius(0.25f)
+    , bSweepBlockingOnly(false)
     , bIsActive(true)
+    , bStoppedBySweep(false)
 {
     bCanEverTick = true;
 }
@@ -54,6 +62,12 @@ void UProjectileMovementComponent::TickComponent(float DeltaSeconds)
         }
     }
 
+    // 스윕에 막혀 멈춘 발사체는 수명만 흐르고 더 움직이지 않는다
+    if (bStoppedBySweep)
+    {
+        return;
+    }
+
     // 2. 호밍 가속도 계산
     if (bIsHomingProjectile)
     {
@@ -73,6 +87,10 @@ void UProjectileMovementComponent::TickComponent(float DeltaSeconds)
     FVector Delta = Velocity * DeltaSeconds;
     if (!Delta.IsZero())
     {
+        if (bSweepCollision && SweepMove(Delta))
+        {
+            return;
+        }
         UpdatedComponent->AddWorldOffset(Delta);
     }
 
@@ -93,6 +111,7 @@ void UProjectileMovementComponent::FireInDirection(const FVector& ShootDirection
 
     // 상태 초기화
     bIsActive = true;
+    bStoppedBySweep = false;
     CurrentLifetime = 0.0f;
 }
 
@@ -170,6 +189,47 @@ void UProjectileMovementComponent::ComputeHomingAcceleration(float DeltaTime)
     Acceleration = ToTarget * HomingAccelerationMagnitude;
 }
 
+bool UProjectileMovementComponent::SweepMove(const FVector& Delta)
+{
+    UWorld* World = GetWorld();
+    UWorldPartitionManager* Partition = World ? World->GetPartitionManager() : nullptr;
+    if (!Partition)
+    {
+        return false;
+    }
+
+    AActor* Owner = UpdatedComponent->GetOwner();
+
+    FCollisionQuery Query;
+    Query.Start = UpdatedComponent->GetWorldLocation();
+    Query.End = Query.Start + Delta;
+    Query.Shape = SweepRadius > 0.0f ? FCollisionShape::MakeSphere(SweepRadius) : FCollisionShape::MakeLine();
+    Query.IgnoredActor = Owner;
+    Query.bBlockingOnly = bSweepBlockingOnly;
+
+    FCollisionQueryResult Result;
+    if (!Partition->SweepQuery(Query, Result))
+    {
+        return false;
+    }
+
+    // 맞은 위치에서 멈춘다 (시작부터 겹쳐 있으면 제자리). 다시 발사할 때까지 중력도 받지 않는다
+    const FQueryHit& Hit = Result.Hits[0];
+    UpdatedComponent->SetWorldLocation(Hit.Location);
+    Velocity = FVector(0.0f, 0.0f, 0.0f);
+    Acceleration = FVector(0.0f, 0.0f, 0.0f);
+    bStoppedBySweep = true;
+
+    if (Owner)
+    {
+        if (UPrimitiveComponent* Primitive = Cast<UPrimitiveComponent>(UpdatedComponent))
+        {
+            Owner->OnComponentHit.Broadcast(Primitive, Hit.Component);
+        }
+    }
+    return true;
+}
+
 void UProjectileMovementComponent::UpdateRotationFromVelocity()
 {
     if (!UpdatedComponent)
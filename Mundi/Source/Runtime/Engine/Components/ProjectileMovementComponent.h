@@ -72,11 +72,23 @@ public:
     void ResetLifetime() { CurrentLifetime = 0.0f; }
     float GetCurrentLifetime() const { return CurrentLifetime; }
 
+    // 충돌 속성 Getter/Setter
+    void SetSweepCollision(bool bNewSweep) { bSweepCollision = bNewSweep; }
+    bool GetSweepCollision() const { return bSweepCollision; }
+
+    void SetSweepRadius(float NewRadius) { SweepRadius = NewRadius; }
+    float GetSweepRadius() const { return SweepRadius; }
+
+    void SetSweepBlockingOnly(bool bNewBlockingOnly) { bSweepBlockingOnly = bNewBlockingOnly; }
+    bool GetSweepBlockingOnly() const { return bSweepBlockingOnly; }
+
 protected:
     // 내부 헬퍼 함수
     void LimitVelocity();
     void ComputeHomingAcceleration(float DeltaTime);
     void UpdateRotationFromVelocity();
+    // Delta 만큼 스윕 이동. 프리미티브에 막히면 (bSweepBlockingOnly 이면 bBlockComponent 인 것만) 맞은 위치에 멈추고 true
+    bool SweepMove(const FVector& Delta);
 
 protected:
     // [PIE] 값 복사
@@ -128,7 +140,23 @@ protected:
     UPROPERTY(LuaReadWrite, EditAnywhere, Category="발사체", Tooltip="생명 시간 초과시 발사체를 파괴합니다")
     bool bAutoDestroyWhenLifespanExceeded;
 
+    // === 충돌 속성 ===
+    // 프레임 이동 경로를 월드 BVH 에 스윕해 빠른 발사체가 얇은 지오메트리를 뚫고 지나가지 않게 한다
+    UPROPERTY(LuaReadWrite, EditAnywhere, Category="충돌", Tooltip="이동 경로를 스윕해 맞은 지점에서 멈춥니다")
+    bool bSweepCollision;
+
+    // 스윕에 쓰는 구 반지름, 0이면 레이
+    UPROPERTY(LuaReadWrite, EditAnywhere, Category="충돌", Tooltip="스윕 구 반지름입니다 (0이면 레이)")
+    float SweepRadius;
+
+    // 켜면 bBlockComponent 가 켜진 프리미티브에만 막힌다. 기본 데이터에는 막는 프리미티브가 없어 꺼 둔다
+    UPROPERTY(LuaReadWrite, EditAnywhere, Category="충돌", Tooltip="막는(Block) 프리미티브에만 멈춥니다")
+    bool bSweepBlockingOnly;
+
     // === 상태 ===
     // 활성화 상태
     bool bIsActive;
+
+    // 스윕에 막혀 멈춘 상태. FireInDirection 으로 다시 발사하기 전까지 이동하지 않는다 (bIsActive 와 별개)
+    bool bStoppedBySweep;
 };
@@ -45,14 +45,14 @@ USceneComponent::~USceneComponent()
 }
 
 // ──────────────────────────────
-// Relative API 더티플래그 사용해서 업데이트 하도록 수정할 것임.
-// 그리고 bWantsOnUpdateTransform이 True일때만 OnTransformUpdated호출
+// Relative API
+// 값이 바뀌면 NotifyTransformChanged() 로 서브트리 월드 캐시를 무효화하고 OnTransformUpdated 를 호출
 // ──────────────────────────────
 void USceneComponent::SetRelativeLocation(const FVector& NewLocation)
 {
     RelativeLocation = NewLocation;
     UpdateRelativeTransform();
-    OnTransformUpdated();
+    NotifyTransformChanged();
 }
 FVector USceneComponent::GetRelativeLocation() const { return RelativeLocation; }
 
@@ -61,7 +61,7 @@ void USceneComponent::SetRelativeRotation(const FQuat& NewRotation)
     RelativeRotation = NewRotation;
     RelativeRotationEuler = NewRotation.ToEulerZYXDeg(); // Euler 동기화
     UpdateRelativeTransform();
-    OnTransformUpdated();
+    NotifyTransformChanged();
 }
 FQuat USceneComponent::GetRelativeRotation() const { return RelativeRotation; }
 
@@ -75,7 +75,7 @@ void USceneComponent::SetRelativeRotationEuler(const FVector& EulerDegrees)
 
     // Euler 재계산 하지 않음 - UI에서 입력한 값을 그대로 유지
     UpdateRelativeTransform();
-    OnTransformUpdated();
+    NotifyTransformChanged();
 }
 
 FVector USceneComponent::GetRelativeRotationEuler() const
@@ -88,7 +88,7 @@ void USceneComponent::SetRelativeScale(const FVector& NewScale)
 {
     RelativeScale = NewScale;
     UpdateRelativeTransform();
-    OnTransformUpdated();
+    NotifyTransformChanged();
 }
 FVector USceneComponent::GetRelativeScale() const { return RelativeScale; }
 
@@ -96,7 +96,7 @@ void USceneComponent::AddRelativeLocation(const FVector& DeltaLocation)
 {
     RelativeLocation = RelativeLocation + DeltaLocation;
     UpdateRelativeTransform();
-    OnTransformUpdated();
+    NotifyTransformChanged();
 }
 
 void USceneComponent::AddRelativeRotation(const FQuat& DeltaRotation)
@@ -104,7 +104,7 @@ void USceneComponent::AddRelativeRotation(const FQuat& DeltaRotation)
     RelativeRotation = DeltaRotation * RelativeRotation;
     RelativeRotationEuler = RelativeRotation.ToEulerZYXDeg(); // Euler 동기화
     UpdateRelativeTransform();
-    OnTransformUpdated();
+    NotifyTransformChanged();
 }
 
 void USceneComponent::AddRelativeScale3D(const FVector& DeltaScale)
@@ -113,7 +113,7 @@ void USceneComponent::AddRelativeScale3D(const FVector& DeltaScale)
         RelativeScale.Y * DeltaScale.Y,
         RelativeScale.Z * DeltaScale.Z);
     UpdateRelativeTransform();
-    OnTransformUpdated();
+    NotifyTransformChanged();
 }
 
 // ──────────────────────────────
@@ -121,13 +121,38 @@ void USceneComponent::AddRelativeScale3D(const FVector& DeltaScale)
 // ──────────────────────────────
 FTransform USceneComponent::GetWorldTransform() const
 {
-    // Dangling pointer 방지를 위한 체크 
-    if (AttachParent && !AttachParent->IsPendingDestroy())
+    if (!bWorldTransformDirty)
+    {
+        return CachedWorldTransform;
+    }
+
+    // 프레임 갱신 이후 변경이 없으면 테이블 값이 곧 최신 값
+    if (CanReadFromTransformTable())
     {
-        return AttachParent->GetWorldTransform().GetWorldTransform(RelativeTransform);
+        CacheAncestorsFromTransformTable();
+        CachedWorldTransform = TransformTable->GetWorldTransform(TransformHandle);
+        bWorldTransformDirty = false;
+        return CachedWorldTransform;
     }
 
-    return RelativeTransform;
+    if (AttachParent)
+    {
+        // Dangling pointer 방지를 위한 체크. 파괴 중인 부모 기준 값은 캐시하지 않는다
+        if (AttachParent->IsPendingDestroy())
+        {
+            return RelativeTransform;
+        }
+
+        // 부모도 캐시를 쓰므로 더티한 조상 구간만 다시 합성된다
+        CachedWorldTransform = AttachParent->GetWorldTransform().GetWorldTransform(RelativeTransform);
+    }
+    else
+    {
+        CachedWorldTransform = RelativeTransform;
+    }
+
+    bWorldTransformDirty = false;
+    return CachedWorldTransform;
 }
 
 void USceneComponent::SetWorldTransform(const FTransform& W)
@@ -147,7 +172,7 @@ void USceneComponent::SetWorldTransform(const FTransform& W)
     RelativeRotation = RelativeTransform.Rotation;
     RelativeRotationEuler = RelativeRotation.ToEulerZYXDeg(); // Euler 동기화
     RelativeScale = RelativeTransform.Scale3D;
-    OnTransformUpdated();
+    NotifyTransformChanged();
 }
  
 void USceneComponent::SetWorldLocation(const FVector& L)
@@ -249,7 +274,7 @@ void USceneComponent::AddLocalOffset(const FVector& Delta)
     const FVector parentDelta = RelativeRotation.RotateVector(Delta);
     RelativeLocation = RelativeLocation + parentDelta;
     UpdateRelativeTransform();
-    OnTransformUpdated();
+    NotifyTransformChanged();
 }
 
 void USceneComponent::AddLocalRotation(const FQuat& DeltaRot)
@@ -257,7 +282,7 @@ void USceneComponent::AddLocalRotation(const FQuat& DeltaRot)
     RelativeRotation = (RelativeRotation * DeltaRot).GetNormalized(); // 로컬: 우측곱
     RelativeRotationEuler = RelativeRotation.ToEulerZYXDeg(); // Euler 동기화
     UpdateRelativeTransform();
-    OnTransformUpdated();
+    NotifyTransformChanged();
 }
 
 void USceneComponent::SetLocalLocationAndRotation(const FVector& L, const FQuat& R)
@@ -266,15 +291,24 @@ void USceneComponent::SetLocalLocationAndRotation(const FVector& L, const FQuat&
     RelativeRotation = R.GetNormalized();
     RelativeRotationEuler = RelativeRotation.ToEulerZYXDeg(); // Euler 동기화
     UpdateRelativeTransform();
-    OnTransformUpdated();
+    NotifyTransformChanged();
 }
 
 
 FMatrix USceneComponent::GetWorldMatrix() const
 {
+    // 월드 트랜스폼과 같은 시점에 더티가 된다 (MarkWorldTransformDirty)
     if (bIsTransformDirty)
     {
-        CachedWorldMatrix = GetWorldTransform().ToMatrix();
+        if (CanReadFromTransformTable())
+        {
+            CacheAncestorsFromTransformTable();
+            CachedWorldMatrix = TransformTable->GetWorldMatrix(TransformHandle);
+        }
+        else
+        {
+            CachedWorldMatrix = GetWorldTransform().ToMatrix();
+        }
         bIsTransformDirty = false;
     }
     return CachedWorldMatrix;
@@ -318,6 +352,14 @@ void USceneComponent::SetupAttachment(USceneComponent* InParent, EAttachmentRule
     RelativeLocation = RelativeTransform.Translation;
     RelativeRotation = RelativeTransform.Rotation;
     RelativeScale = RelativeTransform.Scale3D;
+
+    // 부모가 바뀌었으므로 서브트리의 월드 캐시를 무효화 (OnTransformUpdated 는 기존처럼 호출하지 않음)
+    MarkWorldTransformDirty();
+    SyncTransformTableParent();
+    if (TransformTable)
+    {
+        TransformTable->SetLocal(TransformHandle, RelativeTransform);
+    }
 }
 
 void USceneComponent::DetachFromParent(bool bKeepWorld)
@@ -338,8 +380,10 @@ void USceneComponent::DetachFromParent(bool bKeepWorld)
     RelativeRotation = RelativeTransform.Rotation;
     RelativeScale = RelativeTransform.Scale3D;
 
+    SyncTransformTableParent();
+
     // Notify transform update so shapes can refresh overlaps
-    OnTransformUpdated();
+    NotifyTransformChanged();
 }
 
 void USceneComponent::DuplicateSubObjects()
@@ -349,6 +393,12 @@ void USceneComponent::DuplicateSubObjects()
     AttachParent = nullptr; // 부모 컴포넌트가 이 객체의 SetupAttachment를 호출할 경우, 불필요한 로직(기존 부모에서 제거) 수행 방지
     SpriteComponent = nullptr;
     AttachChildren.clear(); // Actor에서 할당해줌
+
+    // 원본의 월드 캐시/테이블 핸들이 복사되었으므로 무효화 (복제본은 등록될 때 새 엔트리를 받는다)
+    bWorldTransformDirty = true;
+    bIsTransformDirty = true;
+    TransformTable = nullptr;
+    TransformHandle.Reset();
 }
 
 // ──────────────────────────────
@@ -376,7 +426,7 @@ void USceneComponent::Serialize(const bool bInIsLoading, JSON& InOutHandle)
 
         // 해당 객체의 Transform을 위에서 읽은 값을 기반으로 변경 후, 자식에게 전파
         UpdateRelativeTransform();
-        OnTransformUpdated();
+        NotifyTransformChanged();
 	}
 	else
 	{
@@ -397,6 +447,22 @@ void USceneComponent::OnRegister(UWorld* InWorld)
 {
     Super::OnRegister(InWorld);
 
+    if (InWorld && InWorld->GetTransformTable() && !TransformTable)
+    {
+        TransformTable = InWorld->GetTransformTable();
+        TransformHandle = TransformTable->Register(RelativeTransform);
+        SyncTransformTableParent();
+
+        // 부모보다 먼저 등록된 자식들을 연결
+        for (USceneComponent* Child : AttachChildren)
+        {
+            if (Child && Child->TransformTable == TransformTable)
+            {
+                Child->SyncTransformTableParent();
+            }
+        }
+    }
+
     if (!std::strcmp(this->GetClass()->Name , USceneComponent::StaticClass()->Name) && !SpriteComponent && !InWorld->bPie)
     {
         CREATE_EDITOR_COMPONENT(SpriteComponent, UBillboardComponent);
@@ -404,12 +470,97 @@ void USceneComponent::OnRegister(UWorld* InWorld)
     }
 
     // Notify transform update so shapes can refresh overlaps
+    NotifyTransformChanged();
+}
+
+void USceneComponent::OnUnregister()
+{
+    if (TransformTable)
+    {
+        TransformTable->Unregister(TransformHandle);
+        TransformTable = nullptr;
+        TransformHandle.Reset();
+        MarkWorldTransformDirty();
+    }
+
+    Super::OnUnregister();
+}
+
+void USceneComponent::SyncTransformTableParent()
+{
+    if (!TransformTable)
+    {
+        return;
+    }
+
+    // 부모가 같은 테이블에 없으면 테이블에서는 루트로 둔다 (이때는 이 컴포넌트와 자손 모두 CanReadFromTransformTable 이 false)
+    const bool bParentInTable = AttachParent && AttachParent->TransformTable == TransformTable;
+    TransformTable->SetParent(TransformHandle, bParentInTable ? AttachParent->TransformHandle : FTransformHandle());
+}
+
+bool USceneComponent::CanReadFromTransformTable() const
+{
+    if (!TransformTable || !TransformTable->IsUpToDate() || !TransformTable->IsValid(TransformHandle))
+    {
+        return false;
+    }
+
+    // 테이블 밖 조상이 하나라도 있으면 그 아래는 테이블에서 루트로 끊겨 있어 월드 행렬에 조상 트랜스폼이 빠진다
+    for (const USceneComponent* Ancestor = AttachParent; Ancestor; Ancestor = Ancestor->AttachParent)
+    {
+        if (Ancestor->TransformTable != TransformTable)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+void USceneComponent::CacheAncestorsFromTransformTable() const
+{
+    // 테이블 경로는 부모 캐시를 거치지 않으므로 조상을 직접 채워야 MarkWorldTransformDirty 의 조기 종료 조건이 유지된다.
+    // 깨끗한 조상을 만나면 그 위도 모두 깨끗하다
+    for (const USceneComponent* Ancestor = AttachParent; Ancestor && Ancestor->bWorldTransformDirty; Ancestor = Ancestor->AttachParent)
+    {
+        Ancestor->CachedWorldTransform = TransformTable->GetWorldTransform(Ancestor->TransformHandle);
+        Ancestor->bWorldTransformDirty = false;
+    }
+}
+
+void USceneComponent::NotifyTransformChanged()
+{
+    // 오버라이드된 OnTransformUpdated 가 Super 호출 전에 월드 트랜스폼을 읽을 수 있으므로
+    // 캐시 무효화를 먼저 끝내 둔다
+    MarkWorldTransformDirty();
+    if (TransformTable)
+    {
+        TransformTable->SetLocal(TransformHandle, RelativeTransform);
+    }
     OnTransformUpdated();
 }
 
-void USceneComponent::OnTransformUpdated()
+void USceneComponent::MarkWorldTransformDirty()
 {
+    // 조회는 항상 부모 캐시부터 채우므로 (테이블 경로는 CacheAncestorsFromTransformTable),
+    // 더티한 컴포넌트의 자손은 모두 더티다. 이미 더티면 더 내려갈 필요 없음
+    if (bWorldTransformDirty && bIsTransformDirty)
+    {
+        return;
+    }
+
+    bWorldTransformDirty = true;
     bIsTransformDirty = true;
+    for (USceneComponent* Child : AttachChildren)
+    {
+        if (Child)
+        {
+            Child->MarkWorldTransformDirty();
+        }
+    }
+}
+
+void USceneComponent::OnTransformUpdated()
+{
     for (USceneComponent* Child : GetAttachChildren())
     {
         Child->OnTransformUpdated();
@@ -2,6 +2,7 @@
 
 #include "Vector.h"
 #include "ActorComponent.h"
+#include "TransformTable.h"
 #include "USceneComponent.generated.h"
 
 // 부착 시 로컬을 유지할지, 월드를 유지할지
@@ -48,7 +49,7 @@ public:
     // ──────────────────────────────
     // World Transform API
     // ──────────────────────────────
-    FTransform GetWorldTransform() const;
+    FTransform GetWorldTransform() const; // 캐시 반환. 더티할 때만 더티한 조상 구간을 다시 합성
     void SetWorldTransform(const FTransform& W);
 
     void SetWorldLocation(const FVector& L);
@@ -91,11 +92,14 @@ public:
     void SetParent(USceneComponent* InParent)
     {
         AttachParent = InParent;
+        MarkWorldTransformDirty();
+        SyncTransformTableParent();
     }
 
     // Serialize
     void Serialize(const bool bInIsLoading, JSON& InOutHandle) override;
     void OnRegister(UWorld* InWorld) override;
+    void OnUnregister() override;
 
     virtual void OnTransformUpdated();
 
@@ -152,8 +156,16 @@ protected:
     UPROPERTY(LuaReadWrite, EditAnywhere, Category="Transform")
     FVector RelativeRotationEuler{ 0,0,0 };
 
+    // 월드 트랜스폼 캐시. 자신이나 조상의 트랜스폼이 바뀌면 서브트리 전체가 더티가 되고, 조회할 때만 다시 계산한다
+    mutable FTransform CachedWorldTransform;
+    mutable bool bWorldTransformDirty = true;
+
     mutable FMatrix CachedWorldMatrix = FMatrix::Identity();
     mutable bool bIsTransformDirty = true;
+
+    // 월드의 트랜스폼 테이블 엔트리 (등록된 동안만 유효). 테이블이 최신이면 월드 값을 여기서 읽는다
+    FTransformTable* TransformTable = nullptr;
+    FTransformHandle TransformHandle;
     
     // Hierarchy
     USceneComponent* AttachParent = nullptr;
@@ -163,6 +175,17 @@ protected:
     FTransform RelativeTransform;
 
     void UpdateRelativeTransform();
+
+    // 서브트리의 월드 캐시를 무효화한 뒤 OnTransformUpdated() 호출. 트랜스폼을 바꾸는 API 는 모두 이것을 거친다
+    void NotifyTransformChanged();
+    // 자신과 자손의 월드 트랜스폼/행렬 캐시를 더티로 표시 (OnTransformUpdated 오버라이드와 무관하게 항상 전파)
+    void MarkWorldTransformDirty();
+    // 트랜스폼 테이블의 부모 링크를 AttachParent 에 맞춘다
+    void SyncTransformTableParent();
+    // 테이블의 월드 값이 이 컴포넌트의 현재 상태와 같은지
+    bool CanReadFromTransformTable() const;
+    // 더티한 조상의 월드 캐시를 테이블 값으로 채운다 (CanReadFromTransformTable 이 true 일 때만)
+    void CacheAncestorsFromTransformTable() const;
     
     uint32 SceneId; // Scene파일에서 불러온 Id. 컴포넌트끼리 자식부모관계 연결하기 위해 저장. Scene에 저장할 때는 UUID를 저장
     uint32 ParentId;
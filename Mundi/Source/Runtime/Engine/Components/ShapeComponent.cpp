@@ -5,6 +5,8 @@
 #include "World.h"
 #include "WorldPartitionManager.h"
 #include "BVHierarchy.h"
+#include "OverlapBroadPhase.h"
+#include "NarrowPhase.h"
 #include "GameObject.h"
 // IMPLEMENT_CLASS is now auto-generated in .generated.cpp
 UShapeComponent::UShapeComponent() : bShapeIsVisible(true), bShapeHiddenInGame(true)
@@ -23,6 +25,27 @@ void UShapeComponent::OnRegister(UWorld* InWorld)
     Super::OnRegister(InWorld);
     
     GetWorldAABB();
+
+    if (InWorld)
+    {
+        if (FOverlapBroadPhase* BroadPhase = InWorld->GetOverlapBroadPhase())
+        {
+            BroadPhase->Register(this);
+        }
+    }
+}
+
+void UShapeComponent::OnUnregister()
+{
+    if (UWorld* World = GetWorld())
+    {
+        if (FOverlapBroadPhase* BroadPhase = World->GetOverlapBroadPhase())
+        {
+            BroadPhase->Unregister(this);
+        }
+    }
+
+    Super::OnUnregister();
 }
 
 void UShapeComponent::OnTransformUpdated()
@@ -36,6 +59,10 @@ void UShapeComponent::OnTransformUpdated()
         {
             Partition->MarkDirty(this);
         }
+        if (FOverlapBroadPhase* BroadPhase = World->GetOverlapBroadPhase())
+        {
+            BroadPhase->MarkDirty(this);
+        }
     }
 
     //UpdateOverlaps();
@@ -49,134 +76,21 @@ void UShapeComponent::TickComponent(float DeltaSeconds)
         bGenerateOverlapEvents = false;
     }
 
-    if (!bGenerateOverlapEvents)
-    {
-        OverlapInfos.clear();
-    }
-
-    UWorld* World = GetWorld();
-    if (!World) return;
-
-    //Test용 O(N^2) 
-    OverlapNow.clear();
-
-    for (AActor* Actor : World->GetActors())
-    {
-        if (!Actor || !Actor->IsActorActive())
-            continue;
-
-        for (USceneComponent* Comp : Actor->GetSceneComponents())
-        {
-            UShapeComponent* Other = Cast<UShapeComponent>(Comp);
-            if (!Other || Other == this) continue;
-            if (Other->GetOwner() == this->GetOwner()) continue;
-            if (!Other->bGenerateOverlapEvents) continue;
-
-            AActor* Owner = this->GetOwner();
-            AActor* OtherOwner = Other->GetOwner();
-
-            // Collision 모듈
-            if (!Collision::CheckOverlap(this, Other)) continue;
-
-            OverlapNow.Add(Other);
-            //UE_LOG("Collision!!");
-        }
-    }
-
-    // Publish current overlaps
-    OverlapInfos.clear();
-    for (UShapeComponent* Other : OverlapNow)
-    {
-        FOverlapInfo Info;
-        Info.OtherActor = Other->GetOwner();
-        Info.Other = Other;
-        OverlapInfos.Add(Info);
-    }
-
-    //Begin
-    for (UShapeComponent* Comp : OverlapNow)
-    {
-        if (!Comp || Comp->IsPendingDestroy())
-        {
-            continue;
-        }
-
-        if (!OverlapPrev.Contains(Comp))
-        {
-            AActor* Owner = this->GetOwner();
-            AActor* OtherOwner = Comp ? Comp->GetOwner() : nullptr;
-
-            // 이전에 호출된 적이 있는 이벤트 인지 확인
-            if (!(Owner && OtherOwner && World->TryMarkOverlapPair(Owner, OtherOwner)))
-            {
-                continue;
-            }
-
-            // 양방향 호출 
-            Owner->OnComponentBeginOverlap.Broadcast(this, Comp);
-            if (AActor* OtherOwner = Comp->GetOwner())
-            {
-                OtherOwner->OnComponentBeginOverlap.Broadcast(Comp, this);
-            }
-
-            // Hit호출 
-            Owner->OnComponentHit.Broadcast(this, Comp);
-            if (bBlockComponent)
-            {
-                if (AActor* OtherOwner = Comp->GetOwner())
-                {
-                    OtherOwner->OnComponentHit.Broadcast(Comp, this);
-                }
-            }
-        }
-    }
-
-    //End
-    for (UShapeComponent* Comp : OverlapPrev)
-    {
-        if (!Comp || Comp->IsPendingDestroy())
-        {
-            continue;
-        }
-
-        if (!OverlapNow.Contains(Comp))
-        {
-            AActor* Owner = this->GetOwner();
-            AActor* OtherOwner = Comp ? Comp->GetOwner() : nullptr;
-
-            // 이전에 호출된 적이 있는 이벤트 인지 확인
-            if (!(Owner && OtherOwner && World->TryMarkOverlapPair(Owner, OtherOwner)))
-            {
-                continue;
-            }
-
-            // 양방향 호출
-            Owner->OnComponentEndOverlap.Broadcast(this, Comp);
-            if (AActor* OtherOwner = Comp->GetOwner())
-            {
-                OtherOwner->OnComponentEndOverlap.Broadcast(Comp, this);
-            }
-        }
-    }
-
-    OverlapPrev.clear();
-    for (UShapeComponent* Comp : OverlapNow)
-    {
-            if (Comp && !Comp->IsPendingDestroy())
-            {
-                OverlapPrev.Add(Comp);
-            }
-    }
+    // 겹침 판정, OverlapInfos, Begin/End 이벤트는 월드의 FOverlapBroadPhase 가
+    // 액터 틱 이후 프레임당 한 번 처리한다 (UWorld::Tick)
 }
 
 FAABB UShapeComponent::GetWorldAABB() const
 {
-    if (AActor* Owner = GetOwner())
-    {
-        FAABB OwnerBounds = Owner->GetBounds();
-        const FVector HalfExtent = OwnerBounds.GetHalfExtent();
-        WorldAABB = OwnerBounds;
-    }
+    // 소유 액터 바운드가 아니라 셰이프 자체 (내로우 페이즈와 같은 월드 셰이프) 를 감싼다
+    FShape Shape;
+    Shape.Kind = EShapeKind::Sphere;
+    Shape.Sphere.SphereRadius = 0.0f; // GetShape 를 구현하지 않은 셰이프는 점
+    GetShape(Shape);
+
+    Collision::FWorldShape WorldShape;
+    Collision::BuildWorldShape(Shape, GetWorldTransform(), WorldShape);
+    WorldAABB = Collision::GetWorldShapeBounds(WorldShape);
     return WorldAABB;
 }
   
@@ -40,6 +40,7 @@ public:
 	virtual void GetShape(FShape& OutShape) const {};
 	virtual void BeginPlay() override;
     virtual void OnRegister(UWorld* InWorld) override;
+    virtual void OnUnregister() override;
     virtual void OnTransformUpdated() override;
 
     void UpdateOverlaps(); 
@@ -53,9 +54,10 @@ public:
 	// ㅡㅡㅡㅡㅡㅡㅡㅡㅡ디버깅용ㅡㅡㅡㅡㅡㅡㅡㅡㅡㅡ
  
 protected: 
+	// 겹침 쌍/OverlapInfos 는 월드의 FOverlapBroadPhase 가 프레임당 한 번 갱신한다
+	friend class FOverlapBroadPhase;
+
 	mutable FAABB WorldAABB; //브로드 페이즈 용 
-	TSet<UShapeComponent*> OverlapNow; // 이번 프레임에서 overlap 된 Shap Comps
-	TSet<UShapeComponent*> OverlapPrev; // 지난 프레임에서 overlap 됐으면 Cache
 	 
 
 	FVector4 ShapeColor ;
@@ -4,6 +4,7 @@
 #include "AnimSingleNodeInstance.h"
 #include "AnimSequence.h"
 #include "AnimationTypes.h"
+#include "World.h"
 
 USkeletalMeshComponent::USkeletalMeshComponent()
 {
@@ -48,6 +49,7 @@ void USkeletalMeshComponent::SetSkeletalMesh(const FString& PathFileName)
 
         CurrentLocalSpacePose.SetNum(NumBones);
         CurrentComponentSpacePose.SetNum(NumBones);
+        InverseBindPoses.SetNum(NumBones);
         TempFinalSkinningMatrices.SetNum(NumBones);
         TempFinalSkinningNormalMatrices.SetNum(NumBones);
 
@@ -57,6 +59,8 @@ void USkeletalMeshComponent::SetSkeletalMesh(const FString& PathFileName)
             const int32 ParentIndex = ThisBone.ParentIndex;
             FMatrix LocalBindMatrix;
 
+            InverseBindPoses.Set(i, FMatrix3x4(ThisBone.InverseBindPose));
+
             if (ParentIndex == -1) // 루트 본
             {
                 LocalBindMatrix = ThisBone.BindPose;
@@ -77,6 +81,7 @@ void USkeletalMeshComponent::SetSkeletalMesh(const FString& PathFileName)
         // 메시 로드 실패 시 버퍼 비우기
         CurrentLocalSpacePose.Empty();
         CurrentComponentSpacePose.Empty();
+        InverseBindPoses.SetNum(0);
         TempFinalSkinningMatrices.Empty();
         TempFinalSkinningNormalMatrices.Empty();
     }
@@ -159,17 +164,12 @@ void USkeletalMeshComponent::UpdateComponentSpaceTransforms()
 
 void USkeletalMeshComponent::UpdateFinalSkinningMatrices()
 {
-    const FSkeleton& Skeleton = SkeletalMesh->GetSkeletalMeshData()->Skeleton;
-    const int32 NumBones = Skeleton.Bones.Num();
+    // 컴포넌트 공간 포즈를 SoA 로 옮겨 모든 본을 한 번에 계산 (애니메이션 단계에서 스레드마다 작업 버퍼 재사용)
+    // 스키닝 행렬 = InverseBindPose * ComponentPose, 노말 행렬 = 그 3x3 부분의 역전치
+    thread_local FTransformSoA ComponentPoseSoA;
+    ComponentPoseSoA.FromAoS(CurrentComponentSpacePose);
 
-    for (int32 BoneIndex = 0; BoneIndex < NumBones; ++BoneIndex)
-    {
-        const FMatrix& InvBindPose = Skeleton.Bones[BoneIndex].InverseBindPose;
-        const FMatrix ComponentPoseMatrix = CurrentComponentSpacePose[BoneIndex].ToMatrix();
-
-        TempFinalSkinningMatrices[BoneIndex] = InvBindPose * ComponentPoseMatrix;
-        TempFinalSkinningNormalMatrices[BoneIndex] = TempFinalSkinningMatrices[BoneIndex].Inverse().Transpose();
-    }
+    FSoAMath::BuildSkinningMatrices(InverseBindPoses, ComponentPoseSoA, TempFinalSkinningMatrices, TempFinalSkinningNormalMatrices);
 }
 
 // Animation Section Implementation
@@ -264,20 +264,53 @@ void USkeletalMeshComponent::TickAnimation(float DeltaTime)
     if (!AnimInstance)
         return;
 
-    // 애니메이션 파이프라인 실행 (Native + Lua)
+    // 1. 게임 스레드: 노드 시간 / 상태 머신 전이 갱신 (Native + Lua)
     AnimInstance->UpdateAnimation(DeltaTime);
 
-    // 포즈 추출 및 적용
-    FPoseContext Pose;
-    AnimInstance->GetAnimationPose(Pose);
+    // 2. 포즈 추출과 스키닝 행렬은 월드 애니메이션 단계에서 다른 컴포넌트와 함께 병렬로
+    if (UWorld* World = GetWorld())
+    {
+        if (!bAnimationEvaluationQueued)
+        {
+            bAnimationEvaluationQueued = true;
+            World->QueueAnimationEvaluation(this);
+        }
+        return;
+    }
+
+    // 월드 없이 틱되면 바로 처리
+    EvaluateAnimation();
+    DispatchAnimNotifies();
+}
+
+void USkeletalMeshComponent::EvaluateAnimation()
+{
+    if (!AnimInstance)
+        return;
+
+    // 포즈 추출 + Notify 수집 (Notify 는 DispatchAnimNotifies 까지 보관)
+    AnimationPose.AnimNotifies.Empty();
+    AnimInstance->GetAnimationPose(AnimationPose);
 
     // Pose를 CurrentLocalSpacePose에 적용
-    const int32 NumBones = FMath::Min(Pose.GetNumBones(), CurrentLocalSpacePose.Num());
+    const int32 NumBones = FMath::Min(AnimationPose.GetNumBones(), CurrentLocalSpacePose.Num());
     for (int32 i = 0; i < NumBones; ++i)
     {
-        CurrentLocalSpacePose[i] = Pose.BoneTransforms[i];
+        CurrentLocalSpacePose[i] = AnimationPose.BoneTransforms[i];
     }
 
     // 스키닝 업데이트
     ForceRecomputePose();
 }
+
+void USkeletalMeshComponent::DispatchAnimNotifies()
+{
+    bAnimationEvaluationQueued = false;
+
+    if (AnimInstance && !AnimationPose.AnimNotifies.IsEmpty())
+    {
+        // 핸들러가 액터/Lua 를 건드리므로 게임 스레드에서만
+        AnimInstance->TriggerAnimNotifies(AnimationPose);
+    }
+    AnimationPose.AnimNotifies.Empty();
+}
@@ -1,5 +1,7 @@
 ﻿#pragma once
 #include "SkinnedMeshComponent.h"
+#include "AnimationTypes.h"
+#include "VectorSoA.h"
 #include "USkeletalMeshComponent.generated.h"
 
 // 전방 선언
@@ -50,10 +52,22 @@ public:
     // AnimNotify 핸들링 (발제 문서 구조)
     void HandleAnimNotify(const FAnimNotifyEvent& Notify);
 
+    // 월드 애니메이션 단계 (UWorld::TickAnimationPhase)
+    // 포즈 추출/블렌딩 -> 컴포넌트 공간 -> 스키닝 행렬. 컴포넌트끼리 독립이라 워커 스레드에서 병렬로 불린다
+    void EvaluateAnimation();
+    // 동기화 지점 (게임 스레드): EvaluateAnimation 에서 수집한 Notify 트리거
+    void DispatchAnimNotifies();
+
 protected:
     // TickComponent에서 호출
+    // AnimInstance 시간/상태 전이를 갱신하고 월드 애니메이션 단계에 등록한다
     void TickAnimation(float DeltaTime);
 
+    // 애니메이션 단계에서 추출한 포즈와 수집한 Notify (프레임마다 재사용)
+    FPoseContext AnimationPose;
+    // 이번 프레임에 애니메이션 단계에 이미 등록됐는지 (중복 등록 시 같은 컴포넌트를 두 잡이 동시에 평가하는 것 방지)
+    bool bAnimationEvaluationQueued = false;
+
 // Editor Section
 public:
     /**
@@ -88,6 +102,7 @@ protected:
 
     /**
      * @brief CurrentComponentSpacePose를 기반으로 TempFinalSkinningMatrices 채우기
+     * 모든 본을 SoA 로 한 번에 계산 (affine 3x4, 노말 행렬은 4x4 역행렬 없이 3x3 여인수로)
      */
     void UpdateFinalSkinningMatrices();
 
@@ -102,12 +117,17 @@ protected:
      */
     TArray<FTransform> CurrentComponentSpacePose;
 
+    /**
+     * @brief 스켈레톤의 본별 InverseBindPose (SoA, SetSkeletalMesh에서 채움)
+     */
+    FMatrix3x4SoA InverseBindPoses;
+
     /**
      * @brief 부모에게 보낼 최종 스키닝 행렬 (임시 계산용)
      */
-    TArray<FMatrix> TempFinalSkinningMatrices;
+    TArray<FMatrix3x4> TempFinalSkinningMatrices;
     /**
      * @brief CPU 스키닝에 전달할 최종 노말 스키닝 행렬
      */
-    TArray<FMatrix> TempFinalSkinningNormalMatrices;
+    TArray<FMatrix3x4> TempFinalSkinningNormalMatrices;
 };
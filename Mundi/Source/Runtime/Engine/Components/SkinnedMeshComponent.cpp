@@ -3,6 +3,7 @@
 #include "MeshBatchElement.h"
 #include "SceneView.h"
 #include "PlatformTime.h"
+#include "CPUSkinning.h"
 
 USkinnedMeshComponent::USkinnedMeshComponent() : SkeletalMesh(nullptr)
 {
@@ -219,12 +220,13 @@ void USkinnedMeshComponent::SetSkeletalMesh(const FString& PathFileName)
       VertexBuffer->Release();
       VertexBuffer = nullptr;
    }
+   SkinnedVertices.Empty();
     
    if (SkeletalMesh && SkeletalMesh->GetSkeletalMeshData())
    {
       SkeletalMesh->CreateVertexBuffer(&VertexBuffer);
 
-      const TArray<FMatrix> IdentityMatrices(SkeletalMesh->GetBoneCount(), FMatrix::Identity());
+      const TArray<FMatrix3x4> IdentityMatrices(SkeletalMesh->GetBoneCount(), FMatrix3x4::Identity());
       UpdateSkinningMatrices(IdentityMatrices, IdentityMatrices);
       
       const TArray<FGroupInfo>& GroupInfos = SkeletalMesh->GetMeshGroupInfo();
@@ -239,7 +241,7 @@ void USkinnedMeshComponent::SetSkeletalMesh(const FString& PathFileName)
    else
    {
       SkeletalMesh = nullptr;
-      UpdateSkinningMatrices(TArray<FMatrix>(), TArray<FMatrix>());
+      UpdateSkinningMatrices(TArray<FMatrix3x4>(), TArray<FMatrix3x4>());
    }
 }
 
@@ -252,7 +254,19 @@ void USkinnedMeshComponent::PerformSkinning()
    {
        const TArray<FSkinnedVertex>& SrcVertices = SkeletalMesh->GetSkeletalMeshData()->Vertices;
        const int32 NumVertices = SrcVertices.Num();
-       SkinnedVertices.SetNum(NumVertices);
+       if (SkinnedVertices.Num() != NumVertices)
+       {
+           // UV, 컬러, 본 데이터는 바뀌지 않으므로 메시가 바뀔 때 한 번만 복사
+           SkinnedVertices = SrcVertices;
+       }
+
+       // 스트림 경로: 잡 시스템 + AVX2, Position / Normal / Tangent.xyz 만 쓴다
+       const FSkinningStreams& Streams = SkeletalMesh->GetSkinningStreams();
+       if (Streams.Num() == NumVertices)
+       {
+           FCPUSkinning::SkinVertices(Streams, FinalSkinningMatrices, FinalSkinningNormalMatrices, SkinnedVertices);
+           return;
+       }
 
        for (int32 Idx = 0; Idx < NumVertices; ++Idx)
        {
@@ -262,12 +276,11 @@ void USkinnedMeshComponent::PerformSkinning()
            DstVert.Position = SkinVertexPosition(SrcVert);
            DstVert.Normal = SkinVertexNormal(SrcVert);
            DstVert.Tangent = SkinVertexTangent(SrcVert);
-           DstVert.UV = SrcVert.UV;
        }
    }
 }
 
-void USkinnedMeshComponent::UpdateSkinningMatrices(const TArray<FMatrix>& InSkinningMatrices, const TArray<FMatrix>& InSkinningNormalMatrices)
+void USkinnedMeshComponent::UpdateSkinningMatrices(const TArray<FMatrix3x4>& InSkinningMatrices, const TArray<FMatrix3x4>& InSkinningNormalMatrices)
 {
    FinalSkinningMatrices = InSkinningMatrices;
    FinalSkinningNormalMatrices = InSkinningNormalMatrices;
@@ -285,7 +298,7 @@ FVector USkinnedMeshComponent::SkinVertexPosition(const FSkinnedVertex& InVertex
 
       if (Weight > 0.f)
       {
-         const FMatrix& SkinMatrix = FinalSkinningMatrices[BoneIndex];
+         const FMatrix3x4& SkinMatrix = FinalSkinningMatrices[BoneIndex];
          FVector TransformedPosition = SkinMatrix.TransformPosition(InVertex.Position);
          BlendedPosition += TransformedPosition * Weight;
       }
@@ -305,7 +318,7 @@ FVector USkinnedMeshComponent::SkinVertexNormal(const FSkinnedVertex& InVertex)
 
       if (Weight > 0.f)
       {
-         const FMatrix& SkinMatrix = FinalSkinningNormalMatrices[BoneIndex];
+         const FMatrix3x4& SkinMatrix = FinalSkinningNormalMatrices[BoneIndex];
          FVector TransformedNormal = SkinMatrix.TransformVector(InVertex.Normal);
          BlendedNormal += TransformedNormal * Weight;
       }
@@ -328,7 +341,7 @@ FVector4 USkinnedMeshComponent::SkinVertexTangent(const FSkinnedVertex& InVertex
 
       if (Weight > 0.f)
       {
-         const FMatrix& SkinMatrix = FinalSkinningMatrices[BoneIndex];
+         const FMatrix3x4& SkinMatrix = FinalSkinningMatrices[BoneIndex];
          FVector TransformedTangentDir = SkinMatrix.TransformVector(OriginalTangentDir);
          BlendedTangentDir += TransformedTangentDir * Weight;
       }
@@ -36,15 +36,16 @@ public:
      * @brief 이 컴포넌트의 USkeletalMesh 에셋을 반환
      */
     USkeletalMesh* GetSkeletalMesh() const { return SkeletalMesh; }
-    const TArray<FMatrix>& GetFinalSkinningMatrices() const{ return FinalSkinningMatrices; }
+    const TArray<FMatrix3x4>& GetFinalSkinningMatrices() const{ return FinalSkinningMatrices; }
 
 protected:
     void PerformSkinning();
     /**
      * @brief 자식에게서 원본 메시를 받아 CPU 스키닝을 수행
-     * @param InSkinningMatrices 스키닝 매트릭스
+     * @param InSkinningMatrices 스키닝 매트릭스 (affine 3x4, GPU 스키닝 시 그대로 업로드)
+     * @param InSkinningNormalMatrices 노말 스키닝 매트릭스 (스키닝 매트릭스 3x3 부분의 역전치)
      */
-    void UpdateSkinningMatrices(const TArray<FMatrix>& InSkinningMatrices, const TArray<FMatrix>& InSkinningNormalMatrices);
+    void UpdateSkinningMatrices(const TArray<FMatrix3x4>& InSkinningMatrices, const TArray<FMatrix3x4>& InSkinningNormalMatrices);
     
     UPROPERTY(LuaReadWrite, EditAnywhere, Category = "Skeletal Mesh", Tooltip = "Skeletal mesh asset to render")
     USkeletalMesh* SkeletalMesh;
@@ -62,8 +63,8 @@ private:
     /**
      * @brief 자식이 계산해 준, 현재 프레임의 최종 스키닝 행렬
     */
-    TArray<FMatrix> FinalSkinningMatrices;
-    TArray<FMatrix> FinalSkinningNormalMatrices;
+    TArray<FMatrix3x4> FinalSkinningMatrices;
+    TArray<FMatrix3x4> FinalSkinningNormalMatrices;
     bool bSkinningMatricesDirty = true;
     
     /**
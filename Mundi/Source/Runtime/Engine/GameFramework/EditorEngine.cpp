@@ -1,6 +1,8 @@
 ﻿#include "pch.h"
 #include "EditorEngine.h"
 #include "USlateManager.h"
+#include "FrameArena.h"
+#include "JobSystem.h"
 #include "SelectionManager.h"
 #include "FAudioDevice.h"
 #include "FbxLoader.h"
@@ -178,11 +180,17 @@ bool UEditorEngine::CreateMainWindow(HINSTANCE hInstance)
 
 bool UEditorEngine::Startup(HINSTANCE hInstance)
 {
+    // 정적 클래스 등록은 끝났으므로 IsChildOf 구간을 한 번 만든다 (워커가 Cast 하기 전에)
+    UClass::BuildClassTree();
+
     LoadIniFile();
 
     if (!CreateMainWindow(hInstance))
         return false;
 
+    // 작업 스케줄러 (이후 초기화/프리로드 단계에서도 사용 가능)
+    FJobSystem::Get().Initialize();
+
     //디바이스 리소스 및 렌더러 생성
     RHIDevice.Initialize(HWnd);
     Renderer = std::make_unique<URenderer>(&RHIDevice);
@@ -304,6 +312,9 @@ void UEditorEngine::MainLoop()
 
         if (!bRunning) break;
 
+        // 워커가 예약한 메인 스레드 전용 작업
+        FJobSystem::Get().ProcessMainThreadJobs();
+
         if (bChangedPieToEditor)
         {
             if (GWorld && bPIEActive)
@@ -325,7 +336,10 @@ void UEditorEngine::MainLoop()
        // CauseCrash();
         Tick(DeltaSeconds);
         Render();
-        
+
+        // 프레임 임시 메모리 버퍼 교체 (두 프레임 전 버퍼 리셋)
+        FFrameArena::Get().EndFrame();
+
         // Shader Hot Reloading - Call AFTER render to avoid mid-frame resource conflicts
         // This ensures all GPU commands are submitted before we check for shader updates
         UResourceManager::GetInstance().CheckAndReloadShaders(DeltaSeconds);
@@ -334,6 +348,9 @@ void UEditorEngine::MainLoop()
 
 void UEditorEngine::Shutdown()
 {
+    // 진행 중인 작업이 UObject 를 참조할 수 있으므로 가장 먼저 워커를 정리
+    FJobSystem::Get().Shutdown();
+
     // 월드부터 삭제해야 DeleteAll 때 문제가 없음
     for (FWorldContext WorldContext : WorldContexts)
     {
@@ -1,6 +1,8 @@
 ﻿#include "pch.h"
 #include "GameEngine.h"
 #include "USlateManager.h"
+#include "FrameArena.h"
+#include "JobSystem.h"
 #include "SelectionManager.h"
 #include "FViewport.h"
 #include "PlayerCameraManager.h"
@@ -171,11 +173,17 @@ bool UGameEngine::CreateMainWindow(HINSTANCE hInstance)
 
 bool UGameEngine::Startup(HINSTANCE hInstance)
 {
+    // 정적 클래스 등록은 끝났으므로 IsChildOf 구간을 한 번 만든다 (워커가 Cast 하기 전에)
+    UClass::BuildClassTree();
+
     LoadIniFile();
 
     if (!CreateMainWindow(hInstance))
         return false;
 
+    // 작업 스케줄러 (이후 초기화/프리로드 단계에서도 사용 가능)
+    FJobSystem::Get().Initialize();
+
     // 디바이스 리소스 및 렌더러 생성
     RHIDevice.Initialize(HWnd);
     Renderer = std::make_unique<URenderer>(&RHIDevice);
@@ -313,9 +321,15 @@ void UGameEngine::MainLoop()
 
         if (!bRunning) break;
 
+        // 워커가 예약한 메인 스레드 전용 작업
+        FJobSystem::Get().ProcessMainThreadJobs();
+
         Tick(DeltaSeconds);
         Render();
 
+        // 프레임 임시 메모리 버퍼 교체 (두 프레임 전 버퍼 리셋)
+        FFrameArena::Get().EndFrame();
+
         // Shader Hot Reloading - Call AFTER render to avoid mid-frame resource conflicts
         // This ensures all GPU commands are submitted before we check for shader updates
         UResourceManager::GetInstance().CheckAndReloadShaders(DeltaSeconds);
@@ -324,6 +338,9 @@ void UGameEngine::MainLoop()
 
 void UGameEngine::Shutdown()
 {
+    // 진행 중인 작업이 UObject 를 참조할 수 있으므로 가장 먼저 워커를 정리
+    FJobSystem::Get().Shutdown();
+
     // 월드부터 삭제해야 DeleteAll 때 문제가 없음
     for (FWorldContext WorldContext : WorldContexts)
     {
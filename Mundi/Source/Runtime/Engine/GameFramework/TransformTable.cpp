@@ -0,0 +1,289 @@
+﻿#include "pch.h"
+#include "TransformTable.h"
+#include "JobSystem.h"
+
+namespace
+{
+	// 병렬 처리 단위. 루트 서브트리를 이 크기 이상으로 묶어 배치 하나로 처리한다
+	constexpr int32 MinEntriesPerBatch = 2048;
+	// 이보다 작으면 스레드 분배 비용이 더 크다
+	constexpr int32 ParallelThreshold = 8192;
+}
+
+FTransformHandle FTransformTable::Register(const FTransform& Local)
+{
+	int32 Slot;
+	if (!FreeSlots.IsEmpty())
+	{
+		Slot = FreeSlots.Pop();
+	}
+	else
+	{
+		Slot = Slots.Add(FSlot());
+	}
+
+	Slots[Slot].Dense = AddDense(Slot, Local);
+	++NumAlive;
+	bPendingChanges = true;
+
+	return FTransformHandle{ Slot, Slots[Slot].Generation };
+}
+
+int32 FTransformTable::AddDense(int32 Slot, const FTransform& Local)
+{
+	const int32 Dense = LocalTransforms.Add(Local);
+	WorldTransforms.Add(Local);
+	WorldMatrices.Add(Local.ToMatrix());
+	Parents.Add(-1);
+	Dirty.Add(1);
+	Changed.Add(0);
+	DenseToSlot.Add(Slot);
+
+	// 새 루트는 맨 뒤에 붙여도 계층 순서가 유지된다
+	if (!bOrderDirty)
+	{
+		if (!RootRanges.IsEmpty() && RootRanges.Last().End == Dense && RootRanges.Last().End - RootRanges.Last().Begin < MinEntriesPerBatch)
+		{
+			RootRanges.Last().End = Dense + 1;
+		}
+		else
+		{
+			RootRanges.Add({ Dense, Dense + 1 });
+		}
+	}
+	return Dense;
+}
+
+void FTransformTable::Unregister(FTransformHandle Handle)
+{
+	if (!IsValid(Handle))
+	{
+		return;
+	}
+
+	FSlot& Slot = Slots[Handle.Slot];
+	DenseToSlot[Slot.Dense] = -1;
+
+	Slot.Dense = -1;
+	++Slot.Generation;
+	FreeSlots.Add(Handle.Slot);
+
+	--NumAlive;
+	// 빈 자리는 다음 재정렬 때 정리된다. 자식이 남아있다면 그때 루트가 된다
+	bOrderDirty = true;
+	bPendingChanges = true;
+}
+
+bool FTransformTable::IsValid(FTransformHandle Handle) const
+{
+	return Handle.Slot >= 0 && Handle.Slot < Slots.Num()
+		&& Slots[Handle.Slot].Generation == Handle.Generation
+		&& Slots[Handle.Slot].Dense >= 0;
+}
+
+void FTransformTable::SetLocal(FTransformHandle Handle, const FTransform& Local)
+{
+	if (!IsValid(Handle))
+	{
+		return;
+	}
+
+	const int32 Dense = Slots[Handle.Slot].Dense;
+	LocalTransforms[Dense] = Local;
+	Dirty[Dense] = 1;
+	bPendingChanges = true;
+}
+
+void FTransformTable::SetParent(FTransformHandle Handle, FTransformHandle Parent)
+{
+	if (!IsValid(Handle))
+	{
+		return;
+	}
+
+	const int32 Dense = Slots[Handle.Slot].Dense;
+	const int32 ParentDense = IsValid(Parent) ? Slots[Parent.Slot].Dense : -1;
+	if (Parents[Dense] == ParentDense)
+	{
+		return;
+	}
+
+	// 순환 방지: 새 부모의 조상 중에 자신이 있으면 거부
+	for (int32 Ancestor = ParentDense; Ancestor >= 0; Ancestor = Parents[Ancestor])
+	{
+		if (Ancestor == Dense)
+		{
+			UE_LOG("[TransformTable] SetParent rejected: cycle in hierarchy");
+			return;
+		}
+	}
+
+	Parents[Dense] = ParentDense;
+	Dirty[Dense] = 1;
+	bOrderDirty = true;
+	bPendingChanges = true;
+}
+
+void FTransformTable::Update()
+{
+	if (!bPendingChanges)
+	{
+		return;
+	}
+
+	if (bOrderDirty)
+	{
+		RebuildOrder();
+	}
+
+	if (NumAlive >= ParallelThreshold && RootRanges.Num() > 1)
+	{
+		// 루트 서브트리 구간끼리는 서로의 엔트리를 참조하지 않는다
+		FJobSystem::Get().ParallelFor(RootRanges.Num(), 1, [this](int32 Begin, int32 End)
+		{
+			for (int32 i = Begin; i < End; ++i)
+			{
+				UpdateRange(RootRanges[i].Begin, RootRanges[i].End);
+			}
+		}, "TransformTable");
+	}
+	else
+	{
+		for (const FRootRange& Range : RootRanges)
+		{
+			UpdateRange(Range.Begin, Range.End);
+		}
+	}
+
+	bPendingChanges = false;
+}
+
+void FTransformTable::UpdateRange(int32 Begin, int32 End)
+{
+	for (int32 i = Begin; i < End; ++i)
+	{
+		// 부모가 먼저 처리되므로 부모의 Changed 는 이미 이번 Update 의 값이다
+		const int32 Parent = Parents[i];
+		const bool bChanged = Dirty[i] || (Parent >= 0 && Changed[Parent]);
+		Changed[i] = bChanged ? 1 : 0;
+		Dirty[i] = 0;
+
+		if (!bChanged)
+		{
+			continue;
+		}
+
+		WorldTransforms[i] = (Parent >= 0) ? WorldTransforms[Parent].GetWorldTransform(LocalTransforms[i]) : LocalTransforms[i];
+		WorldMatrices[i] = WorldTransforms[i].ToMatrix();
+	}
+}
+
+void FTransformTable::RebuildOrder()
+{
+	const int32 OldNum = LocalTransforms.Num();
+
+	// 살아있는 부모 기준 자식 목록 (CSR)
+	TArray<int32> ChildStart(OldNum + 1, 0);
+	for (int32 i = 0; i < OldNum; ++i)
+	{
+		const int32 Parent = Parents[i];
+		if (DenseToSlot[i] >= 0 && Parent >= 0 && DenseToSlot[Parent] >= 0)
+		{
+			++ChildStart[Parent + 1];
+		}
+	}
+	for (int32 i = 0; i < OldNum; ++i)
+	{
+		ChildStart[i + 1] += ChildStart[i];
+	}
+	TArray<int32> ChildList(ChildStart[OldNum]);
+	{
+		TArray<int32> Cursor(ChildStart.begin(), ChildStart.end() - 1);
+		for (int32 i = 0; i < OldNum; ++i)
+		{
+			const int32 Parent = Parents[i];
+			if (DenseToSlot[i] >= 0 && Parent >= 0 && DenseToSlot[Parent] >= 0)
+			{
+				ChildList[Cursor[Parent]++] = i;
+			}
+		}
+	}
+
+	// 루트마다 DFS 전위 순회. 기존 순서를 최대한 유지한다
+	TArray<int32> NewToOld;
+	NewToOld.Reserve(NumAlive);
+	TArray<int32> OldToNew(OldNum, -1);
+	TArray<int32> Stack;
+	RootRanges.Empty();
+
+	auto VisitRoot = [&](int32 Root)
+	{
+		const int32 Begin = NewToOld.Num();
+		Stack.Add(Root);
+		while (!Stack.IsEmpty())
+		{
+			const int32 Old = Stack.Pop();
+			OldToNew[Old] = NewToOld.Add(Old);
+			for (int32 c = ChildStart[Old + 1] - 1; c >= ChildStart[Old]; --c)
+			{
+				Stack.Add(ChildList[c]);
+			}
+		}
+
+		// 작은 서브트리는 이전 구간에 합쳐 배치 크기를 맞춘다
+		if (!RootRanges.IsEmpty() && RootRanges.Last().End - RootRanges.Last().Begin < MinEntriesPerBatch)
+		{
+			RootRanges.Last().End = NewToOld.Num();
+		}
+		else
+		{
+			RootRanges.Add({ Begin, NewToOld.Num() });
+		}
+	};
+
+	for (int32 i = 0; i < OldNum; ++i)
+	{
+		const int32 Parent = Parents[i];
+		const bool bRoot = Parent < 0 || DenseToSlot[Parent] < 0;
+		if (DenseToSlot[i] >= 0 && bRoot)
+		{
+			VisitRoot(i);
+		}
+	}
+
+	// 새 배열로 재배치
+	const int32 NewNum = NewToOld.Num();
+	TArray<FTransform> NewLocal(NewNum);
+	TArray<FTransform> NewWorld(NewNum);
+	TArray<FMatrix> NewMatrices(NewNum);
+	TArray<int32> NewParents(NewNum);
+	TArray<uint8> NewDirty(NewNum);
+	TArray<int32> NewDenseToSlot(NewNum);
+
+	for (int32 New = 0; New < NewNum; ++New)
+	{
+		const int32 Old = NewToOld[New];
+		const int32 OldParent = Parents[Old];
+		const int32 NewParent = (OldParent >= 0) ? OldToNew[OldParent] : -1;
+
+		NewLocal[New] = LocalTransforms[Old];
+		NewWorld[New] = WorldTransforms[Old];
+		NewMatrices[New] = WorldMatrices[Old];
+		NewParents[New] = NewParent;
+		// 부모를 잃은 엔트리는 루트 기준으로 다시 계산해야 한다
+		NewDirty[New] = (Dirty[Old] || (OldParent >= 0 && NewParent < 0)) ? 1 : 0;
+		NewDenseToSlot[New] = DenseToSlot[Old];
+
+		Slots[DenseToSlot[Old]].Dense = New;
+	}
+
+	LocalTransforms = std::move(NewLocal);
+	WorldTransforms = std::move(NewWorld);
+	WorldMatrices = std::move(NewMatrices);
+	Parents = std::move(NewParents);
+	Dirty = std::move(NewDirty);
+	Changed.assign(NewNum, 0);
+	DenseToSlot = std::move(NewDenseToSlot);
+
+	bOrderDirty = false;
+}
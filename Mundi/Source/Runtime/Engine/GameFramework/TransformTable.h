@@ -0,0 +1,86 @@
+﻿#pragma once
+#include "Vector.h"
+
+// FTransformTable 의 엔트리를 가리키는 핸들. 재정렬/삭제가 있어도 세대 값으로 유효성을 확인한다
+struct FTransformHandle
+{
+	int32 Slot = -1;
+	uint32 Generation = 0;
+
+	bool IsValid() const { return Slot >= 0; }
+	void Reset() { Slot = -1; Generation = 0; }
+
+	bool operator==(const FTransformHandle& Other) const { return Slot == Other.Slot && Generation == Other.Generation; }
+	bool operator!=(const FTransformHandle& Other) const { return !(*this == Other); }
+};
+
+/**
+ * 월드가 소유하는 트랜스폼 테이블.
+ * - 로컬 트랜스폼, 부모 인덱스, 월드 트랜스폼/행렬을 계층 순서(DFS 전위)로 연속 배열에 저장한다.
+ *   부모가 항상 자식보다 앞에 있으므로 Update() 한 번의 선형 순회로 모든 월드 행렬을 계산할 수 있다.
+ * - 루트 서브트리는 배열에서 연속 구간이고 서로 독립이라, 구간 단위로 병렬 처리한다.
+ * - 계층이 바뀌면(등록/해제/부모 변경) 다음 Update() 에서 순서를 다시 만든다.
+ * - 마지막 Update() 이후 변경이 없을 때만(IsUpToDate) 테이블의 월드 값이 최신이다.
+ *   그 외에는 USceneComponent 의 지연 캐시 경로가 사용된다.
+ */
+class FTransformTable
+{
+public:
+	FTransformHandle Register(const FTransform& Local);
+	void Unregister(FTransformHandle Handle);
+
+	bool IsValid(FTransformHandle Handle) const;
+
+	void SetLocal(FTransformHandle Handle, const FTransform& Local);
+	// Parent 가 유효하지 않으면 루트가 된다
+	void SetParent(FTransformHandle Handle, FTransformHandle Parent);
+
+	// 더티 엔트리와 그 자손의 월드 값을 계층 순서대로 갱신 (프레임당 한 번, 액터 틱 이후)
+	void Update();
+
+	bool IsUpToDate() const { return !bPendingChanges; }
+
+	const FTransform& GetWorldTransform(FTransformHandle Handle) const { return WorldTransforms[Slots[Handle.Slot].Dense]; }
+	const FMatrix& GetWorldMatrix(FTransformHandle Handle) const { return WorldMatrices[Slots[Handle.Slot].Dense]; }
+	// 변경을 처리한 마지막 Update() 에서 월드 값이 바뀌었는지
+	bool WasUpdated(FTransformHandle Handle) const { return Changed[Slots[Handle.Slot].Dense] != 0; }
+
+	int32 Num() const { return NumAlive; }
+
+private:
+	struct FSlot
+	{
+		int32 Dense = -1;
+		uint32 Generation = 0;
+	};
+
+	// 루트 하나와 그 자손이 차지하는 [Begin, End) 구간
+	struct FRootRange
+	{
+		int32 Begin;
+		int32 End;
+	};
+
+	int32 AddDense(int32 Slot, const FTransform& Local);
+	void RebuildOrder();
+	void UpdateRange(int32 Begin, int32 End);
+
+	// ── 엔트리 (계층 순서) ──
+	TArray<FTransform> LocalTransforms;
+	TArray<FTransform> WorldTransforms;
+	TArray<FMatrix> WorldMatrices;
+	TArray<int32> Parents;      // dense 인덱스, 루트는 -1
+	TArray<uint8> Dirty;        // 로컬/부모가 바뀜
+	TArray<uint8> Changed;      // 마지막 Update 에서 월드 값이 바뀜 (Dirty 가 자손으로 전파된 결과)
+	TArray<int32> DenseToSlot;  // 삭제된 엔트리는 -1
+
+	// ── 핸들 → 엔트리 ──
+	TArray<FSlot> Slots;
+	TArray<int32> FreeSlots;
+
+	TArray<FRootRange> RootRanges;
+
+	int32 NumAlive = 0;
+	bool bOrderDirty = false;
+	bool bPendingChanges = false;
+};
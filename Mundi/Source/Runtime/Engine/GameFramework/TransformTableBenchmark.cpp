@@ -0,0 +1,189 @@
+﻿#include "pch.h"
+#include "TransformTable.h"
+#include "SceneComponent.h"
+#include "World.h"
+#include "Benchmark.h"
+
+namespace
+{
+	// 액터 하나 = 루트 + 자식 2 + 손자 1 (메시/콜리전/이펙트 정도의 구성)
+	constexpr int32 ComponentsPerActor = 4;
+	constexpr int32 NumFrames = 10;
+
+	FVector FrameOffset(int32 ActorIndex, int32 Frame)
+	{
+		return FVector(static_cast<float>(ActorIndex % 100), static_cast<float>(Frame), static_cast<float>(ActorIndex / 100));
+	}
+
+	void RunComponentPath(int32 NumActors, double& OutSetMs, double& OutReadMs)
+	{
+		TArray<USceneComponent*> Roots;
+		TArray<USceneComponent*> All;
+		Roots.Reserve(NumActors);
+		All.Reserve(NumActors * ComponentsPerActor);
+
+		for (int32 i = 0; i < NumActors; ++i)
+		{
+			USceneComponent* Root = NewObject<USceneComponent>();
+			USceneComponent* ChildA = NewObject<USceneComponent>();
+			USceneComponent* ChildB = NewObject<USceneComponent>();
+			USceneComponent* GrandChild = NewObject<USceneComponent>();
+			ChildA->SetupAttachment(Root, EAttachmentRule::KeepRelative);
+			ChildB->SetupAttachment(Root, EAttachmentRule::KeepRelative);
+			GrandChild->SetupAttachment(ChildA, EAttachmentRule::KeepRelative);
+			ChildA->SetRelativeLocation(FVector(1, 0, 0));
+			ChildB->SetRelativeLocation(FVector(0, 1, 0));
+			GrandChild->SetRelativeLocation(FVector(0, 0, 1));
+
+			Roots.Add(Root);
+			All.Add(Root);
+			All.Add(ChildA);
+			All.Add(ChildB);
+			All.Add(GrandChild);
+		}
+
+		OutSetMs = 0.0;
+		OutReadMs = 0.0;
+		uint64 Acc = 0;
+		for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+		{
+			{
+				FBenchTimer Timer;
+				for (int32 i = 0; i < NumActors; ++i)
+				{
+					Roots[i]->SetRelativeLocation(FrameOffset(i, Frame));
+				}
+				OutSetMs += Timer.GetMs();
+			}
+			{
+				// 렌더링처럼 모든 컴포넌트의 월드 행렬을 읽는다
+				FBenchTimer Timer;
+				for (USceneComponent* Component : All)
+				{
+					const FMatrix World = Component->GetWorldMatrix();
+					Acc += static_cast<uint64>(World.M[3][0]);
+				}
+				OutReadMs += Timer.GetMs();
+			}
+		}
+		BenchmarkKeep(Acc);
+
+		// 루트를 지우면 자식도 함께 정리된다
+		for (USceneComponent* Root : Roots)
+		{
+			Root->DestroyComponent();
+		}
+	}
+
+	void RunTablePath(int32 NumActors, double& OutSetMs, double& OutUpdateMs, double& OutReadMs)
+	{
+		FTransformTable Table;
+		TArray<FTransformHandle> Roots;
+		TArray<FTransformHandle> All;
+		Roots.Reserve(NumActors);
+		All.Reserve(NumActors * ComponentsPerActor);
+
+		// 컴포넌트 등록처럼 자식이 부모보다 먼저 들어오는 경우도 섞는다
+		for (int32 i = 0; i < NumActors; ++i)
+		{
+			const FTransformHandle GrandChild = Table.Register(FTransform(FVector(0, 0, 1), FQuat::Identity(), FVector::One()));
+			const FTransformHandle Root = Table.Register(FTransform());
+			const FTransformHandle ChildA = Table.Register(FTransform(FVector(1, 0, 0), FQuat::Identity(), FVector::One()));
+			const FTransformHandle ChildB = Table.Register(FTransform(FVector(0, 1, 0), FQuat::Identity(), FVector::One()));
+			Table.SetParent(ChildA, Root);
+			Table.SetParent(ChildB, Root);
+			Table.SetParent(GrandChild, ChildA);
+
+			Roots.Add(Root);
+			All.Add(Root);
+			All.Add(ChildA);
+			All.Add(ChildB);
+			All.Add(GrandChild);
+		}
+		Table.Update();
+
+		OutSetMs = 0.0;
+		OutUpdateMs = 0.0;
+		OutReadMs = 0.0;
+		uint64 Acc = 0;
+		for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+		{
+			{
+				FBenchTimer Timer;
+				for (int32 i = 0; i < NumActors; ++i)
+				{
+					Table.SetLocal(Roots[i], FTransform(FrameOffset(i, Frame), FQuat::Identity(), FVector::One()));
+				}
+				OutSetMs += Timer.GetMs();
+			}
+			{
+				FBenchTimer Timer;
+				Table.Update();
+				OutUpdateMs += Timer.GetMs();
+			}
+			{
+				FBenchTimer Timer;
+				for (const FTransformHandle& Handle : All)
+				{
+					Acc += static_cast<uint64>(Table.GetWorldMatrix(Handle).M[3][0]);
+				}
+				OutReadMs += Timer.GetMs();
+			}
+		}
+		BenchmarkKeep(Acc);
+	}
+
+	// 부모와 자식이 모두 더티일 때 자식만 테이블에서 읽은 뒤 부모를 옮기면 자식 월드 값도 따라와야 한다
+	// (부모가 더티로 남으면 MarkWorldTransformDirty 가 자식까지 내려가지 않는다)
+	bool CheckChildFollowsParentAfterTableRead()
+	{
+		UWorld* World = NewObject<UWorld>();
+		World->bPie = true; // 에디터 아이콘 컴포넌트 생성 생략
+
+		USceneComponent* Parent = NewObject<USceneComponent>();
+		USceneComponent* Child = NewObject<USceneComponent>();
+		Child->SetupAttachment(Parent, EAttachmentRule::KeepRelative);
+		Child->SetRelativeLocation(FVector(1, 0, 0));
+		Parent->RegisterComponent(World);
+		Child->RegisterComponent(World);
+		World->GetTransformTable()->Update();
+
+		Child->GetWorldTransform();
+		Child->GetWorldMatrix();
+
+		Parent->SetRelativeLocation(FVector(0, 5, 0));
+		const FVector Expected(1, 5, 0);
+		const FMatrix ChildMatrix = Child->GetWorldMatrix();
+		const bool bFollows = FVector::Distance(Child->GetWorldLocation(), Expected) < 1e-4f
+			&& FVector::Distance(FVector(ChildMatrix.M[3][0], ChildMatrix.M[3][1], ChildMatrix.M[3][2]), Expected) < 1e-4f;
+
+		// 루트를 지우면 자식도 함께 정리된다
+		Parent->DestroyComponent();
+		ObjectFactory::DeleteObject(World);
+		return bFollows;
+	}
+}
+
+IMPLEMENT_BENCHMARK(TRANSFORMS, "Per-frame world transform update of moving actors: component hierarchy vs FTransformTable")
+{
+	UE_LOG("[Bench] Transforms table read then parent move: %s", CheckChildFollowsParentAfterTableRead() ? "child follows" : "STALE CHILD");
+
+	for (int32 NumComponents : { 10000, 40000, 100000 })
+	{
+		const int32 NumActors = NumComponents / ComponentsPerActor;
+
+		double CompSetMs = 0.0, CompReadMs = 0.0;
+		RunComponentPath(NumActors, CompSetMs, CompReadMs);
+
+		double TableSetMs = 0.0, TableUpdateMs = 0.0, TableReadMs = 0.0;
+		RunTablePath(NumActors, TableSetMs, TableUpdateMs, TableReadMs);
+
+		const double CompTotal = (CompSetMs + CompReadMs) / NumFrames;
+		const double TableTotal = (TableSetMs + TableUpdateMs + TableReadMs) / NumFrames;
+		UE_LOG("[Bench] Transforms %6d comps/frame: components set %.3fms + read %.3fms = %.3fms | table set %.3fms + update %.3fms + read %.3fms = %.3fms  x%.2f",
+			NumComponents,
+			CompSetMs / NumFrames, CompReadMs / NumFrames, CompTotal,
+			TableSetMs / NumFrames, TableUpdateMs / NumFrames, TableReadMs / NumFrames, TableTotal,
+			TableTotal > 0.0 ? CompTotal / TableTotal : 0.0);
+	}
+}
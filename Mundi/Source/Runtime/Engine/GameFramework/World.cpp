@@ -28,7 +28,11 @@
 #include "Level.h"
 #include "LightManager.h"
 #include "LuaManager.h"
+#include "FrameArena.h"
 #include "ShapeComponent.h"
+#include "OverlapBroadPhase.h"
+#include "SkeletalMeshComponent.h"
+#include "JobSystem.h"
 #include "PlayerCameraManager.h"
 #include "Hash.h"
 
@@ -42,6 +46,8 @@ UWorld::UWorld() : Partition(nullptr)  // Will be created in Initialize() based
 	LightManager = std::make_unique<FLightManager>();
 	LightManager->SetOwningWorld(this);  // Set owning world for optimization decisions
 	LuaManager = std::make_unique<FLuaManager>();
+	TransformTable = std::make_unique<FTransformTable>();
+	OverlapBroadPhase = std::make_unique<FOverlapBroadPhase>();
 
 	UnscaledDelta = 0;
 	SlomoOnlyDelta = 0;
@@ -252,7 +258,7 @@ void UWorld::Tick(float DeltaSeconds)
 	if (Level)
 	{
 		// Tick 중에 새로운 actor가 추가될 수도 있어서 복사 후 호출
-		TArray<AActor*> LevelActors = Level->GetActors();
+		TFrameArray<AActor*> LevelActors(Level->GetActors().begin(), Level->GetActors().end());
 		for (AActor* Actor : LevelActors)
 		{
 			if (Actor && Actor->IsActorActive())
@@ -268,6 +274,9 @@ void UWorld::Tick(float DeltaSeconds)
 		}
     }
 
+	// 셰이프 겹침: 브로드 페이즈로 이번 프레임 쌍 목록을 한 번 만들고 지난 프레임과 비교해 Begin/End 이벤트
+	OverlapBroadPhase->UpdateOverlaps(this);
+
     for (AActor* EditorActor : EditorActors)
     {
 		if (EditorActor && !bPie)
@@ -276,6 +285,9 @@ void UWorld::Tick(float DeltaSeconds)
 		}
     }
 
+	// 애니메이션 단계: 액터 틱에서 등록된 스켈레탈 메시 컴포넌트의 포즈 평가 + Notify 트리거
+	TickAnimationPhase();
+
 	// Lua 코루틴 전용 Tick
 	if (LuaManager && bPie)
 	{
@@ -284,6 +296,45 @@ void UWorld::Tick(float DeltaSeconds)
 
 	// 지연 삭제 처리
 	ProcessPendingKillActors();
+
+	// 이번 프레임에 바뀐 트랜스폼을 계층 순서대로 한 번에 갱신 (렌더링 전)
+	TransformTable->Update();
+}
+
+void UWorld::QueueAnimationEvaluation(USkeletalMeshComponent* Component)
+{
+	if (Component)
+	{
+		PendingAnimationComponents.Add(Component);
+	}
+}
+
+void UWorld::TickAnimationPhase()
+{
+	if (PendingAnimationComponents.IsEmpty())
+	{
+		return;
+	}
+
+	// 컴포넌트마다 자기 AnimInstance/포즈/행렬만 쓰고 애니메이션 에셋은 읽기만 하므로 서로 독립
+	// 등록된 컴포넌트는 ProcessPendingKillActors 전까지 살아 있다
+	constexpr int32 MinComponentsPerJob = 2;
+	FJobSystem::Get().ParallelFor(PendingAnimationComponents.Num(), MinComponentsPerJob, [this](int32 Begin, int32 End)
+	{
+		for (int32 i = Begin; i < End; ++i)
+		{
+			PendingAnimationComponents[i]->EvaluateAnimation();
+		}
+	}, "AnimationPhase");
+
+	// 동기화 지점: Notify 핸들러는 액터/Lua 를 건드리므로 게임 스레드에서 등록 순서대로
+	// 핸들러가 새로 등록하는 컴포넌트는 다음 틱으로 넘긴다
+	TArray<USkeletalMeshComponent*> Components = std::move(PendingAnimationComponents);
+	PendingAnimationComponents.Empty();
+	for (USkeletalMeshComponent* Component : Components)
+	{
+		Component->DispatchAnimNotifies();
+	}
 }
 
 UWorld* UWorld::DuplicateWorldForPIE(UWorld* InEditorWorld)
@@ -5,6 +5,7 @@
 #include "Level.h"
 #include "Gizmo/GizmoActor.h"
 #include "LightManager.h"
+#include "TransformTable.h"
 
 // Forward Declarations
 class UResourceManager;
@@ -27,6 +28,8 @@ class BVHierachy;
 class UStaticMesh;
 class FOcclusionCullingManagerCPU;
 class APlayerCameraManager;
+class FOverlapBroadPhase;
+class USkeletalMeshComponent;
 
 struct FTransform;
 struct FSceneCompData;
@@ -96,6 +99,8 @@ public:
     ULevel* GetLevel() const { return Level.get(); }
     FLightManager* GetLightManager() const { return LightManager.get(); }
     FLuaManager* GetLuaManager() const { return LuaManager.get(); }
+    FTransformTable* GetTransformTable() const { return TransformTable.get(); }
+    FOverlapBroadPhase* GetOverlapBroadPhase() const { return OverlapBroadPhase.get(); }
 
     ACameraActor* GetEditorCameraActor() { return MainEditorCameraActor; }
     void SetEditorCameraActor(ACameraActor* InCamera);
@@ -118,6 +123,10 @@ public:
     // Overlap pair de-duplication (per-frame)
     bool TryMarkOverlapPair(const AActor* A, const AActor* B);
 
+    // 애니메이션 단계 등록 (USkeletalMeshComponent::TickAnimation 에서 호출)
+    // 액터 틱이 끝난 뒤 등록된 컴포넌트의 포즈/스키닝 행렬을 병렬로 계산하고 Notify 는 게임 스레드에서 트리거
+    void QueueAnimationEvaluation(USkeletalMeshComponent* Component);
+
     TMap<TWeakObjectPtr<AActor>, FActorTimeState> ActorTimingMap;
 
     /** === 필요한 엑터 게터 === */
@@ -140,6 +149,9 @@ public:
 private:
     bool DestroyActor(AActor* Actor);   // 즉시 삭제
 
+    // 애니메이션 단계: 포즈 추출/블렌딩/스키닝 행렬은 컴포넌트마다 잡으로, Notify 는 끝난 뒤 등록 순서대로
+    void TickAnimationPhase();
+
 private:
     /** === 에디터 특수 액터 관리 === */
     TArray<AActor*> EditorActors;
@@ -157,6 +169,15 @@ private:
 
     /** === 루아 매니저 ===*/
     std::unique_ptr<FLuaManager> LuaManager;
+
+    /** === 씬 컴포넌트 트랜스폼 테이블 ===*/
+    std::unique_ptr<FTransformTable> TransformTable;
+
+    /** === 셰이프 충돌 브로드 페이즈 ===*/
+    std::unique_ptr<FOverlapBroadPhase> OverlapBroadPhase;
+
+    /** === 이번 틱에 애니메이션을 평가할 스켈레탈 메시 컴포넌트 ===*/
+    TArray<USkeletalMeshComponent*> PendingAnimationComponents;
     
     // Object naming system
     TMap<FString, int32> ObjectTypeCounts;
@@ -9,6 +9,8 @@
 #include "StaticMeshComponent.h"
 #include "Frustum.h"
 #include "Gizmo/GizmoActor.h"
+#include "CollisionQuery.h"
+#include "JobSystem.h"
 
 IMPLEMENT_CLASS(UWorldPartitionManager)
 
@@ -182,6 +184,59 @@ void UWorldPartitionManager::RayQueryClosest(FRay InRay, OUT AActor*& OutActor,
 	}
 }
 
+bool UWorldPartitionManager::SweepQuery(const FCollisionQuery& Query, OUT FCollisionQueryResult& OutResult) const
+{
+	OutResult.Hits.clear();
+	if (BVH)
+	{
+		BVH->QuerySweep(Query, OutResult);
+	}
+	return OutResult.HasHit();
+}
+
+bool UWorldPartitionManager::RayQueryMulti(const FVector& Start, const FVector& End, OUT TArray<FQueryHit>& OutHits, const AActor* IgnoredActor) const
+{
+	FCollisionQuery Query;
+	Query.Start = Start;
+	Query.End = End;
+	Query.bMultiHit = true;
+	Query.IgnoredActor = IgnoredActor;
+
+	FCollisionQueryResult Result;
+	SweepQuery(Query, Result);
+	OutHits = std::move(Result.Hits);
+	return !OutHits.IsEmpty();
+}
+
+void UWorldPartitionManager::SweepQueryBatch(const TArray<FCollisionQuery>& Queries, OUT TArray<FCollisionQueryResult>& OutResults) const
+{
+	// 쿼리 수가 적으면 잡 분배 비용이 더 크다
+	constexpr int32 MinQueriesPerJob = 8;
+
+	OutResults.SetNum(Queries.Num());
+	if (!BVH)
+	{
+		for (FCollisionQueryResult& Result : OutResults)
+		{
+			Result.Hits.clear();
+		}
+		return;
+	}
+
+	// BVH 는 읽기만 하므로 쿼리마다 독립적으로 돌릴 수 있다
+	if (Queries.Num() > MinQueriesPerJob)
+	{
+		BVH->PrepareConcurrentQueries();
+	}
+	FJobSystem::Get().ParallelFor(Queries.Num(), MinQueriesPerJob, [&](int32 Begin, int32 End)
+	{
+		for (int32 i = Begin; i < End; ++i)
+		{
+			BVH->QuerySweep(Queries[i], OutResults[i]);
+		}
+	}, "SweepQueryBatch");
+}
+
 void UWorldPartitionManager::FrustumQuery(FFrustum InFrustum)
 {
 	if (BVH)
@@ -9,6 +9,8 @@
 #include "CameraActor.h"
 #include "CameraComponent.h"
 #include "PlayerCameraManager.h"
+#include "WorldPartitionManager.h"
+#include "CollisionQuery.h"
 #include <tuple>
 
 sol::object MakeCompProxy(sol::state_view SolState, void* Instance, UClass* Class) {
@@ -16,6 +18,11 @@ sol::object MakeCompProxy(sol::state_view SolState, void* Instance, UClass* Clas
     LuaObjectProxy Proxy;  // Using LuaObjectProxy (LuaComponentProxy is alias)
     Proxy.Instance = static_cast<UObject*>(Instance);  // Cast to UObject*
     Proxy.Class = Class;
+    if (Proxy.Instance)
+    {
+        Proxy.ObjectIndex = Proxy.Instance->InternalIndex;
+        Proxy.SerialNumber = ObjectFactory::GetObjectSerialNumber(Proxy.ObjectIndex);
+    }
     return sol::make_object(SolState, std::move(Proxy));
 }
 
@@ -341,6 +348,7 @@ FLuaManager::FLuaManager()
 
     RegisterComponentProxy(*Lua);
     ExposeGlobalFunctions();
+    ExposeCollisionQueries();
     ExposeAllComponentsToLua();
 
     // 위 등록 마친 뒤 fall back 설정 : Shared lib의 fall back은 G
@@ -583,6 +591,147 @@ void FLuaManager::ExposeGlobalFunctions()
     );
 }
 
+namespace
+{
+    // 히트 하나 -> { GameObject, Component, Location, ImpactPoint, Normal, Distance, bStartPenetrating }
+    sol::table MakeHitTable(sol::state_view SolState, const FQueryHit& Hit)
+    {
+        sol::table Table = SolState.create_table();
+        Table["GameObject"] = Hit.Actor ? Hit.Actor->GetGameObject() : nullptr;
+        Table["Component"] = Hit.Component ? MakeCompProxy(SolState, Hit.Component, Hit.Component->GetClass()) : sol::make_object(SolState, sol::nil);
+        Table["Location"] = Hit.Location;
+        Table["ImpactPoint"] = Hit.ImpactPoint;
+        Table["Normal"] = Hit.Normal;
+        Table["Distance"] = Hit.Distance;
+        Table["bStartPenetrating"] = Hit.bStartPenetrating;
+        return Table;
+    }
+
+    sol::table MakeHitArray(sol::state_view SolState, const TArray<FQueryHit>& Hits)
+    {
+        sol::table Table = SolState.create_table();
+        for (int32 i = 0; i < Hits.Num(); ++i)
+        {
+            Table[i + 1] = MakeHitTable(SolState, Hits[i]);
+        }
+        return Table;
+    }
+
+    const AActor* GetIgnoredActor(sol::optional<FGameObject&> Ignore)
+    {
+        return Ignore ? Ignore->GetOwner() : nullptr;
+    }
+
+    // 가장 가까운 히트 테이블, 없으면 nil
+    sol::object RunSingleQuery(sol::state_view SolState, const FCollisionQuery& Query)
+    {
+        UWorldPartitionManager* Partition = GWorld ? GWorld->GetPartitionManager() : nullptr;
+        FCollisionQueryResult Result;
+        if (!Partition || !Partition->SweepQuery(Query, Result))
+        {
+            return sol::make_object(SolState, sol::nil);
+        }
+        return MakeHitTable(SolState, Result.Hits[0]);
+    }
+
+    FCollisionQuery MakeQuery(const FVector& Start, const FVector& End, const FCollisionShape& Shape, bool bMultiHit, const AActor* IgnoredActor)
+    {
+        FCollisionQuery Query;
+        Query.Start = Start;
+        Query.End = End;
+        Query.Shape = Shape;
+        Query.bMultiHit = bMultiHit;
+        Query.IgnoredActor = IgnoredActor;
+        return Query;
+    }
+
+    // TraceBatch 항목: { Start, End, Shape = "Line"|"Sphere"|"Capsule"|"Box", Radius, HalfHeight, HalfExtent, Multi, Ignore }
+    FCollisionQuery ParseQueryTable(const sol::table& Table)
+    {
+        const FString ShapeName = Table.get_or<FString>("Shape", "Line");
+        FCollisionShape Shape;
+        if (ShapeName == "Sphere")
+        {
+            Shape = FCollisionShape::MakeSphere(Table.get_or("Radius", 0.0f));
+        }
+        else if (ShapeName == "Capsule")
+        {
+            Shape = FCollisionShape::MakeCapsule(Table.get_or("Radius", 0.0f), Table.get_or("HalfHeight", 0.0f));
+        }
+        else if (ShapeName == "Box")
+        {
+            Shape = FCollisionShape::MakeBox(Table.get_or("HalfExtent", FVector(0.0f, 0.0f, 0.0f)));
+        }
+
+        sol::optional<FGameObject&> Ignore = Table.get<sol::optional<FGameObject&>>("Ignore");
+        return MakeQuery(Table.get_or("Start", FVector(0.0f, 0.0f, 0.0f)), Table.get_or("End", FVector(0.0f, 0.0f, 0.0f)),
+            Shape, Table.get_or("Multi", false), GetIgnoredActor(Ignore));
+    }
+}
+
+void FLuaManager::ExposeCollisionQueries()
+{
+    // 가장 가까운 히트 (없으면 nil)
+    SharedLib.set_function("LineTrace",
+        [this](FVector Start, FVector End, sol::optional<FGameObject&> Ignore) -> sol::object
+        {
+            return RunSingleQuery(*Lua, MakeQuery(Start, End, FCollisionShape::MakeLine(), false, GetIgnoredActor(Ignore)));
+        });
+    SharedLib.set_function("SphereCast",
+        [this](FVector Start, FVector End, float Radius, sol::optional<FGameObject&> Ignore) -> sol::object
+        {
+            return RunSingleQuery(*Lua, MakeQuery(Start, End, FCollisionShape::MakeSphere(Radius), false, GetIgnoredActor(Ignore)));
+        });
+    SharedLib.set_function("CapsuleCast",
+        [this](FVector Start, FVector End, float Radius, float HalfHeight, sol::optional<FGameObject&> Ignore) -> sol::object
+        {
+            return RunSingleQuery(*Lua, MakeQuery(Start, End, FCollisionShape::MakeCapsule(Radius, HalfHeight), false, GetIgnoredActor(Ignore)));
+        });
+    SharedLib.set_function("BoxCast",
+        [this](FVector Start, FVector End, FVector HalfExtent, sol::optional<FGameObject&> Ignore) -> sol::object
+        {
+            return RunSingleQuery(*Lua, MakeQuery(Start, End, FCollisionShape::MakeBox(HalfExtent), false, GetIgnoredActor(Ignore)));
+        });
+
+    // 경로 위의 모든 히트 (거리순 배열)
+    SharedLib.set_function("LineTraceMulti",
+        [this](FVector Start, FVector End, sol::optional<FGameObject&> Ignore) -> sol::table
+        {
+            TArray<FQueryHit> Hits;
+            if (UWorldPartitionManager* Partition = GWorld ? GWorld->GetPartitionManager() : nullptr)
+            {
+                Partition->RayQueryMulti(Start, End, Hits, GetIgnoredActor(Ignore));
+            }
+            return MakeHitArray(*Lua, Hits);
+        });
+
+    // 여러 쿼리를 한 번에 (잡 시스템으로 병렬 처리). 결과[i] = 쿼리 i 의 히트 배열 (단일 쿼리는 0~1개)
+    SharedLib.set_function("TraceBatch",
+        [this](sol::table QueryTables) -> sol::table
+        {
+            TArray<FCollisionQuery> Queries;
+            Queries.Reserve(QueryTables.size());
+            for (size_t i = 1; i <= QueryTables.size(); ++i)
+            {
+                Queries.Add(ParseQueryTable(QueryTables.get<sol::table>(i)));
+            }
+
+            TArray<FCollisionQueryResult> Results;
+            if (UWorldPartitionManager* Partition = GWorld ? GWorld->GetPartitionManager() : nullptr)
+            {
+                Partition->SweepQueryBatch(Queries, Results);
+            }
+            Results.SetNum(Queries.Num());
+
+            sol::table Out = Lua->create_table();
+            for (int32 i = 0; i < Results.Num(); ++i)
+            {
+                Out[i + 1] = MakeHitArray(*Lua, Results[i].Hits);
+            }
+            return Out;
+        });
+}
+
 bool FLuaManager::LoadScriptInto(sol::environment& Env, const FString& Path) {
     auto Chunk = Lua->load_file(Path);
     if (!Chunk.valid()) { sol::error Err = Chunk; UE_LOG("[Lua][error] %s", Err.what()); return false; }
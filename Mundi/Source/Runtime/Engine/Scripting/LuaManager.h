@@ -17,6 +17,8 @@ public:
     void RegisterComponentProxy(sol::state& Lua);
     void ExposeAllComponentsToLua();
     void ExposeGlobalFunctions();
+    // LineTrace / SphereCast / ... / TraceBatch (월드 BVH 레이/스윕 쿼리)
+    void ExposeCollisionQueries();
 
     bool LoadScriptInto(sol::environment& Env, const FString& Path);
     
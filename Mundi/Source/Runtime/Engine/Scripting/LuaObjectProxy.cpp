@@ -6,7 +6,7 @@
 #include "LuaStructProxy.h"
 #include "ObjectFactory.h"  // For GUObjectArray
 
-TMap<UClass*, FBoundClassDesc> GBoundClasses;
+TFlatMap<UClass*, FBoundClassDesc> GBoundClasses;
 
 // External function from LuaManager.cpp
 extern sol::object MakeCompProxy(sol::state_view SolState, void* Instance, UClass* Class);
@@ -43,7 +43,7 @@ void BuildBoundClass(UClass* Class)
 
 bool LuaObjectProxy::IsValid() const
 {
-    return IsValidUObject(Instance);
+    return Instance && ObjectFactory::ResolveObjectHandle(ObjectIndex, SerialNumber) == Instance;
 }
 
 sol::object LuaObjectProxy::Index(sol::this_state LuaState, LuaObjectProxy& Self, const char* Key)
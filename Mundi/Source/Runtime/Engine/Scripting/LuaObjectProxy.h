@@ -4,6 +4,7 @@
 #include <sol/sol.hpp>
 
 #include "LuaBindingRegistry.h"
+#include "FlatHashMap.h"
 
 struct FBoundProp
 {
@@ -13,10 +14,10 @@ struct FBoundProp
 struct FBoundClassDesc   // Property list per class
 {
     UClass* Class = nullptr;
-    TMap<FString, FBoundProp> PropsByName;
+    TFlatMap<FString, FBoundProp> PropsByName;
 };
 
-extern TMap<UClass*, FBoundClassDesc> GBoundClasses;
+extern TFlatMap<UClass*, FBoundClassDesc> GBoundClasses;
 
 void BuildBoundClass(UClass* Class);
 
@@ -26,6 +27,9 @@ struct LuaObjectProxy
 {
     UObject* Instance = nullptr;  // Changed from void* for type safety
     UClass* Class = nullptr;
+    // GUObjectArray handle captured at creation; rejects proxies whose slot was reused
+    uint32 ObjectIndex = 0;
+    uint32 SerialNumber = 0;
 
     // Validate if the UObject instance is still valid
     bool IsValid() const;
@@ -11,6 +11,8 @@
 #include "OBB.h"
 #include "Frustum.h"
 #include "Picking.h" // FRay
+#include "VectorSoA.h"
+#include "CollisionQuery.h"
 
 #include "StaticMeshComponent.h"
 
@@ -45,6 +47,104 @@ namespace {
         outTMax = tmax;
         return true;
     }
+
+    // 마지막 전체 빌드 대비 SAH 비용이 이 배수를 넘으면 다시 빌드
+    constexpr float RebuildCostRatio = 1.3f;
+    // 한 프레임 변경이 이 수와 전체의 1/4 중 큰 값을 넘으면 부분 갱신 대신 바로 재빌드
+    constexpr int32 MinIncrementalBudget = 64;
+    // 회전으로 줄어드는 표면적이 이 비율 미만이면 무시 (왕복 회전 방지)
+    constexpr float MinRotationGain = 1e-3f;
+
+    inline float SurfaceArea(const FAABB& Box)
+    {
+        const FVector D = Box.Max - Box.Min;
+        if (D.X < 0.0f || D.Y < 0.0f || D.Z < 0.0f)
+        {
+            return 0.0f;
+        }
+        return 2.0f * (D.X * D.Y + D.Y * D.Z + D.Z * D.X);
+    }
+
+    inline bool IsSameBounds(const FAABB& A, const FAABB& B)
+    {
+        return A.Min.X == B.Min.X && A.Min.Y == B.Min.Y && A.Min.Z == B.Min.Z
+            && A.Max.X == B.Max.X && A.Max.Y == B.Max.Y && A.Max.Z == B.Max.Z;
+    }
+
+    // 보이는지 검사할 리프 프리미티브를 8개씩 모아 AreAABBsVisible_8_AVX 한 번으로 판정
+    // (리프 크기가 1 이어도 여러 리프에 걸쳐 모으므로 레인이 채워진다). 보이는 슬롯마다 OnVisible(Slot)
+    template<typename VisibleFunc>
+    struct TFrustumCullBatch
+    {
+        const FFrustum& Frustum;
+        VisibleFunc& OnVisible;
+        const bool bUseAVX;
+        FAABB Boxes[8];
+        int32 Slots[8];
+        int32 Num = 0;
+
+        TFrustumCullBatch(const FFrustum& InFrustum, VisibleFunc& InOnVisible)
+            : Frustum(InFrustum)
+            , OnVisible(InOnVisible)
+            , bUseAVX(FSoAMath::IsUsingSIMD())
+        {
+        }
+
+        void Add(const FAABB& Box, int32 Slot)
+        {
+            Boxes[Num] = Box;
+            Slots[Num] = Slot;
+            if (++Num == 8)
+            {
+                Flush();
+            }
+        }
+
+        void Flush()
+        {
+            if (Num == 0)
+            {
+                return;
+            }
+
+            uint32 VisibleMask = 0;
+            if (bUseAVX)
+            {
+                // 남는 레인은 첫 박스로 채우고 결과에서 잘라낸다
+                for (int32 i = Num; i < 8; ++i)
+                {
+                    Boxes[i] = Boxes[0];
+                }
+                VisibleMask = AreAABBsVisible_8_AVX(Frustum, Boxes) & ((1u << Num) - 1u);
+            }
+            else
+            {
+                for (int32 i = 0; i < Num; ++i)
+                {
+                    if (IsAABBVisible(Frustum, Boxes[i]))
+                    {
+                        VisibleMask |= 1u << i;
+                    }
+                }
+            }
+
+            for (int32 i = 0; i < Num; ++i)
+            {
+                if (VisibleMask & (1u << i))
+                {
+                    OnVisible(Slots[i]);
+                }
+            }
+            Num = 0;
+        }
+    };
+
+    // 순회 스택 항목. bInside 면 프러스텀에 완전히 포함된 서브트리라 더 검사하지 않는다
+    struct FCullStackEntry
+    {
+        int32 Idx;
+        bool bInside;
+    };
 }
 
 FBVHierarchy::FBVHierarchy(const FAABB& InBounds, int InDepth, int InMaxDepth, int InMaxObjects)
@@ -63,11 +163,21 @@ FBVHierarchy::~FBVHierarchy()
 void FBVHierarchy::Clear()
 {
     // NOTE: TMap, TArray를 clear로 비우면 capacity가 그대로이기 때문에 새 객체로 초기화
-    StaticMeshComponentBounds = TMap<UPrimitiveComponent*, FAABB>();
+    StaticMeshComponentBounds = TFlatMap<UPrimitiveComponent*, FAABB>();
     StaticMeshComponentArray = TArray<UPrimitiveComponent*>();
+    LeafBounds = TArray<FAABB>();
+    LeafOwners = TArray<AActor*>();
+    LeafFlags = TArray<uint8>();
     Nodes = TArray<FLBVHNode>();
+    FreeNodes = TArray<int32>();
+    ComponentLeaves = TFlatMap<UPrimitiveComponent*, int32>();
+    FreeSlots = TArray<int32>();
+    DirtyComponents = TFlatSet<UPrimitiveComponent*>();
     Bounds = FAABB();
+    BuildCost = 0.0f;
+    CurrentCost = 0.0f;
     bPendingRebuild = false;
+    bCostDirty = false;
 }
 
 void FBVHierarchy::BulkUpdate(const TArray<UPrimitiveComponent*>& Components)
@@ -84,6 +194,7 @@ void FBVHierarchy::BulkUpdate(const TArray<UPrimitiveComponent*>& Components)
     // 일반적인 update에서 budget 단위로 끊어 갱신되는 로직 우회해 강제 rebuild
     BuildLBVH();
     bPendingRebuild = false;
+    DirtyComponents.Empty();
 }
 
 void FBVHierarchy::Update(UPrimitiveComponent* InComponent)
@@ -99,10 +210,19 @@ void FBVHierarchy::Update(UPrimitiveComponent* InComponent)
         return;
     }
 
-    const FAABB WorldBounds = InComponent->GetWorldAABB();
+    UpdateBounds(InComponent, InComponent->GetWorldAABB());
+}
 
+void FBVHierarchy::UpdateBounds(UPrimitiveComponent* InComponent, const FAABB& WorldBounds)
+{
+    if (!InComponent)
+    {
+        return;
+    }
+
+    // 트리 반영은 FlushRebuild 에서 한 번에 (같은 프레임 여러 번 움직여도 refit 은 한 번)
     StaticMeshComponentBounds.Add(InComponent, WorldBounds);
-    bPendingRebuild = true;
+    DirtyComponents.Add(InComponent);
 }
 
 void FBVHierarchy::Remove(UPrimitiveComponent* InComponent)
@@ -115,11 +235,39 @@ void FBVHierarchy::Remove(UPrimitiveComponent* InComponent)
     if (StaticMeshComponentBounds.Find(InComponent))
     {
         StaticMeshComponentBounds.Remove(InComponent);
-        bPendingRebuild = true;
+        DirtyComponents.Remove(InComponent);
+        // 컴포넌트가 곧 삭제될 수 있으므로 트리에서는 즉시 떼어낸다
+        RemoveFromTree(InComponent);
     }
 }
 
 void FBVHierarchy::QueryFrustum(const FFrustum& InFrustum)
+{
+    ForEachSlotInFrustum(InFrustum, [this](int32 Slot)
+    {
+        LeafOwners[Slot]->SetCulled(false);
+    });
+}
+
+void FBVHierarchy::CullFrustum(const FFrustum& InFrustum, FVisibilityBitset& Out) const
+{
+    Out.Reset(StaticMeshComponentArray.Num());
+    Out.NumTested = ComponentLeaves.Num();
+    ForEachSlotInFrustum(InFrustum, [&Out](int32 Slot)
+    {
+        Out.SetVisible(Slot);
+        ++Out.NumVisible;
+    });
+}
+
+int32 FBVHierarchy::GetComponentSlot(UPrimitiveComponent* InComponent) const
+{
+    const int32* Leaf = ComponentLeaves.Find(InComponent);
+    return Leaf ? FindLeafSlot(Nodes[*Leaf], InComponent) : -1;
+}
+
+template<typename VisibleFunc>
+void FBVHierarchy::ForEachSlotInFrustum(const FFrustum& InFrustum, VisibleFunc OnVisible) const
 {
     if (Nodes.empty()) return;
     //프러스텀 외부에 바운드 존재
@@ -127,51 +275,63 @@ void FBVHierarchy::QueryFrustum(const FFrustum& InFrustum)
     //프러스텀 내부에 바운드 존재 (교차 X)
     if (!IsAABBIntersects(InFrustum, Nodes[0].Bounds))
     {
-        for (UPrimitiveComponent* Component : StaticMeshComponentArray)
+        const int32 NumSlots = LeafOwners.Num();
+        for (int32 i = 0; i < NumSlots; ++i)
         {
-            if (!Component) continue;
-            if (StaticMeshComponentBounds.find(Component) == StaticMeshComponentBounds.end())
-                continue;
-            if (AActor* Owner = Component->GetOwner())
+            if ((LeafFlags[i] & LeafFlag_Valid) && LeafOwners[i])
             {
-                Owner->SetCulled(false);
+                OnVisible(i);
             }
         }
         return;
     }
     //프러스텀과 바운드가 교차
-    TArray<int32> IdxStack;
-    IdxStack.push_back({ 0 });
+    TArray<FCullStackEntry> Stack;
+    Stack.Reserve(64);
+    Stack.push_back({ 0, false });
+    TFrustumCullBatch<VisibleFunc> Batch(InFrustum, OnVisible);
 
-    while (!IdxStack.empty())
+    while (!Stack.empty())
     {
-        int32 Idx = IdxStack.back();
-        IdxStack.pop_back();
-        const FLBVHNode& node = Nodes[Idx];
+        const FCullStackEntry Entry = Stack.back();
+        Stack.pop_back();
+        const FLBVHNode& node = Nodes[Entry.Idx];
         if (node.IsLeaf())
         {
-            for (int32 i = 0; i < node.Count; ++i)
+            const int32 End = node.First + node.Count;
+            for (int32 i = node.First; i < End; ++i)
             {
-                UPrimitiveComponent* Component = StaticMeshComponentArray[node.First + i];
-                if (!Component || StaticMeshComponentBounds.find(Component) == StaticMeshComponentBounds.end())
-                    continue;
-                const FAABB* Cached = StaticMeshComponentBounds.Find(Component);
-                const FAABB Box = Cached ? *Cached : Component->GetWorldAABB();
-                if (IsAABBVisible(InFrustum, Box))
+                if ((LeafFlags[i] & LeafFlag_Valid) && LeafOwners[i])
                 {
-                    if (AActor* Owner = Component->GetOwner())
+                    if (Entry.bInside)
+                    {
+                        OnVisible(i);
+                    }
+                    else
                     {
-                        Owner->SetCulled(false);
+                        Batch.Add(LeafBounds[i], i);
                     }
                 }
             }
             continue;
         }
-        if (node.Left >= 0 && IsAABBVisible(InFrustum, Nodes[node.Left].Bounds))
-            IdxStack.push_back({ node.Left });
-        if (node.Right >= 0 && IsAABBVisible(InFrustum, Nodes[node.Right].Bounds))
-            IdxStack.push_back({ node.Right });
+        for (const int32 Child : { node.Left, node.Right })
+        {
+            if (Child < 0)
+            {
+                continue;
+            }
+            if (Entry.bInside)
+            {
+                Stack.push_back({ Child, true });
+            }
+            else if (IsAABBVisible(InFrustum, Nodes[Child].Bounds))
+            {
+                Stack.push_back({ Child, !IsAABBIntersects(InFrustum, Nodes[Child].Bounds) });
+            }
+        }
     }
+    Batch.Flush();
 }
 
 void FBVHierarchy::DebugDraw(URenderer* Renderer) const
@@ -182,6 +342,10 @@ void FBVHierarchy::DebugDraw(URenderer* Renderer) const
     for (size_t i = 0; i < Nodes.size(); ++i)
     {
         const FLBVHNode& N = Nodes[i];
+        if (N.IsFree())
+        {
+            continue;
+        }
         const FVector Min = N.Bounds.Min;
         const FVector Max = N.Bounds.Max;
         const FVector4 LineColor(1.0f, N.IsLeaf() ? 0.2f : 0.8f, 0.0f, 1.0f);
@@ -220,12 +384,12 @@ void FBVHierarchy::DebugDraw(URenderer* Renderer) const
 
 int FBVHierarchy::TotalNodeCount() const
 {
-    return static_cast<int>(Nodes.size());
+    return static_cast<int>(Nodes.size()) - FreeNodes.Num();
 }
 
 int FBVHierarchy::TotalActorCount() const
 {
-    return static_cast<int>(StaticMeshComponentArray.size());
+    return ComponentLeaves.Num();
 }
 
 int FBVHierarchy::MaxOccupiedDepth() const
@@ -273,11 +437,20 @@ void FBVHierarchy::BuildLBVH()
 {
     StaticMeshComponentArray = StaticMeshComponentBounds.GetKeys();
     const int N = StaticMeshComponentArray.Num();
+    LeafBounds.Empty();
+    LeafOwners.Empty();
+    LeafFlags.Empty();
     Nodes = TArray<FLBVHNode>();
+    FreeNodes.Empty();
+    FreeSlots.Empty();
+    ComponentLeaves.Empty();
+    ++NumFullRebuilds;
 
     if (N == 0)
     {
         Bounds = FAABB();
+        BuildCost = CurrentCost = 0.0f;
+        bCostDirty = false;
         return;
     }
 
@@ -351,9 +524,38 @@ void FBVHierarchy::BuildLBVH()
         StaticMeshComponentArray[i] = ComponentCodePairs[i].first;
     }
 
+    // 리프 데이터를 LBVH 순서로 채운다 (BuildRange 가 이 배열로 리프 바운드를 계산)
+    LeafBounds.SetNum(N);
+    LeafOwners.SetNum(N);
+    LeafFlags.SetNum(N);
+    for (int i = 0; i < N; ++i)
+    {
+        UPrimitiveComponent* Component = StaticMeshComponentArray[i];
+        const FAABB* Bound = StaticMeshComponentBounds.Find(Component);
+        WriteLeafSlot(i, Component, Bound ? *Bound : Component->GetWorldAABB());
+    }
+
     Nodes.reserve(std::max(1, 2 * N));
     Nodes.clear();
     BuildRange(0, N);
+
+    // 부분 갱신용 역참조
+    ComponentLeaves.reserve(N);
+    for (int32 i = 0; i < Nodes.Num(); ++i)
+    {
+        const FLBVHNode& Node = Nodes[i];
+        if (!Node.IsLeaf())
+        {
+            continue;
+        }
+        for (int32 j = Node.First; j < Node.First + Node.Count; ++j)
+        {
+            ComponentLeaves.Add(StaticMeshComponentArray[j], i);
+        }
+    }
+
+    BuildCost = CurrentCost = ComputeSAHCost();
+    bCostDirty = false;
 }
 
 int FBVHierarchy::BuildRange(int s, int e)
@@ -371,14 +573,12 @@ int FBVHierarchy::BuildRange(int s, int e)
         FAABB Accumulated;
         for (int i = s; i < e; ++i)
         {
-            UPrimitiveComponent* Component = StaticMeshComponentArray[i];
-            if (!Component)
+            if (!(LeafFlags[i] & LeafFlag_Valid))
             {
                 continue;
             }
 
-            const FAABB* Bound = StaticMeshComponentBounds.Find(Component);
-            const FAABB LocalBound = Bound ? *Bound : Component->GetWorldAABB();
+            const FAABB& LocalBound = LeafBounds[i];
             if (!bInitialized)
             {
                 Accumulated = LocalBound;
@@ -398,6 +598,8 @@ int FBVHierarchy::BuildRange(int s, int e)
     int R = BuildRange(mid, e);
     node.Left = L; node.Right = R; node.First = -1; node.Count = 0;
     node.Bounds = FAABB::Union(Nodes[L].Bounds, Nodes[R].Bounds);
+    Nodes[L].Parent = nodeIdx;
+    Nodes[R].Parent = nodeIdx;
     return nodeIdx;
 }
 
@@ -438,16 +640,15 @@ void FBVHierarchy::QueryRayClosest(const FRay& Ray, AActor*& OutActor, OUT float
         const FLBVHNode& node = Nodes[entry.Idx];
         if (node.IsLeaf())
         {
-            for (int i = 0; i < node.Count; ++i)
+            const int End = node.First + node.Count;
+            for (int i = node.First; i < End; ++i)
             {
-                UPrimitiveComponent* Component = StaticMeshComponentArray[node.First + i];
-                if (!Component) continue;
-                AActor* Owner = Component->GetOwner();
+                if (!(LeafFlags[i] & LeafFlag_Valid)) continue;
+                AActor* Owner = LeafOwners[i];
                 if (!Owner) continue;
                 if (Owner->GetActorHiddenInEditor()) continue;
 
-                const FAABB* Cached = StaticMeshComponentBounds.Find(Component);
-                const FAABB Box = Cached ? *Cached : Component->GetWorldAABB();
+                const FAABB& Box = LeafBounds[i];
 
                 float tmin, tmax;
                 if (!RayAABB_IntersectT(Ray, Box, tmin, tmax))
@@ -494,25 +695,537 @@ void FBVHierarchy::QueryRayClosest(const FRay& Ray, AActor*& OutActor, OUT float
     }
 }
 
+void FBVHierarchy::QuerySweep(const FCollisionQuery& Query, FCollisionQueryResult& OutResult) const
+{
+    OutResult.Hits.clear();
+    if (Nodes.empty()) return;
+
+    const FVector Delta = Query.End - Query.Start;
+    const float Length = Delta.Size();
+    const FVector Extent = Query.Shape.GetExtent();
+    const bool bHasLength = Length > KINDA_SMALL_NUMBER;
+    const FVector Direction = bHasLength ? Delta / Length : FVector(0, 0, 0);
+
+    // 단일 히트는 지금까지 가장 가까운 시점보다 먼 노드를 건너뛴다
+    float BestTime = FLT_MAX;
+
+    TArray<int32> Stack;
+    Stack.Reserve(64);
+    Stack.push_back(0);
+    while (!Stack.empty())
+    {
+        const FLBVHNode& Node = Nodes[Stack.back()];
+        Stack.pop_back();
+
+        float EnterTime;
+        if (!CollisionQuery::IntersectSegmentAABB(Query.Start, Delta, Node.Bounds, Extent, EnterTime))
+            continue;
+        if (!Query.bMultiHit && EnterTime > BestTime)
+            continue;
+
+        if (!Node.IsLeaf())
+        {
+            if (Node.Left >= 0) Stack.push_back(Node.Left);
+            if (Node.Right >= 0) Stack.push_back(Node.Right);
+            continue;
+        }
+
+        const int32 End = Node.First + Node.Count;
+        for (int32 i = Node.First; i < End; ++i)
+        {
+            if (!(LeafFlags[i] & LeafFlag_Valid)) continue;
+            AActor* Owner = LeafOwners[i];
+            if (!Owner || Owner == Query.IgnoredActor) continue;
+            if (Owner->IsPendingDestroy() || Owner->GetActorHiddenInGame()) continue;
+
+            UPrimitiveComponent* Component = StaticMeshComponentArray[i];
+            if (Query.bBlockingOnly && !Component->GetBlockComponent()) continue;
+
+            FQueryHit Hit;
+            float Time;
+            if (!CollisionQuery::SweepAABB(Query.Start, Delta, Query.Shape, LeafBounds[i], Time, Hit.Normal, Hit.ImpactPoint, Hit.bStartPenetrating))
+                continue;
+            if (!Query.bMultiHit && Time > BestTime)
+                continue;
+
+            // 스태틱 메시: 바운드만 맞고 메시는 비껴간 경우를 걸러 내고 실제 접촉 시점으로 바꾼다
+            // (레이는 삼각형 레이캐스트, 스윕은 시작 위치와 관계없이 구-삼각형 스윕)
+            if (const UStaticMeshComponent* StaticMeshComponent = Cast<UStaticMeshComponent>(Component))
+            {
+                if (Query.Shape.IsLine())
+                {
+                    if (bHasLength)
+                    {
+                        float HitDistance;
+                        if (!CollisionQuery::RaycastStaticMesh(StaticMeshComponent, Query.Start, Direction, Length, HitDistance, Hit.Normal))
+                            continue;
+                        Time = HitDistance / Length;
+                        Hit.ImpactPoint = Query.Start + Direction * HitDistance;
+                        Hit.bStartPenetrating = false;
+                    }
+                }
+                else if (!CollisionQuery::SweepStaticMesh(StaticMeshComponent, Query.Start, Delta, Query.Shape, Time, Hit.Normal, Hit.ImpactPoint, Hit.bStartPenetrating))
+                {
+                    continue;
+                }
+                if (!Query.bMultiHit && Time > BestTime)
+                    continue;
+            }
+
+            Hit.Actor = Owner;
+            Hit.Component = Component;
+            Hit.Distance = Time * Length;
+            Hit.Location = Query.Start + Delta * Time;
+
+            if (Query.bMultiHit)
+            {
+                OutResult.Hits.Add(Hit);
+            }
+            else if (Time < BestTime)
+            {
+                BestTime = Time;
+                OutResult.Hits.clear();
+                OutResult.Hits.Add(Hit);
+            }
+        }
+    }
+
+    if (Query.bMultiHit)
+    {
+        std::sort(OutResult.Hits.begin(), OutResult.Hits.end());
+    }
+}
+
+void FBVHierarchy::PrepareConcurrentQueries() const
+{
+    const int32 NumSlots = StaticMeshComponentArray.Num();
+    for (int32 i = 0; i < NumSlots; ++i)
+    {
+        if ((LeafFlags[i] & LeafFlag_Valid) && StaticMeshComponentArray[i])
+        {
+            StaticMeshComponentArray[i]->GetWorldMatrix();
+        }
+    }
+}
+
 void FBVHierarchy::FlushRebuild()
 {
-    if (bPendingRebuild)
+    if (!bPendingRebuild && DirtyComponents.IsEmpty() && !bCostDirty)
+    {
+        return;
+    }
+
+    // 많이 바뀌었으면 부분 갱신을 여러 번 하는 것보다 한 번 다시 만드는 편이 싸다
+    const int32 IncrementalBudget = std::max(MinIncrementalBudget, StaticMeshComponentBounds.Num() / 4);
+    if (bPendingRebuild || Nodes.empty() || DirtyComponents.Num() > IncrementalBudget)
     {
         BuildLBVH();
         bPendingRebuild = false;
+        DirtyComponents.Empty();
+        return;
+    }
+
+    for (UPrimitiveComponent* Component : DirtyComponents)
+    {
+        const FAABB* Bound = StaticMeshComponentBounds.Find(Component);
+        if (!Bound)
+        {
+            continue;
+        }
+        if (const int32* Leaf = ComponentLeaves.Find(Component))
+        {
+            WriteLeafSlot(FindLeafSlot(Nodes[*Leaf], Component), Component, *Bound);
+            RefitUpward(*Leaf);
+        }
+        else
+        {
+            InsertLeaf(Component, *Bound);
+        }
+    }
+    DirtyComponents.Empty();
+
+    if (Nodes.empty())
+    {
+        Bounds = FAABB();
+        CurrentCost = 0.0f;
+        bCostDirty = false;
+        return;
+    }
+
+    Bounds = Nodes[0].Bounds;
+    CurrentCost = ComputeSAHCost();
+    bCostDirty = false;
+
+    // 회전만으로 회복되지 않을 만큼 품질이 떨어졌거나 빈 노드가 쌓였으면 다시 빌드
+    if (CurrentCost > BuildCost * RebuildCostRatio || FreeNodes.Num() > Nodes.Num() / 2)
+    {
+        BuildLBVH();
+    }
+}
+
+int32 FBVHierarchy::AllocateNode()
+{
+    if (!FreeNodes.IsEmpty())
+    {
+        const int32 Idx = FreeNodes.Pop();
+        Nodes[Idx] = FLBVHNode{};
+        return Idx;
+    }
+    return Nodes.Add(FLBVHNode{});
+}
+
+void FBVHierarchy::FreeNode(int32 Idx)
+{
+    Nodes[Idx] = FLBVHNode{};
+    Nodes[Idx].Count = -1;
+    FreeNodes.Add(Idx);
+}
+
+void FBVHierarchy::MoveNode(int32 From, int32 To)
+{
+    Nodes[To] = Nodes[From];
+    const FLBVHNode& Node = Nodes[To];
+    if (Node.IsLeaf())
+    {
+        for (int32 i = Node.First; i < Node.First + Node.Count; ++i)
+        {
+            if (UPrimitiveComponent* Component = StaticMeshComponentArray[i])
+            {
+                ComponentLeaves.Add(Component, To);
+            }
+        }
+    }
+    else
+    {
+        Nodes[Node.Left].Parent = To;
+        Nodes[Node.Right].Parent = To;
+    }
+}
+
+void FBVHierarchy::ReplaceChild(int32 ParentIdx, int32 OldChild, int32 NewChild)
+{
+    FLBVHNode& Parent = Nodes[ParentIdx];
+    if (Parent.Left == OldChild)
+    {
+        Parent.Left = NewChild;
+    }
+    else
+    {
+        Parent.Right = NewChild;
+    }
+    Nodes[NewChild].Parent = ParentIdx;
+}
+
+bool FBVHierarchy::ComputeLeafBounds(const FLBVHNode& Leaf, FAABB& OutBounds) const
+{
+    bool bInitialized = false;
+    for (int32 i = Leaf.First; i < Leaf.First + Leaf.Count; ++i)
+    {
+        if (!(LeafFlags[i] & LeafFlag_Valid))
+        {
+            continue;
+        }
+        OutBounds = bInitialized ? FAABB::Union(OutBounds, LeafBounds[i]) : LeafBounds[i];
+        bInitialized = true;
+    }
+    return bInitialized;
+}
+
+int32 FBVHierarchy::FindLeafSlot(const FLBVHNode& Leaf, UPrimitiveComponent* Component) const
+{
+    for (int32 i = Leaf.First; i < Leaf.First + Leaf.Count; ++i)
+    {
+        if (StaticMeshComponentArray[i] == Component)
+        {
+            return i;
+        }
+    }
+    return -1;
+}
+
+void FBVHierarchy::WriteLeafSlot(int32 Slot, UPrimitiveComponent* Component, const FAABB& Bound)
+{
+    StaticMeshComponentArray[Slot] = Component;
+    LeafBounds[Slot] = Bound;
+    LeafOwners[Slot] = Component->GetOwner();
+    LeafFlags[Slot] = LeafFlag_Valid;
+}
+
+void FBVHierarchy::ClearLeafSlot(int32 Slot)
+{
+    StaticMeshComponentArray[Slot] = nullptr;
+    LeafOwners[Slot] = nullptr;
+    LeafFlags[Slot] = 0;
+}
+
+void FBVHierarchy::RefitUpward(int32 NodeIdx)
+{
+    bCostDirty = true;
+    for (int32 Idx = NodeIdx; Idx >= 0; Idx = Nodes[Idx].Parent)
+    {
+        FAABB NewBounds;
+        if (Nodes[Idx].IsLeaf())
+        {
+            if (!ComputeLeafBounds(Nodes[Idx], NewBounds))
+            {
+                return;
+            }
+        }
+        else
+        {
+            // 자식 바운드가 최신이므로 여기서 구조를 고칠 수 있다. 회전해도 이 노드의 바운드는 그대로다
+            TryRotate(Idx);
+            NewBounds = FAABB::Union(Nodes[Nodes[Idx].Left].Bounds, Nodes[Nodes[Idx].Right].Bounds);
+        }
+
+        // 바운드가 그대로면 조상도 그대로다
+        if (IsSameBounds(NewBounds, Nodes[Idx].Bounds))
+        {
+            return;
+        }
+        Nodes[Idx].Bounds = NewBounds;
+    }
+}
+
+bool FBVHierarchy::TryRotate(int32 NodeIdx)
+{
+    // Kopta et al. 2012: 자식 하나를 반대편 자식의 자식(손자)과 바꿔 그 자식의 표면적이 줄면 교환
+    const int32 A = Nodes[NodeIdx].Left;
+    const int32 B = Nodes[NodeIdx].Right;
+
+    float BestGain = 0.0f;
+    int32 BestChild = -1;       // NodeIdx 에서 내려보낼 자식
+    int32 BestOther = -1;       // 손자를 가진 반대편 자식
+    int32 BestGrandChild = -1;  // 끌어올릴 손자
+
+    auto Consider = [&](int32 Child, int32 Other)
+    {
+        const FLBVHNode& OtherNode = Nodes[Other];
+        if (OtherNode.IsLeaf())
+        {
+            return;
+        }
+        const float OtherArea = SurfaceArea(OtherNode.Bounds);
+        const float MinGain = OtherArea * MinRotationGain;
+        const FAABB& ChildBounds = Nodes[Child].Bounds;
+
+        // Child <-> Other.Left: Other 는 (Child, Other.Right) 를 감싸게 된다
+        const float GainL = OtherArea - SurfaceArea(FAABB::Union(ChildBounds, Nodes[OtherNode.Right].Bounds));
+        if (GainL > MinGain && GainL > BestGain)
+        {
+            BestGain = GainL; BestChild = Child; BestOther = Other; BestGrandChild = OtherNode.Left;
+        }
+        const float GainR = OtherArea - SurfaceArea(FAABB::Union(ChildBounds, Nodes[OtherNode.Left].Bounds));
+        if (GainR > MinGain && GainR > BestGain)
+        {
+            BestGain = GainR; BestChild = Child; BestOther = Other; BestGrandChild = OtherNode.Right;
+        }
+    };
+    Consider(A, B);
+    Consider(B, A);
+
+    if (BestChild < 0)
+    {
+        return false;
+    }
+
+    ReplaceChild(NodeIdx, BestChild, BestGrandChild);
+    ReplaceChild(BestOther, BestGrandChild, BestChild);
+    FLBVHNode& Other = Nodes[BestOther];
+    Other.Bounds = FAABB::Union(Nodes[Other.Left].Bounds, Nodes[Other.Right].Bounds);
+    ++NumRotations;
+    return true;
+}
+
+void FBVHierarchy::InsertLeaf(UPrimitiveComponent* Component, const FAABB& Bound)
+{
+    int32 Slot;
+    if (!FreeSlots.IsEmpty())
+    {
+        Slot = FreeSlots.Pop();
+    }
+    else
+    {
+        Slot = StaticMeshComponentArray.Add(nullptr);
+        LeafBounds.Add(FAABB());
+        LeafOwners.Add(nullptr);
+        LeafFlags.Add(0);
+    }
+    WriteLeafSlot(Slot, Component, Bound);
+
+    const int32 Leaf = AllocateNode();
+    Nodes[Leaf].Bounds = Bound;
+    Nodes[Leaf].First = Slot;
+    Nodes[Leaf].Count = 1;
+    ComponentLeaves.Add(Component, Leaf);
+
+    // 형제 찾기 (Box2D 방식): 여기서 새 부모를 만드는 비용과 자식으로 내려가는 비용을 비교
+    int32 Sibling = 0;
+    while (!Nodes[Sibling].IsLeaf())
+    {
+        const FLBVHNode& Node = Nodes[Sibling];
+        const float CombinedArea = SurfaceArea(FAABB::Union(Node.Bounds, Bound));
+        const float CreateCost = 2.0f * CombinedArea;
+        const float InheritCost = 2.0f * (CombinedArea - SurfaceArea(Node.Bounds));
+
+        auto DescendCost = [&](int32 Child)
+        {
+            const FLBVHNode& ChildNode = Nodes[Child];
+            const float Enlarged = SurfaceArea(FAABB::Union(ChildNode.Bounds, Bound));
+            return (ChildNode.IsLeaf() ? Enlarged : Enlarged - SurfaceArea(ChildNode.Bounds)) + InheritCost;
+        };
+        const float CostLeft = DescendCost(Node.Left);
+        const float CostRight = DescendCost(Node.Right);
+
+        if (CreateCost < CostLeft && CreateCost < CostRight)
+        {
+            break;
+        }
+        Sibling = (CostLeft < CostRight) ? Node.Left : Node.Right;
+    }
+
+    const int32 OldParent = Nodes[Sibling].Parent;
+    if (Sibling == 0)
+    {
+        // 루트 자리는 0 번으로 고정: 기존 루트를 옮기고 0 번에 새 부모를 만든다
+        const int32 Moved = AllocateNode();
+        MoveNode(0, Moved);
+        FLBVHNode& Root = Nodes[0];
+        Root = FLBVHNode{};
+        Root.Left = Moved;
+        Root.Right = Leaf;
+        Root.Bounds = FAABB::Union(Nodes[Moved].Bounds, Bound);
+        Nodes[Moved].Parent = 0;
+        Nodes[Leaf].Parent = 0;
+        bCostDirty = true;
+        return;
+    }
+
+    const int32 NewParent = AllocateNode();
+    Nodes[NewParent].Left = Sibling;
+    Nodes[NewParent].Right = Leaf;
+    Nodes[NewParent].Bounds = FAABB::Union(Nodes[Sibling].Bounds, Bound);
+    ReplaceChild(OldParent, Sibling, NewParent);
+    Nodes[Sibling].Parent = NewParent;
+    Nodes[Leaf].Parent = NewParent;
+    RefitUpward(OldParent);
+}
+
+void FBVHierarchy::RemoveFromTree(UPrimitiveComponent* Component)
+{
+    const int32* Found = ComponentLeaves.Find(Component);
+    if (!Found)
+    {
+        return;
+    }
+    const int32 Leaf = *Found;
+    ComponentLeaves.Remove(Component);
+
+    const FLBVHNode& Node = Nodes[Leaf];
+    bool bHasOther = false;
+    for (int32 i = Node.First; i < Node.First + Node.Count; ++i)
+    {
+        if (StaticMeshComponentArray[i] == Component)
+        {
+            ClearLeafSlot(i);
+        }
+        else if (StaticMeshComponentArray[i])
+        {
+            bHasOther = true;
+        }
+    }
+
+    if (bHasOther)
+    {
+        RefitUpward(Leaf);
+    }
+    else
+    {
+        RemoveLeaf(Leaf);
+    }
+}
+
+void FBVHierarchy::RemoveLeaf(int32 LeafIdx)
+{
+    bCostDirty = true;
+    {
+        const FLBVHNode& Leaf = Nodes[LeafIdx];
+        for (int32 i = Leaf.First; i < Leaf.First + Leaf.Count; ++i)
+        {
+            ClearLeafSlot(i);
+            FreeSlots.Add(i);
+        }
+    }
+
+    const int32 Parent = Nodes[LeafIdx].Parent;
+    if (Parent < 0)
+    {
+        // 마지막 리프
+        Nodes.Empty();
+        FreeNodes.Empty();
+        FreeSlots.Empty();
+        StaticMeshComponentArray.Empty();
+        LeafBounds.Empty();
+        LeafOwners.Empty();
+        LeafFlags.Empty();
+        Bounds = FAABB();
+        return;
+    }
+
+    const int32 Sibling = (Nodes[Parent].Left == LeafIdx) ? Nodes[Parent].Right : Nodes[Parent].Left;
+    const int32 GrandParent = Nodes[Parent].Parent;
+    FreeNode(LeafIdx);
+
+    if (GrandParent < 0)
+    {
+        // 부모가 루트: 형제를 0 번으로 끌어올린다
+        MoveNode(Sibling, 0);
+        Nodes[0].Parent = -1;
+        FreeNode(Sibling);
+        return;
+    }
+
+    ReplaceChild(GrandParent, Parent, Sibling);
+    FreeNode(Parent);
+    RefitUpward(GrandParent);
+}
+
+float FBVHierarchy::ComputeSAHCost() const
+{
+    if (Nodes.empty())
+    {
+        return 0.0f;
+    }
+    const float RootArea = SurfaceArea(Nodes[0].Bounds);
+    if (RootArea <= 0.0f)
+    {
+        return 0.0f;
+    }
+
+    double Sum = 0.0;
+    for (const FLBVHNode& Node : Nodes)
+    {
+        if (Node.IsFree())
+        {
+            continue;
+        }
+        Sum += static_cast<double>(SurfaceArea(Node.Bounds)) * (Node.IsLeaf() ? Node.Count : 1);
     }
+    return static_cast<float>(Sum / RootArea);
 }
 
 template<typename BoundType, typename NodeIntersectFunc, typename ComponentIntersectFunc>
-TArray<UPrimitiveComponent*> FBVHierarchy::QueryIntersectedComponentsGeneric(
+TFrameArray<UPrimitiveComponent*> FBVHierarchy::QueryIntersectedComponentsGeneric(
     const BoundType& InBound,
     NodeIntersectFunc NodeIntersects,
     ComponentIntersectFunc ComponentIntersects) const
 {
-    TSet<UPrimitiveComponent*> IntersectedComponents;
+    // StaticMeshComponentArray는 맵 키로 만들어지므로 리프 간 중복이 없다 -> TSet 중복 제거 불필요
+    TFrameArray<UPrimitiveComponent*> IntersectedComponents;
     if (Nodes.empty())
-        return TArray<UPrimitiveComponent*>();
-    TArray<int32> IdxStack;
+        return IntersectedComponents;
+    TFrameArray<int32> IdxStack;
+    IdxStack.Reserve(64);
     IdxStack.push_back({ 0 });
 
     while (!IdxStack.empty())
@@ -524,16 +1237,14 @@ TArray<UPrimitiveComponent*> FBVHierarchy::QueryIntersectedComponentsGeneric(
         {
             if (Node.IsLeaf())
             {
-                for (int32 i = 0; i < Node.Count; ++i)
+                const int32 End = Node.First + Node.Count;
+                for (int32 i = Node.First; i < End; ++i)
                 {
-                    UPrimitiveComponent* Component = StaticMeshComponentArray[Node.First + i];
-                    if (!Component || StaticMeshComponentBounds.find(Component) == StaticMeshComponentBounds.end())
+                    if (!(LeafFlags[i] & LeafFlag_Valid))
                         continue;
-                    const FAABB* Cached = StaticMeshComponentBounds.Find(Component);
-                    const FAABB Box = Cached ? *Cached : Component->GetWorldAABB();
-                    if (ComponentIntersects(Box, InBound))
+                    if (ComponentIntersects(LeafBounds[i], InBound))
                     {
-                        IntersectedComponents.insert(Component);
+                        IntersectedComponents.Add(StaticMeshComponentArray[i]);
                     }
                 }
             }
@@ -544,11 +1255,11 @@ TArray<UPrimitiveComponent*> FBVHierarchy::QueryIntersectedComponentsGeneric(
             }
         }
     }
-    return IntersectedComponents.Array();
+    return IntersectedComponents;
 }
 
 // FAABB 오버로드
-TArray<UPrimitiveComponent*> FBVHierarchy::QueryIntersectedComponents(const FAABB& InBound) const
+TFrameArray<UPrimitiveComponent*> FBVHierarchy::QueryIntersectedComponents(const FAABB& InBound) const
 {
     return QueryIntersectedComponentsGeneric(
         InBound,
@@ -558,7 +1269,7 @@ TArray<UPrimitiveComponent*> FBVHierarchy::QueryIntersectedComponents(const FAAB
 }
 
 // FOBB 오버로드
-TArray<UPrimitiveComponent*> FBVHierarchy::QueryIntersectedComponents(const FOBB& InBound) const
+TFrameArray<UPrimitiveComponent*> FBVHierarchy::QueryIntersectedComponents(const FOBB& InBound) const
 {
     return QueryIntersectedComponentsGeneric(
         InBound,
@@ -568,7 +1279,7 @@ TArray<UPrimitiveComponent*> FBVHierarchy::QueryIntersectedComponents(const FOBB
 }
 
 // FBoundingSphere 오버로드
-TArray<UPrimitiveComponent*> FBVHierarchy::QueryIntersectedComponents(const FBoundingSphere& InBound) const
+TFrameArray<UPrimitiveComponent*> FBVHierarchy::QueryIntersectedComponents(const FBoundingSphere& InBound) const
 {
     return QueryIntersectedComponentsGeneric(
         InBound,
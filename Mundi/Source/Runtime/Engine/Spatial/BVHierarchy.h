@@ -1,4 +1,6 @@
 ﻿#pragma once
+#include "FrameArena.h"
+#include "FlatHashMap.h"
 
 struct FFrustum;
 struct FRay; // forward declaration for ray type
@@ -6,9 +8,49 @@ class UPrimitiveComponent;
 class AActor;
 struct FOBB;
 struct FBoundingSphere;
+struct FCollisionQuery;
+struct FCollisionQueryResult;
+
+/**
+ * 뷰 하나의 가시성 결과. 비트 인덱스는 FBVHierarchy 리프 슬롯 (GetComponentSlot).
+ * 뷰마다 따로 두므로 여러 뷰(메인/그림자)를 동시에 컬링해도 서로 덮어쓰지 않는다.
+ */
+struct FVisibilityBitset
+{
+    TArray<uint64> Words;
+    int32 NumVisible = 0;
+    int32 NumTested = 0;
+
+    void Reset(int32 NumBits)
+    {
+        Words.assign((NumBits + 63) / 64, 0ull);
+        NumVisible = 0;
+        NumTested = 0;
+    }
+    void SetVisible(int32 Slot)
+    {
+        Words[Slot >> 6] |= 1ull << (Slot & 63);
+    }
+    bool IsVisible(int32 Slot) const
+    {
+        return (Slot >> 6) < Words.Num() && (Words[Slot >> 6] & (1ull << (Slot & 63))) != 0;
+    }
+    int32 GetNumCulled() const { return NumTested - NumVisible; }
+};
 
 /**
  * @brief Broad phase BVH based on UPrimitiveComponent
+ *
+ * 갱신 방식:
+ * - 이미 트리에 있는 컴포넌트가 움직이면 해당 리프부터 루트까지 AABB 만 다시 맞춘다(refit).
+ *   올라가면서 자식/손자 교환(tree rotation)으로 표면적이 줄어드는 경우 구조를 고친다.
+ * - 새 컴포넌트는 표면적 증가가 가장 적은 위치에 리프로 끼워 넣고, 제거는 리프를 떼어낸다.
+ * - SAH 비용이 마지막 전체 빌드 대비 RebuildCostRatio 배를 넘거나, 한 번에 바뀐 양이 많으면 LBVH 를 다시 만든다.
+ *
+ * 리프 데이터:
+ * - 프리미티브의 바운드/소유 액터/플래그를 슬롯(LBVH 순서) 별 연속 배열에 둔다.
+ *   쿼리는 리프 구간을 선형으로 읽고 해시 조회나 컴포넌트 역참조를 하지 않는다.
+ * - 리프 바운드는 FlushRebuild 시점의 값이다 (트리 노드 바운드와 항상 일치).
  */
 class FBVHierarchy
 {
@@ -28,15 +70,30 @@ public:
 
     void BulkUpdate(const TArray<UPrimitiveComponent*>& Components);
     void Update(UPrimitiveComponent* InComponent);
+    // 소유 액터 검사 없이 주어진 월드 바운드로 갱신 (Update 가 검사 후 호출)
+    void UpdateBounds(UPrimitiveComponent* InComponent, const FAABB& WorldBounds);
     void Remove(UPrimitiveComponent* InComponent);
 
+    // 쌓인 변경을 반영. 가능하면 부분 갱신, 품질이 떨어졌으면 전체 재빌드
     void FlushRebuild();
+    // 다음 FlushRebuild 에서 무조건 전체 재빌드
+    void RequestFullRebuild() { bPendingRebuild = true; }
 
     void QueryRayClosest(const FRay& Ray, AActor*& OutActor, OUT float& OutBestT) const;
+    // 레이/스윕 쿼리 (단일/다중 히트). 트리를 읽기만 하므로 여러 스레드에서 동시에 호출 가능
+    void QuerySweep(const FCollisionQuery& Query, FCollisionQueryResult& OutResult) const;
+    // 여러 스레드에서 QuerySweep 하기 전에 호출. 쿼리 중 지연 계산되는 컴포넌트 월드 행렬 캐시를 미리 채운다
+    void PrepareConcurrentQueries() const;
     void QueryFrustum(const FFrustum& InFrustum);
-    TArray<UPrimitiveComponent*> QueryIntersectedComponents(const FAABB& InBound) const;
-    TArray<UPrimitiveComponent*> QueryIntersectedComponents(const FOBB& InBound) const;
-    TArray<UPrimitiveComponent*> QueryIntersectedComponents(const FBoundingSphere& InBound) const;
+    // 프러스텀 안의 리프 슬롯을 Out 에 표시. 트리를 읽기만 하므로 여러 스레드에서 동시에 호출 가능
+    void CullFrustum(const FFrustum& InFrustum, FVisibilityBitset& Out) const;
+    // 컴포넌트의 리프 슬롯 (트리에 없으면 -1). FlushRebuild 전까지 유효
+    int32 GetComponentSlot(UPrimitiveComponent* InComponent) const;
+    int32 GetNumSlots() const { return StaticMeshComponentArray.Num(); }
+    // 결과는 프레임 아레나에 할당됨 (이번 프레임 안에서만 사용)
+    TFrameArray<UPrimitiveComponent*> QueryIntersectedComponents(const FAABB& InBound) const;
+    TFrameArray<UPrimitiveComponent*> QueryIntersectedComponents(const FOBB& InBound) const;
+    TFrameArray<UPrimitiveComponent*> QueryIntersectedComponents(const FBoundingSphere& InBound) const;
 
     void DebugDraw(URenderer* Renderer) const;
 
@@ -47,6 +104,12 @@ public:
     void DebugDump() const;
     const FAABB& GetBounds() const { return Bounds; }
 
+    // SAH 비용: 노드 표면적 합 / 루트 표면적 (리프는 컴포넌트 수 가중). 낮을수록 쿼리가 빠르다
+    float GetSAHCost() const { return CurrentCost; }
+    float GetBuildSAHCost() const { return BuildCost; }
+    uint32 GetNumFullRebuilds() const { return NumFullRebuilds; }
+    uint32 GetNumRotations() const { return NumRotations; }
+
     // 프러스텀 기준으로 오클루더(내부노드 AABB) / 오클루디(리프의 액터들) 수집
     // VP는 행벡터 기준(네 컨벤션): p' = p * VP
 
@@ -59,15 +122,37 @@ private:
         int32 Right = -1;
         int32 First = -1;
         int32 Count = 0;
+        int32 Parent = -1;
         bool IsLeaf() const { return Count > 0; }
+        bool IsFree() const { return Count < 0; }
     };
     void BuildLBVH();
 
+    // === 부분 갱신 ===
+    int32 AllocateNode();
+    void FreeNode(int32 Idx);
+    // 노드 내용을 다른 슬롯으로 옮기고 자식/컴포넌트의 역참조를 고친다 (루트는 항상 0 번)
+    void MoveNode(int32 From, int32 To);
+    void ReplaceChild(int32 ParentIdx, int32 OldChild, int32 NewChild);
+    bool ComputeLeafBounds(const FLBVHNode& Leaf, FAABB& OutBounds) const;
+    int32 FindLeafSlot(const FLBVHNode& Leaf, UPrimitiveComponent* Component) const;
+    void WriteLeafSlot(int32 Slot, UPrimitiveComponent* Component, const FAABB& Bound);
+    void ClearLeafSlot(int32 Slot);
+    void RefitUpward(int32 NodeIdx);
+    bool TryRotate(int32 NodeIdx);
+    void InsertLeaf(UPrimitiveComponent* Component, const FAABB& Bound);
+    void RemoveFromTree(UPrimitiveComponent* Component);
+    void RemoveLeaf(int32 LeafIdx);
+    float ComputeSAHCost() const;
+
 private:
     template<typename BoundType, typename NodeIntersectFunc, typename ComponentIntersectFunc>
-    TArray<UPrimitiveComponent*> QueryIntersectedComponentsGeneric(const BoundType& InBound
+    TFrameArray<UPrimitiveComponent*> QueryIntersectedComponentsGeneric(const BoundType& InBound
         , NodeIntersectFunc NodeIntersects
         , ComponentIntersectFunc ComponentIntersects) const;
+    // 프러스텀과 겹치는 리프 슬롯마다 OnVisible(Slot) 호출
+    template<typename VisibleFunc>
+    void ForEachSlotInFrustum(const FFrustum& InFrustum, VisibleFunc OnVisible) const;
 
     int BuildRange(int s, int e);
 
@@ -76,11 +161,32 @@ private:
     int MaxObjects;
     FAABB Bounds;
 
-    TMap<UPrimitiveComponent*, FAABB> StaticMeshComponentBounds;
+    TFlatMap<UPrimitiveComponent*, FAABB> StaticMeshComponentBounds;
     TArray<UPrimitiveComponent*> StaticMeshComponentArray;
 
+    // 리프 프리미티브 데이터: StaticMeshComponentArray 와 같은 슬롯 인덱스
+    enum ELeafFlags : uint8
+    {
+        LeafFlag_Valid = 1 << 0,    // 슬롯에 컴포넌트가 있음 (빈 슬롯은 0)
+    };
+    TArray<FAABB> LeafBounds;
+    TArray<AActor*> LeafOwners;
+    TArray<uint8> LeafFlags;
+
     // LBVH nodes
     TArray<FLBVHNode> Nodes;
+    TArray<int32> FreeNodes;
+    // 부분 갱신용 역참조: 컴포넌트 -> 리프 노드, 비어 있는 StaticMeshComponentArray 슬롯
+    TFlatMap<UPrimitiveComponent*, int32> ComponentLeaves;
+    TArray<int32> FreeSlots;
+    // 다음 FlushRebuild 에서 refit/삽입할 컴포넌트
+    TFlatSet<UPrimitiveComponent*> DirtyComponents;
+
+    float BuildCost = 0.0f;
+    float CurrentCost = 0.0f;
+    uint32 NumFullRebuilds = 0;
+    uint32 NumRotations = 0;
 
     bool bPendingRebuild = false;
+    bool bCostDirty = false;
 };
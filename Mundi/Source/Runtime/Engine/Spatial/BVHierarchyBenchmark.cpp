@@ -0,0 +1,140 @@
+﻿#include "pch.h"
+#include <random>
+#include "BVHierarchy.h"
+#include "StaticMeshComponent.h"
+#include "Benchmark.h"
+
+namespace
+{
+	constexpr int32 NumStatic = 10000;
+	constexpr int32 NumMoving = 500;
+	constexpr int32 NumFrames = 60;
+	constexpr int32 NumQueries = 1000;
+	constexpr float WorldSize = 2000.0f;
+
+	FAABB MakeBox(const FVector& Center, float HalfSize)
+	{
+		return FAABB(Center - FVector(HalfSize, HalfSize, HalfSize), Center + FVector(HalfSize, HalfSize, HalfSize));
+	}
+
+	// 움직이는 컴포넌트는 원을 따라 돈다 (프레임마다 위치가 조금씩 바뀌는 일반적인 경우)
+	FVector MovingCenter(int32 Index, int32 Frame)
+	{
+		const float Angle = static_cast<float>(Index) * 0.37f + static_cast<float>(Frame) * 0.05f;
+		const float Radius = 100.0f + static_cast<float>(Index % 50) * 15.0f;
+		return FVector(WorldSize * 0.5f + Radius * std::cos(Angle), WorldSize * 0.5f + Radius * std::sin(Angle), static_cast<float>(Index % 20) * 10.0f);
+	}
+
+	struct FRunResult
+	{
+		double UpdateMs = 0.0;
+		double QueryMs = 0.0;
+		float SAHCost = 0.0f;
+		float BuildSAHCost = 0.0f;
+		uint32 NumFullRebuilds = 0;
+		uint32 NumRotations = 0;
+		uint64 NumHits = 0;
+	};
+
+	FRunResult Run(const TArray<UPrimitiveComponent*>& Statics, const TArray<FAABB>& StaticBounds,
+		const TArray<UPrimitiveComponent*>& Movings, const TArray<FAABB>& QueryBoxes, bool bAlwaysRebuild)
+	{
+		FRunResult Result;
+		FBVHierarchy BVH(FAABB(), 0, 8, 1);
+		for (int32 i = 0; i < Statics.Num(); ++i)
+		{
+			BVH.UpdateBounds(Statics[i], StaticBounds[i]);
+		}
+		for (int32 i = 0; i < Movings.Num(); ++i)
+		{
+			BVH.UpdateBounds(Movings[i], MakeBox(MovingCenter(i, 0), 2.0f));
+		}
+		BVH.FlushRebuild();
+		const uint32 InitialRebuilds = BVH.GetNumFullRebuilds();
+
+		for (int32 Frame = 1; Frame <= NumFrames; ++Frame)
+		{
+			FBenchTimer Timer;
+			for (int32 i = 0; i < Movings.Num(); ++i)
+			{
+				BVH.UpdateBounds(Movings[i], MakeBox(MovingCenter(i, Frame), 2.0f));
+			}
+			if (bAlwaysRebuild)
+			{
+				// 이전 방식: 더티가 하나라도 있으면 LBVH 전체 재빌드
+				BVH.RequestFullRebuild();
+			}
+			BVH.FlushRebuild();
+			Result.UpdateMs += Timer.GetMs();
+		}
+
+		{
+			FBenchTimer Timer;
+			for (const FAABB& Box : QueryBoxes)
+			{
+				Result.NumHits += BVH.QueryIntersectedComponents(Box).Num();
+			}
+			Result.QueryMs = Timer.GetMs();
+		}
+
+		Result.UpdateMs /= NumFrames;
+		Result.SAHCost = BVH.GetSAHCost();
+		Result.BuildSAHCost = BVH.GetBuildSAHCost();
+		Result.NumFullRebuilds = BVH.GetNumFullRebuilds() - InitialRebuilds;
+		Result.NumRotations = BVH.GetNumRotations();
+		return Result;
+	}
+}
+
+IMPLEMENT_BENCHMARK(BVH, "Broad phase BVH: 10k static + 500 moving components per frame, full LBVH rebuild vs incremental refit")
+{
+	std::mt19937 Random(1234);
+	std::uniform_real_distribution<float> Position(0.0f, WorldSize);
+	std::uniform_real_distribution<float> Size(0.5f, 8.0f);
+
+	// BVH 는 포인터만 키로 쓰므로 바운드는 직접 넣는다 (메시 로드 없이 측정)
+	TArray<UPrimitiveComponent*> Statics;
+	TArray<FAABB> StaticBounds;
+	TArray<UPrimitiveComponent*> Movings;
+	Statics.Reserve(NumStatic);
+	StaticBounds.Reserve(NumStatic);
+	Movings.Reserve(NumMoving);
+	for (int32 i = 0; i < NumStatic; ++i)
+	{
+		Statics.Add(NewObject<UStaticMeshComponent>());
+		StaticBounds.Add(MakeBox(FVector(Position(Random), Position(Random), Position(Random) * 0.1f), Size(Random)));
+	}
+	for (int32 i = 0; i < NumMoving; ++i)
+	{
+		Movings.Add(NewObject<UStaticMeshComponent>());
+	}
+
+	TArray<FAABB> QueryBoxes;
+	QueryBoxes.Reserve(NumQueries);
+	for (int32 i = 0; i < NumQueries; ++i)
+	{
+		QueryBoxes.Add(MakeBox(FVector(Position(Random), Position(Random), Position(Random) * 0.1f), 30.0f));
+	}
+
+	const FRunResult Full = Run(Statics, StaticBounds, Movings, QueryBoxes, true);
+	const FRunResult Incremental = Run(Statics, StaticBounds, Movings, QueryBoxes, false);
+
+	UE_LOG("[Bench] BVH full rebuild : update %.3fms/frame | SAH %.2f | %d queries %.3fms (%llu hits)",
+		Full.UpdateMs, Full.SAHCost, NumQueries, Full.QueryMs, Full.NumHits);
+	UE_LOG("[Bench] BVH incremental  : update %.3fms/frame | SAH %.2f (build %.2f, x%.2f) | %d queries %.3fms (%llu hits) | %u rebuilds, %u rotations in %d frames",
+		Incremental.UpdateMs, Incremental.SAHCost, Incremental.BuildSAHCost,
+		Incremental.BuildSAHCost > 0.0f ? Incremental.SAHCost / Incremental.BuildSAHCost : 0.0f,
+		NumQueries, Incremental.QueryMs, Incremental.NumHits,
+		Incremental.NumFullRebuilds, Incremental.NumRotations, NumFrames);
+	UE_LOG("[Bench] BVH update speedup x%.2f",
+		Incremental.UpdateMs > 0.0 ? Full.UpdateMs / Incremental.UpdateMs : 0.0);
+
+	for (UPrimitiveComponent* Component : Statics)
+	{
+		ObjectFactory::DeleteObject(Component);
+	}
+	for (UPrimitiveComponent* Component : Movings)
+	{
+		ObjectFactory::DeleteObject(Component);
+	}
+}
@@ -1,10 +1,88 @@
 ﻿#include "pch.h"
 #include "MeshBVH.h"
+#include "JobSystem.h"
+#include <bit>
+#include <cfloat>
+#include <immintrin.h> // SSE
+
+namespace
+{
+	// 축마다 중심점을 나눌 구간 수
+	constexpr int32 NumSAHBins = 16;
+	// 분할 비용이 리프보다 비싸도 이 개수를 넘으면 나눈다
+	constexpr uint32 MaxLeafSize = 16;
+	// 이 개수 이상인 구간은 왼쪽 서브트리를 워커에서 빌드
+	constexpr uint32 ParallelBuildThreshold = 8192;
+	// 삼각형 교차 1회 대비 노드 방문 비용
+	constexpr float TraversalCost = 1.0f;
+
+	// 빈 상태에서 시작해 점/박스를 합쳐 가는 AABB
+	struct FBinBounds
+	{
+		FVector Min = FVector(FLT_MAX, FLT_MAX, FLT_MAX);
+		FVector Max = FVector(-FLT_MAX, -FLT_MAX, -FLT_MAX);
+
+		void Grow(const FVector& Point)
+		{
+			Min = Min.ComponentMin(Point);
+			Max = Max.ComponentMax(Point);
+		}
+		void Grow(const FVector& InMin, const FVector& InMax)
+		{
+			Min = Min.ComponentMin(InMin);
+			Max = Max.ComponentMax(InMax);
+		}
+		// 표면적의 절반 (비교용이라 상수배는 무시)
+		float HalfArea() const
+		{
+			if (Min.X > Max.X)
+			{
+				return 0.0f;
+			}
+			const FVector D = Max - Min;
+			return D.X * D.Y + D.Y * D.Z + D.Z * D.X;
+		}
+	};
+
+	inline float HalfArea(const FAABB& Box)
+	{
+		const FVector D = Box.Max - Box.Min;
+		return D.X * D.Y + D.Y * D.Z + D.Z * D.X;
+	}
+
+	// 따로 빌드한 서브트리를 OutNodes 뒤에 붙이고 자식 인덱스를 옮긴다. 서브트리 루트의 새 인덱스 반환
+	int AppendSubtree(TArray<FMeshBVHNode>& OutNodes, const TArray<FMeshBVHNode>& Subtree)
+	{
+		const int Offset = OutNodes.Num();
+		for (FMeshBVHNode Node : Subtree)
+		{
+			if (!Node.IsLeaf())
+			{
+				Node.Left += Offset;
+				Node.Right += Offset;
+			}
+			OutNodes.Add(Node);
+		}
+		return Offset;
+	}
+}
+
+// 빌드 동안만 쓰는 삼각형별 데이터 (읽기 전용이라 워커들이 공유)
+struct FMeshBVHBuildContext
+{
+	TArray<FAABB> TriBounds;
+	TArray<FVector> TriCenters;
+};
 
 void FMeshBVH::Build(const TArray<FNormalVertex>& Vertices, const TArray<uint32>& Indices)
 {
 	TriIndices.Empty();
 	Nodes.Empty();
+	WideNodes.Empty();
+	TrianglePacks.Empty();
+	MaxTraversalStack = 0;
+	SourceVertexCount = static_cast<uint32>(Vertices.Num());
+	SourceIndexCount = static_cast<uint32>(Indices.Num());
 	uint32 TriCount = Indices.Num() / 3;
 	if (TriCount == 0) return;
 
@@ -12,90 +90,333 @@ void FMeshBVH::Build(const TArray<FNormalVertex>& Vertices, const TArray<uint32>
 	for (uint32 t = 0; t < TriCount; ++t)
 		TriIndices.Add(t);
 
-	BuildRecursive(0, TriCount, Vertices, Indices);
+	// 삼각형 바운드/중심은 분할마다 다시 계산하지 않도록 한 번만 구한다
+	FMeshBVHBuildContext Context;
+	Context.TriBounds.SetNum(TriCount);
+	Context.TriCenters.SetNum(TriCount);
+	FJobSystem::Get().ParallelFor(static_cast<int32>(TriCount), 4096, [&](int32 Begin, int32 End)
+	{
+		for (int32 t = Begin; t < End; ++t)
+		{
+			Context.TriBounds[t] = ComputeTriBounds(t, Vertices, Indices);
+			Context.TriCenters[t] = ComputeTriCenter(t, Vertices, Indices);
+		}
+	}, "MeshBVHTriBounds");
+
+	Nodes.Reserve(2 * (TriCount / LeafSize) + 1);
+	BuildRecursive(Context, 0, TriCount, Nodes);
+
+	// 쿼리용 4-ary 트리 + 삼각형 팩
+	WideNodes.Reserve(Nodes.Num() / 3 + 1);
+	TrianglePacks.Reserve(TriCount / 4 + Nodes.Num() / 2 + 1);
+	int32 MaxDepth = 0;
+	CollapseNode(0, Vertices, Indices, 1, MaxDepth);
+	MaxTraversalStack = 3 * MaxDepth + 1;
 }
 
-// 삼각형과 맞을 경우 , BVH를 따라 내려가면서 교차 가능성 있는 노드만 검사한다. 
-// Möller–Trumbore로 교차 체크 ! 
-bool FMeshBVH::IntersectRay(const FRay& InLocalRay,
-	const TArray<FNormalVertex>& InVertices,
-	const TArray<uint32>& InIndices,
-	float& OutHitDistance)
+bool FMeshBVH::IsValidFor(const TArray<FNormalVertex>& Vertices, const TArray<uint32>& Indices) const
 {
-	if (Nodes.Num() == 0)
+	if (SourceVertexCount != static_cast<uint32>(Vertices.Num()) || SourceIndexCount != static_cast<uint32>(Indices.Num()))
 	{
 		return false;
 	}
 
-	float RootEntry, RootExit;
-	if (!Nodes[0].Bounds.IntersectsRay(InLocalRay, RootEntry, RootExit))
+	const uint32 TriCount = Indices.Num() / 3;
+	if (static_cast<uint32>(TriIndices.Num()) != TriCount || (TriCount > 0) != (Nodes.Num() > 0))
 	{
 		return false;
 	}
+	for (uint32 TriangleID : TriIndices)
+	{
+		if (TriangleID >= TriCount)
+		{
+			return false;
+		}
+	}
 
-	struct FHeapItem
+	// 자식은 항상 부모보다 뒤에 있다 (순환 방지 겸 범위 검사)
+	const int NumNodes = Nodes.Num();
+	for (int i = 0; i < NumNodes; ++i)
 	{
-		int NodeIndex;
-		float EntryDistance;
+		const FMeshBVHNode& Node = Nodes[i];
+		if (Node.IsLeaf())
+		{
+			if (static_cast<uint64>(Node.Start) + Node.Count > TriCount)
+			{
+				return false;
+			}
+		}
+		else if (Node.Left <= i || Node.Right <= i || Node.Left >= NumNodes || Node.Right >= NumNodes)
+		{
+			return false;
+		}
+	}
 
-		bool operator>(const FHeapItem& Other) const
+	// 4-ary 트리: 같은 규칙 + 리프 팩 범위
+	const int32 NumWideNodes = WideNodes.Num();
+	const uint64 NumPacks = static_cast<uint64>(TrianglePacks.Num());
+	if ((TriCount > 0) != (NumWideNodes > 0) || MaxTraversalStack < 0)
+	{
+		return false;
+	}
+	for (int32 i = 0; i < NumWideNodes; ++i)
+	{
+		const FMeshBVH4Node& Node = WideNodes[i];
+		for (int32 Slot = 0; Slot < 4; ++Slot)
+		{
+			const int32 Child = Node.Children[Slot];
+			if (Child >= 0)
+			{
+				if (Child <= i || Child >= NumWideNodes)
+				{
+					return false;
+				}
+			}
+			else if (static_cast<uint64>(~Child) + Node.PackCounts[Slot] > NumPacks)
+			{
+				return false;
+			}
+		}
+	}
+	// 4-ary 깊이는 이진 트리 노드 수를 넘을 수 없다
+	if (MaxTraversalStack > 3 * NumNodes + 1)
+	{
+		return false;
+	}
+	for (const FMeshBVHTrianglePack& Pack : TrianglePacks)
+	{
+		for (uint32 TriangleID : Pack.TriangleIDs)
 		{
-			return EntryDistance > Other.EntryDistance; // 최소 힙
+			if (TriangleID >= TriCount && TriangleID != UINT32_MAX)
+			{
+				return false;
+			}
 		}
+	}
+	return true;
+}
+
+float FMeshBVH::ComputeSAHCost() const
+{
+	if (Nodes.Num() == 0)
+	{
+		return 0.0f;
+	}
+	const float RootArea = HalfArea(Nodes[0].Bounds);
+	if (RootArea <= 0.0f)
+	{
+		return 0.0f;
+	}
+
+	float Sum = 0.0f;
+	for (const FMeshBVHNode& Node : Nodes)
+	{
+		Sum += HalfArea(Node.Bounds) * (Node.IsLeaf() ? static_cast<float>(Node.Count) : TraversalCost);
+	}
+	return Sum / RootArea;
+}
+
+// 4-ary 트리를 가까운 자식부터 내려가면서 교차 가능성 있는 노드만 검사한다.
+// 자식 박스 4개, 삼각형 4개씩 SSE 로 한 번에 검사 (삼각형은 Möller–Trumbore, IntersectRayTriangleMT 와 같은 허용 오차)
+bool FMeshBVH::IntersectRay(const FRay& InLocalRay, float& OutHitDistance) const
+{
+	FVector HitNormal;
+	return IntersectRay(InLocalRay, OutHitDistance, HitNormal);
+}
+
+bool FMeshBVH::IntersectRay(const FRay& InLocalRay, float& OutHitDistance, FVector& OutHitNormal) const
+{
+	if (WideNodes.Num() == 0)
+	{
+		return false;
+	}
+
+	const float Epsilon = KINDA_SMALL_NUMBER;
+	const FVector& Origin = InLocalRay.Origin;
+	const FVector& Direction = InLocalRay.Direction;
+
+	// 슬랩 테스트: 방향 부호에 따라 가까운 면(Min/Max)을 미리 고른다 -> 뒤집힌(빈) 바운드는 항상 빗나간다
+	const FVector InvDirection(1.0f / Direction.X, 1.0f / Direction.Y, 1.0f / Direction.Z);
+	const bool bNegX = InvDirection.X < 0.0f;
+	const bool bNegY = InvDirection.Y < 0.0f;
+	const bool bNegZ = InvDirection.Z < 0.0f;
+
+	const __m128 OriginX = _mm_set1_ps(Origin.X);
+	const __m128 OriginY = _mm_set1_ps(Origin.Y);
+	const __m128 OriginZ = _mm_set1_ps(Origin.Z);
+	const __m128 InvX = _mm_set1_ps(InvDirection.X);
+	const __m128 InvY = _mm_set1_ps(InvDirection.Y);
+	const __m128 InvZ = _mm_set1_ps(InvDirection.Z);
+	const __m128 DirX = _mm_set1_ps(Direction.X);
+	const __m128 DirY = _mm_set1_ps(Direction.Y);
+	const __m128 DirZ = _mm_set1_ps(Direction.Z);
+	const __m128 Zero = _mm_setzero_ps();
+	const __m128 PosEpsilon = _mm_set1_ps(Epsilon);
+	const __m128 NegEpsilon = _mm_set1_ps(-Epsilon);
+	const __m128 OnePlusEpsilon = _mm_set1_ps(1.0f + Epsilon);
+	const __m128 AbsMask = _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff));
+
+	float ClosestDistance = FLT_MAX;
+	__m128 Closest = _mm_set1_ps(FLT_MAX);
+	const FMeshBVHTrianglePack* ClosestPack = nullptr;
+	int32 ClosestLane = 0;
+
+	struct FTraversalEntry
+	{
+		int32 Child;
+		uint32 PackCount;
+		float EntryDistance;
 	};
 
-	std::priority_queue<FHeapItem, TArray<FHeapItem>, std::greater<FHeapItem>> Heap;
-	Heap.push({ 0, RootEntry });
+	// 보통은 스택 배열로 충분하다. 아주 깊은 트리만 힙 사용
+	constexpr int32 LocalStackSize = 192;
+	FTraversalEntry LocalStack[LocalStackSize];
+	TArray<FTraversalEntry> HeapStack;
+	FTraversalEntry* Stack = LocalStack;
+	if (MaxTraversalStack > LocalStackSize)
+	{
+		HeapStack.SetNum(MaxTraversalStack);
+		Stack = HeapStack.data();
+	}
+
+	int32 StackSize = 0;
+	Stack[StackSize++] = { 0, 0, 0.0f };
 
-	while (!Heap.empty())
+	while (StackSize > 0)
 	{
-		FHeapItem Current = Heap.top();
-		Heap.pop();
+		const FTraversalEntry Entry = Stack[--StackSize];
+		if (Entry.EntryDistance > ClosestDistance)
+		{
+			continue;
+		}
 
-		const FMeshBVHNode& Node = Nodes[Current.NodeIndex];
-		if (Node.IsLeaf())
+		if (Entry.Child < 0)
 		{
-			for (uint32 TriOffset = 0; TriOffset < Node.Count; ++TriOffset)
+			// 리프: 팩마다 삼각형 4개
+			const FMeshBVHTrianglePack* Pack = TrianglePacks.data() + ~Entry.Child;
+			for (uint32 PackIndex = 0; PackIndex < Entry.PackCount; ++PackIndex, ++Pack)
 			{
-				const uint32 TriangleID = TriIndices[Node.Start + TriOffset];
-				const uint32 V0 = InIndices[3 * TriangleID + 0];
-				const uint32 V1 = InIndices[3 * TriangleID + 1];
-				const uint32 V2 = InIndices[3 * TriangleID + 2];
-
-				const FVector& A = InVertices[V0].pos;
-				const FVector& B = InVertices[V1].pos;
-				const FVector& C = InVertices[V2].pos;
+				const __m128 E1X = _mm_load_ps(Pack->Edge1X);
+				const __m128 E1Y = _mm_load_ps(Pack->Edge1Y);
+				const __m128 E1Z = _mm_load_ps(Pack->Edge1Z);
+				const __m128 E2X = _mm_load_ps(Pack->Edge2X);
+				const __m128 E2Y = _mm_load_ps(Pack->Edge2Y);
+				const __m128 E2Z = _mm_load_ps(Pack->Edge2Z);
+
+				// P = D x E2, Det = E1 . P
+				const __m128 PX = _mm_sub_ps(_mm_mul_ps(DirY, E2Z), _mm_mul_ps(DirZ, E2Y));
+				const __m128 PY = _mm_sub_ps(_mm_mul_ps(DirZ, E2X), _mm_mul_ps(DirX, E2Z));
+				const __m128 PZ = _mm_sub_ps(_mm_mul_ps(DirX, E2Y), _mm_mul_ps(DirY, E2X));
+				const __m128 Det = _mm_add_ps(_mm_add_ps(_mm_mul_ps(E1X, PX), _mm_mul_ps(E1Y, PY)), _mm_mul_ps(E1Z, PZ));
+				__m128 Mask = _mm_cmpge_ps(_mm_and_ps(Det, AbsMask), PosEpsilon);
+				if (_mm_movemask_ps(Mask) == 0)
+				{
+					continue;
+				}
+				const __m128 InvDet = _mm_div_ps(_mm_set1_ps(1.0f), Det);
+
+				// T = O - V0, U = (T . P) / Det
+				const __m128 TX = _mm_sub_ps(OriginX, _mm_load_ps(Pack->V0X));
+				const __m128 TY = _mm_sub_ps(OriginY, _mm_load_ps(Pack->V0Y));
+				const __m128 TZ = _mm_sub_ps(OriginZ, _mm_load_ps(Pack->V0Z));
+				const __m128 U = _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(TX, PX), _mm_mul_ps(TY, PY)), _mm_mul_ps(TZ, PZ)), InvDet);
+				Mask = _mm_and_ps(Mask, _mm_and_ps(_mm_cmpge_ps(U, NegEpsilon), _mm_cmple_ps(U, OnePlusEpsilon)));
+
+				// Q = T x E1, V = (D . Q) / Det, Distance = (E2 . Q) / Det
+				const __m128 QX = _mm_sub_ps(_mm_mul_ps(TY, E1Z), _mm_mul_ps(TZ, E1Y));
+				const __m128 QY = _mm_sub_ps(_mm_mul_ps(TZ, E1X), _mm_mul_ps(TX, E1Z));
+				const __m128 QZ = _mm_sub_ps(_mm_mul_ps(TX, E1Y), _mm_mul_ps(TY, E1X));
+				const __m128 V = _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(DirX, QX), _mm_mul_ps(DirY, QY)), _mm_mul_ps(DirZ, QZ)), InvDet);
+				Mask = _mm_and_ps(Mask, _mm_and_ps(_mm_cmpge_ps(V, NegEpsilon), _mm_cmple_ps(_mm_add_ps(U, V), OnePlusEpsilon)));
+
+				const __m128 Distance = _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(E2X, QX), _mm_mul_ps(E2Y, QY)), _mm_mul_ps(E2Z, QZ)), InvDet);
+				Mask = _mm_and_ps(Mask, _mm_and_ps(_mm_cmpgt_ps(Distance, PosEpsilon), _mm_cmplt_ps(Distance, Closest)));
+
+				int32 HitMask = _mm_movemask_ps(Mask);
+				if (HitMask == 0)
+				{
+					continue;
+				}
 
-				float HitT = 0.0f;
-				if (IntersectRayTriangleMT(InLocalRay, A, B, C, HitT))
+				alignas(16) float Distances[4];
+				_mm_store_ps(Distances, Distance);
+				while (HitMask)
 				{
-					OutHitDistance = HitT;
-					return true; // 🚀 첫 번째 히트 → 바로 종료
+					const int32 Lane = std::countr_zero(static_cast<uint32>(HitMask));
+					HitMask &= HitMask - 1;
+					if (Distances[Lane] < ClosestDistance)
+					{
+						ClosestDistance = Distances[Lane];
+						ClosestPack = Pack;
+						ClosestLane = Lane;
+					}
 				}
+				Closest = _mm_set1_ps(ClosestDistance);
 			}
+			continue;
 		}
-		else
+
+		// 내부 노드: 자식 박스 4개 슬랩 테스트
+		const FMeshBVH4Node& Node = WideNodes[Entry.Child];
+		const __m128 NearX = _mm_mul_ps(_mm_sub_ps(_mm_load_ps(bNegX ? Node.MaxX : Node.MinX), OriginX), InvX);
+		const __m128 NearY = _mm_mul_ps(_mm_sub_ps(_mm_load_ps(bNegY ? Node.MaxY : Node.MinY), OriginY), InvY);
+		const __m128 NearZ = _mm_mul_ps(_mm_sub_ps(_mm_load_ps(bNegZ ? Node.MaxZ : Node.MinZ), OriginZ), InvZ);
+		const __m128 FarX = _mm_mul_ps(_mm_sub_ps(_mm_load_ps(bNegX ? Node.MinX : Node.MaxX), OriginX), InvX);
+		const __m128 FarY = _mm_mul_ps(_mm_sub_ps(_mm_load_ps(bNegY ? Node.MinY : Node.MaxY), OriginY), InvY);
+		const __m128 FarZ = _mm_mul_ps(_mm_sub_ps(_mm_load_ps(bNegZ ? Node.MinZ : Node.MaxZ), OriginZ), InvZ);
+		const __m128 Entry4 = _mm_max_ps(_mm_max_ps(NearX, NearY), _mm_max_ps(NearZ, Zero));
+		const __m128 Exit4 = _mm_min_ps(_mm_min_ps(FarX, FarY), _mm_min_ps(FarZ, Closest));
+		int32 HitMask = _mm_movemask_ps(_mm_cmple_ps(Entry4, Exit4));
+		if (HitMask == 0)
+		{
+			continue;
+		}
+
+		alignas(16) float EntryDistances[4];
+		_mm_store_ps(EntryDistances, Entry4);
+
+		// 맞은 자식을 진입 거리 내림차순으로 쌓아 가까운 자식부터 꺼내지게 한다
+		FTraversalEntry Hits[4];
+		int32 NumHits = 0;
+		while (HitMask)
 		{
-			if (Node.Left >= 0)
+			const int32 Slot = std::countr_zero(static_cast<uint32>(HitMask));
+			HitMask &= HitMask - 1;
+			if (Node.Children[Slot] < 0 && Node.PackCounts[Slot] == 0)
 			{
-				float ChildEntry, ChildExit;
-				if (Nodes[Node.Left].Bounds.IntersectsRay(InLocalRay, ChildEntry, ChildExit))
-				{
-					Heap.push({ Node.Left, ChildEntry });
-				}
+				continue;
 			}
-			if (Node.Right >= 0)
+
+			FTraversalEntry Hit{ Node.Children[Slot], Node.PackCounts[Slot], EntryDistances[Slot] };
+			int32 Insert = NumHits++;
+			while (Insert > 0 && Hits[Insert - 1].EntryDistance < Hit.EntryDistance)
 			{
-				float ChildEntry, ChildExit;
-				if (Nodes[Node.Right].Bounds.IntersectsRay(InLocalRay, ChildEntry, ChildExit))
-				{
-					Heap.push({ Node.Right, ChildEntry });
-				}
+				Hits[Insert] = Hits[Insert - 1];
+				--Insert;
 			}
+			Hits[Insert] = Hit;
 		}
+		for (int32 i = 0; i < NumHits; ++i)
+		{
+			Stack[StackSize++] = Hits[i];
+		}
+	}
+
+	if (ClosestDistance == FLT_MAX)
+	{
+		return false;
 	}
+	OutHitDistance = ClosestDistance;
 
-	return false;
+	// 면 법선 = E1 x E2 (감는 방향과 무관하게 레이 반대쪽으로)
+	const FVector Edge1(ClosestPack->Edge1X[ClosestLane], ClosestPack->Edge1Y[ClosestLane], ClosestPack->Edge1Z[ClosestLane]);
+	const FVector Edge2(ClosestPack->Edge2X[ClosestLane], ClosestPack->Edge2Y[ClosestLane], ClosestPack->Edge2Z[ClosestLane]);
+	OutHitNormal = FVector::Cross(Edge1, Edge2).GetSafeNormal();
+	if (FVector::Dot(OutHitNormal, Direction) > 0.0f)
+	{
+		OutHitNormal = -OutHitNormal;
+	}
+	return true;
 }
 //bool FMeshBVH::IntersectRay(const FRay& InLocalRay, const TArray<FNormalVertex>& InVertices, const TArray<uint32>& InIndices, float& OutHitDistance)
 //{
@@ -188,6 +509,59 @@ bool FMeshBVH::IntersectRay(const FRay& InLocalRay,
 //	return false;
 //}
 
+// 4-ary 트리를 박스 겹침으로만 내려간다 (순서 무관). 팩의 빈 레인은 건너뛴다
+void FMeshBVH::GatherTriangles(const FAABB& LocalBounds, TArray<FVector>& OutVertices) const
+{
+	if (WideNodes.Num() == 0)
+	{
+		return;
+	}
+
+	const FVector& Min = LocalBounds.Min;
+	const FVector& Max = LocalBounds.Max;
+
+	TArray<int32> Stack;
+	Stack.Reserve(MaxTraversalStack);
+	Stack.Add(0);
+	while (!Stack.IsEmpty())
+	{
+		const FMeshBVH4Node& Node = WideNodes[Stack.back()];
+		Stack.pop_back();
+
+		for (int32 Slot = 0; Slot < 4; ++Slot)
+		{
+			if (Node.MinX[Slot] > Max.X || Node.MaxX[Slot] < Min.X ||
+				Node.MinY[Slot] > Max.Y || Node.MaxY[Slot] < Min.Y ||
+				Node.MinZ[Slot] > Max.Z || Node.MaxZ[Slot] < Min.Z)
+			{
+				continue;
+			}
+
+			if (Node.Children[Slot] >= 0)
+			{
+				Stack.Add(Node.Children[Slot]);
+				continue;
+			}
+
+			const FMeshBVHTrianglePack* Pack = TrianglePacks.data() + ~Node.Children[Slot];
+			for (uint32 PackIndex = 0; PackIndex < Node.PackCounts[Slot]; ++PackIndex, ++Pack)
+			{
+				for (int32 Lane = 0; Lane < 4; ++Lane)
+				{
+					if (Pack->TriangleIDs[Lane] == UINT32_MAX)
+					{
+						continue;
+					}
+					const FVector V0(Pack->V0X[Lane], Pack->V0Y[Lane], Pack->V0Z[Lane]);
+					OutVertices.Add(V0);
+					OutVertices.Add(V0 + FVector(Pack->Edge1X[Lane], Pack->Edge1Y[Lane], Pack->Edge1Z[Lane]));
+					OutVertices.Add(V0 + FVector(Pack->Edge2X[Lane], Pack->Edge2Y[Lane], Pack->Edge2Z[Lane]));
+				}
+			}
+		}
+	}
+}
+
 FAABB FMeshBVH::ComputeTriBounds(uint32 TriangleID, const TArray<FNormalVertex>& Vertices, const TArray<uint32>& Indices) const
 {
 	// TriangleID : 몇 번째 삼각형인지 (0번, 1번 , 2번)
@@ -240,35 +614,26 @@ FVector FMeshBVH::ComputeTriCenter(uint32 TriangleID, const TArray<FNormalVertex
 	return TriangleCenter;
 }
 
-// 여러 삼각형을 한 번에 감싸는 AABB를 계산 
-FAABB FMeshBVH::ComputeBounds(uint32 Start, uint32 Count, const TArray<FNormalVertex>& Vertices, const TArray<uint32>& Indices) const
+// BVH 트리 -> 재귀 구축 (binned SAH)
+int FMeshBVH::BuildRecursive(const FMeshBVHBuildContext& Context, uint32 Start, uint32 Count, TArray<FMeshBVHNode>& OutNodes)
 {
-	// 첫 번째 삼각형 ID로 AABB 초기화 
-	FAABB Bounds = ComputeTriBounds(TriIndices[Start], Vertices, Indices);
-	// Start+1 ~ Start+Count-1 까지 모든 삼각형에 대해 반복 
-	// 가장 큰 MIN , MAX 찾아낸다. 
-	for (uint32 i = 1; i < Count; i++)
+	// 이 노드가 감싸는 AABB, 분할 축을 고를 중심점 AABB
+	FBinBounds NodeBounds;
+	FBinBounds CenterBounds;
+	for (uint32 i = Start; i < Start + Count; ++i)
 	{
-		FAABB TB = ComputeTriBounds(TriIndices[Start + i], Vertices, Indices);
-		Bounds.Min = Bounds.Min.ComponentMin(TB.Min);
-		Bounds.Max = Bounds.Max.ComponentMax(TB.Max);
+		const uint32 TriangleID = TriIndices[i];
+		NodeBounds.Grow(Context.TriBounds[TriangleID].Min, Context.TriBounds[TriangleID].Max);
+		CenterBounds.Grow(Context.TriCenters[TriangleID]);
 	}
-	return Bounds;
-}
 
-// BVH 트리 -> 재귀 구축 
-int FMeshBVH::BuildRecursive(uint32 Start, uint32 Count, const TArray<FNormalVertex>& Vertices, const TArray<uint32>& Indices)
-{
 	FMeshBVHNode Node;
+	Node.Bounds = FAABB(NodeBounds.Min, NodeBounds.Max);
 	Node.Start = Start;
 	Node.Count = Count;
 
-	// 이 노드가 감싸는 AABB 계산
-	Node.Bounds = ComputeBounds(Start, Count, Vertices, Indices);
-
 	// 현재 노드 인덱스 확보 & 추가 -> 자식으로 쪼갤 때 사용 
-	int NodeIndex = Nodes.Num();
-	Nodes.Add(Node);
+	const int NodeIndex = OutNodes.Add(Node);
 
 	// 리프 조건: 삼각형 개수가 LeafSize 이하
 	if (Count <= LeafSize)
@@ -277,57 +642,246 @@ int FMeshBVH::BuildRecursive(uint32 Start, uint32 Count, const TArray<FNormalVer
 	}
 
 	// -------------------------------
-	// 분할 축 선택 (가장 긴 축)
+	// 축마다 중심점을 NumSAHBins 구간으로 나눠 SAH 비용이 가장 낮은 경계 선택
+	// 비용 = 왼쪽 면적 * 왼쪽 삼각형 수 + 오른쪽 면적 * 오른쪽 삼각형 수
 	// -------------------------------
-	FVector Extent = Node.Bounds.GetHalfExtent();
-	EAxis Axis = EAxis::X;
+	int32 BestAxis = -1;
+	int32 BestSplit = 0;
+	float BestCost = FLT_MAX;
+	float BestAxisMin = 0.0f;
+	float BestScale = 0.0f;
+
+	for (int32 Axis = 0; Axis < 3; ++Axis)
+	{
+		const float AxisMin = CenterBounds.Min[Axis];
+		const float Extent = CenterBounds.Max[Axis] - AxisMin;
+		if (Extent <= 0.0f)
+		{
+			continue; // 이 축으로는 중심점이 모두 같다
+		}
+		const float Scale = static_cast<float>(NumSAHBins) / Extent;
 
-	if (Extent.Y > Extent.X && Extent.Y >= Extent.Z)
-		Axis = EAxis::Y;
-	else if (Extent.Z > Extent.X && Extent.Z >= Extent.Y)
-		Axis = EAxis::Z;
+		FBinBounds BinBounds[NumSAHBins];
+		uint32 BinCounts[NumSAHBins] = {};
+		for (uint32 i = Start; i < Start + Count; ++i)
+		{
+			const uint32 TriangleID = TriIndices[i];
+			const int32 Bin = std::min(NumSAHBins - 1, static_cast<int32>((Context.TriCenters[TriangleID][Axis] - AxisMin) * Scale));
+			++BinCounts[Bin];
+			BinBounds[Bin].Grow(Context.TriBounds[TriangleID].Min, Context.TriBounds[TriangleID].Max);
+		}
 
-	// 중간 지점 -> 반으로 쪼갤 준비하기 
-	uint32 Mid = Start + Count / 2;
+		// 오른쪽 끝에서부터 누적: 경계 b 의 오른쪽 = [b, NumSAHBins)
+		float RightArea[NumSAHBins] = {};
+		uint32 RightCount[NumSAHBins] = {};
+		FBinBounds Accum;
+		uint32 AccumCount = 0;
+		for (int32 b = NumSAHBins - 1; b > 0; --b)
+		{
+			Accum.Grow(BinBounds[b].Min, BinBounds[b].Max);
+			AccumCount += BinCounts[b];
+			RightArea[b] = Accum.HalfArea();
+			RightCount[b] = AccumCount;
+		}
 
-	// -------------------------------
-	// 삼각형 중심 좌표 기준으로 분할
-	// -------------------------------
-	// 오른쪽 왼쪽으로 나누기 좋은 
-	// nth_element 가이드 
-	// nth_element(first, nth, last, comp)
-	// nth 위치에 "정렬했을 때 올 원소"를 제자리에 넣음
-	// 왼쪽 구간 [first, nth) 에는 그 원소보다 "작은 것들"만
-	// 오른쪽 구간 [nth+1, last) 에는 "큰 것들"만 놓음
-
-	// 선택된 Axis를 방향으로 왼쪽과 오른쪽으로 나눈다. 
-	// 전체를 정렬하지 않고, n번째 작은 원소를 찾아서 놓는다. 
-	std::nth_element(
-		TriIndices.begin() + Start, // 분할할 구간 시작
-		TriIndices.begin() + Mid, // 중간 값의 위치 
-		TriIndices.begin() + Start + Count, // 분할할 구간의 끝 
-		[&](uint32 A, uint32 B)			// 비교함수 
+		// 왼쪽에서부터 누적하며 경계마다 비용 계산: 왼쪽 = [0, b)
+		Accum = FBinBounds();
+		AccumCount = 0;
+		for (int32 b = 1; b < NumSAHBins; ++b)
 		{
-			FVector CenterA = ComputeTriCenter(A, Vertices, Indices);
-			FVector CenterB = ComputeTriCenter(B, Vertices, Indices);
+			Accum.Grow(BinBounds[b - 1].Min, BinBounds[b - 1].Max);
+			AccumCount += BinCounts[b - 1];
+			if (AccumCount == 0 || RightCount[b] == 0)
+			{
+				continue;
+			}
 
-			switch (Axis)
+			const float Cost = Accum.HalfArea() * static_cast<float>(AccumCount) + RightArea[b] * static_cast<float>(RightCount[b]);
+			if (Cost < BestCost)
 			{
-			case EAxis::X: return CenterA.X < CenterB.X;
-			case EAxis::Y: return CenterA.Y < CenterB.Y;
-			case EAxis::Z: return CenterA.Z < CenterB.Z;
-			default:       return CenterA.X < CenterB.X;
+				BestCost = Cost;
+				BestAxis = Axis;
+				BestSplit = b;
+				BestAxisMin = AxisMin;
+				BestScale = Scale;
 			}
-		});
+		}
+	}
+
+	// 나누는 편이 리프보다 비싸면 (작은 구간에 한해) 리프로 둔다. 양쪽 모두 노드 면적을 곱한 단위
+	const float NodeArea = NodeBounds.HalfArea();
+	const float LeafCost = NodeArea * static_cast<float>(Count);
+	const float SplitCost = TraversalCost * NodeArea + BestCost;
+	if ((BestAxis < 0 || SplitCost >= LeafCost) && Count <= MaxLeafSize)
+	{
+		return NodeIndex;
+	}
+
+	uint32 Mid = Start + Count / 2;
+	if (BestAxis >= 0)
+	{
+		// 고른 경계 왼쪽 구간의 삼각형을 앞으로 모은다 (구간 계산은 위와 같은 식)
+		auto SplitIt = std::partition(
+			TriIndices.begin() + Start,
+			TriIndices.begin() + Start + Count,
+			[&](uint32 TriangleID)
+			{
+				const int32 Bin = std::min(NumSAHBins - 1, static_cast<int32>((Context.TriCenters[TriangleID][BestAxis] - BestAxisMin) * BestScale));
+				return Bin < BestSplit;
+			});
+		Mid = static_cast<uint32>(SplitIt - TriIndices.begin());
+	}
+	// else: 중심점이 한 점에 모여 나눌 기준이 없다 -> 순서대로 반씩 (리프 크기 제한용)
 
 	// -------------------------------
 	// 내부 노드로 전환 & 자식 생성
 	// -------------------------------
-	// 자식 생성으로 본인 Count 초기화.
-	// Left, Right에 자식 달기 
-	Nodes[NodeIndex].Count = 0;
-	Nodes[NodeIndex].Left = BuildRecursive(Start, Mid - Start, Vertices, Indices);
-	Nodes[NodeIndex].Right = BuildRecursive(Mid, Start + Count - Mid, Vertices, Indices);
+	OutNodes[NodeIndex].Count = 0;
+	if (Count >= ParallelBuildThreshold)
+	{
+		// 왼쪽 서브트리는 워커에서, 오른쪽은 이 스레드에서 각자의 노드 배열에 빌드한 뒤 이어 붙인다
+		// (두 작업은 서로 다른 TriIndices 구간만 건드린다)
+		TArray<FMeshBVHNode> LeftNodes;
+		TArray<FMeshBVHNode> RightNodes;
+		FJobCounter Counter;
+		FJobSystem::Get().Run([this, &Context, &LeftNodes, Start, Mid]()
+		{
+			BuildRecursive(Context, Start, Mid - Start, LeftNodes);
+		}, &Counter, "MeshBVHBuild");
+		BuildRecursive(Context, Mid, Start + Count - Mid, RightNodes);
+		FJobSystem::Get().Wait(Counter);
+
+		const int Left = AppendSubtree(OutNodes, LeftNodes);
+		const int Right = AppendSubtree(OutNodes, RightNodes);
+		OutNodes[NodeIndex].Left = Left;
+		OutNodes[NodeIndex].Right = Right;
+	}
+	else
+	{
+		const int Left = BuildRecursive(Context, Start, Mid - Start, OutNodes);
+		const int Right = BuildRecursive(Context, Mid, Start + Count - Mid, OutNodes);
+		OutNodes[NodeIndex].Left = Left;
+		OutNodes[NodeIndex].Right = Right;
+	}
 
 	return NodeIndex;
 }
+
+// 이진 노드를 4-ary 노드 하나로 접는다
+// 자식 후보 중 표면적이 가장 큰 내부 노드를 펼치는 것을 4개가 될 때까지 반복
+int32 FMeshBVH::CollapseNode(int32 BinaryIndex, const TArray<FNormalVertex>& Vertices, const TArray<uint32>& Indices, int32 Depth, int32& InOutMaxDepth)
+{
+	int32 Slots[4];
+	int32 NumSlots = 0;
+
+	const FMeshBVHNode& BinaryNode = Nodes[BinaryIndex];
+	if (BinaryNode.IsLeaf())
+	{
+		// 루트가 리프인 작은 메시
+		Slots[NumSlots++] = BinaryIndex;
+	}
+	else
+	{
+		Slots[NumSlots++] = BinaryNode.Left;
+		Slots[NumSlots++] = BinaryNode.Right;
+		while (NumSlots < 4)
+		{
+			int32 ExpandSlot = -1;
+			float ExpandArea = -1.0f;
+			for (int32 i = 0; i < NumSlots; ++i)
+			{
+				const FMeshBVHNode& Candidate = Nodes[Slots[i]];
+				if (!Candidate.IsLeaf() && HalfArea(Candidate.Bounds) > ExpandArea)
+				{
+					ExpandArea = HalfArea(Candidate.Bounds);
+					ExpandSlot = i;
+				}
+			}
+			if (ExpandSlot < 0)
+			{
+				break; // 모두 리프
+			}
+
+			const FMeshBVHNode& Expand = Nodes[Slots[ExpandSlot]];
+			Slots[ExpandSlot] = Expand.Left;
+			Slots[NumSlots++] = Expand.Right;
+		}
+	}
+
+	// 빈 슬롯: 뒤집힌 바운드 + 팩 0개 리프
+	FMeshBVH4Node WideNode;
+	for (int32 Slot = 0; Slot < 4; ++Slot)
+	{
+		WideNode.MinX[Slot] = WideNode.MinY[Slot] = WideNode.MinZ[Slot] = FLT_MAX;
+		WideNode.MaxX[Slot] = WideNode.MaxY[Slot] = WideNode.MaxZ[Slot] = -FLT_MAX;
+		WideNode.Children[Slot] = -1;
+		WideNode.PackCounts[Slot] = 0;
+	}
+
+	const int32 WideIndex = WideNodes.Add(WideNode);
+	InOutMaxDepth = std::max(InOutMaxDepth, Depth);
+
+	for (int32 Slot = 0; Slot < NumSlots; ++Slot)
+	{
+		const FMeshBVHNode& Child = Nodes[Slots[Slot]];
+		WideNode.MinX[Slot] = Child.Bounds.Min.X;
+		WideNode.MinY[Slot] = Child.Bounds.Min.Y;
+		WideNode.MinZ[Slot] = Child.Bounds.Min.Z;
+		WideNode.MaxX[Slot] = Child.Bounds.Max.X;
+		WideNode.MaxY[Slot] = Child.Bounds.Max.Y;
+		WideNode.MaxZ[Slot] = Child.Bounds.Max.Z;
+
+		if (Child.IsLeaf())
+		{
+			const int32 FirstPack = TrianglePacks.Num();
+			WideNode.PackCounts[Slot] = AppendTrianglePacks(Child.Start, Child.Count, Vertices, Indices);
+			WideNode.Children[Slot] = ~FirstPack;
+		}
+		else
+		{
+			// 재귀 중에 WideNodes 가 재할당될 수 있으므로 로컬 노드에 채우고 마지막에 기록
+			WideNode.Children[Slot] = CollapseNode(Slots[Slot], Vertices, Indices, Depth + 1, InOutMaxDepth);
+		}
+	}
+
+	WideNodes[WideIndex] = WideNode;
+	return WideIndex;
+}
+
+uint32 FMeshBVH::AppendTrianglePacks(uint32 Start, uint32 Count, const TArray<FNormalVertex>& Vertices, const TArray<uint32>& Indices)
+{
+	const uint32 NumPacks = (Count + 3) / 4;
+	for (uint32 PackIndex = 0; PackIndex < NumPacks; ++PackIndex)
+	{
+		FMeshBVHTrianglePack Pack{};
+		for (uint32 Lane = 0; Lane < 4; ++Lane)
+		{
+			const uint32 Offset = PackIndex * 4 + Lane;
+			if (Offset >= Count)
+			{
+				Pack.TriangleIDs[Lane] = UINT32_MAX;   // Edge 가 0 -> Det 0 -> 항상 빗나감
+				continue;
+			}
+
+			const uint32 TriangleID = TriIndices[Start + Offset];
+			const FVector& A = Vertices[Indices[3 * TriangleID + 0]].pos;
+			const FVector& B = Vertices[Indices[3 * TriangleID + 1]].pos;
+			const FVector& C = Vertices[Indices[3 * TriangleID + 2]].pos;
+			const FVector Edge1 = B - A;
+			const FVector Edge2 = C - A;
+
+			Pack.V0X[Lane] = A.X;
+			Pack.V0Y[Lane] = A.Y;
+			Pack.V0Z[Lane] = A.Z;
+			Pack.Edge1X[Lane] = Edge1.X;
+			Pack.Edge1Y[Lane] = Edge1.Y;
+			Pack.Edge1Z[Lane] = Edge1.Z;
+			Pack.Edge2X[Lane] = Edge2.X;
+			Pack.Edge2Y[Lane] = Edge2.Y;
+			Pack.Edge2Z[Lane] = Edge2.Z;
+			Pack.TriangleIDs[Lane] = TriangleID;
+		}
+		TrianglePacks.Add(Pack);
+	}
+	return NumPacks;
+}
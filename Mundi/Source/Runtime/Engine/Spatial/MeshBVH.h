@@ -1,5 +1,6 @@
 ﻿#pragma once
 #include "AABB.h"
+#include "Archive.h"
 
 struct FMeshBVHNode
 {
@@ -12,19 +13,107 @@ struct FMeshBVHNode
 	bool IsLeaf() const { return Count > 0; }
 };
 
+/**
+ * 4-ary BVH 노드 (레이 쿼리 전용). 이진 트리를 접어서 만든다.
+ * - 자식 4개의 AABB 를 축별 SoA 로 저장해 SSE 한 번에 4개를 검사한다.
+ * - Children >= 0: 내부 노드 인덱스, < 0: 리프 (~Children = 첫 삼각형 팩, PackCounts = 팩 개수)
+ * - 빈 슬롯은 팩 0개짜리 리프이고, 바운드가 뒤집혀 있어 절대 맞지 않는다.
+ */
+struct alignas(16) FMeshBVH4Node
+{
+	float MinX[4];
+	float MinY[4];
+	float MinZ[4];
+	float MaxX[4];
+	float MaxY[4];
+	float MaxZ[4];
+	int32 Children[4];
+	uint32 PackCounts[4];
+};
+
+/**
+ * 삼각형 4개를 SoA 로 묶은 팩. Möller–Trumbore 에 필요한 값(V0, Edge1, Edge2)을 미리 계산해 둔다.
+ * 쿼리는 렌더용 정점/인덱스 버퍼를 읽지 않는다. 빈 레인은 Edge 가 0 이라 항상 빗나간다.
+ */
+struct alignas(16) FMeshBVHTrianglePack
+{
+	float V0X[4];
+	float V0Y[4];
+	float V0Z[4];
+	float Edge1X[4];
+	float Edge1Y[4];
+	float Edge1Z[4];
+	float Edge2X[4];
+	float Edge2Y[4];
+	float Edge2Z[4];
+	uint32 TriangleIDs[4];   // 원래 삼각형 번호 (빈 레인 = UINT32_MAX)
+};
+
 struct FStackItem
 {
 	int32 NodeIndex;
 	float EntryDistance;
 };
+struct FMeshBVHBuildContext;
+
+/**
+ * 메시 하나의 삼각형 BVH (로컬 공간).
+ * - 빌드: 중심점을 축마다 NumSAHBins 개 구간으로 나눠 SAH 비용이 가장 낮은 분할을 고른다 (binned SAH).
+ *   큰 구간은 자식 하나를 잡 시스템 워커에서 동시에 빌드한다.
+ * - 쿼리: 빌드 후 4-ary 트리(FMeshBVH4Node)로 접고, 리프 삼각형은 팩(FMeshBVHTrianglePack)으로 미리 풀어 둔다.
+ * - 노드/삼각형 순서/4-ary 트리/팩 배열은 그대로 직렬화되어 메시 캐시(.obj.bin) 옆 .bvh.bin 으로 저장된다.
+ */
 class FMeshBVH
 {
 public:
+	// 캐시 포맷이 바뀌면 올린다 (다르면 로드 실패 -> 재빌드)
+	static constexpr uint32 CacheVersion = 2;
 
 	void Build(const TArray<FNormalVertex>& Vertices, const TArray<uint32>& Indices);
 
-	bool IntersectRay(const FRay& InLocalRay, const TArray<FNormalVertex>& InVertices, const TArray<uint32>& InIndices, float& OutHitDistance);
+	// 가장 가까운 교차 거리 (로컬 공간). 4-ary 트리와 삼각형 팩만 읽는다
+	bool IntersectRay(const FRay& InLocalRay, float& OutHitDistance) const;
+	// 맞은 삼각형의 면 법선(로컬 공간, 정규화, 레이 반대쪽을 향함)도 돌려준다
+	bool IntersectRay(const FRay& InLocalRay, float& OutHitDistance, FVector& OutHitNormal) const;
+	// LocalBounds 와 겹치는 삼각형의 세 꼭짓점(로컬 공간)을 OutVertices 뒤에 3개씩 붙인다 (스윕의 좁은 단계용)
+	void GatherTriangles(const FAABB& LocalBounds, TArray<FVector>& OutVertices) const;
+
+	// 캐시에서 읽은 트리가 이 정점/인덱스 버퍼로 만든 것인지, 인덱스가 범위 안인지
+	bool IsValidFor(const TArray<FNormalVertex>& Vertices, const TArray<uint32>& Indices) const;
+
+	// SAH 비용: 노드 표면적 합 / 루트 표면적 (리프는 삼각형 수 가중). 낮을수록 레이 쿼리가 빠르다
+	float ComputeSAHCost() const;
+	int32 GetNumNodes() const { return Nodes.Num(); }
+	int32 GetNumTriangles() const { return TriIndices.Num(); }
 
+	friend FArchive& operator<<(FArchive& Ar, FMeshBVH& BVH)
+	{
+		uint32 Version = CacheVersion;
+		Ar << Version;
+		if (Ar.IsLoading() && Version != CacheVersion)
+		{
+			throw std::runtime_error("Mesh BVH cache version mismatch.");
+		}
+		Ar << BVH.SourceVertexCount;
+		Ar << BVH.SourceIndexCount;
+		Ar << BVH.MaxTraversalStack;
+
+		if (Ar.IsSaving())
+		{
+			Serialization::WriteArray(Ar, BVH.Nodes);
+			Serialization::WriteArray(Ar, BVH.TriIndices);
+			Serialization::WriteArray(Ar, BVH.WideNodes);
+			Serialization::WriteArray(Ar, BVH.TrianglePacks);
+		}
+		else if (Ar.IsLoading())
+		{
+			Serialization::ReadArray(Ar, BVH.Nodes);
+			Serialization::ReadArray(Ar, BVH.TriIndices);
+			Serialization::ReadArray(Ar, BVH.WideNodes);
+			Serialization::ReadArray(Ar, BVH.TrianglePacks);
+		}
+		return Ar;
+	}
 
 private:
 	// Helper 함수들
@@ -32,9 +121,13 @@ private:
 
 	FVector ComputeTriCenter(uint32 TriangleID, const TArray<FNormalVertex>& Vertices, const TArray<uint32>& Indices) const;
 
-	FAABB ComputeBounds(uint32 Start, uint32 Count, const TArray<FNormalVertex>& Vertices, const TArray<uint32>& Indices) const;
+	// [Start, Start + Count) 구간의 서브트리를 OutNodes 끝에 만들고 루트 인덱스를 반환 (자식 인덱스는 OutNodes 기준)
+	int BuildRecursive(const FMeshBVHBuildContext& Context, uint32 Start, uint32 Count, TArray<FMeshBVHNode>& OutNodes);
 
-	int BuildRecursive(uint32 Start, uint32 Count, const TArray<FNormalVertex>& Vertices, const TArray<uint32>& Indices);
+	// 이진 노드 BinaryIndex 아래를 4-ary 노드로 접는다. 새 노드 인덱스 반환
+	int32 CollapseNode(int32 BinaryIndex, const TArray<FNormalVertex>& Vertices, const TArray<uint32>& Indices, int32 Depth, int32& InOutMaxDepth);
+	// TriIndices[Start, Start + Count) 삼각형을 팩으로 풀어 TrianglePacks 끝에 추가. 추가한 팩 수 반환
+	uint32 AppendTrianglePacks(uint32 Start, uint32 Count, const TArray<FNormalVertex>& Vertices, const TArray<uint32>& Indices);
 
 private:
 
@@ -42,6 +135,13 @@ private:
 	//삼각형 ID(번호) 목록 , 삼각형의 인덱스를 의미한다. 
 	//삼각형 순서만 재배치  , 정점 좌표와 인덱스 버퍼를 직접적으로 건들면 안되기 때문이다.
 	TArray<uint32> TriIndices;
+	// 빌드에 사용한 버퍼 크기 (캐시 검증용)
+	uint32 SourceVertexCount = 0;
+	uint32 SourceIndexCount = 0;
+	// 레이 쿼리용 4-ary 트리 (루트 = 0)와 리프 삼각형 팩
+	TArray<FMeshBVH4Node> WideNodes;
+	TArray<FMeshBVHTrianglePack> TrianglePacks;
+	// 순회 스택 최대 깊이 (4-ary 깊이 * 3 + 1)
+	int32 MaxTraversalStack = 0;
 	const uint32 LeafSize = 4;
 };
-
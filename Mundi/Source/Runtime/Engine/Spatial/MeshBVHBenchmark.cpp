@@ -0,0 +1,148 @@
+﻿#include "pch.h"
+#include <random>
+#include <filesystem>
+#include "MeshBVH.h"
+#include "Benchmark.h"
+#include "WindowsBinReader.h"
+#include "WindowsBinWriter.h"
+
+namespace
+{
+	constexpr int32 GridSize = 400;       // 400 x 400 격자 -> 삼각형 약 32만 개
+	constexpr int32 NumRays = 100000;
+	constexpr int32 NumReferenceRays = 200;   // 전수 검사와 결과 비교할 레이 수
+	constexpr float CellSize = 1.0f;
+
+	// 높이가 고르지 않은 지형 + 한쪽 구석에 촘촘히 모인 작은 삼각형 (중앙값 분할이 불리한 분포)
+	void MakeTerrainMesh(TArray<FNormalVertex>& OutVertices, TArray<uint32>& OutIndices)
+	{
+		OutVertices.Reserve((GridSize + 1) * (GridSize + 1));
+		for (int32 Y = 0; Y <= GridSize; ++Y)
+		{
+			for (int32 X = 0; X <= GridSize; ++X)
+			{
+				// 앞쪽 1/4 에 정점을 몰아 넣는다
+				const float U = static_cast<float>(X) / GridSize;
+				const float Warp = U * U * U;
+				FNormalVertex Vertex{};
+				Vertex.pos = FVector(Warp * GridSize * CellSize, Y * CellSize, 8.0f * std::sin(X * 0.05f) * std::cos(Y * 0.07f));
+				OutVertices.Add(Vertex);
+			}
+		}
+
+		OutIndices.Reserve(GridSize * GridSize * 6);
+		for (int32 Y = 0; Y < GridSize; ++Y)
+		{
+			for (int32 X = 0; X < GridSize; ++X)
+			{
+				const uint32 I0 = Y * (GridSize + 1) + X;
+				const uint32 I1 = I0 + 1;
+				const uint32 I2 = I0 + (GridSize + 1);
+				const uint32 I3 = I2 + 1;
+				OutIndices.Add(I0); OutIndices.Add(I2); OutIndices.Add(I1);
+				OutIndices.Add(I1); OutIndices.Add(I2); OutIndices.Add(I3);
+			}
+		}
+	}
+}
+
+IMPLEMENT_BENCHMARK(MESHBVH, "Mesh BVH on a 320k triangle uneven terrain: binned SAH parallel build, 4-wide SIMD ray queries (rays/sec), .bvh.bin cache round trip")
+{
+	TArray<FNormalVertex> Vertices;
+	TArray<uint32> Indices;
+	MakeTerrainMesh(Vertices, Indices);
+
+	FMeshBVH BVH;
+	double BuildMs = 0.0;
+	{
+		FBenchTimer Timer;
+		BVH.Build(Vertices, Indices);
+		BuildMs = Timer.GetMs();
+	}
+
+	// 절반은 위에서 아래로 (피킹), 절반은 비스듬한 방향 (라인 트레이스)
+	std::mt19937 Random(1234);
+	std::uniform_real_distribution<float> Position(0.0f, GridSize * CellSize);
+	std::uniform_real_distribution<float> Slope(-1.0f, 1.0f);
+	TArray<FRay> Rays;
+	Rays.Reserve(NumRays);
+	for (int32 i = 0; i < NumRays; ++i)
+	{
+		FRay Ray;
+		Ray.Origin = FVector(Position(Random), Position(Random), 100.0f);
+		Ray.Direction = (i % 2 == 0) ? FVector(0.0f, 0.0f, -1.0f) : FVector(Slope(Random), Slope(Random), -0.5f).GetNormalized();
+		Rays.Add(Ray);
+	}
+
+	int32 NumHits = 0;
+	double QueryMs = 0.0;
+	{
+		FBenchTimer Timer;
+		for (const FRay& Ray : Rays)
+		{
+			float HitDistance = 0.0f;
+			NumHits += BVH.IntersectRay(Ray, HitDistance) ? 1 : 0;
+		}
+		QueryMs = Timer.GetMs();
+	}
+
+	// 정점 버퍼 전수 검사 (스칼라 Möller–Trumbore) 와 가장 가까운 히트 비교
+	int32 NumMismatches = 0;
+	double ReferenceMs = 0.0;
+	{
+		FBenchTimer Timer;
+		for (int32 i = 0; i < NumReferenceRays; ++i)
+		{
+			const FRay& Ray = Rays[i];
+			float ReferenceDistance = FLT_MAX;
+			for (int32 Index = 0; Index + 2 < Indices.Num(); Index += 3)
+			{
+				float HitDistance = 0.0f;
+				if (IntersectRayTriangleMT(Ray, Vertices[Indices[Index]].pos, Vertices[Indices[Index + 1]].pos, Vertices[Indices[Index + 2]].pos, HitDistance))
+				{
+					ReferenceDistance = std::min(ReferenceDistance, HitDistance);
+				}
+			}
+
+			float HitDistance = FLT_MAX;
+			const bool bHit = BVH.IntersectRay(Ray, HitDistance);
+			if (bHit != (ReferenceDistance < FLT_MAX) || (bHit && std::abs(HitDistance - ReferenceDistance) > 1e-3f))
+			{
+				++NumMismatches;
+			}
+		}
+		ReferenceMs = Timer.GetMs();
+	}
+
+	// 캐시 저장/로드 (메시 로드 시 빌드 대신 이 경로를 탄다)
+	const FString CachePath = (std::filesystem::temp_directory_path() / "MeshBVHBenchmark.bvh.bin").string();
+	double SaveMs = 0.0;
+	double LoadMs = 0.0;
+	bool bLoadedValid = false;
+	{
+		FBenchTimer Timer;
+		FWindowsBinWriter Writer(CachePath);
+		Writer << BVH;
+		Writer.Close();
+		SaveMs = Timer.GetMs();
+	}
+	{
+		FBenchTimer Timer;
+		FMeshBVH Loaded;
+		FWindowsBinReader Reader(CachePath);
+		Reader << Loaded;
+		Reader.Close();
+		bLoadedValid = Loaded.IsValidFor(Vertices, Indices);
+		LoadMs = Timer.GetMs();
+	}
+	std::filesystem::remove(CachePath);
+
+	UE_LOG("[Bench] MeshBVH build   : %d triangles in %.2fms | %d nodes | SAH %.2f",
+		BVH.GetNumTriangles(), BuildMs, BVH.GetNumNodes(), BVH.ComputeSAHCost());
+	UE_LOG("[Bench] MeshBVH query   : %d rays %.3fms (%d hits) | %.2f Mrays/s",
+		NumRays, QueryMs, NumHits, QueryMs > 0.0 ? NumRays / (QueryMs * 1000.0) : 0.0);
+	UE_LOG("[Bench] MeshBVH verify  : %d rays vs brute force %.2fms | %d mismatches",
+		NumReferenceRays, ReferenceMs, NumMismatches);
+	UE_LOG("[Bench] MeshBVH cache   : save %.2fms | load+validate %.2fms (%s) | x%.1f faster than build",
+		SaveMs, LoadMs, bLoadedValid ? "valid" : "INVALID", LoadMs > 0.0 ? BuildMs / LoadMs : 0.0);
+}
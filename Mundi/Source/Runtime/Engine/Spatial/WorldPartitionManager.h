@@ -12,6 +12,9 @@ class FBVHierarchy;
 struct FRay;
 struct FAABB;
 struct FFrustum;
+struct FCollisionQuery;
+struct FCollisionQueryResult;
+struct FQueryHit;
 
 class UWorldPartitionManager : public UObject
 {
@@ -34,9 +37,18 @@ public:
 	void MarkDirty(UPrimitiveComponent* Smc);
 
 	void Update(float DeltaTime, const uint32 BudgetCount = 256);
+	// 더티 큐에 남아 BVH 바운드가 아직 갱신되지 않은 컴포넌트인지 (컬링 시 보이는 것으로 취급)
+	bool IsPendingUpdate(UPrimitiveComponent* Component) const { return ComponentDirtySet.Contains(Component); }
 
     //void RayQueryOrdered(FRay InRay, OUT TArray<std::pair<AActor*, float>>& Candidates);
     void RayQueryClosest(FRay InRay, OUT AActor*& OutActor, OUT float& OutBestT);
+
+	// 레이/스윕 쿼리 (CollisionQuery.h). BVH 는 마지막 Update 시점의 바운드 기준
+	bool SweepQuery(const FCollisionQuery& Query, OUT FCollisionQueryResult& OutResult) const;
+	// Start -> End 위의 모든 히트 (거리순)
+	bool RayQueryMulti(const FVector& Start, const FVector& End, OUT TArray<FQueryHit>& OutHits, const AActor* IgnoredActor = nullptr) const;
+	// 여러 쿼리를 잡 시스템 워커로 나눠 동시에 처리. OutResults[i] = Queries[i] 의 결과
+	void SweepQueryBatch(const TArray<FCollisionQuery>& Queries, OUT TArray<FCollisionQueryResult>& OutResults) const;
 	void FrustumQuery(FFrustum InFrustum);
 
 	/** 옥트리 게터 */
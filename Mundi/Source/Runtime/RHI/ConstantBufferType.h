@@ -51,9 +51,10 @@ struct PostProcessBufferType // b0
 };
 
 // b5 VS
+// affine 3x4 행렬 (48바이트). 4x4 대비 업로드 크기 25% 감소
 struct FSkinningMatrixBufferType
 {
-    FMatrix SkinningMatrices[1000];
+    FMatrix3x4 SkinningMatrices[1000];
 };
 
 struct FogBufferType // b2
@@ -204,7 +205,8 @@ struct FTileCullingBufferType
     uint32 bUseTileCulling;   // 타일 컬링 활성화 여부 (0=비활성화, 1=활성화)
     uint32 ViewportStartX;    // 뷰포트 시작 X 좌표
     uint32 ViewportStartY;    // 뷰포트 시작 Y 좌표
-    uint32 Padding[2];
+    float DepthSliceScale;    // 깊이 슬라이스 = log2(ViewDepth) * Scale + Bias (FTileLightCuller)
+    float DepthSliceBias;
 };
 
 struct FPointLightShadowBufferType
@@ -137,13 +137,13 @@ public:
 	}
 
 	// 기존의 구조체 전달 방식은 SkinningMatrix같은 대용량 버퍼를 전달하기에 적합하지 않음(힙에서 스택으로 64KB 복사됨)
-	// 그래서 따로 만듦.
-	void ConstantBufferUpdateForMatrixArray(ID3D11Buffer* ConstantBuffer, const TArray<FMatrix>& Data, const uint32 Slot, const bool bIsVS, const bool bIsPS)
+	// 그래서 따로 만듦. 행렬은 affine 3x4 (셰이더의 row_major float3x4)
+	void ConstantBufferUpdateForMatrixArray(ID3D11Buffer* ConstantBuffer, const TArray<FMatrix3x4>& Data, const uint32 Slot, const bool bIsVS, const bool bIsPS)
 	{
 		D3D11_MAPPED_SUBRESOURCE MSR;
 
 		DeviceContext->Map(ConstantBuffer, 0, D3D11_MAP_WRITE_DISCARD, 0, &MSR);
-		memcpy(MSR.pData, Data.data(), sizeof(FMatrix) * Data.Num());
+		memcpy(MSR.pData, Data.data(), sizeof(FMatrix3x4) * Data.Num());
 		DeviceContext->Unmap(ConstantBuffer, 0);
 
 		ConstantBufferSet(ConstantBuffer, Slot, bIsVS, bIsPS);
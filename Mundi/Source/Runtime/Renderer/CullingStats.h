@@ -0,0 +1,97 @@
+﻿#pragma once
+#include "UEContainer.h"
+
+// 뷰 하나의 절두체 컬링 결과 (메시 단위)
+struct FCullingViewStats
+{
+	const char* Name = "";
+	int32 SubViewIndex = 0;   // 그림자 뷰: 큐브 면(0~5) / 캐스케이드 인덱스
+	uint32 NumVisible = 0;
+	uint32 NumCulled = 0;
+};
+
+// 프레임의 뷰별 절두체 컬링 통계
+// 메인 뷰 + 그림자 뷰(라이트 요청 하나당 하나)
+struct FCullingStats
+{
+	FCullingViewStats MainView;
+	TArray<FCullingViewStats> ShadowViews;
+
+	// 그림자 뷰 합계
+	uint32 TotalShadowVisible = 0;
+	uint32 TotalShadowCulled = 0;
+
+	// 컬링 작업 시간 (메인 뷰는 수집과 겹쳐서 실행되므로 대기 시간만 측정)
+	float MainViewWaitMS = 0.0f;
+	float ShadowViewCullMS = 0.0f;
+
+	// 모든 통계를 0으로 리셋
+	void Reset()
+	{
+		MainView = FCullingViewStats();
+		ShadowViews.Empty();
+		TotalShadowVisible = 0;
+		TotalShadowCulled = 0;
+		MainViewWaitMS = 0.0f;
+		ShadowViewCullMS = 0.0f;
+	}
+
+	// 그림자 뷰 합계 계산
+	void CalculateTotal()
+	{
+		TotalShadowVisible = 0;
+		TotalShadowCulled = 0;
+		for (const FCullingViewStats& ViewStats : ShadowViews)
+		{
+			TotalShadowVisible += ViewStats.NumVisible;
+			TotalShadowCulled += ViewStats.NumCulled;
+		}
+	}
+};
+
+// 절두체 컬링 통계 전역 매니저 (싱글톤)
+// UStatsOverlayD2D에서 접근할 수 있도록 전역 통계 제공
+class FCullingStatManager
+{
+public:
+	static FCullingStatManager& GetInstance()
+	{
+		static FCullingStatManager Instance;
+		return Instance;
+	}
+
+	// 메인 뷰 통계 업데이트 (GatherVisibleProxies)
+	void UpdateMainViewStats(const FCullingViewStats& InStats, float InWaitMS)
+	{
+		CurrentStats.MainView = InStats;
+		CurrentStats.MainViewWaitMS = InWaitMS;
+	}
+
+	// 그림자 뷰 통계 업데이트 (RenderShadowMaps)
+	void UpdateShadowViewStats(const TArray<FCullingViewStats>& InViews, float InCullMS)
+	{
+		CurrentStats.ShadowViews = InViews;
+		CurrentStats.ShadowViewCullMS = InCullMS;
+		CurrentStats.CalculateTotal();
+	}
+
+	// 통계 조회
+	const FCullingStats& GetStats() const
+	{
+		return CurrentStats;
+	}
+
+	// 통계 리셋
+	void ResetStats()
+	{
+		CurrentStats.Reset();
+	}
+
+private:
+	FCullingStatManager() = default;
+	~FCullingStatManager() = default;
+	FCullingStatManager(const FCullingStatManager&) = delete;
+	FCullingStatManager& operator=(const FCullingStatManager&) = delete;
+
+	FCullingStats CurrentStats;
+};
@@ -0,0 +1,143 @@
+﻿#include "pch.h"
+#include "Benchmark.h"
+#include "StaticMeshComponent.h"
+#include "SkinnedMeshComponent.h"
+#include "BillboardComponent.h"
+#include "DecalComponent.h"
+#include "LineComponent.h"
+#include "HeightFogComponent.h"
+#include "DirectionalLightComponent.h"
+#include "AmbientLightComponent.h"
+#include "PointLightComponent.h"
+#include "SpotLightComponent.h"
+
+namespace
+{
+	constexpr int32 NumComponents = 50000;
+	constexpr int32 NumFrames = 20;
+
+	// 이전 UClass::IsChildOf (Super 체인 선형 탐색)
+	struct FSuperChainIsA
+	{
+		bool operator()(const UObject* Obj, const UClass* Base) const
+		{
+			for (const UClass* C = Obj->GetClass(); C; C = C->Super)
+			{
+				if (C == Base) return true;
+			}
+			return false;
+		}
+	};
+
+	// 현재 UClass::IsChildOf (DFS 구간 비교)
+	struct FClassTreeIsA
+	{
+		bool operator()(const UObject* Obj, const UClass* Base) const
+		{
+			return Obj->IsA(Base);
+		}
+	};
+
+	struct FGatherCounts
+	{
+		uint64 Meshes = 0;
+		uint64 Billboards = 0;
+		uint64 Decals = 0;
+		uint64 Lines = 0;
+		uint64 Fogs = 0;
+		uint64 Lights = 0;
+	};
+
+	// FSceneRenderer::GatherVisibleProxies 의 컴포넌트 분류 Cast 체인과 같은 순서
+	template<typename TIsA>
+	void Classify(const TArray<USceneComponent*>& Components, FGatherCounts& Counts)
+	{
+		const TIsA IsA;
+		for (USceneComponent* Component : Components)
+		{
+			if (IsA(Component, UPrimitiveComponent::StaticClass()))
+			{
+				if (IsA(Component, UMeshComponent::StaticClass()))
+				{
+					if (IsA(Component, UStaticMeshComponent::StaticClass()) || IsA(Component, USkinnedMeshComponent::StaticClass()))
+					{
+						++Counts.Meshes;
+					}
+				}
+				else if (IsA(Component, UBillboardComponent::StaticClass()))
+				{
+					++Counts.Billboards;
+				}
+				else if (IsA(Component, UDecalComponent::StaticClass()))
+				{
+					++Counts.Decals;
+				}
+				else if (IsA(Component, ULineComponent::StaticClass()))
+				{
+					++Counts.Lines;
+				}
+			}
+			else if (IsA(Component, UHeightFogComponent::StaticClass()))
+			{
+				++Counts.Fogs;
+			}
+			else if (IsA(Component, UDirectionalLightComponent::StaticClass())
+				|| IsA(Component, UAmbientLightComponent::StaticClass()))
+			{
+				++Counts.Lights;
+			}
+			else if (IsA(Component, UPointLightComponent::StaticClass()))
+			{
+				Counts.Lights += IsA(Component, USpotLightComponent::StaticClass()) ? 2 : 1;
+			}
+		}
+	}
+
+	template<typename TIsA>
+	double RunFrames(const TArray<USceneComponent*>& Components, FGatherCounts& Counts)
+	{
+		FBenchTimer Timer;
+		for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+		{
+			Classify<TIsA>(Components, Counts);
+		}
+		return Timer.GetMs() / NumFrames;
+	}
+}
+
+IMPLEMENT_BENCHMARK(GATHER, "GatherVisibleProxies component classification on 50k components: Super chain walk vs class tree intervals")
+{
+	// 메시 위주 씬에 빌보드/데칼/라이트를 섞는다
+	TArray<USceneComponent*> Components;
+	Components.Reserve(NumComponents);
+	for (int32 i = 0; i < NumComponents; ++i)
+	{
+		switch (i % 20)
+		{
+		case 0:  Components.Add(NewObject<UBillboardComponent>()); break;
+		case 1:  Components.Add(NewObject<UDecalComponent>()); break;
+		case 2:  Components.Add(NewObject<UPointLightComponent>()); break;
+		case 3:  Components.Add(NewObject<USpotLightComponent>()); break;
+		case 4:  Components.Add(NewObject<USceneComponent>()); break;
+		default: Components.Add(NewObject<UStaticMeshComponent>()); break;
+		}
+	}
+
+	FGatherCounts ChainCounts;
+	FGatherCounts TreeCounts;
+	const double ChainMs = RunFrames<FSuperChainIsA>(Components, ChainCounts);
+	const double TreeMs = RunFrames<FClassTreeIsA>(Components, TreeCounts);
+
+	const bool bMatch = ChainCounts.Meshes == TreeCounts.Meshes && ChainCounts.Lights == TreeCounts.Lights
+		&& ChainCounts.Billboards == TreeCounts.Billboards && ChainCounts.Decals == TreeCounts.Decals;
+	BenchmarkKeep(TreeCounts.Meshes + TreeCounts.Lights + ChainCounts.Meshes);
+
+	UE_LOG("[Bench] Gather %d comps/frame: super chain %.3fms | class tree %.3fms  x%.2f %s",
+		NumComponents, ChainMs, TreeMs, TreeMs > 0.0 ? ChainMs / TreeMs : 0.0, bMatch ? "" : "(MISMATCH)");
+
+	for (USceneComponent* Component : Components)
+	{
+		ObjectFactory::DeleteObject(Component);
+	}
+	ObjectFactory::CompactNullSlots();
+}
@@ -35,6 +35,8 @@ public:
     // Tile-based light culling
     void SetTileSize(uint32 Value) { TileSize = Value; }
     uint32 GetTileSize() const { return TileSize; }
+    void SetTileDepthBounds(bool bValue) { bTileDepthBounds = bValue; }
+    bool IsTileDepthBoundsEnabled() const { return bTileDepthBounds; }
 
     // 그림자 안티 에일리어싱
     void SetShadowAATechnique(EShadowAATechnique In) { ShadowAATechnique = In; }
@@ -52,6 +54,7 @@ private:
 
     // Tile-based light culling
     uint32 TileSize = 16;                   // 타일 크기 (픽셀, 기본값: 16)
+    bool bTileDepthBounds = true;           // 깊이 슬라이스로 라이트를 한 번 더 거름
 
     // 그림자 안티 에일리어싱
     EShadowAATechnique ShadowAATechnique = EShadowAATechnique::PCF; // 기본값 PCF
@@ -48,6 +48,8 @@
 #include "PostProcessing/VignettePass.h"
 #include "FbxLoader.h"
 #include "SkinnedMeshComponent.h"
+#include "CullingStats.h"
+#include "JobSystem.h"
 
 FSceneRenderer::FSceneRenderer(UWorld* InWorld, FSceneView* InView, URenderer* InOwnerRenderer)
 	: World(InWorld)
@@ -234,18 +236,56 @@ void FSceneRenderer::RenderSceneDepthPath()
 // 그림자맵 구현
 //====================================================================================
 
+namespace
+{
+	// 그림자 캐스터 하나의 배치 구간과 컬링 슬롯
+	struct FShadowCasterRange
+	{
+		int32 Slot;
+		int32 BatchBegin;
+		int32 BatchEnd;
+	};
+
+	// 그림자 뷰 하나에서 보이는 캐스터의 배치만 골라 담는다
+	void FilterShadowBatches(const TArray<FMeshBatchElement>& InBatches, const TArray<FShadowCasterRange>& InCasters,
+		const FVisibilityBitset& Visibility, TArray<FMeshBatchElement>& OutBatches, FCullingViewStats& OutStats)
+	{
+		OutBatches.clear();
+		for (const FShadowCasterRange& Caster : InCasters)
+		{
+			if (Caster.Slot >= 0 && !Visibility.IsVisible(Caster.Slot))
+			{
+				++OutStats.NumCulled;
+				continue;
+			}
+			++OutStats.NumVisible;
+			OutBatches.insert(OutBatches.end(), InBatches.begin() + Caster.BatchBegin, InBatches.begin() + Caster.BatchEnd);
+		}
+	}
+
+	const char* GetShadowViewName(const FShadowRenderRequest& Request)
+	{
+		if (Cast<UDirectionalLightComponent>(Request.LightOwner)) return "Directional";
+		if (Cast<USpotLightComponent>(Request.LightOwner)) return "Spot";
+		return "Point";
+	}
+}
+
 void FSceneRenderer::RenderShadowMaps()
 {
     FLightManager* LightManager = World->GetLightManager();
 	if (!LightManager) return;
 
-	// 2. 그림자 캐스터(Caster) 메시 수집
+	// 2. 그림자 캐스터(Caster) 메시 수집 (메인 뷰에서 컬링된 메시 포함, 캐스터마다 배치 구간 기록)
 	TArray<FMeshBatchElement> ShadowMeshBatches;
-	for (UMeshComponent* MeshComponent : Proxies.Meshes)
+	TArray<FShadowCasterRange> ShadowCasterRanges;
+	for (UMeshComponent* MeshComponent : Proxies.ShadowCasters)
 	{
 		if (MeshComponent && MeshComponent->IsCastShadows() && MeshComponent->IsVisible())
 		{
+			const int32 BatchBegin = ShadowMeshBatches.Num();
 			MeshComponent->CollectMeshBatches(ShadowMeshBatches, View);
+			ShadowCasterRanges.Add({ GetCullingSlot(MeshComponent), BatchBegin, ShadowMeshBatches.Num() });
 		}
 	}
 
@@ -321,6 +361,7 @@ void FSceneRenderer::RenderShadowMaps()
 	if (!World->GetRenderSettings().IsShowFlagEnabled(EEngineShowFlags::SF_Shadows))
 	{
 		LightManager->ClearAllDepthStencilView(RHIDevice);
+		FCullingStatManager::GetInstance().UpdateShadowViewStats(TArray<FCullingViewStats>(), 0.0f);
 		return;
 	}
 
@@ -329,6 +370,34 @@ void FSceneRenderer::RenderShadowMaps()
 	// 2.2. 큐브맵 슬라이스 할당 (Allocate only)
 	LightManager->AllocateAtlasCubeSlices(RequestsCube); // FLightManager가 RequestsCube의 AssignedSliceIndex와 Size 업데이트
 
+	// 2.3. 그림자 뷰(요청)마다 절두체 컬링. 뷰별 비트셋이라 워커들이 동시에 채운다 (인덱스: 2D 요청 다음 큐브 요청)
+	const int32 NumViews2D = Requests2D.Num();
+	const int32 NumShadowViews = NumViews2D + RequestsCube.Num();
+	TArray<FVisibilityBitset> ShadowViewVisibility;
+	ShadowViewVisibility.SetNum(NumShadowViews);
+	const uint64 ShadowCullStart = FPlatformTime::Cycles64();
+	if (FBVHierarchy* BVH = World->GetPartitionManager() ? World->GetPartitionManager()->GetBVH() : nullptr)
+	{
+		FJobSystem::Get().ParallelFor(NumShadowViews, 1, [&](int32 Begin, int32 End)
+		{
+			for (int32 ViewIndex = Begin; ViewIndex < End; ++ViewIndex)
+			{
+				const FShadowRenderRequest& Request = ViewIndex < NumViews2D ? Requests2D[ViewIndex] : RequestsCube[ViewIndex - NumViews2D];
+				if (Request.Size == 0)
+				{
+					continue;
+				}
+				BVH->CullFrustum(CreateFrustumFromViewProjection(Request.ViewMatrix * Request.ProjectionMatrix), ShadowViewVisibility[ViewIndex]);
+			}
+		}, "ShadowViewCulling");
+	}
+	const float ShadowCullMS = static_cast<float>(FPlatformTime::ToMilliseconds(FPlatformTime::Cycles64() - ShadowCullStart));
+
+	TArray<FCullingViewStats> ShadowViewStats;
+	ShadowViewStats.SetNum(NumShadowViews);
+	TArray<FMeshBatchElement> ViewMeshBatches;
+	ViewMeshBatches.Reserve(ShadowMeshBatches.Num());
+
 	// --- 1단계: 2D 아틀라스 렌더링 (Spot + Directional) ---
 	{
 		ID3D11DepthStencilView* AtlasDSV2D = LightManager->GetShadowAtlasDSV2D();
@@ -363,14 +432,20 @@ void FSceneRenderer::RenderShadowMaps()
 			RHIDevice->RSSetState(ERasterizerMode::Shadows);
 			RHIDevice->OMSetDepthStencilState(EComparisonFunc::LessEqual);
 
-			for (FShadowRenderRequest& Request : Requests2D)
+			for (int32 ViewIndex = 0; ViewIndex < NumViews2D; ++ViewIndex)
 			{
+				FShadowRenderRequest& Request = Requests2D[ViewIndex];
+				FCullingViewStats& ViewStats = ShadowViewStats[ViewIndex];
+				ViewStats.Name = GetShadowViewName(Request);
+				ViewStats.SubViewIndex = Request.SubViewIndex;
+
 				// 뷰포트 설정
 				D3D11_VIEWPORT ShadowVP = { Request.AtlasViewportOffset.X, Request.AtlasViewportOffset.Y, static_cast<FLOAT>(Request.Size), static_cast<FLOAT>(Request.Size), 0.0f, 1.0f };
 				RHIDevice->GetDeviceContext()->RSSetViewports(1, &ShadowVP);
 
-				// 뎁스 패스 렌더링
-				RenderShadowDepthPass(Request, ShadowMeshBatches);
+				// 뎁스 패스 렌더링 (이 뷰에서 보이는 캐스터만)
+				FilterShadowBatches(ShadowMeshBatches, ShadowCasterRanges, ShadowViewVisibility[ViewIndex], ViewMeshBatches, ViewStats);
+				RenderShadowDepthPass(Request, ViewMeshBatches);
 
 				FShadowMapData Data;
 				if (Request.Size > 0) // 렌더링 성공
@@ -405,8 +480,14 @@ void FSceneRenderer::RenderShadowMaps()
 			RHIDevice->GetDeviceContext()->RSSetViewports(1, &ShadowVP);
 
 			// 이제 RequestsCube 배열을 직접 순회
-			for (FShadowRenderRequest& Request : RequestsCube) // 레퍼런스 유지
+			for (int32 CubeIndex = 0; CubeIndex < RequestsCube.Num(); ++CubeIndex)
 			{
+				FShadowRenderRequest& Request = RequestsCube[CubeIndex]; // 레퍼런스 유지
+				const int32 ViewIndex = NumViews2D + CubeIndex;
+				FCullingViewStats& ViewStats = ShadowViewStats[ViewIndex];
+				ViewStats.Name = GetShadowViewName(Request);
+				ViewStats.SubViewIndex = Request.SubViewIndex;
+
 				// 슬라이스 할당 실패는 FLightManager::Allocate... 함수가 처리 (Size=0 설정)
 				if (Request.Size == 0) // 할당 실패한 요청 건너뛰기
 				{
@@ -430,12 +511,15 @@ void FSceneRenderer::RenderShadowMaps()
 				{
 					RHIDevice->OMSetCustomRenderTargets(0, nullptr, FaceDSV);
 					RHIDevice->GetDeviceContext()->ClearDepthStencilView(FaceDSV, D3D11_CLEAR_DEPTH | D3D11_CLEAR_STENCIL, 1.0f, 0);
-					RenderShadowDepthPass(Request, ShadowMeshBatches);
+					FilterShadowBatches(ShadowMeshBatches, ShadowCasterRanges, ShadowViewVisibility[ViewIndex], ViewMeshBatches, ViewStats);
+					RenderShadowDepthPass(Request, ViewMeshBatches);
 				}
 			}
 		}
 	}
 
+	FCullingStatManager::GetInstance().UpdateShadowViewStats(ShadowViewStats, ShadowCullMS);
+
 	// --- 3. RHI 상태 복구 ---
 	RHIDevice->RSSetState(ERasterizerMode::Solid);
 	ID3D11RenderTargetView* nullRTV = nullptr;
@@ -607,9 +691,10 @@ void FSceneRenderer::PrepareView()
 
 void FSceneRenderer::GatherVisibleProxies()
 {
-	// NOTE: 일단 컴포넌트 단위와 데칼 관련 이슈 해결까지 컬링 무시
-	//// 절두체 컬링 수행 -> 결과가 멤버 변수 PotentiallyVisibleActors에 저장됨
-	//PerformFrustumCulling();
+	// 메인 뷰 절두체 컬링 -> 결과가 멤버 변수 MainViewVisibility에 저장됨
+	// 워커에서 BVH 를 순회하는 동안 아래 컴포넌트 수집을 진행하고, 메시 목록을 만든 뒤 결과를 기다린다
+	FJobCounter CullingCounter;
+	PerformFrustumCulling(CullingCounter);
 
 	const bool bDrawStaticMeshes = World->GetRenderSettings().IsShowFlagEnabled(EEngineShowFlags::SF_StaticMeshes);
 	const bool bDrawSkeletalMeshes = World->GetRenderSettings().IsShowFlagEnabled(EEngineShowFlags::SF_SkeletalMeshes);
@@ -739,6 +824,52 @@ void FSceneRenderer::GatherVisibleProxies()
 		CollectComponentsFromActor(Actor, false);
 	}
 
+	// 메인 뷰 컬링 결과로 메시 목록을 거른다 (그림자 캐스터 후보는 거르기 전 목록)
+	{
+		const uint64 WaitStart = FPlatformTime::Cycles64();
+		FJobSystem::Get().Wait(CullingCounter);
+		const float WaitMS = static_cast<float>(FPlatformTime::ToMilliseconds(FPlatformTime::Cycles64() - WaitStart));
+
+		// 라이트 시점으로 카메라를 덮어쓰면 화면이 메인 뷰 절두체와 달라지므로 거르지 않는다
+		bool bCullMainView = true;
+		if (FLightManager* LightManager = World->GetLightManager())
+		{
+			for (UDirectionalLightComponent* Light : LightManager->GetDirectionalLightList())
+			{
+				bCullMainView &= !Light->IsOverrideCameraLightPerspective();
+			}
+			for (USpotLightComponent* Light : LightManager->GetSpotLightList())
+			{
+				bCullMainView &= !Light->IsOverrideCameraLightPerspective();
+			}
+			for (UPointLightComponent* Light : LightManager->GetPointLightList())
+			{
+				bCullMainView &= !Light->IsOverrideCameraLightPerspective();
+			}
+		}
+
+		FCullingViewStats MainViewStats;
+		MainViewStats.Name = "Main";
+		Proxies.ShadowCasters.Reserve(Proxies.Meshes.Num());
+		int32 NumVisibleMeshes = 0;
+		for (int32 i = 0; i < Proxies.Meshes.Num(); ++i)
+		{
+			UMeshComponent* MeshComponent = Proxies.Meshes[i];
+			Proxies.ShadowCasters.Add(MeshComponent);
+
+			const int32 Slot = bCullMainView ? GetCullingSlot(MeshComponent) : -1;
+			if (Slot >= 0 && !MainViewVisibility.IsVisible(Slot))
+			{
+				++MainViewStats.NumCulled;
+				continue;
+			}
+			Proxies.Meshes[NumVisibleMeshes++] = MeshComponent;
+		}
+		Proxies.Meshes.SetNum(NumVisibleMeshes);
+		MainViewStats.NumVisible = static_cast<uint32>(NumVisibleMeshes);
+		FCullingStatManager::GetInstance().UpdateMainViewStats(MainViewStats, WaitMS);
+	}
+
 	// 라이트 통계 업데이트
 	FLightStats LightStats;
 	LightStats.TotalPointLights = SceneLocals.PointLights.Num();
@@ -816,7 +947,8 @@ void FSceneRenderer::PerformTileLightCulling()
 			View->NearClip,
 			View->FarClip,
 			ViewportWidth,
-			ViewportHeight
+			ViewportHeight,
+			RenderSettings.IsTileDepthBoundsEnabled()
 		);
 
 		// 통계를 전역 매니저에 업데이트
@@ -832,6 +964,8 @@ void FSceneRenderer::PerformTileLightCulling()
 	TileCullingBuffer.bUseTileCulling = bTileCullingEnabled ? 1 : 0;  // ShowFlag에 따라 설정
 	TileCullingBuffer.ViewportStartX = View->ViewRect.MinX;  // ShowFlag에 따라 설정
 	TileCullingBuffer.ViewportStartY = View->ViewRect.MinY;  // ShowFlag에 따라 설정
+	TileCullingBuffer.DepthSliceScale = bTileCullingEnabled ? TileLightCuller->GetDepthSliceScale() : 0.0f;
+	TileCullingBuffer.DepthSliceBias = bTileCullingEnabled ? TileLightCuller->GetDepthSliceBias() : 0.0f;
 
 	RHIDevice->SetAndUpdateConstantBuffer(TileCullingBuffer);
 
@@ -846,24 +980,41 @@ void FSceneRenderer::PerformTileLightCulling()
 	}
 }
 
-void FSceneRenderer::PerformFrustumCulling()
+void FSceneRenderer::PerformFrustumCulling(FJobCounter& OutCounter)
 {
-	PotentiallyVisibleComponents.clear();	// 할 필요 없는데 명목적으로 초기화
+	MainViewVisibility.Reset(0);
 
-	// Todo: 프로스텀 컬링 수행, 추후 프로스텀 컬링이 컴포넌트 단위로 변경되면 적용
+	UWorldPartitionManager* Partition = World->GetPartitionManager();
+	FBVHierarchy* BVH = Partition ? Partition->GetBVH() : nullptr;
+	if (!BVH)
+	{
+		return;
+	}
 
-	//World->GetPartitionManager()->FrustumQuery(ViewFrustum)
+	// BVH 갱신(파티션 Update)은 월드 틱에서만 일어나므로 렌더링 중에는 워커에서 읽기만 해도 안전
+	const FFrustum ViewFrustum = View->ViewFrustum;
+	FJobSystem::Get().Run([this, BVH, ViewFrustum]()
+	{
+		BVH->CullFrustum(ViewFrustum, MainViewVisibility);
+	}, &OutCounter, "MainViewCulling");
+}
 
-	//for (AActor* Actor : World->GetActors())
-	//{
-	//	if (!Actor || Actor->GetActorHiddenInEditor()) continue;
+int32 FSceneRenderer::GetCullingSlot(UMeshComponent* MeshComponent) const
+{
+	// 스켈레탈 메시는 월드 AABB 가 아직 없어(빈 박스) 컬링하지 않는다
+	if (!MeshComponent || !MeshComponent->IsA(UStaticMeshComponent::StaticClass()))
+	{
+		return -1;
+	}
 
-	//	// 절두체 컬링을 통과한 액터만 목록에 추가
-	//	if (ViewFrustum.Intersects(Actor->GetBounds()))
-	//	{
-	//		PotentiallyVisibleActors.Add(Actor);
-	//	}
-	//}
+	UWorldPartitionManager* Partition = World->GetPartitionManager();
+	FBVHierarchy* BVH = Partition ? Partition->GetBVH() : nullptr;
+	// 더티 큐에 남아 있으면 BVH 바운드가 이전 위치라 믿을 수 없다
+	if (!BVH || Partition->IsPendingUpdate(MeshComponent))
+	{
+		return -1;
+	}
+	return BVH->GetComponentSlot(MeshComponent);
 }
 
 void FSceneRenderer::RenderOpaquePass(EViewMode InRenderViewMode)
@@ -938,11 +1089,11 @@ void FSceneRenderer::RenderDecalPass()
 		}
 
 		// Decal이 그려질 Primitives
-		TArray<UPrimitiveComponent*> TargetPrimitives;
+		TFrameArray<UPrimitiveComponent*> TargetPrimitives;
 
 		// 1. Decal의 World AABB와 충돌한 모든 StaticMeshComponent 쿼리
 		const FOBB DecalOBB = Decal->GetWorldOBB();
-		TArray<UPrimitiveComponent*> IntersectedStaticMeshComponents = BVH->QueryIntersectedComponents(DecalOBB);
+		TFrameArray<UPrimitiveComponent*> IntersectedStaticMeshComponents = BVH->QueryIntersectedComponents(DecalOBB);
 
 		// 2. 충돌한 모든 visible Actor의 PrimitiveComponent를 TargetPrimitives에 추가
 		// Actor에 기본으로 붙어있는 TextRenderComponent, BoundingBoxComponent는 decal 적용 안되게 하기 위해,
@@ -1422,7 +1573,7 @@ void FSceneRenderer::DrawMeshBatches(TArray<FMeshBatchElement>& InMeshBatches, b
 		// GPU 스키닝 적용
 		if (Batch.SkinnedMeshComponent)
 		{
-			const TArray<FMatrix>& SkinningMatrices = Batch.SkinnedMeshComponent->GetFinalSkinningMatrices();
+			const TArray<FMatrix3x4>& SkinningMatrices = Batch.SkinnedMeshComponent->GetFinalSkinningMatrices();
 			TIME_PROFILE(SkinningTimeCPU)
 			// 기존의 구조체 전달 방식은 SkinningMatrix같은 대용량 버퍼를 전달하기에 적합하지 않음(힙에서 스택으로 64KB 복사됨)
 			// 그래서 따로 만듦.
@@ -1,5 +1,7 @@
 ﻿#pragma once
 #include "Frustum.h"
+#include "FrameArena.h"
+#include "BVHierarchy.h"
 
 // TODO : Post Processing 떼어내기, 전방선언으로라든지...
 #include "PostProcessing/FadeInOutPass.h"
@@ -28,39 +30,42 @@ class UGizmoArrowComponent;
 class FSceneView;
 class FTileLightCuller;
 class ULineComponent;
+class FJobCounter;
 
 struct FCandidateDrawable;
 
-// 렌더링할 대상들의 집합을 담는 구조체
+// 렌더링할 대상들의 집합을 담는 구조체 (매 프레임 다시 수집되므로 프레임 아레나 사용)
 struct FVisibleRenderProxySet
 {
 	// --- Type 1: Main Scene (PP O, Depth-Test O) ---
-	TArray<UMeshComponent*> Meshes;
-	TArray<UBillboardComponent*> Billboards; // 인게임 빌보드 (파티클, 잔디 등)
-	TArray<UDecalComponent*> Decals;
-	TArray<UTextRenderComponent*> Texts;
+	TFrameArray<UMeshComponent*> Meshes;
+	TFrameArray<UBillboardComponent*> Billboards; // 인게임 빌보드 (파티클, 잔디 등)
+	TFrameArray<UDecalComponent*> Decals;
+	TFrameArray<UTextRenderComponent*> Texts;
+	// 그림자 캐스터 후보 (메인 뷰 컬링 전 목록. 화면 밖 메시도 그림자는 드리운다)
+	TFrameArray<UMeshComponent*> ShadowCasters;
 
 	// --- Type 2: In-Scene Editor (PP X, Depth-Test O) ---
-	TArray<ULineComponent*> EditorLines;	// 그리드
-	TArray<UPrimitiveComponent*> EditorPrimitives; // 빛 기즈모, *에디터 아이콘 빌보드*
+	TFrameArray<ULineComponent*> EditorLines;	// 그리드
+	TFrameArray<UPrimitiveComponent*> EditorPrimitives; // 빛 기즈모, *에디터 아이콘 빌보드*
 
 	// --- Type 3: Overlay (PP X, Depth-Test X) ---
-	TArray<UPrimitiveComponent*> OverlayPrimitives; // 트랜스폼 기즈모
+	TFrameArray<UPrimitiveComponent*> OverlayPrimitives; // 트랜스폼 기즈모
 };
 
 struct FSceneLocals
 {
-	TArray<UPointLightComponent*> PointLights;
-	TArray<USpotLightComponent*> SpotLights;
+	TFrameArray<UPointLightComponent*> PointLights;
+	TFrameArray<USpotLightComponent*> SpotLights;
 };
 
 // NOTE: 추후 UWorld로 이동해서 등록/해지 방식으로 변경?
 // 전역 효과 및 설정을 담는 구조체
 struct FSceneGlobals
 {
-	TArray<UDirectionalLightComponent*> DirectionalLights;
-	TArray<UAmbientLightComponent*> AmbientLights;
-	TArray<UHeightFogComponent*> Fogs;	// 첫 번째로 찾은 Fog를 사용함
+	TFrameArray<UDirectionalLightComponent*> DirectionalLights;
+	TFrameArray<UAmbientLightComponent*> AmbientLights;
+	TFrameArray<UHeightFogComponent*> Fogs;	// 첫 번째로 찾은 Fog를 사용함
 };
 
 /**
@@ -91,8 +96,11 @@ private:
 	/** @brief 렌더링에 필요한 뷰 행렬, 절두체 등 프레임 데이터를 준비합니다. */
 	void PrepareView();
 
-	/** @brief 월드의 모든 액터를 대상으로 절두체 컬링을 수행합니다. */
-	void PerformFrustumCulling();
+	/** @brief 메인 뷰 절두체 컬링 작업을 잡 시스템에 예약합니다. 결과는 MainViewVisibility 에 기록됩니다. */
+	void PerformFrustumCulling(FJobCounter& OutCounter);
+
+	/** @brief 컬링에 쓸 BVH 리프 슬롯. 컬링 대상이 아니거나 BVH 에 아직 반영되지 않았으면 -1 (항상 보임) */
+	int32 GetCullingSlot(UMeshComponent* MeshComponent) const;
 
 	/** @brief 씬을 순회하며 컬링을 통과한 모든 렌더링 대상을 수집합니다. */
 	void GatherVisibleProxies();
@@ -141,8 +149,8 @@ private:
 	// 씬 전역 설정
 	FSceneGlobals SceneGlobals;
 
-	// 컬링을 거친 가시성 목록, NOTE: 추후 컴포넌트 단위로 수정
-	TArray<UPrimitiveComponent*> PotentiallyVisibleComponents;
+	// 메인 뷰 절두체 컬링 결과 (BVH 리프 슬롯 기준). 그림자 뷰는 RenderShadowMaps 에서 뷰마다 따로 만든다
+	FVisibilityBitset MainViewVisibility;
 
 	// 각 패스에서 수집된 드로우 콜 정보 리스트
 	TArray<FMeshBatchElement> MeshBatchElements;
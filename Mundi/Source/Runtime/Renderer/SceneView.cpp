@@ -39,6 +39,7 @@ FSceneView::FSceneView(FMinimalViewInfo* InMinimalViewInfo, URenderSettings* InR
 		InMinimalViewInfo->ZoomFactor,
 		InMinimalViewInfo->ProjectionMode
 	);
+	ViewFrustum = CreateFrustumFromViewProjection(ViewMatrix * ProjectionMatrix);
 
 	ViewShaderMacros = CreateViewShaderMacros();
 }
@@ -62,7 +63,7 @@ FSceneView::FSceneView(UCameraComponent* InCamera, FViewport* InViewport, URende
 
 	ViewMatrix = InCamera->GetViewMatrix();
 	ProjectionMatrix = InCamera->GetProjectionMatrix(AspectRatio, InViewport);
-	//ViewFrustum = CreateFrustumFromCamera(*InCamera, AspectRatio);
+	ViewFrustum = CreateFrustumFromViewProjection(ViewMatrix * ProjectionMatrix);
 	ViewLocation = InCamera->GetWorldLocation();
 	ViewRotation = InCamera->GetWorldRotation();
 	NearClip = InCamera->GetNearClip();
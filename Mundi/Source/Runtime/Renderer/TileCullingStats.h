@@ -27,7 +27,10 @@ struct FTileCullingStats
 
 	// 성능 메트릭
 	float ComputeShaderTimeMS = 0.0f;
-	uint32 LightIndexBufferSizeBytes = 0;
+	float CPUCullTimeMS = 0.0f;     // CPU 컬링 시간 (업로드 제외)
+	uint32 LightIndexBufferSizeBytes = 0;  // GPU 버퍼 용량
+	uint32 UploadBytesPerFrame = 0;        // 이번 프레임에 업로드한 크기 (그리드 + 인덱스 목록)
+	uint32 DepthSliceCount = 0;     // 깊이 슬라이스 수 (깊이 제한을 끄면 1)
 
 	// 시각화 모드
 	enum class EVisualizationMode : uint8
@@ -57,7 +60,10 @@ struct FTileCullingStats
 		TotalLightTests = 0;
 		TotalLightsPassed = 0;
 		ComputeShaderTimeMS = 0.0f;
+		CPUCullTimeMS = 0.0f;
 		LightIndexBufferSizeBytes = 0;
+		UploadBytesPerFrame = 0;
+		DepthSliceCount = 0;
 	}
 
 	// 파생 통계 계산
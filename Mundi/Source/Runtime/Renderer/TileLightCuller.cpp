@@ -1,6 +1,64 @@
 ﻿#include "pch.h"
 #include "TileLightCuller.h"
+#include "JobSystem.h"
 #include <algorithm>
+#include <bit>
+#include <cfloat>
+#include <chrono>
+#include <climits>
+#include <cstring>
+#include <immintrin.h>
+
+namespace
+{
+	// 한 잡이 처리할 최소 타일 행 수
+	constexpr int32 MinRowsPerJob = 4;
+
+	// GPU log2 와의 오차로 경계 픽셀이 빠지지 않도록 라이트 깊이 범위를 조금 넓힌다
+	constexpr float DepthRangePadding = 0.01f;
+
+	// 라이트 인덱스 워드는 16비트 인덱스를 쓴다
+	constexpr int32 MaxLightIndex = 0xFFFF;
+
+	// 버퍼가 모자라면 여유를 두고 키워 매 프레임 재생성을 피한다
+	constexpr float BufferGrowthFactor = 1.5f;
+
+	FVector Unproject(const FMatrix& InvProj, float NDCX, float NDCY, float NDCZ)
+	{
+		FVector4 Pos = FVector4(NDCX, NDCY, NDCZ, 1.0f) * InvProj;
+		Pos /= Pos.W;
+		return FVector(Pos.X, Pos.Y, Pos.Z);
+	}
+
+	// 세 점을 지나고 Inside 쪽이 양수인 평면 (xyz = 법선, w = 거리)
+	FVector4 MakePlane(const FVector& A, const FVector& B, const FVector& C, const FVector& Inside)
+	{
+		FVector Normal = FVector::Cross(B - A, C - A).GetSafeNormal();
+		float Distance = -FVector::Dot(Normal, A);
+		if (FVector::Dot(Normal, Inside) + Distance < 0.0f)
+		{
+			Normal = -Normal;
+			Distance = -Distance;
+		}
+		return FVector4(Normal.X, Normal.Y, Normal.Z, Distance);
+	}
+
+	// 4 레인 구간 포함 테스트: First <= Value <= Last
+	inline int32 RangeContainsMask(__m128i First, __m128i Last, __m128i Value)
+	{
+		const __m128i Outside = _mm_or_si128(_mm_cmpgt_epi32(First, Value), _mm_cmpgt_epi32(Value, Last));
+		return ~_mm_movemask_ps(_mm_castsi128_ps(Outside)) & 0xF;
+	}
+
+	void PadTo4(TArray<int32>& First, TArray<int32>& Last)
+	{
+		while (First.Num() & 3)
+		{
+			First.Add(INT_MAX);
+			Last.Add(INT_MIN);
+		}
+	}
+}
 
 FTileLightCuller::FTileLightCuller()
 	: RHI(nullptr)
@@ -34,8 +92,11 @@ void FTileLightCuller::CullLights(
 	float NearPlane,
 	float FarPlane,
 	UINT ViewportWidth,
-	UINT ViewportHeight)
+	UINT ViewportHeight,
+	bool bDepthBounds)
 {
+	const auto CullStart = std::chrono::high_resolution_clock::now();
+
 	// 타일 그리드 계산
 	TileCountX = (ViewportWidth + TileSize - 1) / TileSize;
 	TileCountY = (ViewportHeight + TileSize - 1) / TileSize;
@@ -50,350 +111,409 @@ void FTileLightCuller::CullLights(
 	Stats.TotalSpotLights = SpotLights.Num();
 	Stats.TotalLights = PointLights.Num() + SpotLights.Num();
 
-	// 타일 라이트 인덱스 버퍼 크기 재조정
-	UINT RequiredSize = TotalTileCount * MaxLightsPerTile;
-	if (TileLightIndices.Num() != RequiredSize)
+	// 그리드 구간. 1패스에서는 타일별 라이트 개수만 적는다
+	TileLightData.SetNum(TotalTileCount);
+	RowLightIndices.resize(TileCountY);
+	RowIndexOffsets.SetNum(TileCountY);
+
+	// 1) 라이트를 뷰 공간으로 한 번만 변환
+	PrepareLights(PointLights, SpotLights, ViewMatrix, ProjMatrix, NearPlane, FarPlane, bDepthBounds);
+	Stats.DepthSliceCount = bDepthBounds && DepthSliceScale > 0.0f ? DepthSliceCount : 1;
+
+	// 2) 라이트별 겹치는 열/행 범위 (타일 옆면 테스트와 같음)
+	BuildBoundaryPlanes(ProjMatrix, ViewportWidth, ViewportHeight);
+	ComputeTileRanges(ColumnPlanes, LightFirstX, LightLastX);
+	ComputeTileRanges(RowPlanes, LightFirstY, LightLastY);
+
+	// 3) 1패스: 타일 행 단위로 병렬 컬링. 행마다 자기 목록과 그리드 구간에만 쓴다
+	RowLightsPassed.SetNum(TileCountY);
+	RowMinLights.SetNum(TileCountY);
+	RowMaxLights.SetNum(TileCountY);
+	FJobSystem::Get().ParallelFor(static_cast<int32>(TileCountY), MinRowsPerJob, [this](int32 Begin, int32 End)
 	{
-		TileLightIndices.SetNum(RequiredSize);
-	}
+		TArray<int32> RowLights;
+		TArray<int32> RowFirstX;
+		TArray<int32> RowLastX;
+		for (int32 TileY = Begin; TileY < End; ++TileY)
+		{
+			CullTileRow(static_cast<UINT>(TileY), RowLights, RowFirstX, RowLastX);
+		}
+	}, "TileLightCulling");
 
-	// 버퍼 초기화 (모든 타일의 라이트 개수를 0으로)
-	memset(TileLightIndices.GetData(), 0, RequiredSize * sizeof(uint32));
+	// 4) 행 목록 길이의 prefix sum 으로 인덱스 목록에서의 행 시작 위치 결정
+	uint32 TotalIndices = 0;
+	for (UINT TileY = 0; TileY < TileCountY; ++TileY)
+	{
+		RowIndexOffsets[TileY] = TotalIndices;
+		TotalIndices += static_cast<uint32>(RowLightIndices[TileY].Num());
+	}
+	TileLightData.SetNum(TotalTileCount + TotalIndices);
 
-	// Inverse View-Projection 행렬 계산
-	FMatrix InvViewProj = ProjMatrix.InversePerspectiveProjection() * ViewMatrix.InverseAffine();
+	// 5) 2패스: 행 목록을 한 배열로 모으고 그리드에 (시작 위치, 개수) 기록
+	FJobSystem::Get().ParallelFor(static_cast<int32>(TileCountY), MinRowsPerJob, [this](int32 Begin, int32 End)
+	{
+		for (int32 TileY = Begin; TileY < End; ++TileY)
+		{
+			PackTileRow(static_cast<UINT>(TileY));
+		}
+	}, "TileLightPacking");
 
-	// 각 타일에 대해 컬링 수행
-	Stats.MinLightsPerTile = UINT_MAX;
+	// 통계 업데이트 (테스트 수는 타일 x 라이트 조합 기준)
+	Stats.MinLightsPerTile = TileCountY > 0 ? UINT_MAX : 0;
 	Stats.MaxLightsPerTile = 0;
-	uint32 TotalLightsAcrossAllTiles = 0;
-
 	for (UINT TileY = 0; TileY < TileCountY; ++TileY)
 	{
-		for (UINT TileX = 0; TileX < TileCountX; ++TileX)
-		{
-			UINT TileIndex = TileY * TileCountX + TileX;
-			UINT TileDataOffset = TileIndex * MaxLightsPerTile;
-
-			// 타일 프러스텀 생성
-			FFrustum Frustum = CreateTileFrustum(TileX, TileY, InvViewProj, NearPlane, FarPlane);
-
-			uint32 LightCount = 0;
-
-			// Point Light 테스트
-			for (int32 i = 0; i < PointLights.Num() && LightCount < MaxLightsPerTile - 1; ++i)
-			{
-				Stats.TotalLightTests++;
-
-				if (TestPointLightAgainstFrustum(PointLights[i], Frustum, ViewMatrix))
-				{
-					// 라이트 인덱스 저장 (상위 16비트: 타입(0=Point), 하위 16비트: 인덱스)
-					TileLightIndices[TileDataOffset + 1 + LightCount] = i;
-					LightCount++;
-					Stats.TotalLightsPassed++;
-				}
-			}
+		Stats.TotalLightsPassed += RowLightsPassed[TileY];
+		Stats.MinLightsPerTile = FMath::Min(Stats.MinLightsPerTile, RowMinLights[TileY]);
+		Stats.MaxLightsPerTile = FMath::Max(Stats.MaxLightsPerTile, RowMaxLights[TileY]);
+	}
+	Stats.TotalLightTests = TotalTileCount * Stats.TotalLights;
 
-			// Spot Light 테스트
-			for (int32 i = 0; i < SpotLights.Num() && LightCount < MaxLightsPerTile - 1; ++i)
-			{
-				Stats.TotalLightTests++;
-
-				if (TestSpotLightAgainstFrustum(SpotLights[i], Frustum, ViewMatrix))
-				{
-					// 라이트 인덱스 저장 (상위 16비트: 타입(1=Spot), 하위 16비트: 인덱스)
-					TileLightIndices[TileDataOffset + 1 + LightCount] = (1 << 16) | i;
-					LightCount++;
-					Stats.TotalLightsPassed++;
-				}
-			}
+	// 평균, 컬링 효율성 계산
+	Stats.CalculateStats();
 
-			// 첫 번째 요소에 라이트 개수 저장
-			TileLightIndices[TileDataOffset] = LightCount;
+	const auto CullEnd = std::chrono::high_resolution_clock::now();
+	Stats.CPUCullTimeMS = std::chrono::duration<float, std::milli>(CullEnd - CullStart).count();
 
-			// 통계 업데이트
-			Stats.MinLightsPerTile = FMath::Min(Stats.MinLightsPerTile, LightCount);
-			Stats.MaxLightsPerTile = FMath::Max(Stats.MaxLightsPerTile, LightCount);
-			TotalLightsAcrossAllTiles += LightCount;
-		}
-	}
+	UploadLightData();
+}
 
-	// 평균 계산
-	if (TotalTileCount > 0)
+void FTileLightCuller::UploadLightData()
+{
+	const UINT RequiredSize = static_cast<UINT>(TileLightData.Num());
+	if (RequiredSize == 0)
 	{
-		Stats.AvgLightsPerTile = static_cast<float>(TotalLightsAcrossAllTiles) / static_cast<float>(TotalTileCount);
+		return;
 	}
 
-	// 컬링 효율성 계산
-	Stats.CalculateStats();
-
-	// GPU 버퍼 생성 또는 업데이트
-	if (!LightIndexBuffer)
+	// 용량이 모자랄 때만 다시 만든다 (SRV 도 버퍼 크기에 묶여 있으므로 함께)
+	if (!LightIndexBuffer || RequiredSize > BufferCapacity)
 	{
-		// 버퍼 생성
+		Release();
+
+		const UINT NewCapacity = static_cast<UINT>(static_cast<float>(RequiredSize) * BufferGrowthFactor);
 		HRESULT hr = RHI->CreateStructuredBuffer(
 			sizeof(uint32),
-			RequiredSize,
-			TileLightIndices.GetData(),
+			NewCapacity,
+			nullptr,
 			&LightIndexBuffer
 		);
 
-		if (SUCCEEDED(hr))
+		if (FAILED(hr))
 		{
-			// SRV 생성
-			RHI->CreateStructuredBufferSRV(LightIndexBuffer, &LightIndexBufferSRV);
+			return;
 		}
 
-		Stats.LightIndexBufferSizeBytes = RequiredSize * sizeof(uint32);
-	}
-	else
-	{
-		// 기존 버퍼 업데이트
-		RHI->UpdateStructuredBuffer(
-			LightIndexBuffer,
-			TileLightIndices.GetData(),
-			RequiredSize * sizeof(uint32)
-		);
+		// SRV 생성
+		RHI->CreateStructuredBufferSRV(LightIndexBuffer, &LightIndexBufferSRV);
+		BufferCapacity = NewCapacity;
 	}
+
+	// 실제로 쓰는 크기만 업로드
+	RHI->UpdateStructuredBuffer(
+		LightIndexBuffer,
+		TileLightData.GetData(),
+		RequiredSize * sizeof(uint32)
+	);
+	Stats.UploadBytesPerFrame = RequiredSize * sizeof(uint32);
+	Stats.LightIndexBufferSizeBytes = BufferCapacity * sizeof(uint32);
 }
 
-FFrustum FTileLightCuller::CreateTileFrustum(
-	UINT TileX,
-	UINT TileY,
-	const FMatrix& InvViewProj,
+void FTileLightCuller::PrepareLights(
+	const TArray<FPointLightInfo>& PointLights,
+	const TArray<FSpotLightInfo>& SpotLights,
+	const FMatrix& ViewMatrix,
+	const FMatrix& ProjMatrix,
 	float NearPlane,
-	float FarPlane)
+	float FarPlane,
+	bool bDepthBounds)
 {
-	FFrustum Frustum;
-
-	// 타일의 NDC 좌표 계산
-	// NDC: [-1, 1] 범위, 왼쪽 아래가 (-1, -1), 오른쪽 위가 (1, 1)
-	// 주의: DirectX는 Y축이 위쪽이 양수
-
-	float TileMinX = static_cast<float>(TileX * TileSize);
-	float TileMaxX = static_cast<float>((TileX + 1) * TileSize);
-	float TileMinY = static_cast<float>(TileY * TileSize);
-	float TileMaxY = static_cast<float>((TileY + 1) * TileSize);
-
-	// 뷰포트 크기
-	float ViewportWidth = static_cast<float>(TileCountX * TileSize);
-	float ViewportHeight = static_cast<float>(TileCountY * TileSize);
-
-	// Screen Space -> NDC
-	float NDC_MinX = (TileMinX / ViewportWidth) * 2.0f - 1.0f;
-	float NDC_MaxX = (TileMaxX / ViewportWidth) * 2.0f - 1.0f;
-	float NDC_MinY = 1.0f - (TileMaxY / ViewportHeight) * 2.0f; // Y축 반전
-	float NDC_MaxY = 1.0f - (TileMinY / ViewportHeight) * 2.0f;
-
-	// 8개의 프러스텀 코너 (NDC 공간)
-	FVector4 FrustumCorners[8];
-
-	// Near plane corners
-	FrustumCorners[0] = FVector4(NDC_MinX, NDC_MinY, 0.0f, 1.0f);
-	FrustumCorners[1] = FVector4(NDC_MaxX, NDC_MinY, 0.0f, 1.0f);
-	FrustumCorners[2] = FVector4(NDC_MaxX, NDC_MaxY, 0.0f, 1.0f);
-	FrustumCorners[3] = FVector4(NDC_MinX, NDC_MaxY, 0.0f, 1.0f);
-
-	// Far plane corners
-	FrustumCorners[4] = FVector4(NDC_MinX, NDC_MinY, 1.0f, 1.0f);
-	FrustumCorners[5] = FVector4(NDC_MaxX, NDC_MinY, 1.0f, 1.0f);
-	FrustumCorners[6] = FVector4(NDC_MaxX, NDC_MaxY, 1.0f, 1.0f);
-	FrustumCorners[7] = FVector4(NDC_MinX, NDC_MaxY, 1.0f, 1.0f);
-
-	// NDC -> World Space 변환
-	FVector WorldCorners[8];
-	for (int i = 0; i < 8; ++i)
+	// 원근 투영에서만 클립 w 가 뷰 깊이 (직교 투영은 깊이 제한/근원 컬링 없이 보수적으로)
+	const bool bPerspective = std::abs(ProjMatrix.M[3][3]) < KINDA_SMALL_NUMBER && NearPlane > 0.0f && FarPlane > NearPlane;
+	if (bDepthBounds && bPerspective)
 	{
-		FVector4 WorldPos = FrustumCorners[i] * InvViewProj;
-		WorldPos /= WorldPos.W; // Perspective divide
-		WorldCorners[i] = FVector(WorldPos.X, WorldPos.Y, WorldPos.Z);
+		DepthSliceScale = static_cast<float>(DepthSliceCount) / std::log2(FarPlane / NearPlane);
+		DepthSliceBias = -std::log2(NearPlane) * DepthSliceScale;
 	}
-
-	// 프러스텀 평면 생성 (외향 법선)
-	// 평면 방정식: Normal · P + Distance = 0
-
-	// Left plane (점: 0, 3, 7)
+	else
 	{
-		FVector Edge1 = WorldCorners[3] - WorldCorners[0];
-		FVector Edge2 = WorldCorners[7] - WorldCorners[0];
-		FVector Normal = FVector::Cross(Edge1, Edge2).GetSafeNormal();
-		Frustum.LeftFace.Normal = FVector4(Normal.X, Normal.Y, Normal.Z, 0.0f);
-		Frustum.LeftFace.Distance = -FVector::Dot(Normal, WorldCorners[0]);
+		DepthSliceScale = 0.0f;
+		DepthSliceBias = 0.0f;
 	}
 
-	// Right plane (점: 1, 5, 6)
+	const int32 MaxLights = PointLights.Num() + SpotLights.Num();
+	NumCullLights = 0;
+	LightCenterX.clear();
+	LightCenterY.clear();
+	LightCenterZ.clear();
+	LightRadius.clear();
+	LightPackedIndex.clear();
+	LightCenterX.Reserve(MaxLights + 3);
+	LightCenterY.Reserve(MaxLights + 3);
+	LightCenterZ.Reserve(MaxLights + 3);
+	LightRadius.Reserve(MaxLights + 3);
+	LightPackedIndex.Reserve(MaxLights + 3);
+
+	auto ToView = [&ViewMatrix](const FVector& WorldPos)
 	{
-		FVector Edge1 = WorldCorners[5] - WorldCorners[1];
-		FVector Edge2 = WorldCorners[6] - WorldCorners[1];
-		FVector Normal = FVector::Cross(Edge1, Edge2).GetSafeNormal();
-		Frustum.RightFace.Normal = FVector4(Normal.X, Normal.Y, Normal.Z, 0.0f);
-		Frustum.RightFace.Distance = -FVector::Dot(Normal, WorldCorners[1]);
-	}
+		const FVector4 ViewPos = FVector4(WorldPos.X, WorldPos.Y, WorldPos.Z, 1.0f) * ViewMatrix;
+		return FVector(ViewPos.X, ViewPos.Y, ViewPos.Z);
+	};
 
-	// Bottom plane (점: 0, 1, 5)
+	// Point Light: 감쇠 반경 구
+	const int32 NumPoint = std::min(PointLights.Num(), MaxLightIndex + 1);
+	for (int32 i = 0; i < NumPoint; ++i)
 	{
-		FVector Edge1 = WorldCorners[1] - WorldCorners[0];
-		FVector Edge2 = WorldCorners[5] - WorldCorners[0];
-		FVector Normal = FVector::Cross(Edge1, Edge2).GetSafeNormal();
-		Frustum.BottomFace.Normal = FVector4(Normal.X, Normal.Y, Normal.Z, 0.0f);
-		Frustum.BottomFace.Distance = -FVector::Dot(Normal, WorldCorners[0]);
+		const FPointLightInfo& Light = PointLights[i];
+		AddLight(ToView(Light.Position), Light.AttenuationRadius, static_cast<uint32>(i), ProjMatrix, NearPlane, FarPlane, bPerspective);
 	}
 
-	// Top plane (점: 2, 3, 7)
+	// Spot Light: 원뿔(감쇠 반경, 바깥 반각)을 감싸는 최소 구
+	const int32 NumSpot = std::min(SpotLights.Num(), MaxLightIndex + 1);
+	for (int32 i = 0; i < NumSpot; ++i)
 	{
-		FVector Edge1 = WorldCorners[3] - WorldCorners[2];
-		FVector Edge2 = WorldCorners[7] - WorldCorners[2];
-		FVector Normal = FVector::Cross(Edge1, Edge2).GetSafeNormal();
-		Frustum.TopFace.Normal = FVector4(Normal.X, Normal.Y, Normal.Z, 0.0f);
-		Frustum.TopFace.Distance = -FVector::Dot(Normal, WorldCorners[2]);
+		const FSpotLightInfo& Light = SpotLights[i];
+		const float Height = Light.AttenuationRadius;
+		const float HalfAngle = DegreesToRadians(Light.OuterConeAngle);
+		const FVector Direction = Light.Direction.GetSafeNormal();
+
+		FVector Center = Light.Position;
+		float Radius = Height;
+		if (!Direction.IsZero() && HalfAngle < PI * 0.5f)
+		{
+			const float CosHalf = std::cos(HalfAngle);
+			if (HalfAngle > PI * 0.25f)
+			{
+				// 넓은 원뿔: 밑면 원이 지름
+				Center = Light.Position + Direction * (Height * CosHalf);
+				Radius = Height * std::sin(HalfAngle);
+			}
+			else
+			{
+				// 좁은 원뿔: 꼭지점과 밑면 가장자리를 지나는 구
+				Radius = Height / (2.0f * CosHalf);
+				Center = Light.Position + Direction * Radius;
+			}
+		}
+
+		const uint32 PackedIndex = (1u << LightTypeShift) | static_cast<uint32>(i);
+		AddLight(ToView(Center), Radius, PackedIndex, ProjMatrix, NearPlane, FarPlane, bPerspective);
 	}
 
-	// Near plane (점: 0, 1, 2)
+	// 4의 배수로 패딩 (반경이 음수라 모든 평면 테스트에서 밖으로 판정)
+	while (LightCenterX.Num() & 3)
 	{
-		FVector Edge1 = WorldCorners[1] - WorldCorners[0];
-		FVector Edge2 = WorldCorners[2] - WorldCorners[0];
-		FVector Normal = FVector::Cross(Edge1, Edge2).GetSafeNormal();
-		Frustum.NearFace.Normal = FVector4(Normal.X, Normal.Y, Normal.Z, 0.0f);
-		Frustum.NearFace.Distance = -FVector::Dot(Normal, WorldCorners[0]);
+		LightCenterX.Add(0.0f);
+		LightCenterY.Add(0.0f);
+		LightCenterZ.Add(0.0f);
+		LightRadius.Add(-FLT_MAX);
+		LightPackedIndex.Add(0);
 	}
+}
 
-	// Far plane (점: 4, 6, 5)
+void FTileLightCuller::AddLight(const FVector& ViewCenter, float Radius, uint32 PackedIndex, const FMatrix& ProjMatrix, float NearPlane, float FarPlane, bool bPerspective)
+{
+	uint32 MinSlice = 0;
+	uint32 MaxSlice = DepthSliceCount - 1;
+	if (bPerspective)
 	{
-		FVector Edge1 = WorldCorners[6] - WorldCorners[4];
-		FVector Edge2 = WorldCorners[5] - WorldCorners[4];
-		FVector Normal = FVector::Cross(Edge1, Edge2).GetSafeNormal();
-		Frustum.FarFace.Normal = FVector4(Normal.X, Normal.Y, Normal.Z, 0.0f);
-		Frustum.FarFace.Distance = -FVector::Dot(Normal, WorldCorners[4]);
+		// 클립 w = 뷰 깊이. 구의 깊이 범위가 근/원 평면 밖이면 어떤 타일에도 들지 않는다
+		const FVector DepthAxis(ProjMatrix.M[0][3], ProjMatrix.M[1][3], ProjMatrix.M[2][3]);
+		const float Depth = FVector::Dot(ViewCenter, DepthAxis) + ProjMatrix.M[3][3];
+		const float DepthExtent = Radius * DepthAxis.Size();
+		const float MinDepth = Depth - DepthExtent;
+		const float MaxDepth = Depth + DepthExtent;
+		if (MaxDepth < NearPlane || MinDepth > FarPlane)
+		{
+			return;
+		}
+
+		if (DepthSliceScale > 0.0f)
+		{
+			MinSlice = ComputeDepthSlice(std::max(MinDepth * (1.0f - DepthRangePadding), NearPlane));
+			MaxSlice = ComputeDepthSlice(std::min(MaxDepth * (1.0f + DepthRangePadding), FarPlane));
+		}
 	}
 
-	return Frustum;
+	LightCenterX.Add(ViewCenter.X);
+	LightCenterY.Add(ViewCenter.Y);
+	LightCenterZ.Add(ViewCenter.Z);
+	LightRadius.Add(Radius);
+	LightPackedIndex.Add(PackedIndex | (MinSlice << MinSliceShift) | (MaxSlice << MaxSliceShift));
+	++NumCullLights;
 }
 
-bool FTileLightCuller::TestPointLightAgainstFrustum(
-	const FPointLightInfo& Light,
-	const FFrustum& Frustum,
-	const FMatrix& ViewMatrix)
+uint32 FTileLightCuller::ComputeDepthSlice(float ViewDepth) const
 {
-	// Point Light는 구체로 근사
-	FVector LightPos = Light.Position;
-	float Radius = Light.AttenuationRadius;
-
-	return SphereIntersectsFrustum(LightPos, Radius, Frustum);
+	const float Slice = std::log2(std::max(ViewDepth, 1e-4f)) * DepthSliceScale + DepthSliceBias;
+	return static_cast<uint32>(std::clamp(Slice, 0.0f, static_cast<float>(DepthSliceCount - 1)));
 }
 
-bool FTileLightCuller::TestSpotLightAgainstFrustum(
-	const FSpotLightInfo& Light,
-	const FFrustum& Frustum,
-	const FMatrix& ViewMatrix)
+void FTileLightCuller::BuildBoundaryPlanes(const FMatrix& ProjMatrix, UINT ViewportWidth, UINT ViewportHeight)
 {
-	FVector LightPos = Light.Position;
-	float Radius = Light.AttenuationRadius;
+	// NDC: [-1, 1] 범위, 왼쪽 아래가 (-1, -1). 타일 Y 는 화면 위쪽부터 증가
+	// 셰이더가 뷰포트 기준 픽셀 좌표로 타일을 찾으므로 경계는 실제 뷰포트 크기로 나눈다
+	const FMatrix InvProj = ProjMatrix.Inverse();
+	const float Width = static_cast<float>(std::max(ViewportWidth, 1u));
+	const float Height = static_cast<float>(std::max(ViewportHeight, 1u));
+
+	ColumnPlanes.SetNum(TileCountX + 1);
+	for (UINT i = 0; i <= TileCountX; ++i)
+	{
+		const float NDCX = static_cast<float>(i * TileSize) / Width * 2.0f - 1.0f;
+		ColumnPlanes[i] = MakePlane(
+			Unproject(InvProj, NDCX, -1.0f, 0.0f),
+			Unproject(InvProj, NDCX, 1.0f, 0.0f),
+			Unproject(InvProj, NDCX, 1.0f, 0.5f),
+			Unproject(InvProj, NDCX + 1.0f, 0.0f, 0.5f));
+	}
 
-	// Spot Light도 구체로 근사
-	return SphereIntersectsFrustum(LightPos, Radius, Frustum);
+	RowPlanes.SetNum(TileCountY + 1);
+	for (UINT i = 0; i <= TileCountY; ++i)
+	{
+		const float NDCY = 1.0f - static_cast<float>(i * TileSize) / Height * 2.0f;
+		RowPlanes[i] = MakePlane(
+			Unproject(InvProj, -1.0f, NDCY, 0.0f),
+			Unproject(InvProj, 1.0f, NDCY, 0.0f),
+			Unproject(InvProj, 1.0f, NDCY, 0.5f),
+			Unproject(InvProj, 0.0f, NDCY - 1.0f, 0.5f));
+	}
 }
 
-bool FTileLightCuller::SphereIntersectsFrustum(
-	const FVector& Center,
-	float Radius,
-	const FFrustum& Frustum)
+void FTileLightCuller::ComputeTileRanges(const TArray<FVector4>& Planes, TArray<int32>& OutFirst, TArray<int32>& OutLast) const
 {
-	// 구체가 모든 평면의 앞쪽(양수)에 있으면 프러스텀 내부
-	// 하나라도 뒤쪽(음수)에 있고 거리가 반지름보다 크면 외부
-
-	// 6개 평면 각각에 대해 테스트
-	const FPlane* Planes[6] = {
-		&Frustum.LeftFace,
-		&Frustum.RightFace,
-		&Frustum.TopFace,
-		&Frustum.BottomFace,
-		&Frustum.NearFace,
-		&Frustum.FarFace
-	};
-
-	for (int i = 0; i < 6; ++i)
+	// 경계 i 의 평면은 타일 i-1 과 i 사이. 타일 t 는 경계 t 에 못 미친 구 (거리 < -r) 나
+	// 경계 t+1 을 완전히 넘어간 구 (거리 > r) 와 겹치지 않는다 (타일 프러스텀의 옆면 테스트와 같음)
+	// 통과한 타일 중 처음과 마지막을 범위로 쓴다
+	const int32 NumTiles = Planes.Num() - 1;
+	const int32 NumPadded = LightCenterX.Num();
+	OutFirst.SetNum(NumPadded);
+	OutLast.SetNum(NumPadded);
+
+	for (int32 L = 0; L < NumPadded; L += 4)
 	{
-		// 평면 방정식: Normal · P + Distance = 0
-		// 점 P에서 평면까지의 부호 있는 거리 = Normal · P + Distance
-		FVector Normal3D(Planes[i]->Normal.X, Planes[i]->Normal.Y, Planes[i]->Normal.Z);
-		float SignedDistance = FVector::Dot(Normal3D, Center) + Planes[i]->Distance;
+		const __m128 CX = _mm_loadu_ps(&LightCenterX[L]);
+		const __m128 CY = _mm_loadu_ps(&LightCenterY[L]);
+		const __m128 CZ = _mm_loadu_ps(&LightCenterZ[L]);
+		const __m128 R = _mm_loadu_ps(&LightRadius[L]);
+		const __m128 NegR = _mm_sub_ps(_mm_setzero_ps(), R);
 
-		// 구체가 평면 뒤쪽에 완전히 있으면 교차하지 않음
-		if (SignedDistance < -Radius)
+		auto PlaneDistance = [&](const FVector4& Plane)
 		{
-			return false;
+			__m128 Dist = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(Plane.X), CX), _mm_set1_ps(Plane.W));
+			Dist = _mm_add_ps(Dist, _mm_mul_ps(_mm_set1_ps(Plane.Y), CY));
+			return _mm_add_ps(Dist, _mm_mul_ps(_mm_set1_ps(Plane.Z), CZ));
+		};
+
+		__m128i First = _mm_set1_epi32(INT_MAX);
+		__m128i Last = _mm_set1_epi32(INT_MIN);
+		__m128i Found = _mm_setzero_si128();
+		__m128 PrevDist = PlaneDistance(Planes[0]);
+		for (int32 t = 0; t < NumTiles; ++t)
+		{
+			const __m128 NextDist = PlaneDistance(Planes[t + 1]);
+			const __m128i Passed = _mm_castps_si128(_mm_and_ps(_mm_cmpge_ps(PrevDist, NegR), _mm_cmple_ps(NextDist, R)));
+			const __m128i Tile = _mm_set1_epi32(t);
+
+			// 처음 통과한 타일은 한 번만, 마지막은 통과할 때마다 갱신
+			const __m128i FirstHit = _mm_andnot_si128(Found, Passed);
+			First = _mm_or_si128(_mm_and_si128(FirstHit, Tile), _mm_andnot_si128(FirstHit, First));
+			Last = _mm_or_si128(_mm_and_si128(Passed, Tile), _mm_andnot_si128(Passed, Last));
+			Found = _mm_or_si128(Found, Passed);
+			PrevDist = NextDist;
 		}
+
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(&OutFirst[L]), First);
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(&OutLast[L]), Last);
 	}
 
-	return true;
+	// 패딩 레인은 빈 범위
+	for (int32 L = NumCullLights; L < NumPadded; ++L)
+	{
+		OutFirst[L] = INT_MAX;
+		OutLast[L] = INT_MIN;
+	}
 }
 
-bool FTileLightCuller::ConeIntersectsFrustum(
-	const FVector& Apex,
-	const FVector& Direction,
-	float Height,
-	float CosHalfAngle,
-	const FFrustum& Frustum)
+void FTileLightCuller::CullTileRow(UINT TileY, TArray<int32>& RowLights, TArray<int32>& RowFirstX, TArray<int32>& RowLastX)
 {
-	// 원뿔-프러스텀 교차 테스트
-	float SinHalfAngle = sqrt(1.0f - CosHalfAngle * CosHalfAngle);
-
-	// 원뿔 밑면의 반지름
-	float BaseRadius = Height * SinHalfAngle;
-
-	// 경계 구체의 중심은 원뿔 축을 따라 이동
-	float K = (CosHalfAngle > 0.707f) ? 0.5f : (0.5f + 0.5f * SinHalfAngle);
-	FVector SphereCenter = Apex + Direction * (Height * K);
-
-	// 경계 구체의 반지름 (원뿔의 꼭지점과 밑면 가장자리를 모두 포함)
-	float SphereRadius;
-	if (CosHalfAngle > 0.707f) // 각도가 45도 이하 (좁은 원뿔)
+	TArray<uint32>& RowIndices = RowLightIndices[TileY];
+	RowIndices.clear();
+
+	// 1) 이 행과 겹치는 라이트만 추린다 (라이트 순서 유지)
+	RowLights.clear();
+	RowFirstX.clear();
+	RowLastX.clear();
+	const __m128i RowIndex = _mm_set1_epi32(static_cast<int32>(TileY));
+	for (int32 L = 0; L < LightFirstY.Num(); L += 4)
 	{
-		// 좁은 원뿔: 밑면 중심에서 가장자리까지의 거리
-		SphereRadius = sqrt(BaseRadius * BaseRadius + (Height * 0.5f) * (Height * 0.5f));
-	}
-	else // 각도가 45도 이상 (넓은 원뿔)
-	{
-		// 넓은 원뿔: 더 보수적인 반지름 사용
-		SphereRadius = Height * 0.866f; // sqrt(3)/2 ≈ 0.866
+		const __m128i First = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&LightFirstY[L]));
+		const __m128i Last = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&LightLastY[L]));
+		int32 Mask = RangeContainsMask(First, Last, RowIndex);
+		while (Mask)
+		{
+			const int32 Lane = std::countr_zero(static_cast<uint32>(Mask));
+			Mask &= Mask - 1;
+			RowLights.Add(L + Lane);
+			RowFirstX.Add(LightFirstX[L + Lane]);
+			RowLastX.Add(LightLastX[L + Lane]);
+		}
 	}
+	PadTo4(RowFirstX, RowLastX);
 
-	// 2. 경계 구체가 프러스텀과 교차하는지 먼저 테스트 (빠른 거부)
-	if (!SphereIntersectsFrustum(SphereCenter, SphereRadius, Frustum))
+	// 2) 열마다 겹치는 라이트를 기록
+	uint32 RowPassed = 0;
+	uint32 RowMin = UINT_MAX;
+	uint32 RowMax = 0;
+	for (UINT TileX = 0; TileX < TileCountX; ++TileX)
 	{
-		return false;
-	}
+		uint32 LightCount = 0;
 
-	// 3. 추가 정밀 테스트: 원뿔 끝점(밑면 중심)도 체크
-	FVector ConeEnd = Apex + Direction * Height;
-
-	// 6개 평면 각각에 대해 테스트
-	const FPlane* Planes[6] = {
-		&Frustum.LeftFace,
-		&Frustum.RightFace,
-		&Frustum.TopFace,
-		&Frustum.BottomFace,
-		&Frustum.NearFace,
-		&Frustum.FarFace
-	};
+		const __m128i ColumnIndex = _mm_set1_epi32(static_cast<int32>(TileX));
+		for (int32 L = 0; L < RowFirstX.Num() && LightCount < MaxLightsPerTile; L += 4)
+		{
+			const __m128i First = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&RowFirstX[L]));
+			const __m128i Last = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&RowLastX[L]));
+			int32 Mask = RangeContainsMask(First, Last, ColumnIndex);
+			while (Mask && LightCount < MaxLightsPerTile)
+			{
+				const int32 Lane = std::countr_zero(static_cast<uint32>(Mask));
+				Mask &= Mask - 1;
+				RowIndices.Add(LightPackedIndex[RowLights[L + Lane]]);
+				++LightCount;
+			}
+		}
 
-	// 원뿔의 꼭지점과 끝점이 모두 같은 평면 뒤쪽에 있는지 확인
-	for (int i = 0; i < 6; ++i)
-	{
-		FVector Normal3D(Planes[i]->Normal.X, Planes[i]->Normal.Y, Planes[i]->Normal.Z);
+		// 그리드에 우선 개수만 기록 (시작 위치는 PackTileRow 에서)
+		TileLightData[TileY * TileCountX + TileX] = LightCount;
 
-		float ApexDistance = FVector::Dot(Normal3D, Apex) + Planes[i]->Distance;
-		float EndDistance = FVector::Dot(Normal3D, ConeEnd) + Planes[i]->Distance;
+		RowPassed += LightCount;
+		RowMin = std::min(RowMin, LightCount);
+		RowMax = std::max(RowMax, LightCount);
+	}
 
-		// 두 점이 모두 평면 뒤쪽에 있고, 밑면 반지름보다 멀리 있으면 완전히 외부
-		if (ApexDistance < -BaseRadius && EndDistance < -BaseRadius)
-		{
-			return false;
-		}
+	RowLightsPassed[TileY] = RowPassed;
+	RowMinLights[TileY] = TileCountX > 0 ? RowMin : 0;
+	RowMaxLights[TileY] = RowMax;
+}
+
+void FTileLightCuller::PackTileRow(UINT TileY)
+{
+	const TArray<uint32>& RowIndices = RowLightIndices[TileY];
+	uint32 Offset = TotalTileCount + RowIndexOffsets[TileY];
+	if (!RowIndices.IsEmpty())
+	{
+		memcpy(&TileLightData[Offset], RowIndices.GetData(), RowIndices.Num() * sizeof(uint32));
 	}
 
-	// 모든 테스트를 통과하면 교차한다고 판단
-	return true;
+	for (UINT TileX = 0; TileX < TileCountX; ++TileX)
+	{
+		uint32& GridWord = TileLightData[TileY * TileCountX + TileX];
+		const uint32 LightCount = GridWord;
+		// 시작 위치가 24비트를 넘는 타일은 비운다 (4K 에서도 한참 남는 크기)
+		GridWord = Offset + LightCount <= MaxGridOffset ? (Offset << GridOffsetShift) | LightCount : 0;
+		Offset += LightCount;
+	}
 }
 
 ID3D11ShaderResourceView* FTileLightCuller::GetLightIndexBufferSRV()
@@ -414,6 +534,5 @@ void FTileLightCuller::Release()
 		LightIndexBuffer->Release();
 		LightIndexBuffer = nullptr;
 	}
-
-	TileLightIndices.Empty();
+	BufferCapacity = 0;
 }
@@ -2,13 +2,32 @@
 #include "LightManager.h"
 #include "TileCullingStats.h"
 #include "D3D11RHI.h"
-#include "Frustum.h"
 
 // 타일 기반 라이트 컬링을 CPU에서 수행하는 클래스
-// Conservative(near, far) frustum 방식으로 각 타일에 영향을 주는 라이트를 계산
+// - 라이트는 프레임마다 한 번 뷰 공간 바운딩 구로 변환한다 (스팟은 원뿔을 감싸는 구)
+// - 타일 옆면 4개는 열 경계(X)와 행 경계(Y) 평면으로 나뉘므로, 라이트마다 옆면 테스트를 통과하는 열/행 범위를 구해
+//   타일마다 구-프러스텀 테스트를 하는 대신 쓴다. 범위 계산은 라이트 4개씩 SSE 로 처리
+// - 타일 목록은 행 단위로 잡 시스템에서 병렬로 채운다
+// - 깊이 제한 (clustered Z): 뷰 깊이를 로그 간격 DepthSliceCount 개 슬라이스로 나누고
+//   라이트 인덱스 워드에 라이트가 걸친 슬라이스 범위를 넣는다. 셰이더는 픽셀 깊이의 슬라이스가 범위 밖인 라이트를 건너뛴다
+// - 결과는 가변 길이: 타일 그리드(시작 위치, 개수) 뒤에 모든 타일의 인덱스를 이어 붙인 하나의 버퍼.
+//   행별 목록을 만든 뒤 prefix sum 으로 위치를 정해 모으고, 실제로 쓴 크기만 업로드한다
 class FTileLightCuller
 {
 public:
+	// 라이트 인덱스 워드 구성 (LightingBuffers.hlsl 과 일치)
+	// [0..15] 라이트 인덱스, [16..19] 타입 (0=Point, 1=Spot), [20..24] 최소 깊이 슬라이스, [25..29] 최대 깊이 슬라이스
+	static constexpr uint32 LightTypeShift = 16;
+	static constexpr uint32 MinSliceShift = 20;
+	static constexpr uint32 MaxSliceShift = 25;
+	static constexpr uint32 DepthSliceCount = 32;
+
+	// 타일 그리드 워드 (LightingBuffers.hlsl 과 일치): [0..7] 라이트 개수, [8..31] 버퍼 안에서 인덱스 목록 시작 위치
+	static constexpr uint32 GridOffsetShift = 8;
+	static constexpr uint32 MaxGridOffset = (1u << 24) - 1;
+	// 타일당 최대 라이트 개수 (그리드 워드의 개수 비트)
+	static constexpr uint32 MaxLightsPerTile = 255;
+
 	FTileLightCuller();
 	~FTileLightCuller();
 
@@ -16,6 +35,7 @@ public:
 	void Initialize(D3D11RHI* InRHI, UINT InTileSize = 16);
 
 	// 타일 컬링 수행 (매 프레임 호출)
+	// bDepthBounds: 깊이 슬라이스 범위를 인덱스에 기록 (끄면 모든 슬라이스를 허용)
 	void CullLights(
 		const TArray<FPointLightInfo>& PointLights,
 		const TArray<FSpotLightInfo>& SpotLights,
@@ -24,12 +44,18 @@ public:
 		float NearPlane,
 		float FarPlane,
 		UINT ViewportWidth,
-		UINT ViewportHeight
+		UINT ViewportHeight,
+		bool bDepthBounds = true
 	);
 
 	// 컬링 결과를 Structured Buffer에 업데이트하고 SRV 반환
 	ID3D11ShaderResourceView* GetLightIndexBufferSRV();
 
+	// 픽셀 깊이 슬라이스 = clamp(floor(log2(ViewDepth) * Scale + Bias), 0, DepthSliceCount - 1)
+	// 깊이 제한을 쓰지 않으면 둘 다 0 (모든 픽셀이 슬라이스 0)
+	float GetDepthSliceScale() const { return DepthSliceScale; }
+	float GetDepthSliceBias() const { return DepthSliceBias; }
+
 	// 통계 정보 반환
 	const FTileCullingStats& GetStats() const { return Stats; }
 
@@ -37,30 +63,34 @@ public:
 	void Release();
 
 private:
-	// 타일 프러스텀 생성 (Conservative near/far 방식)
-	FFrustum CreateTileFrustum(
-		UINT TileX,
-		UINT TileY,
-		const FMatrix& InvViewProj,
+	// 라이트를 뷰 공간 바운딩 구(SoA)로 변환하고 깊이 슬라이스 범위를 인덱스 워드에 기록
+	// 근/원 평면 밖의 라이트는 여기서 제외
+	void PrepareLights(
+		const TArray<FPointLightInfo>& PointLights,
+		const TArray<FSpotLightInfo>& SpotLights,
+		const FMatrix& ViewMatrix,
+		const FMatrix& ProjMatrix,
 		float NearPlane,
-		float FarPlane
+		float FarPlane,
+		bool bDepthBounds
 	);
+	void AddLight(const FVector& ViewCenter, float Radius, uint32 PackedIndex, const FMatrix& ProjMatrix, float NearPlane, float FarPlane, bool bPerspective);
 
-	// 라이트가 타일 프러스텀과 교차하는지 테스트
-	bool TestPointLightAgainstFrustum(const FPointLightInfo& Light, const FFrustum& Frustum, const FMatrix& ViewMatrix);
-	bool TestSpotLightAgainstFrustum(const FSpotLightInfo& Light, const FFrustum& Frustum, const FMatrix& ViewMatrix);
+	// 타일 경계 평면 (뷰 공간, Normal · P + W = 0). 법선은 타일 인덱스가 커지는 쪽을 향한다
+	void BuildBoundaryPlanes(const FMatrix& ProjMatrix, UINT ViewportWidth, UINT ViewportHeight);
 
-	// 구체와 프러스텀 교차 테스트
-	bool SphereIntersectsFrustum(const FVector& Center, float Radius, const FFrustum& Frustum);
+	// 경계 평면들과 라이트 구를 4개씩 비교해 라이트마다 겹치는 타일 범위 [OutFirst, OutLast] 계산
+	void ComputeTileRanges(const TArray<FVector4>& Planes, TArray<int32>& OutFirst, TArray<int32>& OutLast) const;
 
-	// 원뿔과 프러스텀 교차 테스트 (SpotLight용)
-	bool ConeIntersectsFrustum(
-		const FVector& Apex,           // 원뿔 꼭지점 (라이트 위치)
-		const FVector& Direction,      // 원뿔 방향 (정규화됨)
-		float Height,                  // 원뿔 높이 (AttenuationRadius)
-		float CosHalfAngle,            // cos(OuterConeAngle / 2)
-		const FFrustum& Frustum
-	);
+	// 1패스: 타일 한 행의 라이트 목록(RowLightIndices)과 타일별 개수 채우기. RowLights 는 호출자가 재사용하는 작업 버퍼
+	void CullTileRow(UINT TileY, TArray<int32>& RowLights, TArray<int32>& RowFirstX, TArray<int32>& RowLastX);
+	// 2패스: 행 목록을 TileLightData 의 제 위치로 복사하고 그리드 워드 완성
+	void PackTileRow(UINT TileY);
+
+	// 필요하면 버퍼를 키우고 TileLightData 를 업로드
+	void UploadLightData();
+
+	uint32 ComputeDepthSlice(float ViewDepth) const;
 
 private:
 	D3D11RHI* RHI;
@@ -71,17 +101,43 @@ private:
 	UINT TileCountY;        // 세로 타일 개수
 	UINT TotalTileCount;    // 전체 타일 개수
 
-	// 타일당 최대 라이트 개수 (보수적으로 설정)
-	static constexpr UINT MaxLightsPerTile = 256;
-
-	// 타일별 라이트 인덱스 저장
-	// [TileIndex * MaxLightsPerTile] 위치에 라이트 개수 저장
-	// [TileIndex * MaxLightsPerTile + 1 ~ ...] 위치에 라이트 인덱스 저장
-	TArray<uint32> TileLightIndices;
+	// GPU 로 보낼 데이터
+	// [0 ~ TotalTileCount) 타일 그리드 워드
+	// [TotalTileCount ~ ...) 모든 타일의 라이트 인덱스를 타일 순서대로 이어 붙인 목록
+	TArray<uint32> TileLightData;
+
+	// 1패스 결과: 행별 라이트 인덱스 목록과 그 행의 목록 안 시작 위치 (prefix sum)
+	TArray<TArray<uint32>> RowLightIndices;
+	TArray<uint32> RowIndexOffsets;
+
+	// 컬링 대상 라이트 (SoA, 4의 배수로 패딩. 패딩은 어떤 타일 범위에도 들지 않는다)
+	int32 NumCullLights = 0;
+	TArray<float> LightCenterX;
+	TArray<float> LightCenterY;
+	TArray<float> LightCenterZ;
+	TArray<float> LightRadius;
+	TArray<uint32> LightPackedIndex;
+	TArray<int32> LightFirstX;
+	TArray<int32> LightLastX;
+	TArray<int32> LightFirstY;
+	TArray<int32> LightLastY;
+
+	// 열 경계 TileCountX + 1 개, 행 경계 TileCountY + 1 개
+	TArray<FVector4> ColumnPlanes;
+	TArray<FVector4> RowPlanes;
+
+	// 행별 통계 (병렬로 채운 뒤 합산)
+	TArray<uint32> RowLightsPassed;
+	TArray<uint32> RowMinLights;
+	TArray<uint32> RowMaxLights;
+
+	float DepthSliceScale = 0.0f;
+	float DepthSliceBias = 0.0f;
 
 	// GPU 리소스
 	ID3D11Buffer* LightIndexBuffer;
 	ID3D11ShaderResourceView* LightIndexBufferSRV;
+	UINT BufferCapacity = 0;    // 버퍼 원소 수 (TileLightData 보다 크거나 같다)
 
 	// 통계
 	FTileCullingStats Stats;
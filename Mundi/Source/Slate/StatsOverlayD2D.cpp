@@ -7,12 +7,14 @@
 #include "StatsOverlayD2D.h"
 #include "UIManager.h"
 #include "MemoryManager.h"
+#include "FrameArena.h"
 #include "Picking.h"
 #include "PlatformTime.h"
 #include "DecalStatManager.h"
 #include "TileCullingStats.h"
 #include "LightStats.h"
 #include "ShadowStats.h"
+#include "CullingStats.h"
 
 #pragma comment(lib, "d2d1")
 #pragma comment(lib, "dwrite")
@@ -98,7 +100,7 @@ static void DrawTextBlock(
 
 void UStatsOverlayD2D::Draw()
 {
-	if (!bInitialized || (!bShowFPS && !bShowMemory && !bShowPicking && !bShowDecal && !bShowTileCulling && !bShowLights && !bShowShadow && !bShowSkinningProfile) || !SwapChain)
+	if (!bInitialized || (!bShowFPS && !bShowMemory && !bShowPicking && !bShowDecal && !bShowTileCulling && !bShowLights && !bShowShadow && !bShowCulling && !bShowSkinningProfile) || !SwapChain)
 		return;
 
 	ID2D1Factory1* D2dFactory = nullptr;
@@ -223,18 +225,24 @@ void UStatsOverlayD2D::Draw()
 
 	if (bShowMemory)
 	{
-		double Mb = static_cast<double>(FMemoryManager::TotalAllocationBytes) / (1024.0 * 1024.0);
+		const FMemoryStats MemStats = FMemoryManager::GetStats();
+		double Mb = static_cast<double>(MemStats.LiveBytes) / (1024.0 * 1024.0);
+		double PoolMb = static_cast<double>(MemStats.PoolReservedBytes) / (1024.0 * 1024.0);
 
-		wchar_t Buf[128];
-		swprintf_s(Buf, L"Memory: %.1f MB\nAllocs: %u", Mb, FMemoryManager::TotalAllocationCount);
+		double ArenaKb = static_cast<double>(FFrameArena::Get().GetLastFrameUsedBytes()) / 1024.0;
+
+		wchar_t Buf[256];
+		swprintf_s(Buf, L"Memory: %.1f MB\nAllocs: %llu\nPool: %.1f MB (Frag %.1f%%)\nLarge: %llu\nFrame Arena: %.1f KB",
+			Mb, MemStats.LiveCount, PoolMb, MemStats.GetPoolFragmentation() * 100.0, MemStats.LargeLiveCount, ArenaKb);
 
-		D2D1_RECT_F Rc = D2D1::RectF(Margin, NextY, Margin + PanelWidth, NextY + PanelHeight);
+		const float MemoryPanelHeight = 116.0f;
+		D2D1_RECT_F Rc = D2D1::RectF(Margin, NextY, Margin + PanelWidth, NextY + MemoryPanelHeight);
 		DrawTextBlock(
 			D2dCtx, Dwrite, Buf, Rc, 16.0f,
 			D2D1::ColorF(0, 0, 0, 0.6f),
 			D2D1::ColorF(D2D1::ColorF::LightGreen));
 
-		NextY += PanelHeight + Space;
+		NextY += MemoryPanelHeight + Space;
 	}
 
 	if (bShowDecal)
@@ -276,7 +284,7 @@ void UStatsOverlayD2D::Draw()
 
 		// 2. 출력할 문자열 버퍼를 만듭니다.
 		wchar_t Buf[512];
-		swprintf_s(Buf, L"[Tile Culling Stats]\nTiles: %u x %u (%u)\nLights: %u (P:%u S:%u)\nMin/Avg/Max: %u / %.1f / %u\nCulling Eff: %.1f%%\nBuffer: %u KB",
+		swprintf_s(Buf, L"[Tile Culling Stats]\nTiles: %u x %u (%u)\nLights: %u (P:%u S:%u)\nMin/Avg/Max: %u / %.1f / %u\nCulling Eff: %.1f%%\nCPU Cull: %.3f ms (Z Slices: %u)\nUpload: %u KB / Buffer: %u KB",
 			TileStats.TileCountX,
 			TileStats.TileCountY,
 			TileStats.TotalTileCount,
@@ -287,10 +295,13 @@ void UStatsOverlayD2D::Draw()
 			TileStats.AvgLightsPerTile,
 			TileStats.MaxLightsPerTile,
 			TileStats.CullingEfficiency,
+			TileStats.CPUCullTimeMS,
+			TileStats.DepthSliceCount,
+			TileStats.UploadBytesPerFrame / 1024,
 			TileStats.LightIndexBufferSizeBytes / 1024);
 
 		// 3. 텍스트를 여러 줄 표시해야 하므로 패널 높이를 늘립니다.
-		const float tilePanelHeight = 160.0f;
+		const float tilePanelHeight = 180.0f;
 		D2D1_RECT_F rc = D2D1::RectF(Margin, NextY, Margin + PanelWidth, NextY + tilePanelHeight);
 
 		// 4. DrawTextBlock 함수를 호출하여 화면에 그립니다. 색상은 구분을 위해 cyan으로 설정합니다.
@@ -374,6 +385,49 @@ void UStatsOverlayD2D::Draw()
 		NextY += shadowPanelHeight + Space;
 	}
 
+	if (bShowCulling)
+	{
+		// 1. FCullingStatManager로부터 뷰별 컬링 통계를 가져옵니다.
+		const FCullingStats& CullingStats = FCullingStatManager::GetInstance().GetStats();
+
+		// 2. 메인 뷰 + 그림자 뷰 합계, 그림자 뷰는 앞에서부터 최대 MaxShadowViewLines 개만 줄로 표시합니다.
+		constexpr int32 MaxShadowViewLines = 8;
+		wchar_t Buf[1024];
+		int32 Len = swprintf_s(Buf, L"[Culling Stats]\nMain: %u visible / %u culled (wait %.3fms)\nShadow Views: %d (%.3fms)\n  Total: %u visible / %u culled",
+			CullingStats.MainView.NumVisible,
+			CullingStats.MainView.NumCulled,
+			CullingStats.MainViewWaitMS,
+			CullingStats.ShadowViews.Num(),
+			CullingStats.ShadowViewCullMS,
+			CullingStats.TotalShadowVisible,
+			CullingStats.TotalShadowCulled);
+
+		const int32 NumViewLines = std::min(CullingStats.ShadowViews.Num(), MaxShadowViewLines);
+		for (int32 i = 0; i < NumViewLines && Len > 0; ++i)
+		{
+			const FCullingViewStats& ViewStats = CullingStats.ShadowViews[i];
+			Len += swprintf_s(Buf + Len, _countof(Buf) - Len, L"\n  %hs[%d]: %u / %u",
+				ViewStats.Name, ViewStats.SubViewIndex, ViewStats.NumVisible, ViewStats.NumCulled);
+		}
+		if (CullingStats.ShadowViews.Num() > NumViewLines && Len > 0)
+		{
+			swprintf_s(Buf + Len, _countof(Buf) - Len, L"\n  ... (+%d)", CullingStats.ShadowViews.Num() - NumViewLines);
+		}
+
+		// 3. 그림자 뷰 줄 수에 맞춰 패널 높이를 늘립니다.
+		const int32 NumExtraLines = NumViewLines + (CullingStats.ShadowViews.Num() > NumViewLines ? 1 : 0);
+		const float cullingPanelHeight = 100.0f + 20.0f * static_cast<float>(NumExtraLines);
+		D2D1_RECT_F rc = D2D1::RectF(Margin, NextY, Margin + PanelWidth, NextY + cullingPanelHeight);
+
+		// 4. DrawTextBlock 함수를 호출하여 화면에 그립니다. 색상은 구분을 위해 연두색(LawnGreen)으로 설정합니다.
+		DrawTextBlock(
+			D2dCtx, Dwrite, Buf, rc, 16.0f,
+			D2D1::ColorF(0, 0, 0, 0.6f),
+			D2D1::ColorF(D2D1::ColorF::LawnGreen));
+
+		NextY += cullingPanelHeight + Space;
+	}
+
 	if (bShowSkinningProfile)
 	{
 		wchar_t Buf[512];
@@ -480,6 +534,16 @@ void UStatsOverlayD2D::ToggleShadow()
 	bShowShadow = !bShowShadow;
 }
 
+void UStatsOverlayD2D::SetShowCulling(bool b)
+{
+	bShowCulling = b;
+}
+
+void UStatsOverlayD2D::ToggleCulling()
+{
+	bShowCulling = !bShowCulling;
+}
+
 void UStatsOverlayD2D::ToggleSkinningProfile()
 {
 	bShowSkinningProfile = !bShowSkinningProfile;
@@ -19,6 +19,7 @@ public:
     void SetShowTileCulling(bool b);
     void SetShowLights(bool b);
     void SetShowShadow(bool b);
+    void SetShowCulling(bool b);
     void SetShowSkinningProfile(bool bInShowSkinningProfile);
     void ToggleFPS();
     void ToggleMemory();
@@ -27,6 +28,7 @@ public:
     void ToggleTileCulling();
     void ToggleLights();
     void ToggleShadow();
+    void ToggleCulling();
     void ToggleSkinningProfile();
     bool IsFPSVisible() const { return bShowFPS; }
     bool IsMemoryVisible() const { return bShowMemory; }
@@ -35,6 +37,7 @@ public:
     bool IsTileCullingVisible() const { return bShowTileCulling; }
     bool IsLightsVisible() const { return bShowLights; }
     bool IsShadowVisible() const { return bShowShadow; }
+    bool IsCullingVisible() const { return bShowCulling; }
     bool IsSkinningProfileVisible() const { return bShowSkinningProfile; }
 
 private:
@@ -55,6 +58,7 @@ private:
     bool bShowTileCulling = false;
     bool bShowShadow = false;
     bool bShowLights = false;
+    bool bShowCulling = false;
     bool bShowSkinningProfile = false;
 
     ID3D11Device* D3DDevice = nullptr;
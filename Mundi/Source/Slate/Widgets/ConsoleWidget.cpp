@@ -4,6 +4,8 @@
 #include "GlobalConsole.h"
 #include "StatsOverlayD2D.h"
 #include "USlateManager.h"
+#include "MemoryManager.h"
+#include "Benchmark.h"
 #include <windows.h>
 #include <cstdarg>
 #include <cctype>
@@ -52,9 +54,12 @@ void UConsoleWidget::Initialize()
 	HelpCommandList.Add("STAT NONE");
 	HelpCommandList.Add("STAT LIGHT");
 	HelpCommandList.Add("STAT SHADOW");
+	HelpCommandList.Add("STAT CULLING");
 	HelpCommandList.Add("STAT SKINNING");
 	HelpCommandList.Add("CPU SKINNING");
 	HelpCommandList.Add("GPU SKINNING");
+	HelpCommandList.Add("MEMREPORT");
+	HelpCommandList.Add("BENCH");
 
 	// Add welcome messages
 	AddLog("=== Console Widget Initialized ===");
@@ -362,6 +367,7 @@ void UConsoleWidget::ExecCommand(const char* command_line)
 		AddLog("- STAT DECAL");
 		AddLog("- STAT ALL");
 		AddLog("- STAT LIGHT");
+		AddLog("- STAT CULLING");
 		AddLog("- STAT SKINNING");
 		AddLog("- STAT NONE");
 	}
@@ -390,6 +396,11 @@ void UConsoleWidget::ExecCommand(const char* command_line)
 		UStatsOverlayD2D::Get().ToggleTileCulling();
 		AddLog("STAT LIGHT TOGGLED");
 	}
+	else if (Stricmp(command_line, "STAT CULLING") == 0)
+	{
+		UStatsOverlayD2D::Get().ToggleCulling();
+		AddLog("STAT CULLING TOGGLED");
+	}
 	else if (Stricmp(command_line, "STAT Skinning") == 0)
 	{
 		UStatsOverlayD2D::Get().ToggleSkinningProfile();
@@ -406,6 +417,21 @@ void UConsoleWidget::ExecCommand(const char* command_line)
 		GEngine.GetRenderer()->SetGpuSkinning(true);
 		AddLog("GPU SKINNING On");
 	}
+	else if (Stricmp(command_line, "MEMREPORT") == 0)
+	{
+		FMemoryManager::DumpStats();
+	}
+	else if (Stricmp(command_line, "BENCH") == 0)
+	{
+		FBenchmarkRegistry::LogList();
+	}
+	else if (Strnicmp(command_line, "BENCH ", 6) == 0)
+	{
+		if (!FBenchmarkRegistry::Run(command_line + 6))
+		{
+			AddLog("Unknown benchmark: '%s'", command_line + 6);
+		}
+	}
 	else if (Stricmp(command_line, "STAT ALL") == 0)
 	{
 		UStatsOverlayD2D::Get().SetShowFPS(true);
@@ -413,6 +439,7 @@ void UConsoleWidget::ExecCommand(const char* command_line)
 		UStatsOverlayD2D::Get().SetShowPicking(true);
 		UStatsOverlayD2D::Get().SetShowDecal(true);
 		UStatsOverlayD2D::Get().SetShowTileCulling(true);
+		UStatsOverlayD2D::Get().SetShowCulling(true);
 		AddLog("STAT: ON");
 	}
 	else if (Stricmp(command_line, "STAT NONE") == 0)
@@ -422,6 +449,7 @@ void UConsoleWidget::ExecCommand(const char* command_line)
 		UStatsOverlayD2D::Get().SetShowPicking(false);
 		UStatsOverlayD2D::Get().SetShowDecal(false);
 		UStatsOverlayD2D::Get().SetShowTileCulling(false);
+		UStatsOverlayD2D::Get().SetShowCulling(false);
 		AddLog("STAT: OFF");
 	}
 	else
@@ -1418,6 +1418,7 @@ void SViewportWindow::RenderShowFlagDropdownMenu()
 				UStatsOverlayD2D::Get().SetShowTileCulling(false);
 				UStatsOverlayD2D::Get().SetShowLights(false);
 				UStatsOverlayD2D::Get().SetShowShadow(false);
+				UStatsOverlayD2D::Get().SetShowCulling(false);
 			}
 
 			if (ImGui::IsItemHovered())
@@ -1507,6 +1508,16 @@ void SViewportWindow::RenderShowFlagDropdownMenu()
 				ImGui::SetTooltip("셉도우 맵 통계를 표시합니다. (셉도우 라이트 개수, 아틀라스 크기, 메모리 사용량)");
 			}
 
+			bool bCullingStats = UStatsOverlayD2D::Get().IsCullingVisible();
+			if (ImGui::Checkbox(" CULLING", &bCullingStats))
+			{
+				UStatsOverlayD2D::Get().ToggleCulling();
+			}
+			if (ImGui::IsItemHovered())
+			{
+				ImGui::SetTooltip("뷰별 절두체 컬링 통계를 표시합니다. (메인 뷰, 그림자 뷰의 보이는/컬링된 메시 수)");
+			}
+
 			ImGui::EndMenu();
 		}
 